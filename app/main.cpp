@@ -1,16 +1,37 @@
 // CalcEval
+#include "calceval/Compiler.hpp"
+#include "calceval/Document.hpp"
 #include "calceval/Parser.hpp"
+#include "calceval/Plugin.hpp"
+#include "calceval/Session.hpp"
+#include "calceval/Sweep.hpp"
 
 // C++ Headers
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <optional>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
-std::optional<double> parse(const std::string& expr)
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using symbols_type = CalcEval::Parser<>::symbols_type;
+
+std::optional<double> parse(const std::string& expr, const symbols_type& symbols)
 {
     try
     {
-        CalcEval::Parser parser{};
+        const CalcEval::Parser parser{symbols};
         return parser.parse(expr);
     }
     catch (CalcEval::ParserError& e)
@@ -25,31 +46,244 @@ std::optional<double> parse(const std::string& expr)
     return std::nullopt;
 }
 
+// "name = expr" defines a name in the session and prints every name that
+// got another value, other lines are evaluated with the names.
+void evaluate(const std::string& line, CalcEval::Session& session)
+{
+    try
+    {
+        if (const auto assignment = CalcEval::Session::assignment(line))
+        {
+            for (const std::string& name : session.define(assignment->first, assignment->second))
+            {
+                if (const auto value = session.value(name))
+                    std::cout << name << " = " << *value << '\n';
+                else
+                    std::cout << name << ": " << session.error(name) << '\n';
+            }
+            std::cout << std::flush;
+        }
+        else
+        {
+            std::cout << session.evaluate(line) << std::endl;
+        }
+    }
+    catch (CalcEval::ParserError& e)
+    {
+        std::cerr << "Error parsing!\n" << e.what() << std::endl;
+    }
+    catch (CalcEval::ScannerError& e)
+    {
+        std::cerr << "Error scanning!\n" << e.what() << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+// Arguments with '=' are axes, the other one is the expression. Prints
+// one line per point, the values of the axes followed by the result.
+int sweep(int first, int argc, char* argv[], const symbols_type& symbols)
+{
+    std::vector<CalcEval::Sweep::Axis> axes{};
+    std::vector<std::string> names{};
+    std::optional<std::string> expr{};
+    try
+    {
+        for (int i{first}; i < argc; ++i)
+        {
+            const std::string arg{argv[i]};
+            if (arg.find('=') != std::string::npos)
+            {
+                axes.push_back(CalcEval::Sweep::Axis::parse(arg));
+                names.push_back(axes.back().name);
+            }
+            else if (!expr)
+                expr = arg;
+            else
+                throw std::invalid_argument("Sweep: more than one expression");
+        }
+        if (!expr)
+            throw std::invalid_argument("Sweep: no expression");
+
+        const CalcEval::Compiler compiler{symbols};
+        const CalcEval::Sweep sweep{compiler.compile(*expr, names), axes};
+        sweep.run([](const CalcEval::Sweep::Block& block) {
+            for (std::size_t i{0}; i < block.results.size(); ++i)
+            {
+                for (const double value : block.outer)
+                    std::cout << value << '\t';
+                std::cout << block.inner[i] << '\t' << block.results[i] << '\n';
+            }
+        });
+        std::cout << std::flush;
+        return 0;
+    }
+    catch (CalcEval::ParserError& e)
+    {
+        std::cerr << "Error parsing!\n" << e.what() << std::endl;
+    }
+    catch (CalcEval::ScannerError& e)
+    {
+        std::cerr << "Error scanning!\n" << e.what() << std::endl;
+    }
+    catch (std::invalid_argument& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+
+    return 1;
+}
+
+// Content of a file, std::nullopt if it can not be read.
+std::optional<std::string> readFile(const std::string& path)
+{
+    std::ifstream in{path, std::ios::binary | std::ios::ate};
+    if (!in)
+        return std::nullopt;
+
+    std::string content(static_cast<std::size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(content.data(), static_cast<std::streamsize>(content.size()));
+    content.resize(static_cast<std::size_t>(in.gcount()));
+    return content;
+}
+
+// Prints "line: value" or "line: error" for every line of the file that got
+// another value or error.
+void print(const std::vector<CalcEval::Document::Result>& results)
+{
+    for (const CalcEval::Document::Result& result : results)
+    {
+        if (result.value)
+            std::cout << result.line << ": " << *result.value << '\n';
+        else if (!result.error.empty())
+            std::cout << result.line << ": " << result.error << '\n';
+    }
+    std::cout << std::flush;
+}
+
+// Evaluates every line of the file, then the lines that changed each time
+// it is saved, until the program is stopped.
+int watch(const std::string& path, const symbols_type& symbols)
+{
+    CalcEval::Document document{symbols};
+    const auto load = [&document, &path]() {
+        if (std::optional<std::string> content = readFile(path))
+            print(document.update(*content));
+        else
+            std::cerr << "Can not read " << path << std::endl;
+    };
+    load();
+
+#if defined(__linux__)
+    // Editors often write another file and rename it to path, so the
+    // directory is watched for the name of the file.
+    const std::filesystem::path file{path};
+    const std::string name{file.filename().string()};
+    const std::string directory{(file.has_parent_path()) ? file.parent_path().string() : "."};
+    const int fd{inotify_init1(IN_CLOEXEC)};
+    if (fd < 0 || inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        std::cerr << "Can not watch " << path << std::endl;
+        return 1;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    for (;;)
+    {
+        const ssize_t size{::read(fd, buffer, sizeof(buffer))};
+        if (size < 0 && errno == EINTR)
+            continue;
+        if (size <= 0)
+        {
+            std::cerr << "Can not watch " << path << ": "
+                      << ((size < 0) ? std::strerror(errno) : "end of events") << std::endl;
+            break;
+        }
+
+        bool changed{false};
+        for (ssize_t k{0}; k < size;)
+        {
+            const auto* event{reinterpret_cast<const inotify_event*>(buffer + k)};
+            changed = changed || (event->len > 0 && name == event->name);
+            k += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+        if (changed)
+            load();
+    }
+
+    close(fd);
+    return 1;
+#else
+    // Elsewhere the time of the last change is checked.
+    std::error_code error{};
+    std::filesystem::file_time_type time{std::filesystem::last_write_time(path, error)};
+    for (;;)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+        const std::filesystem::file_time_type now{std::filesystem::last_write_time(path, error)};
+        if (!error && now != time)
+        {
+            time = now;
+            load();
+        }
+    }
+#endif
+}
+
 int main(int argc, char* argv[])
 {
-    if (argc == 1)
+    // "--plugin path" options come first, the plugins are loaded before
+    // anything is parsed and stay loaded until the end.
+    std::vector<CalcEval::Plugin> plugins{};
+    CalcEval::Registry<double> registry{};
+    int first{1};
+    try
+    {
+        for (; first + 1 < argc && std::string{argv[first]} == "--plugin"; first += 2)
+        {
+            plugins.emplace_back(argv[first + 1]);
+            plugins.back().addTo(registry);
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    const symbols_type symbols{(plugins.empty()) ? nullptr : registry.freeze()};
+
+    if (argc > first && std::string{argv[first]} == "--sweep")
+    {
+        return sweep(first + 1, argc, argv, symbols);
+    }
+    else if (argc == first + 2 && std::string{argv[first]} == "--watch")
+    {
+        return watch(argv[first + 1], symbols);
+    }
+    else if (argc == first)
     {
         // REPL
-        // Every line will be evaluated on its own.
+        // Names defined on earlier lines can be used by the later ones.
+        CalcEval::Session session{symbols};
         std::cout << "> " << std::flush;
         std::string line;
         while (std::getline(std::cin, line))
         {
-            if (auto val = parse(line))
-            {
-                std::cout << *val << std::endl;
-            }
+            evaluate(line, session);
             std::cout << "> " << std::flush;
         }
 
         std::cout << std::endl;
     }
-    else if (argc > 1)
+    else
     {
         // Evaluate each expression arguments.
-        for (int i{1}; i < argc; ++i)
+        for (int i{first}; i < argc; ++i)
         {
-            if (auto val = parse(argv[i]))
+            if (auto val = parse(argv[i], symbols))
             {
                 std::cout << *val << std::endl;
             }
@@ -0,0 +1,161 @@
+//
+//  benchmarks/BatchBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Expression.hpp"
+#include "calceval/Registry.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Batch evaluation of 1M rows")
+{
+    constexpr std::size_t rows{1 << 20};
+    std::vector<double> x(rows), y(rows), results(rows);
+    for (std::size_t i{0}; i < rows; ++i)
+    {
+        x[i] = 0.001 * static_cast<double>(i % 1000);
+        y[i] = 1.0 + 0.002 * static_cast<double>(i % 500);
+    }
+    const std::vector<CalcEval::Span<const double>> columns{x, y};
+
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression arithmetic{compiler.compile("(x*y+1.5)/(y-0.25)-x", {"x", "y"})};
+    const CalcEval::Expression functions{compiler.compile("x*y+sin(x)-exp(y/3)", {"x", "y"})};
+
+    // Lower bound, reads two columns and writes one.
+    BENCHMARK("Memory, x+y with a plain loop")
+    {
+        std::transform(x.begin(), x.end(), y.begin(), results.begin(),
+                       [](double a, double b) { return a + b; });
+        return results.back();
+    };
+
+    BENCHMARK("Arithmetic, evaluate per row")
+    {
+        std::vector<double> row(2);
+        for (std::size_t i{0}; i < rows; ++i)
+        {
+            row[0] = x[i];
+            row[1] = y[i];
+            results[i] = arithmetic.evaluate(row);
+        }
+        return results.back();
+    };
+
+    BENCHMARK("Arithmetic, evaluateBatch")
+    {
+        arithmetic.evaluateBatch(columns, results);
+        return results.back();
+    };
+
+    BENCHMARK("Functions, evaluate per row")
+    {
+        std::vector<double> row(2);
+        for (std::size_t i{0}; i < rows; ++i)
+        {
+            row[0] = x[i];
+            row[1] = y[i];
+            results[i] = functions.evaluate(row);
+        }
+        return results.back();
+    };
+
+    BENCHMARK("Functions, evaluateBatch exact")
+    {
+        functions.evaluateBatch(columns, results);
+        return results.back();
+    };
+
+    BENCHMARK("Functions, evaluateBatch fast")
+    {
+        functions.evaluateBatch(columns, results, CalcEval::Kernel::Accuracy::Fast);
+        return results.back();
+    };
+}
+
+TEST_CASE("Batch evaluation of a piecewise formula, 1M rows")
+{
+    // The branch changes every few rows, unpredictable for a branch per row.
+    constexpr std::size_t rows{1 << 20};
+    std::vector<double> x(rows), results(rows);
+    for (std::size_t i{0}; i < rows; ++i)
+        x[i] = -1.0 + 0.002 * static_cast<double>((i * 7919) % 1000);
+    const std::vector<CalcEval::Span<const double>> columns{x};
+
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression piecewise{
+        compiler.compile("if(x < 0, -x*x, if(x < 0.5 and x != 0.25, 2*x - 1, x/(1 + x)))", {"x"})};
+    const CalcEval::Expression smooth{compiler.compile("x*x - 2*x + x/(1 + x)", {"x"})};
+
+    BENCHMARK("Piecewise, evaluate per row")
+    {
+        std::vector<double> row(1);
+        for (std::size_t i{0}; i < rows; ++i)
+        {
+            row[0] = x[i];
+            results[i] = piecewise.evaluate(row);
+        }
+        return results.back();
+    };
+
+    BENCHMARK("Piecewise, evaluateBatch")
+    {
+        piecewise.evaluateBatch(columns, results);
+        return results.back();
+    };
+
+    // Same operators without conditions, for comparison.
+    BENCHMARK("Without conditions, evaluateBatch")
+    {
+        smooth.evaluateBatch(columns, results);
+        return results.back();
+    };
+}
+
+TEST_CASE("Batch evaluation of registered functions, 1M rows")
+{
+    constexpr std::size_t rows{1 << 20};
+    std::vector<double> x(rows), results(rows);
+    for (std::size_t i{0}; i < rows; ++i)
+        x[i] = 0.001 * static_cast<double>(i % 1000);
+    const std::vector<CalcEval::Span<const double>> columns{x};
+
+    // The same function, as from a plugin with and without a batch version.
+    const auto scalar = [](double v) { return v * (1.0 - v); };
+    const auto batch = [](const double* in, double* out, std::size_t n) {
+        for (std::size_t i{0}; i < n; ++i)
+            out[i] = in[i] * (1.0 - in[i]);
+    };
+    CalcEval::Registry<double> registry{};
+    registry.addFunction("scalar", scalar);
+    registry.addFunction("batch", scalar, batch);
+    const CalcEval::Compiler compiler{registry.freeze()};
+    const CalcEval::Expression scalarOnly{compiler.compile("scalar(x)*2 + 1", {"x"})};
+    const CalcEval::Expression withBatch{compiler.compile("batch(x)*2 + 1", {"x"})};
+
+    BENCHMARK("Scalar version per row")
+    {
+        scalarOnly.evaluateBatch(columns, results);
+        return results.back();
+    };
+
+    BENCHMARK("Batch version per block")
+    {
+        withBatch.evaluateBatch(columns, results);
+        return results.back();
+    };
+}
@@ -0,0 +1,77 @@
+//
+//  benchmarks/BigFloatBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/BigFloat.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/type/BigFloat.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using CalcEval::BigFloat;
+
+TEST_CASE("BigFloat operations")
+{
+    for (const std::uint32_t precision : {128u, 1024u, 16384u})
+    {
+        const BigFloat a{BigFloat::fromString("1.2345678901234567890123456789", precision)};
+        const BigFloat b{BigFloat::fromString("9.8765432109876543210987654321", precision)};
+        const std::string suffix{", " + std::to_string(precision) + " bits"};
+
+        BENCHMARK("Multiply" + suffix)
+        {
+            return a * b;
+        };
+
+        BENCHMARK("Divide" + suffix)
+        {
+            return a / b;
+        };
+
+        if (precision > 1024)
+            continue;
+
+        BENCHMARK("exp" + suffix)
+        {
+            return BigFloat::exp(a);
+        };
+
+        BENCHMARK("log" + suffix)
+        {
+            return BigFloat::log(b);
+        };
+
+        BENCHMARK("sin" + suffix)
+        {
+            return BigFloat::sin(b);
+        };
+    }
+}
+
+TEST_CASE("BigFloat vs double parser")
+{
+    std::string ledger{"0"};
+    for (int i{0}; i < 200; ++i)
+        ledger += "+1234.56*1.0725-98.01/3";
+
+    BENCHMARK("Ledger, Standard")
+    {
+        return CalcEval::Parser<CalcEval::Type::Standard>{}.parse(ledger);
+    };
+
+    BENCHMARK("Ledger, BigFloat 128 bits")
+    {
+        return CalcEval::Parser<CalcEval::Type::BigFloat<128>>{}.parse(ledger);
+    };
+}
@@ -0,0 +1,112 @@
+//
+//  benchmarks/DispatchBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Model of the old CalcType contract where stot, constant and function
+// were virtual and reached through a base class reference.
+struct VirtualInterface
+{
+    using func_type = CalcEval::Type::Base<double>::func_type;
+
+    virtual ~VirtualInterface() noexcept = default;
+    [[nodiscard]] virtual double stot(const std::string& str) noexcept = 0;
+    [[nodiscard]] virtual std::optional<double> constant(const std::string& str) noexcept = 0;
+    [[nodiscard]] virtual std::optional<func_type> function(const std::string& str) noexcept = 0;
+};
+
+struct VirtualImpl final : public VirtualInterface
+{
+    [[nodiscard]] double stot(const std::string& str) noexcept override
+    {
+        return CalcEval::Type::Standard{}.stot(str);
+    }
+
+    [[nodiscard]] std::optional<double> constant(const std::string& str) noexcept override
+    {
+        return CalcEval::Type::Standard::constants.find(str);
+    }
+
+    [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept override
+    {
+        return CalcEval::Type::Standard::functions.find(str);
+    }
+};
+
+VirtualInterface& virtualInstance();
+
+struct VirtualStandard : public CalcEval::Type::Base<double>
+{
+    [[nodiscard]] double stot(const std::string& str) noexcept
+    {
+        return m_impl.stot(str);
+    }
+
+    [[nodiscard]] std::optional<double> constant(const std::string& str) noexcept
+    {
+        return m_impl.constant(str);
+    }
+
+    [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept
+    {
+        return m_impl.function(str);
+    }
+
+    VirtualInterface& m_impl{virtualInstance()};
+};
+
+VirtualInterface& virtualInstance()
+{
+    static VirtualImpl impl{};
+    return impl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static std::string repeat(const std::string& term, const std::string& op, std::size_t count)
+{
+    std::string str{term};
+    for (std::size_t i{1}; i < count; ++i)
+        str += op + term;
+    return str;
+}
+
+TEST_CASE("Static vs virtual dispatch")
+{
+    const std::string literals{repeat("1.5*2.25", "+", 200)};
+    const std::string identifiers{repeat("sin(pi)*log(e)", "+", 200)};
+
+    BENCHMARK("Literals, static dispatch")
+    {
+        return CalcEval::Parser<CalcEval::Type::Standard>{}.parse(literals);
+    };
+
+    BENCHMARK("Literals, virtual dispatch")
+    {
+        return CalcEval::Parser<VirtualStandard>{}.parse(literals);
+    };
+
+    BENCHMARK("Identifiers, static dispatch")
+    {
+        return CalcEval::Parser<CalcEval::Type::Standard>{}.parse(identifiers);
+    };
+
+    BENCHMARK("Identifiers, virtual dispatch")
+    {
+        return CalcEval::Parser<VirtualStandard>{}.parse(identifiers);
+    };
+}
@@ -0,0 +1,96 @@
+//
+//  benchmarks/DocumentBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Document.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cstring>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("One line edits of a large document")
+{
+    // A million lines, names that use the name before them and an
+    // expression of two names on every tenth line.
+    std::string content{};
+    for (int i{0}; i < 1000000; ++i)
+    {
+        const std::string n{std::to_string(i)};
+        if (i % 10 == 9)
+            content += "x" + std::to_string(i - 1) + " * x" + std::to_string(i - 2) + "\n";
+        else if (i % 10 == 0)
+            content += "x" + n + " = " + n + " * 0.5\n";
+        else
+            content += "x" + n + " = x" + std::to_string(i - 1) + " + " + n + "\n";
+    }
+
+    CalcEval::Document document{};
+    (void)document.update(content);
+
+    // Line 500001 and the 8 lines that depend on it.
+    std::string edited{content};
+    const std::size_t at{edited.find("x500000 = 500000 * 0.5")};
+    edited.replace(at, 22, "x500000 = 500000 * 0.7");
+
+    // The content is compared on every update, the rest is the cost of
+    // the lines that changed. replace only compares the lines it changes.
+    BENCHMARK("Compare the content")
+    {
+        return std::memcmp(content.data(), edited.data(), content.size());
+    };
+
+    bool flip{false};
+    BENCHMARK("Edit one line")
+    {
+        flip = !flip;
+        return document.update((flip) ? edited : content).size();
+    };
+
+    std::string appended{content + "x999999 + 1\n"};
+    BENCHMARK("Append a line")
+    {
+        flip = !flip;
+        return document.update((flip) ? appended : content).size();
+    };
+
+    (void)document.update(content);
+    BENCHMARK("Replace one line")
+    {
+        flip = !flip;
+        return document.replace(at + 21, 1, (flip) ? "7" : "5").size();
+    };
+
+    const std::size_t size{document.size()};
+    BENCHMARK("Replace at the end")
+    {
+        if (document.size() == size)
+            return document.replace(content.size(), 0, "x999999 + 1\n").size();
+        return document.replace(content.size(), 12, "").size();
+    };
+
+    // The two lines of the cycle are defined again on every edit.
+    const std::string cycle{content + "a = b\nb = a\n"};
+    const std::string changed{edited + "a = b\nb = a\n"};
+    (void)document.update(cycle);
+    BENCHMARK("Edit one line while a line would depend on itself")
+    {
+        flip = !flip;
+        return document.update((flip) ? changed : cycle).size();
+    };
+
+    BENCHMARK("Replace one line while a line would depend on itself")
+    {
+        flip = !flip;
+        return document.replace(at + 21, 1, (flip) ? "7" : "5").size();
+    };
+}
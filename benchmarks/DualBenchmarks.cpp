@@ -0,0 +1,72 @@
+//
+//  benchmarks/DualBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/type/Dual.hpp"
+#include "calceval/type/Standard.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static std::string repeat(const std::string& term, const std::string& op, std::size_t count)
+{
+    std::string str{term};
+    for (std::size_t i{1}; i < count; ++i)
+        str += op + term;
+    return str;
+}
+
+template<std::size_t N>
+static CalcEval::Parser<CalcEval::Type::Dual<N>> dualParser()
+{
+    using D = CalcEval::Dual<N>;
+    CalcEval::Registry<D> registry{};
+    registry.addConstant("x", D::variable(0.5, 0));
+    registry.addConstant("y", (N > 1) ? D::variable(1.5, N - 1) : D{1.5});
+    return CalcEval::Parser<CalcEval::Type::Dual<N>>{registry.freeze()};
+}
+
+TEST_CASE("Dual vs double")
+{
+    const std::string str{repeat("x*y-sin(x)/exp(y)+x^y", "+", 200)};
+
+    CalcEval::Registry<double> registry{};
+    registry.addConstant("x", 0.5);
+    registry.addConstant("y", 1.5);
+    const CalcEval::Parser<CalcEval::Type::Standard> standard{registry.freeze()};
+    const auto dual1{dualParser<1>()};
+    const auto dual2{dualParser<2>()};
+    const auto dual8{dualParser<8>()};
+
+    BENCHMARK("Value, Standard")
+    {
+        return standard.parse(str);
+    };
+
+    BENCHMARK("Value and 1 derivative, Dual<1>")
+    {
+        return dual1.parse(str);
+    };
+
+    BENCHMARK("Value and gradient, Dual<2>")
+    {
+        return dual2.parse(str);
+    };
+
+    BENCHMARK("Value and 8 tangents, Dual<8>")
+    {
+        return dual8.parse(str);
+    };
+}
@@ -0,0 +1,54 @@
+//
+//  benchmarks/ExpressionCacheBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Repeated formulas with and without a cache")
+{
+    // A thousand formulas that arrive again and again, with other spacing.
+    std::vector<std::string> formulas{};
+    for (int i{0}; i < 1000; ++i)
+    {
+        const std::string n{std::to_string(i)};
+        formulas.push_back("(" + n + " * 1.07 ^ 12 - max(" + n + ", 250)) / (1 + sin(" + n +
+                           " / 100))");
+        formulas.push_back(" ( " + n + "*1.07^12 - max(" + n + ",250) ) / ( 1+sin(" + n +
+                           "/100) )");
+    }
+
+    const CalcEval::Parser<> plain{};
+    const CalcEval::Parser<> cached{nullptr, 1 << 24};
+    for (const std::string& formula : formulas)
+        static_cast<void>(cached.parse(formula));
+
+    BENCHMARK("Parse every time")
+    {
+        double total{0.0};
+        for (const std::string& formula : formulas)
+            total += plain.parse(formula);
+        return total;
+    };
+
+    BENCHMARK("Cache hits")
+    {
+        double total{0.0};
+        for (const std::string& formula : formulas)
+            total += cached.parse(formula);
+        return total;
+    };
+}
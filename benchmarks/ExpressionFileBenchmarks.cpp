@@ -0,0 +1,77 @@
+//
+//  benchmarks/ExpressionFileBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ExpressionFile.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <filesystem>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Compiled expressions from a file")
+{
+    // Ten thousand formulas, compiled once and then opened from the file.
+    std::vector<std::string> sources{};
+    for (int i{0}; i < 10000; ++i)
+    {
+        const std::string n{std::to_string(i)};
+        sources.push_back("(x * " + n + " - max(x, " + n + ", y)) / (1 + sin(y / " + n +
+                          ")) + if(x > " + n + ", x^2, y)");
+    }
+    const std::vector<std::string> variables{"x", "y"};
+    const std::string path{
+        (std::filesystem::temp_directory_path() / "calceval-benchmark.cef").string()};
+    std::filesystem::remove(path);
+    (void)CalcEval::ExpressionFile::load(path, sources, variables);
+
+    const CalcEval::Compiler<> compiler{};
+    BENCHMARK("Compile")
+    {
+        std::vector<CalcEval::Expression> expressions{};
+        expressions.reserve(sources.size());
+        for (const std::string& str : sources)
+            expressions.push_back(compiler.compile(str, variables));
+        return expressions.size();
+    };
+
+    BENCHMARK("Open the file")
+    {
+        return CalcEval::ExpressionFile::load(path, sources, variables).size();
+    };
+
+    const std::vector<double> values{2.5, 0.75};
+    std::vector<CalcEval::Expression> expressions{};
+    for (const std::string& str : sources)
+        expressions.push_back(compiler.compile(str, variables));
+    const CalcEval::ExpressionFile file{CalcEval::ExpressionFile::load(path, sources, variables)};
+
+    BENCHMARK("Evaluate compiled")
+    {
+        double total{0.0};
+        for (const CalcEval::Expression& expression : expressions)
+            total += expression.evaluate(values);
+        return total;
+    };
+
+    BENCHMARK("Evaluate in the file")
+    {
+        double total{0.0};
+        for (std::size_t i{0}; i < file.size(); ++i)
+            total += file.evaluate(i, values);
+        return total;
+    };
+
+    std::filesystem::remove(path);
+}
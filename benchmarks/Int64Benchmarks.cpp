@@ -0,0 +1,53 @@
+//
+//  benchmarks/Int64Benchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+#include "calceval/type/Int64.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static std::string repeat(const std::string& term, const std::string& op, std::size_t count)
+{
+    std::string str{term};
+    for (std::size_t i{1}; i < count; ++i)
+        str += op + term;
+    return str;
+}
+
+TEST_CASE("Int64 vs double")
+{
+    const std::string arithmetic{repeat("(1234*5678-91011)/12", "+", 200)};
+    const std::string powers{repeat("3^39/3^38-2^61/2^60", "+", 200)};
+
+    BENCHMARK("Arithmetic, Standard")
+    {
+        return CalcEval::Parser<CalcEval::Type::Standard>{}.parse(arithmetic);
+    };
+
+    BENCHMARK("Arithmetic, Int64")
+    {
+        return CalcEval::Parser<CalcEval::Type::Int64>{}.parse(arithmetic);
+    };
+
+    BENCHMARK("Powers, Standard")
+    {
+        return CalcEval::Parser<CalcEval::Type::Standard>{}.parse(powers);
+    };
+
+    BENCHMARK("Powers, Int64")
+    {
+        return CalcEval::Parser<CalcEval::Type::Int64>{}.parse(powers);
+    };
+}
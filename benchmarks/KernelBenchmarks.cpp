@@ -0,0 +1,91 @@
+//
+//  benchmarks/KernelBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Kernel.hpp"
+#include "calceval/Simd.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using CalcEval::Kernel::Accuracy;
+
+static std::vector<double> values(double from, double to, std::size_t count)
+{
+    std::vector<double> vec(count);
+    for (std::size_t i{0}; i < count; ++i)
+        vec[i] = from + (to - from) * static_cast<double>(i) / static_cast<double>(count);
+    return vec;
+}
+
+// sin(x) * exp(-x) + log(x) evaluated one function at a time over the array.
+static double formula(const std::vector<double>& x, std::vector<double>& a,
+                      std::vector<double>& b, Accuracy accuracy)
+{
+    CalcEval::Kernel::sin(x, a, accuracy);
+    for (std::size_t i{0}; i < x.size(); ++i)
+        b[i] = -x[i];
+    CalcEval::Kernel::exp(b, b, accuracy);
+    for (std::size_t i{0}; i < x.size(); ++i)
+        a[i] *= b[i];
+    CalcEval::Kernel::log(x, b, accuracy);
+
+    double sum{0.0};
+    for (std::size_t i{0}; i < x.size(); ++i)
+        sum += a[i] + b[i];
+    return sum;
+}
+
+TEST_CASE("Exact vs fast kernels")
+{
+    constexpr std::size_t count{1 << 16};
+    const std::vector<double> x{values(0.001, 10.0, count)};
+    std::vector<double> a(count), b(count);
+
+    const std::string simd{CalcEval::Simd::name};
+
+    for (Accuracy accuracy : {Accuracy::Exact, Accuracy::Fast})
+    {
+        const std::string mode{(accuracy == Accuracy::Exact) ? "exact" : "fast (" + simd + ")"};
+
+        BENCHMARK("sin, " + mode)
+        {
+            CalcEval::Kernel::sin(x, a, accuracy);
+            return a[count / 2];
+        };
+
+        BENCHMARK("exp, " + mode)
+        {
+            CalcEval::Kernel::exp(x, a, accuracy);
+            return a[count / 2];
+        };
+
+        BENCHMARK("log, " + mode)
+        {
+            CalcEval::Kernel::log(x, a, accuracy);
+            return a[count / 2];
+        };
+
+        BENCHMARK("arctan, " + mode)
+        {
+            CalcEval::Kernel::atan(x, a, accuracy);
+            return a[count / 2];
+        };
+
+        BENCHMARK("sin(x)*exp(-x)+log(x), " + mode)
+        {
+            return formula(x, a, b, accuracy);
+        };
+    }
+}
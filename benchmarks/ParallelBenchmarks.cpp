@@ -0,0 +1,78 @@
+//
+//  benchmarks/ParallelBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Parallel.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Parallel evaluation of 1M rows")
+{
+    constexpr std::size_t rows{1 << 20};
+    std::vector<double> x(rows), y(rows), results(rows);
+    for (std::size_t i{0}; i < rows; ++i)
+    {
+        x[i] = 0.001 * static_cast<double>(i % 1000);
+        y[i] = 1.0 + 0.002 * static_cast<double>(i % 500);
+    }
+    const std::vector<CalcEval::Span<const double>> columns{x, y};
+
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression expression{compiler.compile("x*y+sin(x)-exp(y/3)", {"x", "y"})};
+    CalcEval::ThreadPool pool{};
+
+    BENCHMARK("evaluateBatch")
+    {
+        expression.evaluateBatch(columns, results);
+        return results.back();
+    };
+
+    BENCHMARK("parallelEvaluate, " + std::to_string(pool.size()) + " worker(s)")
+    {
+        CalcEval::parallelEvaluate(pool, expression, columns, results);
+        return results.back();
+    };
+}
+
+TEST_CASE("Parallel parsing of uneven expressions")
+{
+    // Every 100th expression is 100 times longer than the others.
+    std::vector<std::string> expressions{};
+    for (int i{0}; i < 20000; ++i)
+    {
+        std::string str{"sin(" + std::to_string(i) + ")"};
+        for (int k{0}; k < ((i % 100 == 0) ? 100 : 1); ++k)
+            str += "+" + std::to_string(k) + "*2^0.5";
+        expressions.push_back(str);
+    }
+
+    const CalcEval::Parser<> parser{};
+    CalcEval::ThreadPool pool{};
+
+    BENCHMARK("Sequential")
+    {
+        std::vector<double> values(expressions.size());
+        for (std::size_t i{0}; i < expressions.size(); ++i)
+            values[i] = parser.parse(expressions[i]);
+        return values.back();
+    };
+
+    BENCHMARK("parallelEvaluate, " + std::to_string(pool.size()) + " worker(s)")
+    {
+        return CalcEval::parallelEvaluate(pool, expressions, parser).back();
+    };
+}
@@ -0,0 +1,50 @@
+//
+//  benchmarks/ParallelExpressionBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ParallelExpression.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Evaluation of an expression with 1M terms")
+{
+    std::string str{};
+    for (int i{1}; i <= 1000000; ++i)
+        str += ((i > 1) ? "+x/" : "x/") + std::to_string(i) + "^2";
+
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression expression{compiler.compile(str, {"x"})};
+    const CalcEval::ParallelExpression parallel{expression};
+    CalcEval::ThreadPool pool{};
+    const std::vector<double> variables{1.5};
+
+    BENCHMARK("Expression::evaluate")
+    {
+        return expression.evaluate(variables);
+    };
+
+    BENCHMARK("Sequential, " + std::to_string(pool.size()) + " worker(s)")
+    {
+        return parallel.evaluate(pool, variables);
+    };
+
+    BENCHMARK("Pairwise, " + std::to_string(pool.size()) + " worker(s)")
+    {
+        return parallel.evaluate(pool, variables,
+                                 CalcEval::ParallelExpression::Association::Pairwise);
+    };
+}
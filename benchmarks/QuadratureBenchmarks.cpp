@@ -0,0 +1,42 @@
+//
+//  benchmarks/QuadratureBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Integral of an oscillating function")
+{
+    const CalcEval::Parser<> parser{};
+    const std::string workers{std::to_string(CalcEval::ThreadPool::shared().size()) +
+                              " worker(s)"};
+
+    // A midpoint rule with a million terms, accurate to about 1e-6.
+    BENCHMARK("Midpoint sum, " + workers)
+    {
+        return parser.parse("sum(i = 0, 999999, sin(50*(i+0.5)/50000)^2)/50000");
+    };
+
+    BENCHMARK("integrate, tolerance 1e-10, " + workers)
+    {
+        return parser.parse("integrate(sin(50*x)^2, x, 0, 20)");
+    };
+
+    BENCHMARK("integrate, tolerance 1e-14, " + workers)
+    {
+        return parser.parse("integrate(sin(50*x)^2, x, 0, 20, 1e-14)");
+    };
+}
@@ -0,0 +1,59 @@
+//
+//  benchmarks/SeriesBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Series of 10000 terms")
+{
+    std::string pasted{"1/1^2"};
+    for (int i{2}; i <= 10000; ++i)
+        pasted += "+1/" + std::to_string(i) + "^2";
+    const std::string series{"sum(i = 1, 10000, 1/i^2)"};
+
+    const CalcEval::Parser<> parser{};
+    const CalcEval::Compiler<> compiler{};
+    const CalcEval::Expression expression{compiler.compile(series)};
+
+    BENCHMARK("Parse pasted terms")
+    {
+        return parser.parse(pasted);
+    };
+
+    BENCHMARK("Parse sum")
+    {
+        return parser.parse(series);
+    };
+
+    BENCHMARK("Evaluate compiled sum, " +
+              std::to_string(CalcEval::ThreadPool::shared().size()) + " worker(s)")
+    {
+        return expression.evaluate();
+    };
+}
+
+TEST_CASE("Series of 1M terms")
+{
+    const CalcEval::Parser<> parser{};
+
+    BENCHMARK("Parse sum, " + std::to_string(CalcEval::ThreadPool::shared().size()) +
+              " worker(s)")
+    {
+        return parser.parse("sum(i = 1, 1000000, 1/i^2)");
+    };
+}
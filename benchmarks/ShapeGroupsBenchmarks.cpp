@@ -0,0 +1,56 @@
+//
+//  benchmarks/ShapeGroupsBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ShapeGroups.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Evaluation of 10000 expressions with 10 shapes")
+{
+    const CalcEval::Compiler compiler{};
+    std::vector<CalcEval::Expression> expressions{};
+    for (int i{0}; i < 10000; ++i)
+    {
+        // i % 10 decides the shape, i the constants.
+        const std::string a{std::to_string(0.001 * i)};
+        std::string str{"(" + a + "*x+1)*(y-" + a + ")/(1+" + a + ")"};
+        for (int k{0}; k < i % 10; ++k)
+            str += "+" + a + "*y";
+        expressions.push_back(compiler.compile(str, {"x", "y"}));
+    }
+    const std::vector<double> variables{1.5, 2.5};
+    std::vector<double> results(expressions.size());
+
+    BENCHMARK("evaluate per expression")
+    {
+        for (std::size_t i{0}; i < expressions.size(); ++i)
+            results[i] = expressions[i].evaluate(variables);
+        return results.back();
+    };
+
+    BENCHMARK("Grouping")
+    {
+        return CalcEval::ShapeGroups{expressions}.groupCount();
+    };
+
+    const CalcEval::ShapeGroups groups{expressions};
+    BENCHMARK("ShapeGroups::evaluate")
+    {
+        groups.evaluate(variables, results);
+        return results.back();
+    };
+}
@@ -0,0 +1,56 @@
+//
+//  benchmarks/SweepBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Sweep.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Sweep of 1001 x 1001 points")
+{
+    // Most of the work only depends on the outer axis.
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression expression{compiler.compile(
+        "sin(x)*exp(-x/100)*y + log(x+1)^2 - cos(x/10)*arctan(x)", {"x", "y"})};
+    const std::vector<CalcEval::Sweep::Axis> axes{CalcEval::Sweep::Axis::parse("x=0:1:1000"),
+                                                  CalcEval::Sweep::Axis::parse("y=0:0.01:10")};
+    const CalcEval::Sweep sweep{expression, axes};
+
+    BENCHMARK("Every point")
+    {
+        double total{0.0};
+        std::vector<double> values(2);
+        for (std::size_t i{0}; i < axes[0].count(); ++i)
+        {
+            values[0] = axes[0].value(i);
+            for (std::size_t j{0}; j < axes[1].count(); ++j)
+            {
+                values[1] = axes[1].value(j);
+                total += expression.evaluate(values);
+            }
+        }
+        return total;
+    };
+
+    BENCHMARK("Sweep")
+    {
+        double total{0.0};
+        sweep.run([&total](const CalcEval::Sweep::Block& block) {
+            for (const double value : block.results)
+                total += value;
+        });
+        return total;
+    };
+}
@@ -0,0 +1,63 @@
+//
+//  benchmarks/TapeBenchmarks.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Dual.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/Tape.hpp"
+#include "calceval/type/Dual.hpp"
+
+// Catch2 Headers
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Gradient with 100 variables")
+{
+    constexpr std::size_t count{100};
+    using D = CalcEval::Dual<count>;
+
+    std::vector<std::string> names{};
+    std::vector<double> values{};
+    CalcEval::Registry<D> registry{};
+    std::string str{"0"};
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        names.push_back("x" + std::to_string(i));
+        values.push_back(0.01 * static_cast<double>(i));
+        registry.addConstant(names.back(), D::variable(values.back(), i));
+        str += "+sin(" + names.back() + ")*" + names.back() + "^2";
+    }
+
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression expression{compiler.compile(str, names)};
+    const CalcEval::Parser<CalcEval::Type::Dual<count>> dual{registry.freeze()};
+    CalcEval::Tape tape{expression};
+    std::vector<double> gradient(count);
+
+    BENCHMARK("Value, Expression")
+    {
+        return expression.evaluate(values);
+    };
+
+    BENCHMARK("Gradient, Tape")
+    {
+        return tape.gradient(values, gradient);
+    };
+
+    BENCHMARK("Gradient, Parser with Dual<100>")
+    {
+        return dual.parse(str).value();
+    };
+}
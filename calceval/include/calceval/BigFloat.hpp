@@ -0,0 +1,310 @@
+//
+//  BigFloat.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_BIGFLOAT_HPP
+#define CALCEVAL_BIGFLOAT_HPP
+
+// C++ Headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace CalcEval
+{
+    namespace Detail
+    {
+        /** LimbVector class implementation.
+
+            Vector of 32-bit limbs that keeps up to inlineCapacity limbs
+            inside the object and only allocates for longer ones.
+        */
+        class LimbVector
+        {
+        public:
+            using value_type = std::uint32_t;
+            static constexpr std::size_t inlineCapacity{8};
+
+        public:
+            LimbVector() noexcept = default;
+            LimbVector(const LimbVector& other);
+            LimbVector(LimbVector&& other) noexcept;
+            LimbVector& operator=(const LimbVector& other);
+            LimbVector& operator=(LimbVector&& other) noexcept;
+            ~LimbVector() noexcept = default;
+
+            [[nodiscard]] std::size_t size() const noexcept
+            {
+                return m_size;
+            }
+
+            [[nodiscard]] bool empty() const noexcept
+            {
+                return m_size == 0;
+            }
+
+            [[nodiscard]] bool isInline() const noexcept
+            {
+                return !m_heap;
+            }
+
+            [[nodiscard]] value_type* data() noexcept
+            {
+                return m_heap ? m_heap.get() : m_inline.data();
+            }
+
+            [[nodiscard]] const value_type* data() const noexcept
+            {
+                return m_heap ? m_heap.get() : m_inline.data();
+            }
+
+            [[nodiscard]] value_type& operator[](std::size_t i) noexcept
+            {
+                return data()[i];
+            }
+
+            [[nodiscard]] value_type operator[](std::size_t i) const noexcept
+            {
+                return data()[i];
+            }
+
+            [[nodiscard]] value_type back() const noexcept
+            {
+                return data()[m_size - 1];
+            }
+
+            /** Function for assigning limbs, copies count limbs from limbs.
+
+            */
+            void assign(const value_type* limbs, std::size_t count);
+
+            /** Function for resizing, new limbs are zero.
+
+            */
+            void resize(std::size_t size);
+
+            /** Function for removing the count lowest limbs.
+
+            */
+            void eraseFront(std::size_t count) noexcept;
+
+        private:
+            void reserve(std::size_t capacity);
+
+        private:
+            std::size_t m_size{0};
+            std::size_t m_capacity{inlineCapacity};
+            std::unique_ptr<value_type[]> m_heap{};
+            std::array<value_type, inlineCapacity> m_inline{};
+        };
+
+    } // namespace Detail
+
+    /** BigFloat class implementation.
+
+        Binary floating point number with arbitrary precision. The value is
+
+            (-1)^sign * mantissa * 2^(32 * exponent)
+
+        where the mantissa is an integer of 32-bit limbs without zero
+        limbs at either end. Precision is the number of significant bits
+        kept, about 0.3 decimal digits per bit (128 bits is 38 digits).
+        Values with up to 192 bits, and short values such as small
+        integers at any precision, are stored inline and operations on
+        them do not allocate.
+
+        Precision is carried by every value. The result of an operation
+        has the largest precision of its operands and is rounded to
+        nearest, ties to even. Values made from integers and doubles are
+        exact (precision 0) and use defaultPrecision in operations with
+        other exact values. +, -, *, / and sqrt are correctly rounded
+        apart from rare halfway cases. The other functions are computed
+        with guard bits and are accurate to about one unit in the last
+        place.
+
+        Multiplication is Karatsuba for long mantissas and schoolbook for
+        short ones. Division is long division (Knuth algorithm D).
+
+        Results that can not be represented throw ArithmeticError instead
+        of giving inf or NaN, such as division by zero or log(-1).
+
+        Note that like double it is binary, so 0.1 is not exact but has a
+        relative error of at most 2^-precision.
+    */
+    class BigFloat
+    {
+    public:
+        using limb_type = std::uint32_t;
+        static constexpr std::uint32_t defaultPrecision{128};
+
+    public:
+        /** Default BigFloat constructor.
+
+            @return     zero
+        */
+        BigFloat() noexcept = default;
+
+        /** BigFloat constructor with an integer, exact.
+
+            @param  value   value
+            @return         BigFloat with value
+        */
+        BigFloat(std::int64_t value);
+
+        /** Function for creating a BigFloat from a double, exact.
+
+            Throws ArithmeticError if value is inf or NaN.
+
+            @param  value   value
+            @return         BigFloat with value
+        */
+        [[nodiscard]] static BigFloat fromDouble(double value);
+
+        /** Function for creating a BigFloat from a decimal string.
+
+            The string has the format of a number from the Scanner, such
+            as 12, 0.5 or 1.5e-7. Throws ArithmeticError if it has not.
+
+            @param  str         string to convert
+            @param  precision   precision in bits
+            @return             rounded value
+        */
+        [[nodiscard]] static BigFloat fromString(const std::string& str,
+                                                 std::uint32_t precision = defaultPrecision);
+
+        /** Function for the precision.
+
+            @return     precision in bits, 0 if exact
+        */
+        [[nodiscard]] std::uint32_t precision() const noexcept;
+
+        /** Function for a copy with another precision.
+
+            @param  precision   precision in bits
+            @return             copy rounded to precision
+        */
+        [[nodiscard]] BigFloat withPrecision(std::uint32_t precision) const;
+
+        [[nodiscard]] bool isZero() const noexcept;
+        [[nodiscard]] bool isNegative() const noexcept;
+        [[nodiscard]] bool isInteger() const noexcept;
+
+        /** Function for checking if the value is stored without allocation.
+
+            @return     true if inline
+        */
+        [[nodiscard]] bool isInline() const noexcept;
+
+        /** Function for converting to an integer.
+
+            @return     value if it is an integer that fits, otherwise std::nullopt
+        */
+        [[nodiscard]] std::optional<std::int64_t> toInt64() const noexcept;
+
+        /** Function for converting to double, rounded to nearest.
+
+            @return     value
+        */
+        [[nodiscard]] double toDouble() const noexcept;
+
+        /** Function for converting to a decimal string.
+
+            Uses fixed notation for moderate exponents and scientific
+            otherwise, trailing zeros are removed (as %g).
+
+            @param  digits  significant digits, 0 for all digits of the precision
+            @return         decimal string
+        */
+        [[nodiscard]] std::string toString(std::size_t digits = 0) const;
+
+        BigFloat operator-() const;
+        BigFloat& operator+=(const BigFloat& rhs);
+        BigFloat& operator-=(const BigFloat& rhs);
+        BigFloat& operator*=(const BigFloat& rhs);
+        BigFloat& operator/=(const BigFloat& rhs);
+
+        friend BigFloat operator+(const BigFloat& lhs, const BigFloat& rhs);
+        friend BigFloat operator-(const BigFloat& lhs, const BigFloat& rhs);
+        friend BigFloat operator*(const BigFloat& lhs, const BigFloat& rhs);
+        friend BigFloat operator/(const BigFloat& lhs, const BigFloat& rhs);
+
+        friend bool operator==(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+        friend bool operator!=(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+        friend bool operator<(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+        friend bool operator<=(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+        friend bool operator>(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+        friend bool operator>=(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+
+        /** Math functions, the result has the precision of the argument.
+
+            Named after <cmath>. exp, sin and cos throw ArithmeticError for
+            arguments too large to compute, log and sqrt for arguments
+            outside of their domain.
+        */
+        [[nodiscard]] static BigFloat abs(const BigFloat& x);
+        [[nodiscard]] static BigFloat ldexp(const BigFloat& x, std::int64_t exponent);
+        [[nodiscard]] static BigFloat sqrt(const BigFloat& x);
+        [[nodiscard]] static BigFloat exp(const BigFloat& x);
+        [[nodiscard]] static BigFloat log(const BigFloat& x);
+        [[nodiscard]] static BigFloat log10(const BigFloat& x);
+        [[nodiscard]] static BigFloat sin(const BigFloat& x);
+        [[nodiscard]] static BigFloat cos(const BigFloat& x);
+        [[nodiscard]] static BigFloat tan(const BigFloat& x);
+
+        /** Function for base^exponent.
+
+            Integer exponents use exponentiation by squaring, other
+            exponents exp(exponent * log(base)) and need a positive base.
+
+            @param  base        base
+            @param  exponent    exponent
+            @return             base^exponent
+        */
+        [[nodiscard]] static BigFloat pow(const BigFloat& base, const BigFloat& exponent);
+
+        /** Constants, computed once per thread and precision.
+
+            @param  precision   precision in bits
+            @return             constant rounded to precision
+        */
+        [[nodiscard]] static BigFloat pi(std::uint32_t precision = defaultPrecision);
+        [[nodiscard]] static BigFloat e(std::uint32_t precision = defaultPrecision);
+        [[nodiscard]] static BigFloat ln2(std::uint32_t precision = defaultPrecision);
+
+    private:
+        static BigFloat make(const limb_type* limbs, std::size_t count, std::int64_t exponent,
+                             bool negative, std::uint32_t precision, bool sticky);
+        static BigFloat add(const BigFloat& lhs, const BigFloat& rhs, bool subtract);
+        static int compareMagnitude(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+        static std::uint32_t resultPrecision(const BigFloat& lhs, const BigFloat& rhs) noexcept;
+        static std::uint32_t workingPrecision(const BigFloat& x) noexcept;
+        static BigFloat atanh(const BigFloat& z);
+        static BigFloat arctanInverse(std::uint32_t n, std::uint32_t precision);
+        static BigFloat sinSeries(const BigFloat& x);
+        static BigFloat cosSeries(const BigFloat& x);
+        static BigFloat reduce(const BigFloat& x, std::uint32_t precision, int& quadrant);
+        static BigFloat pow10(std::int64_t exponent, std::uint32_t precision);
+
+        [[nodiscard]] std::int64_t magnitude() const noexcept;
+        [[nodiscard]] bool tinyComparedTo(const BigFloat& sum) const noexcept;
+        [[nodiscard]] BigFloat roundToInteger() const;
+        void roundAt(std::int64_t position, bool sticky);
+        void round(bool sticky);
+        void trim() noexcept;
+
+    private:
+        Detail::LimbVector m_limbs{};
+        std::int64_t m_exponent{0};
+        std::uint32_t m_precision{0};
+        bool m_negative{false};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_BIGFLOAT_HPP
@@ -0,0 +1,87 @@
+//
+//  Compiler.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_COMPILER_HPP
+#define CALCEVAL_COMPILER_HPP
+
+// Local Headers
+#include "calceval/CompilerLogic.hpp"
+#include "calceval/Expression.hpp"
+#include "calceval/type/Standard.hpp"
+
+// C++ Headers
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Compiler class implementation.
+
+        Compiles text to an Expression that can be evaluated many times
+        with different values of its variables, without parsing again.
+
+        Usage:
+            CalcEval::Compiler compiler{};
+            CalcEval::Expression expression{compiler.compile("x*y + sin(x)", {"x", "y"})};
+            double value{expression.evaluate(std::vector<double>{3.0, 4.0})};
+    */
+    template<typename CalcType = Type::Standard>
+    class Compiler
+    {
+    public:
+        using value_type = typename CalcType::value_type;
+        using symbols_type = std::shared_ptr<const SymbolTable<value_type>>;
+
+    public:
+        Compiler() = default;
+
+        /** Compiler constructor with symbols.
+
+            The symbols are looked up before the ones in CalcType.
+            Create them with Registry::freeze().
+
+            @param  symbols     symbols to use
+            @return             initialized Compiler
+        */
+        explicit Compiler(symbols_type symbols) : m_symbols{std::move(symbols)}
+        {
+        }
+
+        /** Function for compiling an expression.
+
+            Throws ParserError for the same errors as Parser.
+
+            @param  str         expression
+            @param  variables   names of the variables, looked up before other names
+            @return             compiled expression
+        */
+        [[nodiscard]] Expression compile(const std::string& str,
+                                         const std::vector<std::string>& variables = {}) const
+        {
+            std::istringstream iss{str};
+            CompilerLogic<CalcType> logic{iss, variables, m_symbols.get()};
+            return logic.compile();
+        }
+
+        /** Retrieve the symbols used by the Compiler.
+
+            @return     symbols, nullptr if none
+        */
+        [[nodiscard]] const symbols_type& symbols() const noexcept
+        {
+            return m_symbols;
+        }
+
+    private:
+        symbols_type m_symbols{};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_COMPILER_HPP
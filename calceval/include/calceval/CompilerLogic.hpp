@@ -0,0 +1,158 @@
+//
+//  CompilerLogic.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_COMPILERLOGIC_HPP
+#define CALCEVAL_COMPILERLOGIC_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/ParserLogic.hpp"
+#include "calceval/Quadrature.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/Scanner.hpp"
+#include "calceval/type/Traits.hpp"
+
+// C++ Headers
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace CalcEval
+{
+    /** CompilerLogic class implementation.
+
+        Object that compiles the calculator syntax to an Expression.
+        Throws ParserError when an error is encountered.
+
+        The grammar, the lookup of constants and functions and the
+        errors are the same as in ParserLogic, the difference is that the
+        operations are appended to an Expression instead of computed.
+        Names of variables are looked up before everything else.
+
+        if(c, a, b) compiles to code with jumps, only the taken branch is
+        run by Expression::evaluate (see OpCode::Select). "a and b" and
+        "a or b" are compiled as if(a, b != 0, 0) and if(a, 1, b != 0),
+        so they short-circuit in the same way.
+
+        sum(i = a, b, body), prod(i = a, b, body) and
+        integrate(body, x, a, b, tolerance) compile body to an Expression of
+        its own, with i or x as one more variable (see
+        Expression::pushReduction). A variable with the same name is hidden
+        in body. The tolerance is optional.
+
+        Only CalcType with double as value_type and without add,
+        subtract, multiply, divide and power can be compiled (see
+        Type::isCompilable). The vectorized functions and operators of
+        CalcType, if it has any, are kept in the Expression for
+        evaluateBatch (see Type::Base).
+    */
+    template<typename CalcType>
+    class CompilerLogic
+    {
+        static_assert(Type::isCalcType<CalcType>, "CalcType must have value_type, stot, "
+                                                  "constant and function (see Type::Base)");
+        static_assert(Type::isCompilable<CalcType>,
+                      "Expression is compiled for CalcType with double as value_type "
+                      "and the built-in operators (see Type::isCompilable)");
+
+    public:
+        using value_type = double;
+        using func_type = typename Symbol<value_type>::func_type;
+
+    public:
+        CompilerLogic() = delete;
+
+        /** CompilerLogic constructor with iss.
+
+            @param  iss         istringstream to use
+            @param  variables   names of the variables
+            @param  symbols     optional symbols to use before CalcType
+            @return             default initialized CompilerLogic
+        */
+        CompilerLogic(std::istringstream& iss, const std::vector<std::string>& variables,
+                      const SymbolTable<value_type>* symbols = nullptr);
+
+        /** CompilerLogic constructor with tokens already scanned.
+
+            Used by ParserLogic for the body of sum and prod. The tokens
+            must end with TokenType::EndMark.
+
+            @param  tokens      tokens to use, must outlive the CompilerLogic
+            @param  line        line the tokens are from, for errors
+            @param  variables   names of the variables
+            @param  symbols     optional symbols to use before CalcType
+            @return             default initialized CompilerLogic
+        */
+        CompilerLogic(const std::vector<Token>& tokens, std::string line,
+                      const std::vector<std::string>& variables,
+                      const SymbolTable<value_type>* symbols = nullptr);
+
+        /** Function for compiling the istream in the scanner.
+
+            @return     compiled expression
+        */
+        [[nodiscard]] Expression compile();
+
+    private:
+        // Same as the functions with the same names in ParserLogic, but
+        // append code instead of returning a value.
+        void scan();
+        const Token& peek();
+        void expr();
+        void exprTail();
+        void conjunction();
+        void conjunctionTail();
+        void negation();
+        void comparison();
+        void arithmetic();
+        void arithmeticTail();
+        void term();
+        void termTail();
+        void factor();
+        void factorTail();
+        void value();
+        void id();
+        void call(const std::string& name, const Variadic<value_type>& func);
+        void reduction(const std::string& name);
+        void integral(const std::string& name);
+        void condition();
+
+        bool keyword(const char* str) const;
+        bool reserved(const std::string& str) const;
+        std::vector<Token> collect(TokenType end);
+        // Variables of a body, the ones of m_expression and name last.
+        std::vector<std::string> scope(const std::string& name) const;
+
+        std::optional<value_type> constant(const std::string& str);
+        std::optional<func_type> function(const std::string& str);
+        std::optional<Variadic<value_type>> variadic(const std::string& str);
+        Kernel::func_type batchFunction(const std::string& str);
+        Expression expression(const std::vector<std::string>& variables);
+
+        std::string line() const;
+        void error(const Token& token, const std::string& expected) const;
+
+    private:
+        std::optional<Scanner> m_scanner;
+        const std::vector<Token>* m_tokens{nullptr};
+        std::size_t m_next{0};
+        std::string m_line{};
+        Token m_token{TokenType::EndMark, {0, 0}, ""};
+        std::optional<Token> m_ahead{}; // scanned by peek
+        CalcType m_calcType{};
+        const SymbolTable<value_type>* m_symbols{nullptr};
+        Expression m_expression;
+    };
+
+} // namespace CalcEval
+
+// Implementation of CompilerLogic is in a separate file.
+#include "CompilerLogic.tpp"
+
+#endif // CALCEVAL_COMPILERLOGIC_HPP
@@ -0,0 +1,705 @@
+//
+//  CompilerLogic.tpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_COMPILERLOGIC_TPP
+#define CALCEVAL_COMPILERLOGIC_TPP
+
+// C++ Headers
+#include <algorithm>
+#include <array>
+#include <string>
+#include <utility>
+
+namespace CalcEval
+{
+    template<typename CalcType>
+    CompilerLogic<CalcType>::CompilerLogic(std::istringstream& iss,
+                                           const std::vector<std::string>& variables,
+                                           const SymbolTable<value_type>* symbols)
+        : m_scanner{std::in_place, iss}, m_symbols{symbols}, m_expression{expression(variables)}
+    {
+    }
+
+    template<typename CalcType>
+    CompilerLogic<CalcType>::CompilerLogic(const std::vector<Token>& tokens, std::string line,
+                                           const std::vector<std::string>& variables,
+                                           const SymbolTable<value_type>* symbols)
+        : m_tokens{&tokens}, m_line{std::move(line)}, m_symbols{symbols},
+          m_expression{expression(variables)}
+    {
+    }
+
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::scan()
+    {
+        if (m_tokens)
+        {
+            // The last token is EndMark, it is repeated if scanned again.
+            m_token = (*m_tokens)[std::min(m_next, m_tokens->size() - 1)];
+            ++m_next;
+            return;
+        }
+
+        if (m_ahead)
+        {
+            m_token = std::move(*m_ahead);
+            m_ahead.reset();
+            return;
+        }
+
+        do
+        {
+            m_token = m_scanner->scan();
+        } while (m_token.type == TokenType::EndOfLine);
+    }
+
+    template<typename CalcType>
+    const Token& CompilerLogic<CalcType>::peek()
+    {
+        if (m_tokens)
+            return (*m_tokens)[std::min(m_next, m_tokens->size() - 1)];
+
+        if (!m_ahead)
+        {
+            do
+            {
+                m_ahead = m_scanner->scan();
+            } while (m_ahead->type == TokenType::EndOfLine);
+        }
+        return *m_ahead;
+    }
+
+    template<typename CalcType>
+    Expression CompilerLogic<CalcType>::compile()
+    {
+        scan();
+
+        if (m_token.type != TokenType::Bad)
+        {
+            expr();
+        }
+
+        if (m_token.type != TokenType::EndMark)
+        {
+            error(m_token, "");
+        }
+
+        return std::move(m_expression);
+    }
+
+    // <expr> ::= <conjunction><expr_tail>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::expr()
+    {
+        conjunction();
+        exprTail();
+    }
+
+    // <expr_tail> ::= or <conjunction><expr_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::exprTail()
+    {
+        // a or b is if(a, 1, b != 0).
+        while (keyword("or"))
+        {
+            scan();
+            m_expression.pushOperator(OpCode::Then);
+            m_expression.pushConstant(1.0);
+            m_expression.pushOperator(OpCode::Else);
+            conjunction();
+            m_expression.pushConstant(0.0);
+            m_expression.pushOperator(OpCode::NotEqual);
+            m_expression.pushOperator(OpCode::Select);
+        }
+    }
+
+    // <conjunction> ::= <negation><conjunction_tail>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::conjunction()
+    {
+        negation();
+        conjunctionTail();
+    }
+
+    // <conjunction_tail> ::= and <negation><conjunction_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::conjunctionTail()
+    {
+        // a and b is if(a, b != 0, 0).
+        while (keyword("and"))
+        {
+            scan();
+            m_expression.pushOperator(OpCode::Then);
+            negation();
+            m_expression.pushConstant(0.0);
+            m_expression.pushOperator(OpCode::NotEqual);
+            m_expression.pushOperator(OpCode::Else);
+            m_expression.pushConstant(0.0);
+            m_expression.pushOperator(OpCode::Select);
+        }
+    }
+
+    // <negation> ::= not <negation>
+    //      |   <comparison>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::negation()
+    {
+        if (keyword("not"))
+        {
+            scan();
+            negation();
+            m_expression.pushConstant(0.0);
+            m_expression.pushOperator(OpCode::Equal);
+            return;
+        }
+
+        comparison();
+    }
+
+    // <comparison> ::= <arithmetic> <relation> <arithmetic>
+    //      |   <arithmetic>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::comparison()
+    {
+        arithmetic();
+
+        std::optional<OpCode> op{};
+        switch (m_token.type)
+        {
+            case TokenType::Less:
+                op = OpCode::Less;
+                break;
+            case TokenType::LessEqual:
+                op = OpCode::LessEqual;
+                break;
+            case TokenType::Greater:
+                op = OpCode::Greater;
+                break;
+            case TokenType::GreaterEqual:
+                op = OpCode::GreaterEqual;
+                break;
+            case TokenType::Equal:
+                op = OpCode::Equal;
+                break;
+            case TokenType::NotEqual:
+                op = OpCode::NotEqual;
+                break;
+            default:
+                return;
+        }
+
+        scan();
+        arithmetic();
+        m_expression.pushOperator(*op);
+    }
+
+    // <arithmetic> ::= <term><arithmetic_tail>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::arithmetic()
+    {
+        term();
+        arithmeticTail();
+    }
+
+    // <arithmetic_tail> ::= +<term><arithmetic_tail>
+    //      |   -<term><arithmetic_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::arithmeticTail()
+    {
+        while (m_token.type == TokenType::Plus || m_token.type == TokenType::Minus)
+        {
+            const OpCode op{(m_token.type == TokenType::Plus) ? OpCode::Add : OpCode::Subtract};
+            scan();
+            term();
+            m_expression.pushOperator(op);
+        }
+    }
+
+    // <term> ::= <factor><term_tail>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::term()
+    {
+        factor();
+        termTail();
+    }
+
+    // <term_tail> ::= *<factor><term_tail>
+    //      |   /<factor><term_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::termTail()
+    {
+        while (m_token.type == TokenType::Multiply || m_token.type == TokenType::Divide)
+        {
+            const OpCode op{(m_token.type == TokenType::Multiply) ? OpCode::Multiply
+                                                                   : OpCode::Divide};
+            scan();
+            factor();
+            m_expression.pushOperator(op);
+        }
+    }
+
+    // <factor> ::= -<value><factor_term>
+    //      |   <value><factor_term>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::factor()
+    {
+        bool negate{false};
+
+        if (m_token.type == TokenType::Minus)
+        {
+            scan();
+            negate = true;
+        }
+
+        value();
+        factorTail();
+
+        // ParserLogic multiplies by 1 when there is no minus, which
+        // never changes the value, so nothing is emitted for it.
+        if (negate)
+            m_expression.pushOperator(OpCode::Negate);
+    }
+
+    // <factor_term> ::= ^-<value><factor_tail>
+    //      |   ^<value><factor_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::factorTail()
+    {
+        if (m_token.type == TokenType::Power)
+        {
+            scan();
+            bool negate{false};
+            if (m_token.type == TokenType::Minus)
+            {
+                scan();
+                negate = true;
+            }
+
+            value();
+            factorTail();
+            if (negate)
+                m_expression.pushOperator(OpCode::Negate);
+            m_expression.pushOperator(OpCode::Power);
+        }
+    }
+
+    // <value> ::= ( <expr> )
+    //      |   <id>
+    //      | 	num
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::value()
+    {
+        if (m_token.type == TokenType::LeftParen)
+        {
+            scan();
+            expr();
+            if (m_token.type != TokenType::RightParen)
+            {
+                error(m_token, "')'");
+            }
+        }
+        else if (m_token.type == TokenType::Identifier)
+        {
+            id();
+            return;
+        }
+        else if (m_token.type == TokenType::Number)
+        {
+            m_expression.pushConstant(m_calcType.stot(m_token.value));
+        }
+        else
+        {
+            error(m_token, "'(', identifier or number");
+        }
+
+        scan();
+    }
+
+    // <id> ::= variable
+    //      |   function <value>
+    //      |   if ( <expr> , <expr> , <expr> )
+    //      |   variadic ( <args> )
+    //      |   sum ( index = <expr> , <expr> , <expr> )
+    //      |   prod ( index = <expr> , <expr> , <expr> )
+    //      |   integrate ( <expr> , variable , <expr> , <expr> [ , <expr> ] )
+    //      |   constant
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::id()
+    {
+        const Token token{m_token};
+        const std::string& str{token.value};
+        scan();
+
+        // Expect a variable or constant
+        if (m_token.type != TokenType::LeftParen)
+        {
+            if (auto index = m_expression.variables().find(str))
+            {
+                m_expression.pushVariable(*index);
+                return;
+            }
+            else if (auto val = constant(str))
+            {
+                m_expression.pushConstant(*val);
+                return;
+            }
+            else if (function(str) || variadic(str))
+            {
+                error(token, "constant, no such constant found\nDid you mean to call " + str +
+                                 "(x)?");
+            }
+
+            error(token, "constant, no such constant found");
+        }
+
+        if (str == "if")
+        {
+            scan(); // '('
+            condition();
+            return;
+        }
+
+        if (auto func = function(str))
+        {
+            value();
+            const auto array = (m_symbols) ? m_symbols->batchFunction(str) : nullptr;
+            m_expression.pushFunction(str, *func, batchFunction(str), array);
+            return;
+        }
+
+        const bool series{str == "sum" || str == "prod"};
+        const std::optional<Variadic<value_type>> vfunc{variadic(str)};
+        if (!series && str != "integrate" && !vfunc)
+        {
+            // No function found, but has '(', so a function is expected.
+            error(token, "function, no such function found");
+        }
+
+        scan(); // '('
+
+        // A name followed by '=' is the index, anything else is an argument.
+        if (series && m_token.type == TokenType::Identifier && peek().type == TokenType::Assign)
+            reduction(str);
+        else if (!series && !vfunc)
+            integral(str);
+        else if (vfunc)
+            call(str, *vfunc);
+        else
+            error(m_token, "index followed by '='");
+    }
+
+    // <args> ::= <expr><args_tail>
+    //
+    // <args_tail> ::= ,<expr><args_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::call(const std::string& name, const Variadic<value_type>& func)
+    {
+        expr();
+        std::size_t count{1};
+        while (m_token.type == TokenType::Comma)
+        {
+            if (count >= func.maxArgs)
+            {
+                error(m_token, "')', at most " + std::to_string(func.maxArgs) + " argument(s)");
+            }
+
+            scan();
+            expr();
+            ++count;
+        }
+
+        if (m_token.type != TokenType::RightParen)
+        {
+            error(m_token, "',' or ')'");
+        }
+
+        if (count < func.minArgs)
+        {
+            error(m_token, "',', at least " + std::to_string(func.minArgs) + " arguments");
+        }
+
+        scan();
+        m_expression.pushVariadic(name, func.function, static_cast<std::uint32_t>(count));
+    }
+
+    // index = <expr> , <expr> , <expr> )
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::reduction(const std::string& name)
+    {
+        const std::string index{m_token.value};
+        if (reserved(index))
+        {
+            error(m_token, "index, a name that is not a keyword");
+        }
+        scan();
+
+        // The bounds are outside of the scope of the index.
+        for (int bound{0}; bound < 2; ++bound)
+        {
+            if (m_token.type != ((bound == 0) ? TokenType::Assign : TokenType::Comma))
+            {
+                error(m_token, (bound == 0) ? "'='" : "','");
+            }
+
+            scan();
+            expr();
+        }
+
+        if (m_token.type != TokenType::Comma)
+        {
+            error(m_token, "','");
+        }
+        scan();
+
+        // The body is compiled with the index as the last variable.
+        const std::vector<std::string> variables{scope(index)};
+        Expression outer{std::move(m_expression)};
+        m_expression = expression(variables);
+        expr();
+        Expression body{std::move(m_expression)};
+        m_expression = std::move(outer);
+
+        if (m_token.type != TokenType::RightParen)
+        {
+            error(m_token, "')'");
+        }
+
+        scan();
+        const auto kind = (name == "prod") ? Expression::Reduction::Kind::Product
+                                           : Expression::Reduction::Kind::Sum;
+        m_expression.pushReduction(name, kind, std::move(body));
+    }
+
+    // <expr> , variable , <expr> , <expr> [ , <expr> ] )
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::integral(const std::string& name)
+    {
+        // The variable comes after the integrand, which is compiled when
+        // its name is known.
+        const std::vector<Token> tokens{collect(TokenType::Comma)};
+        scan();
+        if (m_token.type != TokenType::Identifier || reserved(m_token.value))
+        {
+            error(m_token, "variable, a name that is not a keyword");
+        }
+
+        const std::vector<std::string> variables{scope(m_token.value)};
+        scan();
+
+        CompilerLogic<CalcType> logic{tokens, line(), variables, m_symbols};
+        Expression body{logic.compile()};
+
+        for (int bound{0}; bound < 2; ++bound)
+        {
+            if (m_token.type != TokenType::Comma)
+            {
+                error(m_token, "','");
+            }
+
+            scan();
+            expr();
+        }
+
+        if (m_token.type == TokenType::Comma)
+        {
+            scan();
+            expr();
+        }
+        else
+        {
+            m_expression.pushConstant(Quadrature::defaultTolerance);
+        }
+
+        if (m_token.type != TokenType::RightParen)
+        {
+            error(m_token, "',' or ')'");
+        }
+
+        scan();
+        m_expression.pushReduction(name, Expression::Reduction::Kind::Integral, std::move(body));
+    }
+
+    // <expr> , <expr> , <expr> )
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::condition()
+    {
+        expr();
+        for (const OpCode marker : {OpCode::Then, OpCode::Else})
+        {
+            if (m_token.type != TokenType::Comma)
+            {
+                error(m_token, "','");
+            }
+
+            scan();
+            m_expression.pushOperator(marker);
+            expr();
+        }
+
+        if (m_token.type != TokenType::RightParen)
+        {
+            error(m_token, "')'");
+        }
+
+        scan();
+        m_expression.pushOperator(OpCode::Select);
+    }
+
+    template<typename CalcType>
+    bool CompilerLogic<CalcType>::keyword(const char* str) const
+    {
+        return m_token.type == TokenType::Identifier && m_token.value == str;
+    }
+
+    template<typename CalcType>
+    bool CompilerLogic<CalcType>::reserved(const std::string& str) const
+    {
+        return str == "and" || str == "or" || str == "not" || str == "if";
+    }
+
+    template<typename CalcType>
+    std::vector<std::string> CompilerLogic<CalcType>::scope(const std::string& name) const
+    {
+        // A variable with the same name gets one that is not an
+        // identifier, it keeps its place but can not be used in the body.
+        std::vector<std::string> variables{};
+        for (std::uint32_t i{0}; i < m_expression.variables().size(); ++i)
+        {
+            const std::string_view variable{m_expression.variables().name(i)};
+            if (variable == name)
+                variables.push_back("#" + std::to_string(i));
+            else
+                variables.emplace_back(variable);
+        }
+        variables.push_back(name);
+        return variables;
+    }
+
+    // The tokens up to end outside of parentheses, followed by EndMark.
+    template<typename CalcType>
+    std::vector<Token> CompilerLogic<CalcType>::collect(TokenType end)
+    {
+        std::vector<Token> tokens{};
+        std::size_t depth{0};
+        while (depth > 0 || m_token.type != end)
+        {
+            if (m_token.type == TokenType::EndMark || m_token.type == TokenType::Bad ||
+                (depth == 0 && m_token.type == TokenType::RightParen))
+            {
+                error(m_token, (end == TokenType::Comma) ? "','" : "')'");
+            }
+
+            if (m_token.type == TokenType::LeftParen)
+                ++depth;
+            else if (m_token.type == TokenType::RightParen)
+                --depth;
+
+            tokens.push_back(m_token);
+            scan();
+        }
+
+        tokens.emplace_back(TokenType::EndMark, m_token.location, "");
+        return tokens;
+    }
+
+    template<typename CalcType>
+    std::optional<typename CompilerLogic<CalcType>::value_type>
+    CompilerLogic<CalcType>::constant(const std::string& str)
+    {
+        if (m_symbols)
+            if (m_symbols->symbol(str))
+                return m_symbols->constant(str);
+
+        return m_calcType.constant(str);
+    }
+
+    template<typename CalcType>
+    std::optional<typename CompilerLogic<CalcType>::func_type>
+    CompilerLogic<CalcType>::function(const std::string& str)
+    {
+        if (m_symbols)
+            if (m_symbols->symbol(str))
+                return m_symbols->function(str);
+
+        return m_calcType.function(str);
+    }
+
+    // An empty Expression with the vectorized operators of CalcType.
+    template<typename CalcType>
+    Expression CompilerLogic<CalcType>::expression(const std::vector<std::string>& variables)
+    {
+        Expression result{variables};
+        if constexpr (Type::hasBatchOperator<CalcType>)
+        {
+            constexpr std::array<std::pair<char, OpCode>, 5> operators{
+                std::pair{'+', OpCode::Add}, std::pair{'-', OpCode::Subtract},
+                std::pair{'*', OpCode::Multiply}, std::pair{'/', OpCode::Divide},
+                std::pair{'^', OpCode::Power}};
+            for (const auto& [symbol, op] : operators)
+                result.setBatchOperator(op, m_calcType.batchOperator(symbol).value_or(nullptr));
+        }
+        return result;
+    }
+
+    template<typename CalcType>
+    Kernel::func_type CompilerLogic<CalcType>::batchFunction(const std::string& str)
+    {
+        // A symbol hides the function in CalcType and its batch version.
+        if (m_symbols)
+            if (m_symbols->symbol(str))
+                return nullptr;
+
+        if constexpr (Type::hasBatchFunction<CalcType>)
+            return m_calcType.batchFunction(str).value_or(nullptr);
+        else
+            return nullptr;
+    }
+
+    template<typename CalcType>
+    std::optional<Variadic<typename CompilerLogic<CalcType>::value_type>>
+    CompilerLogic<CalcType>::variadic(const std::string& str)
+    {
+        if (m_symbols)
+            if (m_symbols->symbol(str))
+                return m_symbols->variadic(str);
+
+        if constexpr (Type::hasVariadic<CalcType>)
+            return m_calcType.variadic(str);
+        else
+            return std::nullopt;
+    }
+
+    template<typename CalcType>
+    std::string CompilerLogic<CalcType>::line() const
+    {
+        const std::string content{(m_scanner) ? m_scanner->scanned() : m_line};
+        std::size_t start{0};
+        const std::size_t findLast{content.find_last_of('\n')};
+        if (findLast != std::string::npos)
+            start = findLast + 1;
+
+        return content.substr(start);
+    }
+
+    template<typename CalcType>
+    void CompilerLogic<CalcType>::error(const Token& token, const std::string& expected) const
+    {
+        const std::string unexpectedMsg{"token of \"" + std::string{tokenStr(token.type)} + "\""};
+        const std::string expectedMsg{(!expected.empty()) ? "Expected " + expected + "!" : ""};
+
+        throw ParserError(line(), token.location, unexpectedMsg, expectedMsg, token);
+    }
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_COMPILERLOGIC_TPP
@@ -0,0 +1,208 @@
+//
+//  Document.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_DOCUMENT_HPP
+#define CALCEVAL_DOCUMENT_HPP
+
+// Local Headers
+#include "calceval/Session.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Document class implementation.
+
+        The lines of a file, each one "name = expr" or an expression,
+        evaluated by a Session. When the file changes only the lines that
+        changed are scanned and evaluated again, with the lines that use
+        the names they define.
+
+        update compares the new content with the old from both ends and
+        the lines in between with an index of the hashes of the lines.
+        Lines that are still there, also when they moved, keep their
+        definitions. Blank lines have no result. replace changes a range
+        of the content without comparing the rest, for an editor that
+        knows what it changed.
+
+        The lines are kept in blocks of a few hundred, so an edit only
+        copies the blocks it changes and moves the offsets of the blocks
+        after them.
+
+        A name defined on more than one line is used from the first of
+        the lines, the other lines have an error. A line that does not
+        compile or would depend on itself keeps its name, with an error,
+        so the lines that use it do not see a constant or function with
+        the same name instead.
+
+        The results only depend on the content, not on the edits that led
+        to it. Which line of a cycle has the error depends on the order
+        the lines are defined in, so while a line would depend on itself
+        it is defined again in order with the lines that use it, as for
+        new content.
+
+        Usage:
+            CalcEval::Document document{};
+            document.update("rate = 0.05\n1000 * (1 + rate)^10\n");
+            for (const auto& result : document.update("rate = 0.04\n1000 * (1 + rate)^10\n"))
+                std::cout << result.line << ": " << *result.value << '\n';
+    */
+    class Document
+    {
+    public:
+        using symbols_type = Session::symbols_type;
+
+        struct Result
+        {
+            std::size_t line;            // from 1
+            std::optional<double> value; // std::nullopt if the line has an error or is blank
+            std::string error;
+        };
+
+    public:
+        /** Document constructor with symbols.
+
+            @param  symbols     symbols to use, nullptr if none
+            @return             empty Document
+        */
+        explicit Document(symbols_type symbols = nullptr);
+
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+
+        /** Function for changing the content.
+
+            Lines are separated by '\n', a '\r' before it is ignored.
+
+            @param  content     new content
+            @return             lines with another value or error, sorted by line
+        */
+        std::vector<Result> update(std::string_view content);
+
+        /** Function for replacing a range of the content.
+
+            Same as update with the content where count chars from offset
+            are replaced by text. Throws std::invalid_argument if the range
+            is not in the content.
+
+            @param  offset  first char to replace
+            @param  count   number of chars to replace
+            @param  text    text to insert at offset
+            @return         lines with another value or error, sorted by line
+        */
+        std::vector<Result> replace(std::size_t offset, std::size_t count, std::string_view text);
+
+        /** Retrieve the result of a line.
+
+            Throws std::invalid_argument if there is no line.
+
+            @param  line    line, from 1
+            @return         result
+        */
+        [[nodiscard]] Result result(std::size_t line) const;
+
+        /** Retrieve the number of lines.
+
+            The text after the last '\n' is a line, also when it is empty.
+
+            @return     number of lines
+        */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /** Retrieve the Session with the names of the Document.
+
+            @return     session
+        */
+        [[nodiscard]] const Session& session() const noexcept;
+
+    private:
+        struct Line
+        {
+            std::uint64_t hash;
+            std::size_t start; // in the text of the block
+            std::uint32_t id;  // 0 if blank
+        };
+
+        struct Block
+        {
+            std::string text{}; // the lines, each one followed by '\n'
+            std::vector<Line> lines{};
+            std::size_t first{0};  // index of the first line
+            std::size_t offset{0}; // of the text in the content
+        };
+
+        struct Place
+        {
+            const Block* block{nullptr}; // nullptr if the id is not used
+            std::size_t index{0};        // in the lines of the block
+        };
+
+        struct State
+        {
+            std::string name{};   // empty if not an assignment
+            std::string text{};   // expression
+            std::string error{};  // of the line, the Session has the rest
+            bool rejected{false}; // would depend on itself
+        };
+
+        struct Holders
+        {
+            std::vector<std::uint32_t> ids{}; // lines that define the name
+            std::uint32_t active{0};          // id of the line in the Session, 0 if none
+        };
+
+        // Replaces count lines from first by the lines of str, the text
+        // after the last '\n' is a line if last is true.
+        std::vector<Result> splice(std::size_t first, std::size_t count, std::string_view str,
+                                   bool last);
+        // Index of the block with the line, or with the char at offset.
+        std::size_t block(std::size_t line) const;
+        std::size_t blockAt(std::size_t offset) const;
+        // Line of the block with its '\n'.
+        static std::string_view view(const Block& block, std::size_t index);
+        // Key of the line in the Session.
+        std::string key(std::uint32_t id) const;
+        Result result(std::size_t index, std::uint32_t id) const;
+        std::uint32_t allocate();
+        // Sets the state of a line with a new id.
+        void assign(std::uint32_t id, std::string_view text);
+        // Picks the first line of a name, the lines in pending are defined.
+        void resolve(const std::string& name, const std::vector<std::uint32_t>& redefined,
+                     std::vector<std::pair<std::size_t, std::uint32_t>>& pending,
+                     std::vector<std::string>& changed, std::vector<std::uint32_t>& touched);
+        // Defines the name or expression of a line, keeps the error if it fails.
+        void define(std::uint32_t id, std::vector<std::string>& changed);
+        // Defines the rejected lines and the lines that use them again in
+        // order, adds the lines with another result.
+        void untangle(std::vector<std::uint32_t>& touched);
+        // Id of the line in the Session with the name or key.
+        std::uint32_t line(const std::string& name) const;
+        // Index of the line of an id.
+        std::size_t position(std::uint32_t id) const;
+
+    private:
+        Session m_session;
+        std::vector<std::unique_ptr<Block>> m_blocks{};
+        std::vector<State> m_states{}; // by id
+        std::vector<Place> m_places{}; // by id
+        std::vector<std::uint32_t> m_free{};
+        std::vector<std::uint32_t> m_rejected{}; // ids, also of lines defined again since
+        std::unordered_map<std::string, Holders> m_holders{}; // by name
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_DOCUMENT_HPP
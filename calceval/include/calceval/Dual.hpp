@@ -0,0 +1,292 @@
+//
+//  Dual.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_DUAL_HPP
+#define CALCEVAL_DUAL_HPP
+
+// C++ Headers
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace CalcEval
+{
+    /** Dual class implementation.
+
+        Dual number for forward mode automatic differentiation. Holds a
+        value and N tangents, the derivatives of the value with respect to
+        N inputs. Every operation computes its value as for double and
+        applies the chain rule to the tangents, so a single evaluation gives
+        both the value and the gradient:
+
+            f(x + x'e) = f(x) + f'(x)x'e
+
+        An input is made with variable(value, index), which has tangent 1
+        at index and 0 elsewhere. Numbers made from a double are constants
+        with all tangents 0.
+
+        The math functions (named after <cmath>) are found by
+        argument-dependent lookup, so pow(a, b) works as for double.
+        Derivatives at points where they do not exist follow the limit or
+        the IEEE value, for example sqrt(x) at x = 0 has an infinite
+        derivative.
+
+        Usage:
+            using D = CalcEval::Dual<2>;
+            D x{D::variable(3.0, 0)}, y{D::variable(4.0, 1)};
+            D f{x * y + sin(x)};
+            double dfdx{f.derivative(0)};
+    */
+    template<std::size_t N>
+    class Dual
+    {
+    public:
+        using tangent_type = std::array<double, N>;
+
+    public:
+        /** Default Dual constructor.
+
+            @return     zero
+        */
+        constexpr Dual() noexcept = default;
+
+        /** Dual constructor with a constant.
+
+            @param  value   value
+            @return         constant with all tangents 0
+        */
+        constexpr Dual(double value) noexcept : m_value{value}
+        {
+        }
+
+        /** Dual constructor with a value and its tangents.
+
+            @param  value   value
+            @param  tangent derivatives of the value
+            @return         initialized Dual
+        */
+        constexpr Dual(double value, const tangent_type& tangent) noexcept
+            : m_value{value},
+              m_tangent{tangent}
+        {
+        }
+
+        /** Function for creating an input to differentiate with respect to.
+
+            @param  value   value of the input
+            @param  index   index of the input in the gradient, less than N
+            @return         Dual with tangent 1 at index
+        */
+        [[nodiscard]] static constexpr Dual variable(double value, std::size_t index) noexcept
+        {
+            Dual x{value};
+            x.m_tangent[index] = 1.0;
+            return x;
+        }
+
+        [[nodiscard]] constexpr double value() const noexcept
+        {
+            return m_value;
+        }
+
+        /** Function for the tangents, the gradient when made with variable().
+
+            @return     derivatives with respect to the inputs
+        */
+        [[nodiscard]] constexpr const tangent_type& tangent() const noexcept
+        {
+            return m_tangent;
+        }
+
+        /** Function for one derivative.
+
+            @param  index   index of the input, less than N
+            @return         derivative with respect to input index
+        */
+        [[nodiscard]] constexpr double derivative(std::size_t index) const noexcept
+        {
+            return m_tangent[index];
+        }
+
+        constexpr Dual operator-() const noexcept
+        {
+            return scaled(-m_value, -1.0);
+        }
+
+        constexpr Dual& operator+=(const Dual& rhs) noexcept
+        {
+            m_value += rhs.m_value;
+            for (std::size_t i{0}; i < N; ++i)
+                m_tangent[i] += rhs.m_tangent[i];
+            return *this;
+        }
+
+        constexpr Dual& operator-=(const Dual& rhs) noexcept
+        {
+            m_value -= rhs.m_value;
+            for (std::size_t i{0}; i < N; ++i)
+                m_tangent[i] -= rhs.m_tangent[i];
+            return *this;
+        }
+
+        // (uv)' = u'v + uv'
+        constexpr Dual& operator*=(const Dual& rhs) noexcept
+        {
+            for (std::size_t i{0}; i < N; ++i)
+                m_tangent[i] = m_tangent[i] * rhs.m_value + m_value * rhs.m_tangent[i];
+            m_value *= rhs.m_value;
+            return *this;
+        }
+
+        // (u/v)' = (u' - (u/v)v') / v
+        constexpr Dual& operator/=(const Dual& rhs) noexcept
+        {
+            m_value /= rhs.m_value;
+            for (std::size_t i{0}; i < N; ++i)
+                m_tangent[i] = (m_tangent[i] - m_value * rhs.m_tangent[i]) / rhs.m_value;
+            return *this;
+        }
+
+        friend constexpr Dual operator+(Dual lhs, const Dual& rhs) noexcept
+        {
+            return lhs += rhs;
+        }
+
+        friend constexpr Dual operator-(Dual lhs, const Dual& rhs) noexcept
+        {
+            return lhs -= rhs;
+        }
+
+        friend constexpr Dual operator*(Dual lhs, const Dual& rhs) noexcept
+        {
+            return lhs *= rhs;
+        }
+
+        friend constexpr Dual operator/(Dual lhs, const Dual& rhs) noexcept
+        {
+            return lhs /= rhs;
+        }
+
+        friend Dual exp(const Dual& x) noexcept
+        {
+            const double value{std::exp(x.m_value)};
+            return x.scaled(value, value);
+        }
+
+        friend Dual log(const Dual& x) noexcept
+        {
+            return x.scaled(std::log(x.m_value), 1.0 / x.m_value);
+        }
+
+        friend Dual log10(const Dual& x) noexcept
+        {
+            return x.scaled(std::log10(x.m_value), 1.0 / (x.m_value * std::log(10.0)));
+        }
+
+        friend Dual sqrt(const Dual& x) noexcept
+        {
+            const double value{std::sqrt(x.m_value)};
+            return x.scaled(value, 0.5 / value);
+        }
+
+        friend Dual sin(const Dual& x) noexcept
+        {
+            return x.scaled(std::sin(x.m_value), std::cos(x.m_value));
+        }
+
+        friend Dual cos(const Dual& x) noexcept
+        {
+            return x.scaled(std::cos(x.m_value), -std::sin(x.m_value));
+        }
+
+        friend Dual tan(const Dual& x) noexcept
+        {
+            const double value{std::tan(x.m_value)};
+            return x.scaled(value, 1.0 + value * value);
+        }
+
+        friend Dual asin(const Dual& x) noexcept
+        {
+            return x.scaled(std::asin(x.m_value), 1.0 / std::sqrt(1.0 - x.m_value * x.m_value));
+        }
+
+        friend Dual acos(const Dual& x) noexcept
+        {
+            return x.scaled(std::acos(x.m_value), -1.0 / std::sqrt(1.0 - x.m_value * x.m_value));
+        }
+
+        friend Dual atan(const Dual& x) noexcept
+        {
+            return x.scaled(std::atan(x.m_value), 1.0 / (1.0 + x.m_value * x.m_value));
+        }
+
+        /** Function for y/x in the correct quadrant.
+
+            @param  y   y coordinate
+            @param  x   x coordinate
+            @return     angle of (x, y)
+        */
+        friend Dual atan2(const Dual& y, const Dual& x) noexcept
+        {
+            const double r2{x.m_value * x.m_value + y.m_value * y.m_value};
+            Dual result{std::atan2(y.m_value, x.m_value)};
+            for (std::size_t i{0}; i < N; ++i)
+                result.m_tangent[i] =
+                    (x.m_value * y.m_tangent[i] - y.m_value * x.m_tangent[i]) / r2;
+            return result;
+        }
+
+        /** Function for base^exponent.
+
+            (a^b)' = b a^(b-1) a' + a^b log(a) b'
+
+            Each term is only used for the tangents where its operand
+            depends on an input, so a negative base with a constant exponent
+            such as (-2)^3 has a finite derivative. 0^b with b > 0 has
+            derivative 0 with respect to b, as its limit from above.
+
+            @param  base        base
+            @param  exponent    exponent
+            @return             base^exponent
+        */
+        friend Dual pow(const Dual& base, const Dual& exponent) noexcept
+        {
+            const double a{base.m_value}, b{exponent.m_value};
+            const double value{std::pow(a, b)};
+            const double da{(b == 0.0) ? 0.0 : b * std::pow(a, b - 1.0)};
+            const double db{(a == 0.0 && b > 0.0) ? 0.0 : value * std::log(a)};
+
+            Dual result{value};
+            for (std::size_t i{0}; i < N; ++i)
+            {
+                result.m_tangent[i] = (base.m_tangent[i] != 0.0) ? da * base.m_tangent[i] : 0.0;
+                if (exponent.m_tangent[i] != 0.0)
+                    result.m_tangent[i] += db * exponent.m_tangent[i];
+            }
+            return result;
+        }
+
+    private:
+        // Chain rule for a function of one argument, f(x) = value and
+        // f'(x) = slope. Zero tangents stay zero even if the slope is
+        // infinite, a constant argument gives a constant.
+        constexpr Dual scaled(double value, double slope) const noexcept
+        {
+            Dual result{value};
+            for (std::size_t i{0}; i < N; ++i)
+                result.m_tangent[i] = (m_tangent[i] != 0.0) ? slope * m_tangent[i] : 0.0;
+            return result;
+        }
+
+    private:
+        double m_value{0.0};
+        tangent_type m_tangent{};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_DUAL_HPP
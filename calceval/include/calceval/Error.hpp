@@ -34,6 +34,18 @@ namespace CalcEval
         Location m_loc;
     };
 
+    /** ArithmeticError class implementation.
+
+        Object that is thrown by a CalcType when a result can not be
+        represented, for example on integer overflow or division by zero.
+        Use the ArithmeticError.what() function for details.
+    */
+    class ArithmeticError : public Error
+    {
+    public:
+        using Error::Error;
+    };
+
 } // namespace CalcEval
 
 #endif // CALCEVAL_ERROR_HPP
@@ -0,0 +1,383 @@
+//
+//  Expression.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_EXPRESSION_HPP
+#define CALCEVAL_EXPRESSION_HPP
+
+// Local Headers
+#include "calceval/Function.hpp"
+#include "calceval/Hash.hpp"
+#include "calceval/Kernel.hpp"
+#include "calceval/NameTable.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CalcEval
+{
+    /** OpCode enum class implementation.
+
+        Operations of an Expression. The operators pop their operands
+        from the stack and push the result. Comparisons push 1 if they
+        are true and 0 if not.
+
+        if(c, a, b) is the code of c, Then, a, Else, b, Select. Then and
+        Else are markers that leave their operand on the stack, except in
+        evaluate where they skip the branch that is not taken: Then pops c
+        and skips a if c is 0, Else skips b. index is the number of
+        instructions they skip, set when the Select is appended.
+    */
+    enum class OpCode : std::uint8_t
+    {
+        Constant, // push constants[index]
+        Variable, // push variables[index]
+        Negate,   // -x
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Power,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        Then,     // c, before a
+        Else,     // a, before b
+        Select,   // c != 0 ? a : b
+        Function, // functions[index](x)
+        Variadic, // variadics[index](x1, ..., xn)
+        Reduce    // reductions[index] from a to b
+    };
+
+    /** Instruction struct implementation.
+
+        index is the constant, variable, function or function with several
+        arguments used by the instruction, the number of instructions to
+        skip for Then and Else, 0 for the other operators.
+    */
+    struct Instruction
+    {
+        OpCode op;
+        std::uint32_t index;
+    };
+
+    /** Expression class implementation.
+
+        An expression compiled to postfix code for a stack machine, for
+        expressions that are evaluated more than once. Created by a
+        Compiler (see Compiler.hpp), which parses the text once, the
+        evaluation then only runs the code.
+
+        Variables are named inputs given when evaluating, in the order
+        they were given to the Compiler. Everything else (numbers,
+        constants and functions) is resolved when compiling.
+
+        The operations are the same as the ones done by Parser with
+        Type::Standard, in the same order, so the results are identical.
+        A condition is true if it is not 0, also if it is NaN.
+
+        An Expression is never modified after it is compiled, so any
+        number of threads can evaluate it at the same time.
+    */
+    class Expression
+    {
+    public:
+        using func_type = double (*)(double);
+        using batch_type = BatchFunction<double>;
+        using variadic_type = Variadic<double>::func_type;
+
+        /** Function used by OpCode::Function.
+
+            The name is kept to be able to recognize the function. batch
+            is an optional vectorized version used by evaluateBatch, array
+            is used when there is no batch, for example for a function
+            from a Registry or a Plugin.
+        */
+        struct Function
+        {
+            std::string name;
+            func_type function;
+            Kernel::func_type batch;
+            batch_type array;
+        };
+
+        /** Function with several arguments used by OpCode::Variadic.
+
+            count is the number of arguments of this call.
+        */
+        struct Call
+        {
+            std::string name;
+            variadic_type function;
+            std::uint32_t count;
+        };
+
+        /** Sum, product or integral used by OpCode::Reduce.
+
+            body has the variables of this expression followed by one
+            more, the index or the variable of integration. The operands
+            are popped from the stack: the bounds a and b, and for an
+            integral also the tolerance (see Series.hpp and
+            Quadrature.hpp).
+        */
+        struct Reduction
+        {
+            enum class Kind
+            {
+                Sum,
+                Product,
+                Integral
+            };
+
+            std::string name;
+            Kind kind;
+            std::uint32_t count;
+            std::shared_ptr<const Expression> body;
+
+            /** Function for evaluating the reduction.
+
+                @param  operands    values popped from the stack
+                @param  variables   values of the variables of the expression
+                @return             resulting value
+            */
+            [[nodiscard]] double evaluate(Span<const double> operands,
+                                          Span<const double> variables) const;
+        };
+
+    public:
+        /** Default Expression constructor.
+
+            @return     empty Expression without variables
+        */
+        Expression() = default;
+
+        /** Expression constructor with variables.
+
+            Throws std::invalid_argument if a name is given more than once.
+
+            @param  variables   names of the variables
+            @return             empty Expression
+        */
+        explicit Expression(const std::vector<std::string>& variables);
+
+        /** Functions for appending an instruction to the code.
+
+            pushOperator(OpCode::Select) throws std::invalid_argument if
+            its operands do not end with Then and Else.
+
+            @param  value       constant
+            @param  index       index of the variable
+            @param  op          operator, one of Negate to Select
+            @param  name        name of the function
+            @param  function    function
+            @param  batch       vectorized version of function, nullptr if none
+            @param  array       vectorized version without accuracy, nullptr if none
+            @param  count       number of arguments, at least 1
+            @param  kind        sum, product or integral
+            @param  body        body with one more variable, one with the same
+                                name is named '#' and its index in body
+        */
+        void pushConstant(double value);
+        void pushVariable(std::uint32_t index);
+        void pushOperator(OpCode op);
+        void pushFunction(std::string_view name, func_type function,
+                          Kernel::func_type batch = nullptr, batch_type array = nullptr);
+        void pushVariadic(std::string_view name, variadic_type function, std::uint32_t count);
+        void pushReduction(std::string_view name, Reduction::Kind kind, Expression body);
+
+        /** Function for setting a vectorized version of an operator.
+
+            Used by evaluateBatch and evaluateLanes instead of the built-in
+            operator when at least one operand has a value per row, a
+            single value is repeated for the whole block. evaluate always
+            uses the built-in operator, so with Kernel::Accuracy::Exact
+            batch must give the same results.
+
+            Throws std::invalid_argument if op is not one of Add to Power.
+
+            @param  op      operator, one of Add to Power
+            @param  batch   vectorized version of op, nullptr for the built-in one
+        */
+        void setBatchOperator(OpCode op, Kernel::binary_type batch);
+
+        /** Retrieve the vectorized version of an operator.
+
+            @param  op      operator
+            @return         vectorized version, nullptr if the built-in one is used
+        */
+        [[nodiscard]] Kernel::binary_type batchOperator(OpCode op) const noexcept;
+
+        /** Function for evaluating the expression.
+
+            Only the branch of if(c, a, b) that is taken is evaluated.
+
+            Throws std::invalid_argument if the number of values does not
+            match the number of variables.
+
+            @param  variables   values of the variables
+            @return             resulting value
+        */
+        [[nodiscard]] double evaluate(Span<const double> variables = {}) const;
+
+        /** Function for evaluating the expression for many values at once.
+
+            Row i uses columns[v][i] as the value of variable v and the
+            result is written to results[i]. The rows are evaluated in
+            blocks small enough for the intermediate results to stay in
+            the L1 cache (see blockSize), one instruction at a time for
+            the whole block with SIMD (see Simd.hpp). Variables are read
+            directly from the columns and constant operands are never
+            expanded into blocks.
+
+            A column with a single value is used for every row, the same
+            way as a constant.
+
+            Both branches of if(c, a, b) are evaluated for the whole block
+            and the results are picked lane by lane with a mask, so there
+            are no branches that depend on the values.
+
+            With Kernel::Accuracy::Exact the results are identical to
+            calling evaluate for every row. Fast uses the SIMD kernels for
+            functions that have them (see Kernel.hpp). Functions and
+            operators with a vectorized version are called once per block
+            (see pushFunction and setBatchOperator).
+
+            Throws std::invalid_argument if there is not one column per
+            variable or a column has another size than results or 1.
+
+            @param  columns     values of the variables, one column per variable
+            @param  results     results, one per row
+            @param  accuracy    accuracy of the functions
+        */
+        void evaluateBatch(Span<const Span<const double>> columns, Span<double> results,
+                           Kernel::Accuracy accuracy = Kernel::Accuracy::Exact) const;
+
+        /** Function for evaluating expressions with the same shape at once.
+
+            Like evaluateBatch, but the constants are the columns and the
+            variables are the same for all rows. Lane j uses constants[k][j]
+            as constant k, which evaluates the expressions that differ from
+            this one only in their constants (see sameShape) together, one
+            per SIMD lane. The results are identical to calling evaluate on
+            each of those expressions.
+
+            Throws std::invalid_argument if there is not one column per
+            constant, a column has another size than results or the number
+            of variables does not match.
+
+            @param  constants   values of the constants, one column per constant
+            @param  variables   values of the variables
+            @param  results     results, one per lane
+            @param  accuracy    accuracy of the functions
+        */
+        void evaluateLanes(Span<const Span<const double>> constants, Span<const double> variables,
+                           Span<double> results,
+                           Kernel::Accuracy accuracy = Kernel::Accuracy::Exact) const;
+
+        /** Function for checking if two expressions have the same shape.
+
+            Expressions have the same shape when they only differ in the
+            values of their constants, for example "2*x+1" and "3*x+0.5",
+            but not "2*x+1" and "x*2+1".
+
+            @param  other   expression to compare with
+            @return         true if the shapes are the same
+        */
+        [[nodiscard]] bool sameShape(const Expression& other) const noexcept;
+
+        /** Retrieve a hash of the shape.
+
+            Equal for expressions with the same shape (see sameShape).
+            Updated when the code is appended, so it is free to retrieve.
+
+            @return     hash value
+        */
+        [[nodiscard]] std::uint64_t shapeHash() const noexcept;
+
+        /** Retrieve the number of rows evaluated together by evaluateBatch.
+
+            Chosen so that the stack of blocks is about 16 KB, half of a
+            typical L1 data cache.
+
+            @return     rows per block
+        */
+        [[nodiscard]] std::size_t blockSize() const noexcept;
+
+        /** Retrieve the code.
+
+            @return     instructions in postfix order
+        */
+        [[nodiscard]] const std::vector<Instruction>& code() const noexcept;
+
+        [[nodiscard]] const std::vector<double>& constants() const noexcept;
+        [[nodiscard]] const std::vector<Function>& functions() const noexcept;
+        [[nodiscard]] const std::vector<Call>& variadics() const noexcept;
+        [[nodiscard]] const std::vector<Reduction>& reductions() const noexcept;
+
+        /** Retrieve the variables.
+
+            @return     names of the variables in their order
+        */
+        [[nodiscard]] const NameTable& variables() const noexcept;
+
+        /** Retrieve the number of variables.
+
+            @return     number of variables
+        */
+        [[nodiscard]] std::size_t variableCount() const noexcept;
+
+        /** Retrieve the largest number of values on the stack.
+
+            @return     stack size needed to evaluate
+        */
+        [[nodiscard]] std::size_t stackSize() const noexcept;
+
+        /** Retrieve if the code is a complete expression.
+
+            @return     true if the code leaves exactly one value and every
+                        Then and Else belongs to a Select
+        */
+        [[nodiscard]] bool complete() const noexcept;
+
+    private:
+        // Evaluates parts of the code on different threads.
+        friend class ParallelExpression;
+
+        void push(OpCode op, std::uint32_t index, std::size_t pops);
+        // Sets the number of instructions Then and Else skip.
+        void link();
+        // Runs code[begin, end), which must be a complete expression.
+        double run(std::size_t begin, std::size_t end, double* stack,
+                   const double* variables) const;
+
+    private:
+        std::vector<Instruction> m_code{};
+        std::vector<double> m_constants{};
+        std::vector<Function> m_functions{};
+        std::vector<Call> m_variadics{};
+        std::vector<Reduction> m_reductions{};
+        std::array<Kernel::binary_type, 5> m_operators{}; // Add to Power
+        NameTable m_variables{};
+        std::vector<std::uint32_t> m_starts{}; // first instruction of every value on the stack
+        std::size_t m_markers{0};              // Then and Else without a Select
+        std::size_t m_depth{0};
+        std::size_t m_stackSize{0};
+        std::uint64_t m_shapeHash{hashBasis};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_EXPRESSION_HPP
@@ -0,0 +1,175 @@
+//
+//  ExpressionCache.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_EXPRESSIONCACHE_HPP
+#define CALCEVAL_EXPRESSIONCACHE_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+
+// C++ Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CalcEval
+{
+    /** ExpressionCache class implementation.
+
+        Bounded cache of compiled expressions, keyed by the text with
+        whitespace removed where it does not separate tokens, so "1+ 2"
+        and " 1 + 2" are the same expression but "not x" and "notx" are
+        not. The variables are part of the key.
+
+        The entries are split over shards by the hash of the key. Every
+        shard has its own lock, lookups only take it shared, so they run
+        at the same time. When a shard is full, entries are evicted with
+        the CLOCK algorithm: a lookup marks its entry as used and the
+        hand evicts the first entry that has not been used since it last
+        passed.
+
+        The size is an estimate of the bytes used by the entries and
+        their keys. An expression larger than a shard is not stored.
+
+        A cache must only be used with one set of symbols, the key does
+        not include them.
+
+        Usage:
+            CalcEval::ExpressionCache cache{1 << 20};
+            auto expression = cache.find("x * 2", {"x"});
+            if (!expression)
+                expression = cache.insert("x * 2", {"x"}, compiler.compile("x * 2", {"x"}));
+    */
+    class ExpressionCache
+    {
+    public:
+        /** Statistics struct implementation.
+
+            The counters are updated without ordering, read them when no
+            other thread uses the cache for exact numbers.
+        */
+        struct Statistics
+        {
+            std::uint64_t hits;
+            std::uint64_t misses;
+            std::uint64_t evictions;
+            std::size_t entries;
+            std::size_t bytes;
+        };
+
+        /** Default number of shards.
+
+        */
+        static constexpr std::size_t defaultShards{16};
+
+    public:
+        /** ExpressionCache constructor with capacity and shards.
+
+            Throws std::invalid_argument if shards is 0.
+
+            @param  capacity    largest size in bytes
+            @param  shards      number of shards
+            @return             empty ExpressionCache
+        */
+        explicit ExpressionCache(std::size_t capacity, std::size_t shards = defaultShards);
+
+        ExpressionCache(const ExpressionCache&) = delete;
+        ExpressionCache& operator=(const ExpressionCache&) = delete;
+
+        /** Function for removing whitespace that does not separate tokens.
+
+            A run of whitespace becomes a single space between two
+            characters of names or numbers, and between a relation and =,
+            everything else is removed.
+
+            @param  str     expression
+            @return         canonical text
+        */
+        [[nodiscard]] static std::string canonical(std::string_view str);
+
+        /** Function for finding an expression.
+
+            Counts a hit or a miss.
+
+            @param  str         expression
+            @param  variables   names of the variables
+            @return             expression, nullptr if not cached
+        */
+        [[nodiscard]] std::shared_ptr<const Expression>
+        find(std::string_view str, const std::vector<std::string>& variables = {}) const;
+
+        /** Function for adding an expression.
+
+            Evicts entries until it fits. If another thread added the
+            same key first, that expression is kept and returned.
+
+            @param  str         expression
+            @param  variables   names of the variables
+            @param  expression  compiled str
+            @return             cached expression
+        */
+        std::shared_ptr<const Expression> insert(std::string_view str,
+                                                 const std::vector<std::string>& variables,
+                                                 Expression expression);
+
+        /** Function for removing every entry.
+
+            The counters are kept.
+        */
+        void clear();
+
+        /** Retrieve the counters and size.
+
+            @return     statistics
+        */
+        [[nodiscard]] Statistics statistics() const;
+
+        /** Retrieve the largest size in bytes.
+
+            @return     capacity
+        */
+        [[nodiscard]] std::size_t capacity() const noexcept;
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            std::shared_ptr<const Expression> expression;
+            std::size_t bytes;
+            mutable std::atomic<bool> used{false};
+        };
+
+        struct Shard
+        {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<std::uint64_t, std::size_t> index; // hash to slot
+            std::vector<std::unique_ptr<Entry>> slots;             // nullptr if free
+            std::vector<std::size_t> free;                         // free slots
+            std::size_t hand{0};
+            std::size_t bytes{0};
+            mutable std::atomic<std::uint64_t> hits{0};
+            mutable std::atomic<std::uint64_t> misses{0};
+            std::atomic<std::uint64_t> evictions{0};
+        };
+
+        static std::string key(std::string_view str, const std::vector<std::string>& variables);
+        void evict(Shard& shard, std::size_t bytes);
+
+    private:
+        std::size_t m_capacity;
+        std::vector<Shard> m_shards;
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_EXPRESSIONCACHE_HPP
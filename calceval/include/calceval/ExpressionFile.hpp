@@ -0,0 +1,261 @@
+//
+//  ExpressionFile.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_EXPRESSIONFILE_HPP
+#define CALCEVAL_EXPRESSIONFILE_HPP
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Error.hpp"
+#include "calceval/Expression.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/Span.hpp"
+#include "calceval/type/Standard.hpp"
+
+// C++ Headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+
+namespace CalcEval
+{
+    /** ExpressionFile class implementation.
+
+        Compiled expressions stored in a file that is mapped into memory
+        and evaluated where it is, so a large set of expressions is ready
+        without parsing or copying them again.
+
+        The file has a header followed by the records (one per expression
+        and one per body of a sum, product or integral), the functions,
+        the reductions, the instructions, the constants and the names.
+        Every section is aligned to 8 bytes and the instructions have the
+        layout of Instruction, which is what evaluate runs. Functions are
+        stored by name and number of arguments and looked up again when
+        the file is opened, the pointers are not stored.
+
+        The header has a format version, the byte order, a key of the
+        CalcType and the layout of Instruction, a hash of the sources and
+        checksums of itself and of the rest. Opening a file checks all of
+        them and every instruction, so a file that is damaged or written
+        by another version throws Error instead of being evaluated. load
+        then compiles the sources again and writes a new file.
+
+        Constants from the symbols of the Compiler are folded into the
+        code, so their values are part of the hash of the sources and load
+        rebuilds the file when one of them changes.
+
+        Usage:
+            auto file = CalcEval::ExpressionFile::load("cache.cef", sources, {"x"});
+            double value{file.evaluate(0, std::vector<double>{2.0})};
+    */
+    class ExpressionFile
+    {
+    public:
+        /** Function that compiles text with the variable x.
+
+            Used to look up the functions of a file, "name(x)" or
+            "name(x, x)" is compiled and the function of the result used.
+        */
+        using resolver_type = std::function<Expression(const std::string&)>;
+
+        /** Version of the format.
+
+            Increased when the layout of the file or the meaning of the
+            instructions changes, older files are then rebuilt.
+        */
+        static constexpr std::uint32_t formatVersion{1};
+
+    public:
+        /** ExpressionFile constructor with path, type, sources and resolver.
+
+            Maps the file and checks it. Throws Error if it can not be
+            read, is not valid, was written for another type or sources,
+            or uses a function that resolve can not find.
+
+            @param  path        path of the file
+            @param  type        name of the CalcType the file is for
+            @param  sources     hash of the sources (see sourceHash)
+            @param  resolve     function for looking up the functions
+            @return             opened ExpressionFile
+        */
+        ExpressionFile(std::string path, std::string_view type, std::uint64_t sources,
+                       const resolver_type& resolve);
+
+        ExpressionFile(ExpressionFile&&) noexcept;
+        ExpressionFile& operator=(ExpressionFile&&) noexcept;
+        ~ExpressionFile();
+
+        /** Function for writing expressions to a file.
+
+            The file is written next to path and then renamed, so a
+            reader never sees a partial file. Throws Error if it can not
+            be written.
+
+            @param  path            path of the file
+            @param  expressions     expressions to write
+            @param  type            name of the CalcType
+            @param  sources         hash of the sources (see sourceHash)
+        */
+        static void write(const std::string& path, const std::vector<Expression>& expressions,
+                          std::string_view type, std::uint64_t sources);
+
+        /** Function for hashing the sources of the expressions.
+
+            The constants of symbols are hashed by name and value, they
+            are folded into the code when compiling.
+
+            @param  sources     text of the expressions
+            @param  variables   names of the variables
+            @param  symbols     symbols of the Compiler, nullptr if none
+            @return             hash value
+        */
+        [[nodiscard]] static std::uint64_t
+        sourceHash(const std::vector<std::string>& sources,
+                   const std::vector<std::string>& variables,
+                   const SymbolTable<double>* symbols = nullptr);
+
+        /** Function for opening a file, or building it if it is not valid.
+
+            Opens the file at path if it was written from sources with
+            the same variables and CalcType. Otherwise the sources are
+            compiled with compiler, written to path and opened again.
+            Throws ParserError if a source can not be compiled and Error
+            if the file can not be written.
+
+            @param  path        path of the file
+            @param  sources     text of the expressions
+            @param  variables   names of the variables
+            @param  compiler    compiler for the sources
+            @return             opened ExpressionFile
+        */
+        template<typename CalcType = Type::Standard>
+        [[nodiscard]] static ExpressionFile load(const std::string& path,
+                                                 const std::vector<std::string>& sources,
+                                                 const std::vector<std::string>& variables = {},
+                                                 const Compiler<CalcType>& compiler = {})
+        {
+            const std::string type{typeid(CalcType).name()};
+            const std::uint64_t key{sourceHash(sources, variables, compiler.symbols().get())};
+            const resolver_type resolve = [&compiler](const std::string& str) {
+                return compiler.compile(str, {"x"});
+            };
+
+            try
+            {
+                return ExpressionFile{path, type, key, resolve};
+            }
+            catch (const Error&)
+            {
+                // Missing, damaged or out of date.
+            }
+
+            std::vector<Expression> expressions{};
+            expressions.reserve(sources.size());
+            for (const std::string& str : sources)
+                expressions.push_back(compiler.compile(str, variables));
+            write(path, expressions, type, key);
+
+            ExpressionFile file{path, type, key, resolve};
+            file.m_rebuilt = true;
+            return file;
+        }
+
+        /** Function for evaluating an expression in the file.
+
+            Runs the code in the mapped file, the results are identical to
+            Expression::evaluate.
+
+            Throws std::invalid_argument if there is no expression index
+            or the number of values does not match its variables.
+
+            @param  index       index of the expression
+            @param  variables   values of the variables
+            @return             resulting value
+        */
+        [[nodiscard]] double evaluate(std::size_t index, Span<const double> variables = {}) const;
+
+        /** Function for copying an expression out of the file.
+
+            For evaluateBatch and the other functions of Expression.
+            Throws std::invalid_argument if there is no expression index.
+
+            @param  index   index of the expression
+            @return         expression
+        */
+        [[nodiscard]] Expression expression(std::size_t index) const;
+
+        /** Retrieve the number of expressions.
+
+            @return     number of expressions
+        */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /** Retrieve the number of variables of an expression.
+
+            Throws std::invalid_argument if there is no expression index.
+
+            @param  index   index of the expression
+            @return         number of variables
+        */
+        [[nodiscard]] std::size_t variableCount(std::size_t index) const;
+
+        /** Retrieve the path of the file.
+
+            @return     path
+        */
+        [[nodiscard]] const std::string& path() const noexcept;
+
+        /** Retrieve the size of the file.
+
+            @return     size in bytes
+        */
+        [[nodiscard]] std::size_t bytes() const noexcept;
+
+        /** Retrieve if load built the file.
+
+            @return     true if the file was written by load
+        */
+        [[nodiscard]] bool rebuilt() const noexcept;
+
+    private:
+        struct Mapping;
+        struct Record;
+
+        const Record& record(std::size_t index) const;
+        // Checks the code of a record, bodies are the records of the reductions.
+        void validate(const Record& record, const std::vector<std::uint32_t>& bodies) const;
+        // Copies a record, the reductions before first are not built yet.
+        Expression materialize(const Record& record, std::size_t first) const;
+
+    private:
+        std::string m_path;
+        std::unique_ptr<Mapping> m_mapping;
+        const Record* m_records{nullptr};
+        const Instruction* m_code{nullptr};
+        const double* m_constants{nullptr};
+        const char* m_strings{nullptr};
+        std::size_t m_size{0};
+        std::size_t m_recordCount{0};
+        std::size_t m_codeCount{0};
+        std::size_t m_constantCount{0};
+        std::size_t m_stringBytes{0};
+        std::vector<Expression::Function> m_functions{}; // by function id, if no count
+        std::vector<Expression::Call> m_variadics{};     // by function id, count 0 if none
+        std::vector<Expression::Reduction> m_reductions{};
+        std::array<Kernel::binary_type, 5> m_operators{}; // Add to Power
+        bool m_rebuilt{false};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_EXPRESSIONFILE_HPP
@@ -0,0 +1,53 @@
+//
+//  Function.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_FUNCTION_HPP
+#define CALCEVAL_FUNCTION_HPP
+
+// Local Headers
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <limits>
+
+namespace CalcEval
+{
+    /** Variadic struct implementation.
+
+        A function that takes a list of arguments, for example max(a, b, c).
+        The parser collects the arguments into contiguous memory and calls
+        the function once with all of them.
+
+        The number of arguments is checked by the parser against minArgs
+        and maxArgs, so the function does not need to check it.
+    */
+    template<typename T>
+    struct Variadic
+    {
+        using func_type = T (*)(Span<const T>);
+
+        // Used as maxArgs when there is no upper limit.
+        static constexpr std::size_t unlimited{std::numeric_limits<std::size_t>::max()};
+
+        func_type function{nullptr};
+        std::size_t minArgs{1};
+        std::size_t maxArgs{unlimited};
+    };
+
+    /** Signature of a vectorized single-argument function.
+
+        Computes results[i] = f(values[i]) for i < count. results may be
+        the same memory as values (in-place), but must not partially
+        overlap.
+    */
+    template<typename T>
+    using BatchFunction = void (*)(const T* values, T* results, std::size_t count);
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_FUNCTION_HPP
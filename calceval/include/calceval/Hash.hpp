@@ -0,0 +1,52 @@
+//
+//  Hash.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_HASH_HPP
+#define CALCEVAL_HASH_HPP
+
+// C++ Headers
+#include <cstdint>
+#include <string_view>
+
+namespace CalcEval
+{
+    /** Offset basis for the 64-bit FNV-1a hash.
+
+        Used as the default seed for hash().
+    */
+    inline constexpr std::uint64_t hashBasis{14695981039346656037ull};
+
+    /** Function for hashing a string with 64-bit FNV-1a.
+
+        The seed replaces the offset basis, which makes it possible to
+        search for a seed that gives no collisions for a known set of
+        strings (see StaticTable).
+
+        @param  str     string to hash
+        @param  seed    initial hash value
+        @return         hash value
+    */
+    [[nodiscard]] constexpr std::uint64_t hash(std::string_view str,
+                                               std::uint64_t seed = hashBasis) noexcept
+    {
+        std::uint64_t h{seed};
+        for (const char c : str)
+        {
+            h ^= static_cast<std::uint8_t>(c);
+            h *= 1099511628211ull;
+        }
+
+        // Final avalanche so that the low bits depend on every byte.
+        h ^= h >> 29;
+        h *= 0xbf58476d1ce4e5b9ull;
+        h ^= h >> 32;
+        return h;
+    }
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_HASH_HPP
@@ -0,0 +1,152 @@
+//
+//  Interpreter.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_INTERPRETER_HPP
+#define CALCEVAL_INTERPRETER_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstddef>
+
+namespace CalcEval::Interpreter
+{
+    /** Function for running postfix code on a stack.
+
+        The loop of Expression::evaluate, shared with code that is not
+        stored in an Expression (see ExpressionFile). code[begin, end)
+        must be a complete expression and stack must have room for its
+        stack size. Constants and variables are indexed by the index of
+        the instruction, the calls by calls:
+
+            double function(std::uint32_t index, double x)
+            std::uint32_t arguments(const Instruction& instruction)
+            double variadic(std::uint32_t index, Span<const double> arguments)
+            double reduce(std::uint32_t index, Span<const double> operands,
+                          const double* variables)
+
+        where arguments gives the number of values popped by a Variadic
+        or Reduce instruction.
+
+        @param  code        instructions
+        @param  begin       first instruction to run
+        @param  end         one past the last instruction to run
+        @param  constants   constants of the code
+        @param  stack       stack to use
+        @param  variables   values of the variables
+        @param  calls       functions of the code
+        @return             resulting value
+    */
+    template<typename Calls>
+    [[nodiscard]] double run(const Instruction* code, std::size_t begin, std::size_t end,
+                             const double* constants, double* stack, const double* variables,
+                             const Calls& calls)
+    {
+        // top points one past the last value on the stack.
+        double* top{stack};
+        for (std::size_t k{begin}; k < end; ++k)
+        {
+            const Instruction& instruction{code[k]};
+            switch (instruction.op)
+            {
+                case OpCode::Constant:
+                    *top++ = constants[instruction.index];
+                    break;
+                case OpCode::Variable:
+                    *top++ = variables[instruction.index];
+                    break;
+                case OpCode::Negate:
+                    top[-1] = top[-1] * -1.0;
+                    break;
+                case OpCode::Add:
+                    --top;
+                    top[-1] = top[-1] + top[0];
+                    break;
+                case OpCode::Subtract:
+                    --top;
+                    top[-1] = top[-1] - top[0];
+                    break;
+                case OpCode::Multiply:
+                    --top;
+                    top[-1] = top[-1] * top[0];
+                    break;
+                case OpCode::Divide:
+                    --top;
+                    top[-1] = top[-1] / top[0];
+                    break;
+                case OpCode::Power:
+                    --top;
+                    top[-1] = std::pow(top[-1], top[0]);
+                    break;
+                case OpCode::Less:
+                    --top;
+                    top[-1] = (top[-1] < top[0]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::LessEqual:
+                    --top;
+                    top[-1] = (top[-1] <= top[0]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::Greater:
+                    --top;
+                    top[-1] = (top[-1] > top[0]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::GreaterEqual:
+                    --top;
+                    top[-1] = (top[-1] >= top[0]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::Equal:
+                    --top;
+                    top[-1] = (top[-1] == top[0]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::NotEqual:
+                    --top;
+                    top[-1] = (top[-1] != top[0]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::Then:
+                    // Skips a and Else if c is 0, the Select is reached after b.
+                    --top;
+                    if (*top == 0.0)
+                        k += instruction.index;
+                    break;
+                case OpCode::Else:
+                    k += instruction.index;
+                    break;
+                case OpCode::Select:
+                    break;
+                case OpCode::Function:
+                    top[-1] = calls.function(instruction.index, top[-1]);
+                    break;
+                case OpCode::Variadic:
+                {
+                    // The arguments are the values on top of the stack.
+                    const std::uint32_t count{calls.arguments(instruction)};
+                    top -= count;
+                    *top = calls.variadic(instruction.index, Span<const double>{top, count});
+                    ++top;
+                    break;
+                }
+                case OpCode::Reduce:
+                {
+                    const std::uint32_t count{calls.arguments(instruction)};
+                    top -= count;
+                    *top = calls.reduce(instruction.index, Span<const double>{top, count},
+                                        variables);
+                    ++top;
+                    break;
+                }
+            }
+        }
+
+        return stack[0];
+    }
+
+} // namespace CalcEval::Interpreter
+
+#endif // CALCEVAL_INTERPRETER_HPP
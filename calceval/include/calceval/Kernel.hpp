@@ -0,0 +1,94 @@
+//
+//  Kernel.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_KERNEL_HPP
+#define CALCEVAL_KERNEL_HPP
+
+// Local Headers
+#include "calceval/Span.hpp"
+
+namespace CalcEval::Kernel
+{
+    /** Accuracy of the kernels.
+
+        Exact calls the <cmath> function for every element, so the results
+        are identical to the scalar functions in Type::Standard.
+
+        Fast evaluates the elements with SIMD (see Simd.hpp) using
+        polynomial approximations after the ones in fdlibm. The error
+        compared to the correctly rounded result is at most (ULP = unit in
+        the last place):
+
+            Function | Max error | Domain of the SIMD path
+            ---      | ---       | ---
+            exp      | 1 ULP     | all
+            log      | 1 ULP     | all
+            log10    | 2 ULP     | all
+            sin      | 1 ULP     | |x| <= 2^19 * pi
+            cos      | 1 ULP     | |x| <= 2^19 * pi
+            tan      | 2 ULP     | |x| <= 2^19 * pi
+            arcsin   | 1 ULP     | all
+            arccos   | 1 ULP     | all
+            arctan   | 1 ULP     | all
+
+        Elements outside of the domain (also inf and NaN for sin, cos and
+        tan) are handed to <cmath>. Special values such as NaN, inf, zero
+        and arguments outside of the mathematical domain give the same
+        result as <cmath>, except that the sign of a NaN may differ.
+
+        The fast mode pays off with AVX2 or AVX-512, with only SSE2 a good
+        libm is about as fast (see the KernelBenchmark program).
+    */
+    enum class Accuracy
+    {
+        Exact,
+        Fast
+    };
+
+    /** Signature of the kernels.
+
+        Computes results[i] = f(values[i]) for every element in values.
+        results must have at least values.size() elements and may be the
+        same memory as values (in-place), but must not partially overlap.
+    */
+    using func_type = void (*)(Span<const double> values, Span<double> results, Accuracy accuracy);
+
+    /** Signature of the kernels of operators.
+
+        Computes results[i] = a[i] op b[i] for every element in a. b and
+        results must have at least a.size() elements, results may be the
+        same memory as a or b.
+    */
+    using binary_type = void (*)(Span<const double> a, Span<const double> b, Span<double> results,
+                                 Accuracy accuracy);
+
+    /** Kernels for the single-argument functions in Type::Standard.
+
+        Named after <cmath>, so arcsin is asin and so on.
+    */
+    void log(Span<const double> values, Span<double> results,
+             Accuracy accuracy = Accuracy::Fast) noexcept;
+    void log10(Span<const double> values, Span<double> results,
+               Accuracy accuracy = Accuracy::Fast) noexcept;
+    void exp(Span<const double> values, Span<double> results,
+             Accuracy accuracy = Accuracy::Fast) noexcept;
+    void sin(Span<const double> values, Span<double> results,
+             Accuracy accuracy = Accuracy::Fast) noexcept;
+    void cos(Span<const double> values, Span<double> results,
+             Accuracy accuracy = Accuracy::Fast) noexcept;
+    void tan(Span<const double> values, Span<double> results,
+             Accuracy accuracy = Accuracy::Fast) noexcept;
+    void asin(Span<const double> values, Span<double> results,
+              Accuracy accuracy = Accuracy::Fast) noexcept;
+    void acos(Span<const double> values, Span<double> results,
+              Accuracy accuracy = Accuracy::Fast) noexcept;
+    void atan(Span<const double> values, Span<double> results,
+              Accuracy accuracy = Accuracy::Fast) noexcept;
+
+} // namespace CalcEval::Kernel
+
+#endif // CALCEVAL_KERNEL_HPP
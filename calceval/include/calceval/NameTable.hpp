@@ -0,0 +1,106 @@
+//
+//  NameTable.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_NAMETABLE_HPP
+#define CALCEVAL_NAMETABLE_HPP
+
+// C++ Headers
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace CalcEval
+{
+    /** NameTable class implementation.
+
+        Maps names to dense indices (0, 1, 2, ...) in insertion order.
+
+        Names are interned into one contiguous buffer and looked up through
+        an open-addressing hash table with linear probing. The table is kept
+        at most half full, so the expected cost of a lookup does not depend
+        on the number of names.
+
+        A const NameTable is never modified, so it can be read from several
+        threads at the same time without locking.
+    */
+    class NameTable
+    {
+    public:
+        using index_type = std::uint32_t;
+
+    public:
+        /** Default NameTable constructor.
+
+            @return     empty NameTable
+        */
+        NameTable() = default;
+
+        /** Function for inserting a name.
+
+            If the name already exists the index of it is returned
+            and nothing is inserted.
+
+            @param  name    name to insert
+            @return         index of the name and true if it was inserted
+        */
+        std::pair<index_type, bool> insert(std::string_view name);
+
+        /** Function for finding the index of a name.
+
+            @param  name    name to search for
+            @return         index as an std::optional, std::nullopt if not found
+        */
+        [[nodiscard]] std::optional<index_type> find(std::string_view name) const noexcept;
+
+        /** Retrieve the name at index.
+
+            @param  index   index of the name
+            @return         name
+        */
+        [[nodiscard]] std::string_view name(index_type index) const noexcept;
+
+        /** Retrieve the number of names.
+
+            @return     number of names
+        */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /** Function to reserve space for count names.
+
+            @param  count   number of names
+        */
+        void reserve(std::size_t count);
+
+    private:
+        struct Slot
+        {
+            std::uint64_t hash;
+            index_type index;
+        };
+
+        struct Name
+        {
+            std::uint32_t offset;
+            std::uint32_t length;
+        };
+
+        static constexpr index_type emptySlot{0xffffffff};
+
+        void rehash(std::size_t slotCount);
+
+    private:
+        std::string m_arena{};
+        std::vector<Name> m_names{};
+        std::vector<Slot> m_slots{};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_NAMETABLE_HPP
@@ -0,0 +1,86 @@
+//
+//  Parallel.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_PARALLEL_HPP
+#define CALCEVAL_PARALLEL_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Kernel.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Span.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Function for evaluating many expressions in parallel.
+
+        The expressions are spread over the workers of pool. parse is
+        const and keeps its state in a ParserLogic of its own for every
+        call, so all workers use parser. results[i] is the value of
+        expressions[i], the order does not depend on which worker
+        evaluated it.
+
+        Throws the error (usually ParserError) of the first expression
+        that fails, the remaining expressions are still evaluated.
+
+        Usage:
+            CalcEval::ThreadPool pool{};
+            auto values = CalcEval::parallelEvaluate(pool, lines);
+
+        @param  pool            workers to use
+        @param  expressions     expressions to evaluate
+        @param  parser          parser to use
+        @return                 value of every expression, in the same order
+    */
+    template<typename CalcType = Type::Standard>
+    [[nodiscard]] std::vector<typename CalcType::value_type>
+    parallelEvaluate(ThreadPool& pool, const std::vector<std::string>& expressions,
+                     const Parser<CalcType>& parser = {})
+    {
+        std::vector<typename CalcType::value_type> results(expressions.size());
+
+        // Small chunks, so workers that got expensive expressions are
+        // relieved by stealing.
+        const std::size_t grain{std::max<std::size_t>(expressions.size() / (pool.size() * 32), 1)};
+        pool.parallelFor(expressions.size(), grain,
+                         [&](std::size_t begin, std::size_t end, std::size_t) {
+                             for (std::size_t i{begin}; i < end; ++i)
+                                 results[i] = parser.parse(expressions[i]);
+                         });
+
+        return results;
+    }
+
+    /** Function for evaluating a compiled expression for many rows in parallel.
+
+        Same as Expression::evaluateBatch, with the rows split into
+        chunks of whole blocks that are evaluated by the workers of pool.
+        The results are identical to evaluateBatch.
+
+        Throws std::invalid_argument if there is not one column per
+        variable or a column has another size than results.
+
+        @param  pool        workers to use
+        @param  expression  expression to evaluate
+        @param  columns     values of the variables, one column per variable
+        @param  results     results, one per row
+        @param  accuracy    accuracy of the functions
+    */
+    void parallelEvaluate(ThreadPool& pool, const Expression& expression,
+                          Span<const Span<const double>> columns, Span<double> results,
+                          Kernel::Accuracy accuracy = Kernel::Accuracy::Exact);
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_PARALLEL_HPP
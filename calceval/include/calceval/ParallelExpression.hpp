@@ -0,0 +1,137 @@
+//
+//  ParallelExpression.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_PARALLELEXPRESSION_HPP
+#define CALCEVAL_PARALLELEXPRESSION_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Span.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CalcEval
+{
+    /** ParallelExpression class implementation.
+
+        Evaluates a single very large Expression on several threads. The
+        operands of an operator, function or function with several
+        arguments are independent subtrees of the code. Chains such as
+        "a + b - c + ..." and "a * b / c * ..." are flattened so that all
+        their operands are independent, not only the last one. if(c, a, b)
+        is never split, it runs on one thread so that only the taken
+        branch is evaluated.
+
+        When created, the cost of every subtree is estimated from its
+        instructions. Only operators whose subtree costs at least the
+        threshold are split into tasks, smaller subtrees run as one piece
+        of code on the thread that takes them. Operands are given to the
+        ThreadPool in chunks of about threshold cost.
+
+        The operands are combined in one of two ways:
+            Sequential  in the original order, the result is identical to
+                        Expression::evaluate.
+            Pairwise    sums (chains of + and -) are reassociated into a
+                        fixed pairwise tree (see Reduce::pairwiseSum),
+                        which is more accurate for long sums. Products are
+                        still combined in order.
+        Both are deterministic, the tree only depends on the expression,
+        never on the number of threads or the scheduling.
+    */
+    class ParallelExpression
+    {
+    public:
+        enum class Association
+        {
+            Sequential,
+            Pairwise
+        };
+
+        /** Default cost of a subtree before it is split into tasks.
+
+            An arithmetic instruction costs 1, calls and powers more.
+        */
+        static constexpr std::uint64_t defaultThreshold{1 << 14};
+
+    public:
+        /** ParallelExpression constructor with expression.
+
+            Throws std::invalid_argument if the expression is not complete
+            or threshold is 0.
+
+            @param  expression  expression to evaluate
+            @param  threshold   smallest cost of a subtree that is split
+            @return             initialized ParallelExpression
+        */
+        explicit ParallelExpression(Expression expression,
+                                    std::uint64_t threshold = defaultThreshold);
+
+        /** Function for evaluating the expression.
+
+            Throws std::invalid_argument if the number of values does not
+            match the number of variables.
+
+            @param  pool            workers to use
+            @param  variables       values of the variables
+            @param  association     how operands of sums are combined
+            @return                 resulting value
+        */
+        [[nodiscard]] double evaluate(ThreadPool& pool, Span<const double> variables = {},
+                                      Association association = Association::Sequential) const;
+
+        /** Retrieve the expression.
+
+            @return     expression
+        */
+        [[nodiscard]] const Expression& expression() const noexcept;
+
+        /** Retrieve the number of operators that are split into tasks.
+
+            @return     number of split operators, 0 if evaluated on one thread
+        */
+        [[nodiscard]] std::size_t splitCount() const noexcept;
+
+    private:
+        // A subtree code[begin, end), evaluated by node if it is split.
+        struct Operand
+        {
+            std::uint32_t begin;
+            std::uint32_t end;
+            std::uint32_t node;
+            OpCode op; // how it is combined, Add or Multiply for the first operand
+        };
+
+        // A split operator, code[root] is the operator.
+        struct Node
+        {
+            std::size_t root;
+            std::vector<Operand> operands;
+            std::size_t grain;
+        };
+
+        static constexpr std::uint32_t noNode{0xffffffff};
+
+        std::uint32_t build(std::size_t root, std::size_t depth,
+                            const std::vector<std::uint32_t>& start,
+                            const std::vector<std::uint64_t>& cost);
+        double evaluate(ThreadPool& pool, const Node& node, const double* variables,
+                        Association association) const;
+
+    private:
+        Expression m_expression;
+        std::uint64_t m_threshold;
+        std::vector<Node> m_nodes{};
+        std::uint32_t m_root{noNode};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_PARALLELEXPRESSION_HPP
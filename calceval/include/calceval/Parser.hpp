@@ -9,9 +9,19 @@
 #define CALCEVAL_PARSER_HPP
 
 // Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ExpressionCache.hpp"
 #include "calceval/ParserLogic.hpp"
+#include "calceval/Planner.hpp"
 #include "calceval/type/Standard.hpp"
 
+// C++ Headers
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace CalcEval
 {
     template<typename CalcType = Type::Standard>
@@ -19,29 +29,146 @@ namespace CalcEval
     {
     public:
         using value_type = typename CalcType::value_type;
+        using symbols_type = std::shared_ptr<const SymbolTable<value_type>>;
 
     public:
         Parser() = default;
 
+        /** Parser constructor with symbols.
+
+            The symbols are looked up before the ones in CalcType.
+            Create them with Registry::freeze().
+
+            @param  symbols     symbols to use
+            @return             initialized Parser
+        */
+        explicit Parser(symbols_type symbols) : m_symbols{std::move(symbols)}
+        {
+        }
+
+        /** Parser constructor with symbols and planner.
+
+            @param  symbols     symbols to use, nullptr for none
+            @param  planner     planner used by plan(), see Planner::calibrate
+            @return             initialized Parser
+        */
+        Parser(symbols_type symbols, Planner planner)
+            : m_symbols{std::move(symbols)}, m_planner{std::move(planner)}
+        {
+        }
+
+        /** Parser constructor with symbols and a cache.
+
+            parse(str) keeps the compiled str in an ExpressionCache of
+            cacheBytes bytes, so a string that has been parsed before,
+            also with other whitespace, is only evaluated. Copies of the
+            Parser share the cache and can use it from several threads.
+
+            Only for CalcType that can be compiled, see
+            Type::isCompilable.
+
+            @param  symbols     symbols to use, nullptr for none
+            @param  cacheBytes  largest size of the cache in bytes
+            @return             initialized Parser
+        */
+        Parser(symbols_type symbols, std::size_t cacheBytes)
+            : m_symbols{std::move(symbols)}, m_cache{std::make_shared<ExpressionCache>(cacheBytes)}
+        {
+            static_assert(Type::isCompilable<CalcType>,
+                          "Only CalcType that can be compiled can be cached");
+        }
+
         value_type parse(std::istringstream& iss) const
         {
-            ParserLogic<CalcType> logic{iss};
+            ParserLogic<CalcType> logic{iss, m_symbols.get()};
             return logic.parse();
         }
 
         value_type parse(std::ifstream& ifs) const
         {
-            ParserLogic<CalcType> logic{ifs};
+            ParserLogic<CalcType> logic{ifs, m_symbols.get()};
             return logic.parse();
         }
 
         value_type parse(const std::string& str) const
         {
+            if constexpr (Type::isCompilable<CalcType>)
+            {
+                if (m_cache)
+                {
+                    std::shared_ptr<const Expression> expression{m_cache->find(str)};
+                    if (!expression)
+                        expression = m_cache->insert(
+                            str, {}, Compiler<CalcType>{m_symbols}.compile(str));
+                    return expression->evaluate();
+                }
+            }
+
             std::istringstream iss{str};
-            ParserLogic<CalcType> logic{iss};
+            ParserLogic<CalcType> logic{iss, m_symbols.get()};
             return logic.parse();
         }
 
+        /** Function for choosing how to evaluate an expression.
+
+            Estimates the cost of parsing, compiling and evaluating per
+            row, evaluating in batches and in parallel from the tokens
+            and functions of str, and picks the cheapest. Use the plan
+            with Planner::evaluate and plan.explain() for the reason.
+
+            Throws ScannerError if str can not be scanned and
+            std::invalid_argument if there are variables and CalcType
+            can not be compiled.
+
+            @param  str         expression
+            @param  variables   names of the variables
+            @param  rows        values of the variables per call
+            @param  calls       number of times it is evaluated
+            @return             plan
+        */
+        [[nodiscard]] Plan plan(const std::string& str,
+                                const std::vector<std::string>& variables = {},
+                                std::size_t rows = 1, std::size_t calls = 1) const
+        {
+            Workload workload{Workload::scan(str)};
+            workload.variables = variables.size();
+            workload.rows = rows;
+            workload.calls = calls;
+            workload.compilable = Type::isCompilable<CalcType>;
+            return m_planner.plan(workload);
+        }
+
+        /** Retrieve the planner used by plan().
+
+            @return     planner
+        */
+        [[nodiscard]] const Planner& planner() const noexcept
+        {
+            return m_planner;
+        }
+
+        /** Retrieve the cache used by parse(str).
+
+            @return     cache, nullptr if none
+        */
+        [[nodiscard]] const std::shared_ptr<ExpressionCache>& cache() const noexcept
+        {
+            return m_cache;
+        }
+
+        /** Retrieve the symbols used by the Parser.
+
+            @return     symbols, nullptr if none
+        */
+        [[nodiscard]] const symbols_type& symbols() const noexcept
+        {
+            return m_symbols;
+        }
+
+    private:
+        symbols_type m_symbols{};
+        Planner m_planner{};
+        std::shared_ptr<ExpressionCache> m_cache{};
     };
 
 } // namespace CalcEval
@@ -10,11 +10,18 @@
 
 // Local Headers
 #include "calceval/Error.hpp"
+#include "calceval/Registry.hpp"
 #include "calceval/Scanner.hpp"
+#include "calceval/type/Traits.hpp"
 
 // C++ Headers
 #include <fstream>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace CalcEval
 {
@@ -24,10 +31,28 @@ namespace CalcEval
         Throws ParserError when an error is encountered.
 
         Grammar is:
-        <expr> ::= <term><expr_tail>
+        <expr> ::= <conjunction><expr_tail>
 
-        <expr_tail> ::= +<term><expr_tail>
-            |   -<term><expr_tail>
+        <expr_tail> ::= or <conjunction><expr_tail>
+            |   <empty>
+
+        <conjunction> ::= <negation><conjunction_tail>
+
+        <conjunction_tail> ::= and <negation><conjunction_tail>
+            |   <empty>
+
+        <negation> ::= not <negation>
+            |   <comparison>
+
+        <comparison> ::= <arithmetic> <relation> <arithmetic>
+            |   <arithmetic>
+
+        <relation> ::= < | <= | > | >= | == | !=
+
+        <arithmetic> ::= <term><arithmetic_tail>
+
+        <arithmetic_tail> ::= +<term><arithmetic_tail>
+            |   -<term><arithmetic_tail>
             |   <empty>
 
         <term> ::= <factor><term_tail>
@@ -48,13 +73,54 @@ namespace CalcEval
             |   num
 
         <id> ::= function <value>
+            |   if ( <expr> , <expr> , <expr> )
+            |   variadic ( <args> )
+            |   sum ( index = <expr> , <expr> , <expr> )
+            |   prod ( index = <expr> , <expr> , <expr> )
+            |   integrate ( <expr> , variable , <expr> , <expr> <tolerance> )
+            |   index
             |   constant
+
+        <args> ::= <expr><args_tail>
+
+        <args_tail> ::= ,<expr><args_tail>
+            |   <empty>
+
+        <tolerance> ::= ,<expr>
+            |   <empty>
+
+        In sum and prod the index is the name before '=', anything else
+        is a call of the variadic sum or prod. The last <expr> is the body,
+        evaluated for index = a, a + 1, ... up to and including b. The
+        index hides a constant or an outer index with the same name in the
+        body, not in a and b. For double without its own operators the body is
+        compiled and evaluated by Series (see Series.hpp). Otherwise the
+        tokens of the body are replayed for every value of the index,
+        which requires a value_type that can be compared with <.
+
+        integrate is only available when the body can be compiled. The
+        first <expr> is the integrand of variable from a to b, integrated
+        by Quadrature (see Quadrature.hpp). The variable hides a constant
+        with the same name in the integrand.
+
+        Comparisons, and, or, not and if are available when value_type can
+        be compared with < and ==. Comparisons give 1 or 0, and a value is
+        true if it is not 0. and, or and if short-circuit: the side that
+        is not needed is parsed but not computed, so "if(x == 0, 0, 1/x)"
+        never divides by zero.
     */
+    template<typename CalcType>
+    class CompilerLogic;
+
     template<typename CalcType>
     class ParserLogic
     {
+        static_assert(Type::isCalcType<CalcType>,
+                      "CalcType must have value_type, stot, constant and function (see Type::Base)");
+
     public:
         using value_type = typename CalcType::value_type;
+        using func_type = typename Symbol<value_type>::func_type;
 
     public:
         /** Default ParserLogic constructor is disabled.
@@ -66,23 +132,27 @@ namespace CalcEval
 
         /** ParserLogic constructor with iss.
 
-            @param  iss     istringstream to use
-            @return         default initialized ParserLogic
+            @param  iss         istringstream to use
+            @param  symbols     optional symbols to use before CalcType
+            @return             default initialized ParserLogic
         */
-        explicit ParserLogic(std::istringstream& iss);
+        explicit ParserLogic(std::istringstream& iss,
+                             const SymbolTable<value_type>* symbols = nullptr);
 
         /** ParserLogic constructor with ifs.
 
-            @param  ifs     ifstream to use
-            @return         default initialized ParserLogic
+            @param  ifs         ifstream to use
+            @param  symbols     optional symbols to use before CalcType
+            @return             default initialized ParserLogic
         */
-        explicit ParserLogic(std::ifstream& ifs);
+        explicit ParserLogic(std::ifstream& ifs, const SymbolTable<value_type>* symbols = nullptr);
 
         /** Function for parsing the istream in the scanner.
 
-            A limitation is that the ParserLogic is limited to parse
-            a double and use a double. This can be improved in
-            the future though.
+            All arithmetic is done in value_type of CalcType. Operators
+            and pow are found through overload resolution, so a float
+            value_type is never promoted to double, unless CalcType
+            provides its own (see add below).
 
             @return     resulting value
         */
@@ -96,6 +166,14 @@ namespace CalcEval
         */
         void scan();
 
+        /** Function for looking at the token after m_token.
+
+            The token is scanned ahead of time, scan sets m_token to it.
+
+            @return     next token
+        */
+        const Token& peek();
+
         /** Function starting the expr.
 
             @return     resulting value
@@ -109,6 +187,44 @@ namespace CalcEval
         */
         value_type exprTail(value_type lhs);
 
+        /** Function for the conjunction.
+
+            @return     resulting value
+        */
+        value_type conjunction();
+
+        /** Function for the conjunction_tail.
+
+            @param  lhs     lhs of the conjunction
+            @return         resulting value
+        */
+        value_type conjunctionTail(value_type lhs);
+
+        /** Function for the negation.
+
+            @return     resulting value
+        */
+        value_type negation();
+
+        /** Function for the comparison.
+
+            @return     resulting value
+        */
+        value_type comparison();
+
+        /** Function for the arithmetic.
+
+            @return     resulting value
+        */
+        value_type arithmetic();
+
+        /** Function for the arithmetic_tail.
+
+            @param  lhs     lhs of the arithmetic
+            @return         resulting value
+        */
+        value_type arithmeticTail(value_type lhs);
+
         /** Function for the term.
 
             @return     resulting value
@@ -146,6 +262,111 @@ namespace CalcEval
         */
         value_type id();
 
+        /** Function for calling a function with several arguments.
+
+            Parses the argument list, m_token must be '(' when called.
+
+            @param  func    function to call
+            @return         resulting value
+        */
+        value_type call(const Variadic<value_type>& func);
+
+        /** Function for sum and prod over an index.
+
+            m_token must be the index, followed by '=', when called.
+
+            @param  name    sum or prod
+            @return         resulting value
+        */
+        value_type reduction(const std::string& name);
+
+        /** Function for integrate.
+
+            m_token must be the first token of the integrand when called.
+
+            @return         resulting value
+        */
+        value_type integral();
+
+        /** Function for if.
+
+            m_token must be the first token of the condition when called.
+
+            @return         value of the branch that is taken
+        */
+        value_type condition();
+
+        /** Function for checking if a value is true.
+
+            @param  val     value
+            @return         true if val is not 0
+        */
+        bool truth(const value_type& val) const;
+
+        /** Function for checking if m_token is a keyword.
+
+            @param  str     and, or or not
+            @return         true if m_token is the identifier str
+        */
+        bool keyword(const char* str) const;
+
+        /** Function for checking if a name is a keyword.
+
+            @param  str     name
+            @return         true if str is and, or, not or if
+        */
+        bool reserved(const std::string& str) const;
+
+        /** Function for collecting the tokens of a body.
+
+            @param  end     token that ends the body outside of parentheses
+            @return         tokens before end, followed by TokenType::EndMark
+        */
+        std::vector<Token> collect(TokenType end);
+
+        /** Functions for the arithmetic operators.
+
+            Calls the member function with the same name in CalcType if it
+            has one (see Type::hasAdd and friends), otherwise the built-in
+            operator or pow. Return lhs while a branch is skipped.
+
+            @param  lhs     left hand side
+            @param  rhs     right hand side
+            @return         resulting value
+        */
+        value_type add(value_type lhs, value_type rhs);
+        value_type subtract(value_type lhs, value_type rhs);
+        value_type multiply(value_type lhs, value_type rhs);
+        value_type divide(value_type lhs, value_type rhs);
+        value_type power(value_type lhs, value_type rhs);
+
+        /** Function for finding a constant in the symbols or CalcType.
+
+            @param  str     name of constant
+            @return         constant value as an std::optional
+        */
+        std::optional<value_type> constant(const std::string& str);
+
+        /** Function for finding a function in the symbols or CalcType.
+
+            @param  str     name of function
+            @return         function as an std::optional
+        */
+        std::optional<func_type> function(const std::string& str);
+
+        /** Function for finding a function with several arguments in the symbols or CalcType.
+
+            @param  str     name of function
+            @return         function as an std::optional
+        */
+        std::optional<Variadic<value_type>> variadic(const std::string& str);
+
+        /** Function for retrieving the line that is being scanned.
+
+            @return     scanned content after the last new line
+        */
+        std::string line() const;
+
         /** Function to throw an error.
 
             @param  token           token that caused the error
@@ -156,7 +377,23 @@ namespace CalcEval
     private:
         Scanner m_scanner;
         Token m_token{TokenType::EndMark, {0, 0}, ""};
+        std::optional<Token> m_ahead{}; // scanned by peek
         CalcType m_calcType{};
+        const SymbolTable<value_type>* m_symbols{nullptr};
+        std::vector<value_type> m_arguments{};
+
+        // Body of sum or prod that is replayed instead of scanned, and the
+        // values of the indices of the enclosing sums and prods.
+        const std::vector<Token>* m_replay{nullptr};
+        std::size_t m_next{0};
+        std::vector<std::pair<std::string, value_type>> m_locals{};
+
+        // Not 0 while parsing a side of and, or or if that is not taken,
+        // nothing is computed then.
+        std::size_t m_skip{0};
+
+        // The body is compiled when the Compiler would give the same result.
+        static constexpr bool compiledSeries{Type::isCompilable<CalcType>};
     };
 
     /** ParserError class implementation.
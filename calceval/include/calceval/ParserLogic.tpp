@@ -8,36 +8,76 @@
 #ifndef CALCEVAL_PARSERLOGIC_TPP
 #define CALCEVAL_PARSERLOGIC_TPP
 
+// Local Headers
+#include "calceval/CompilerLogic.hpp"
+#include "calceval/Quadrature.hpp"
+#include "calceval/Series.hpp"
+
 // C++ Headers
+#include <algorithm>
 #include <cmath>
-#include <functional>
+#include <string>
 #include <utility>
 
 namespace CalcEval
 {
     template<typename CalcType>
-    ParserLogic<CalcType>::ParserLogic(std::istringstream& iss) : m_scanner{iss}
+    ParserLogic<CalcType>::ParserLogic(std::istringstream& iss,
+                                       const SymbolTable<value_type>* symbols)
+        : m_scanner{iss}, m_symbols{symbols}
     {
     }
 
     template<typename CalcType>
-    ParserLogic<CalcType>::ParserLogic(std::ifstream& ifs) : m_scanner{ifs}
+    ParserLogic<CalcType>::ParserLogic(std::ifstream& ifs, const SymbolTable<value_type>* symbols)
+        : m_scanner{ifs}, m_symbols{symbols}
     {
     }
 
     template<typename CalcType>
     void ParserLogic<CalcType>::scan()
     {
+        if (m_replay)
+        {
+            // The last token is EndMark, it is repeated if scanned again.
+            m_token = (*m_replay)[std::min(m_next, m_replay->size() - 1)];
+            ++m_next;
+            return;
+        }
+
+        if (m_ahead)
+        {
+            m_token = std::move(*m_ahead);
+            m_ahead.reset();
+            return;
+        }
+
         do
         {
             m_token = m_scanner.scan();
         } while (m_token.type == TokenType::EndOfLine);
     }
 
+    template<typename CalcType>
+    const Token& ParserLogic<CalcType>::peek()
+    {
+        if (m_replay)
+            return (*m_replay)[std::min(m_next, m_replay->size() - 1)];
+
+        if (!m_ahead)
+        {
+            do
+            {
+                m_ahead = m_scanner.scan();
+            } while (m_ahead->type == TokenType::EndOfLine);
+        }
+        return *m_ahead;
+    }
+
     template<typename CalcType>
     typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::parse()
     {
-        value_type val{0.0};
+        value_type val{0};
         scan();
 
         if (m_token.type != TokenType::Bad)
@@ -53,33 +93,161 @@ namespace CalcEval
         return val;
     }
 
-    // <expr> ::= <term><expr_tail>
+    // <expr> ::= <conjunction><expr_tail>
     template<typename CalcType>
     typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::expr()
     {
-        const value_type lhs{term()};
+        const value_type lhs{conjunction()};
         return exprTail(lhs);
     }
 
-    // <expr_tail> ::= +<term><expr_tail>
-    //      |   -<term><expr_tail>
+    // <expr_tail> ::= or <conjunction><expr_tail>
     //      |   <empty>
     template<typename CalcType>
     typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::exprTail(value_type lhs)
+    {
+        if constexpr (Type::isOrdered<CalcType>)
+        {
+            if (keyword("or"))
+            {
+                // The right side is not needed if the left side is true.
+                const bool left{truth(lhs)};
+                scan();
+                m_skip += (left) ? 1 : 0;
+                const bool right{truth(conjunction())};
+                m_skip -= (left) ? 1 : 0;
+                return exprTail((left || right) ? value_type{1} : value_type{0});
+            }
+        }
+
+        return lhs;
+    }
+
+    // <conjunction> ::= <negation><conjunction_tail>
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::conjunction()
+    {
+        const value_type lhs{negation()};
+        return conjunctionTail(lhs);
+    }
+
+    // <conjunction_tail> ::= and <negation><conjunction_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type
+    ParserLogic<CalcType>::conjunctionTail(value_type lhs)
+    {
+        if constexpr (Type::isOrdered<CalcType>)
+        {
+            if (keyword("and"))
+            {
+                // The right side is not needed if the left side is false.
+                const bool left{truth(lhs)};
+                scan();
+                m_skip += (left) ? 0 : 1;
+                const bool right{truth(negation())};
+                m_skip -= (left) ? 0 : 1;
+                return conjunctionTail((left && right) ? value_type{1} : value_type{0});
+            }
+        }
+
+        return lhs;
+    }
+
+    // <negation> ::= not <negation>
+    //      |   <comparison>
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::negation()
+    {
+        if constexpr (Type::isOrdered<CalcType>)
+        {
+            if (keyword("not"))
+            {
+                scan();
+                return (truth(negation())) ? value_type{0} : value_type{1};
+            }
+        }
+
+        return comparison();
+    }
+
+    // <comparison> ::= <arithmetic> <relation> <arithmetic>
+    //      |   <arithmetic>
+    //
+    // <relation> ::= < | <= | > | >= | == | !=
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::comparison()
+    {
+        const value_type lhs{arithmetic()};
+
+        if constexpr (Type::isOrdered<CalcType>)
+        {
+            const TokenType relation{m_token.type};
+            if (relation >= TokenType::Less && relation <= TokenType::NotEqual)
+            {
+                scan();
+                const value_type rhs{arithmetic()};
+
+                // Only < and == are required, for double these are the
+                // same as the built-in operators, also for NaN.
+                bool result{false};
+                switch (relation)
+                {
+                    case TokenType::Less:
+                        result = lhs < rhs;
+                        break;
+                    case TokenType::LessEqual:
+                        result = lhs < rhs || lhs == rhs;
+                        break;
+                    case TokenType::Greater:
+                        result = rhs < lhs;
+                        break;
+                    case TokenType::GreaterEqual:
+                        result = rhs < lhs || lhs == rhs;
+                        break;
+                    case TokenType::Equal:
+                        result = lhs == rhs;
+                        break;
+                    default:
+                        result = !(lhs == rhs);
+                        break;
+                }
+
+                return (result) ? value_type{1} : value_type{0};
+            }
+        }
+
+        return lhs;
+    }
+
+    // <arithmetic> ::= <term><arithmetic_tail>
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::arithmetic()
+    {
+        const value_type lhs{term()};
+        return arithmeticTail(lhs);
+    }
+
+    // <arithmetic_tail> ::= +<term><arithmetic_tail>
+    //      |   -<term><arithmetic_tail>
+    //      |   <empty>
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type
+    ParserLogic<CalcType>::arithmeticTail(value_type lhs)
     {
         value_type val{lhs};
 
         if (m_token.type == TokenType::Plus)
         {
             scan();
-            val += term();
-            return exprTail(val);
+            val = add(val, term());
+            return arithmeticTail(val);
         }
         else if (m_token.type == TokenType::Minus)
         {
             scan();
-            val -= term();
-            return exprTail(val);
+            val = subtract(val, term());
+            return arithmeticTail(val);
         }
 
         return val;
@@ -104,13 +272,13 @@ namespace CalcEval
         if (m_token.type == TokenType::Multiply)
         {
             scan();
-            val *= factor();
+            val = multiply(val, factor());
             return termTail(val);
         }
         else if (m_token.type == TokenType::Divide)
         {
             scan();
-            val /= factor();
+            val = divide(val, factor());
             return termTail(val);
         }
 
@@ -131,7 +299,7 @@ namespace CalcEval
         }
 
         const value_type lhs{value()};
-        return factorTail(lhs) * multi;
+        return multiply(factorTail(lhs), multi);
     }
 
     // <factor_term> ::= ^-<value><factor_tail>
@@ -152,7 +320,7 @@ namespace CalcEval
                 multi = value_type{-1};
             }
 
-            val = pow(val, factorTail(value()) * multi);
+            val = power(val, multiply(factorTail(value()), multi));
         }
 
         return val;
@@ -194,6 +362,12 @@ namespace CalcEval
     }
 
     // <id> ::= function <value>
+    //      |   if ( <expr> , <expr> , <expr> )
+    //      |   variadic ( <args> )
+    //      |   sum ( index = <expr> , <expr> , <expr> )
+    //      |   prod ( index = <expr> , <expr> , <expr> )
+    //      |   integrate ( <expr> , variable , <expr> , <expr> [ , <expr> ] )
+    //      |   index
     //      |   constant
     template<typename CalcType>
     typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::id()
@@ -204,14 +378,18 @@ namespace CalcEval
             const std::string& str{token.value};
             scan();
 
-            // Expect a constant
+            // Expect an index or constant
             if (m_token.type != TokenType::LeftParen)
             {
-                if (auto constant = m_calcType.constant(str))
+                for (auto it = m_locals.rbegin(); it != m_locals.rend(); ++it)
+                    if (it->first == str)
+                        return it->second;
+
+                if (auto val = constant(str))
                 {
-                    return *constant;
+                    return *val;
                 }
-                else if (auto func = m_calcType.function(str))
+                else if (function(str) || variadic(str))
                 {
                     error(token, "constant, no such constant found\nDid you mean to call " + str + "(x)?");
                 }
@@ -221,19 +399,62 @@ namespace CalcEval
                 }
             }
 
+            if constexpr (Type::isOrdered<CalcType>)
+            {
+                if (str == "if")
+                {
+                    scan(); // '('
+                    return condition();
+                }
+            }
+
             // Is str a function?
-            if (auto func = m_calcType.function(str))
+            if (auto func = function(str))
             {
                 if (m_token.type == TokenType::LeftParen)
                 {
                     // Should be a valid function here.
                     // value() might fail, but that is a valid error.
-                     return (*func)(value());
+                    const value_type arg{value()};
+                    return (m_skip > 0) ? arg : (*func)(arg);
                 }
 
                 // it is a function but missing its starting parentheses.
                 error(m_token, "'(', function found");
             }
+
+            if constexpr (compiledSeries || Type::isOrdered<CalcType>)
+            {
+                if (str == "sum" || str == "prod")
+                {
+                    scan(); // '('
+
+                    // A name followed by '=' is the index, anything else
+                    // is an argument.
+                    if (m_token.type == TokenType::Identifier &&
+                        peek().type == TokenType::Assign)
+                        return reduction(str);
+                    else if (auto vfunc = variadic(str))
+                        return call(*vfunc);
+
+                    error(m_token, "index followed by '='");
+                }
+            }
+
+            if constexpr (compiledSeries)
+            {
+                if (str == "integrate" && !variadic(str))
+                {
+                    scan(); // '('
+                    return integral();
+                }
+            }
+
+            if (auto vfunc = variadic(str))
+            {
+                scan(); // '('
+                return call(*vfunc);
+            }
             else if (m_token.type == TokenType::LeftParen)
             {
                 // No function found, but has '(', so a function is expected.
@@ -248,23 +469,395 @@ namespace CalcEval
 
         // Neither error or function, since '(' is not found we expect a constant.
         error(m_token, "identifer");
-        return value_type{0.0};
+        return value_type{0};
     }
 
+    // <args> ::= <expr><args_tail>
+    //
+    // <args_tail> ::= ,<expr><args_tail>
+    //      |   <empty>
     template<typename CalcType>
-    void ParserLogic<CalcType>::error(const Token& token, const std::string& expected) const
+    typename ParserLogic<CalcType>::value_type
+    ParserLogic<CalcType>::call(const Variadic<value_type>& func)
     {
-        const std::string unexpectedMsg{"token of \"" + std::string{tokenStr(token.type)} + "\""};
-        const std::string expectedMsg{(!expected.empty()) ? "Expected " + expected + "!" : ""};
+        // Arguments of nested calls are pushed after these and removed
+        // before returning, so the arguments of this call stay contiguous.
+        const std::size_t start{m_arguments.size()};
+
+        m_arguments.push_back(expr());
+        while (m_token.type == TokenType::Comma)
+        {
+            if (m_arguments.size() - start >= func.maxArgs)
+            {
+                error(m_token, "')', at most " + std::to_string(func.maxArgs) + " argument(s)");
+            }
+
+            scan();
+            m_arguments.push_back(expr());
+        }
+
+        if (m_token.type != TokenType::RightParen)
+        {
+            error(m_token, "',' or ')'");
+        }
+
+        const std::size_t count{m_arguments.size() - start};
+        if (count < func.minArgs)
+        {
+            error(m_token, "',', at least " + std::to_string(func.minArgs) + " arguments");
+        }
+
+        scan();
+        const Span<const value_type> args{m_arguments.data() + start, count};
+        const value_type val{(m_skip > 0) ? args[0] : func.function(args)};
+        m_arguments.resize(start);
+        return val;
+    }
+
+    // index = <expr> , <expr> , <expr> )
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type
+    ParserLogic<CalcType>::reduction(const std::string& name)
+    {
+        const std::string index{m_token.value};
+        const bool isProduct{name == "prod"};
+        if (reserved(index))
+        {
+            error(m_token, "index, a name that is not a keyword");
+        }
+        scan();
+
+        // The bounds are outside of the scope of the index.
+        value_type bounds[2]{};
+        for (std::size_t k{0}; k < 2; ++k)
+        {
+            if (m_token.type != ((k == 0) ? TokenType::Assign : TokenType::Comma))
+            {
+                error(m_token, (k == 0) ? "'='" : "','");
+            }
+
+            scan();
+            bounds[k] = expr();
+        }
+
+        if (m_token.type != TokenType::Comma)
+        {
+            error(m_token, "','");
+        }
+        scan();
+
+        const std::vector<Token> body{collect(TokenType::RightParen)};
+        const Token close{m_token};
+
+        value_type result{(isProduct) ? value_type{1} : value_type{0}};
+        if constexpr (compiledSeries)
+        {
+            CompilerLogic<CalcType> logic{body, line(), {index}, m_symbols};
+            const Expression expression{logic.compile()};
+            if (m_skip == 0)
+                result = (isProduct) ? Series::product(expression, bounds[0], bounds[1])
+                                     : Series::sum(expression, bounds[0], bounds[1]);
+        }
+        else
+        {
+            const std::vector<Token>* replay{m_replay};
+            const std::size_t next{m_next};
+            m_replay = &body;
+            m_locals.emplace_back(index, bounds[0]);
+
+            const auto term = [this]() {
+                m_next = 0;
+                scan();
+                const value_type val{expr()};
+                if (m_token.type != TokenType::EndMark)
+                {
+                    error(m_token, "')'");
+                }
+                return val;
+            };
+
+            // A skipped body is parsed once, the index is not stepped.
+            if (m_skip > 0)
+                static_cast<void>(term());
+
+            const value_type one{m_calcType.stot("1")};
+            while (m_skip == 0 && !(bounds[1] < m_locals.back().second))
+            {
+                result = (isProduct) ? multiply(result, term()) : add(result, term());
+
+                // Stop if the index can no longer be stepped, as in a float
+                // above 2^24, instead of looping forever.
+                const value_type i{m_locals.back().second};
+                m_locals.back().second = add(i, one);
+                if (!(i < m_locals.back().second))
+                {
+                    error(close, "index that can be stepped to the last value");
+                }
+            }
+
+            m_locals.pop_back();
+            m_replay = replay;
+            m_next = next;
+        }
+
+        m_token = close;
+        scan();
+        return result;
+    }
+
+    // <expr> , variable , <expr> , <expr> [ , <expr> ] )
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::integral()
+    {
+        // The variable comes after the integrand, which is compiled when
+        // its name is known.
+        const std::vector<Token> body{collect(TokenType::Comma)};
+        scan();
+        if (m_token.type != TokenType::Identifier || reserved(m_token.value))
+        {
+            error(m_token, "variable, a name that is not a keyword");
+        }
+
+        CompilerLogic<CalcType> logic{body, line(), {m_token.value}, m_symbols};
+        const Expression integrand{logic.compile()};
+        scan();
+
+        value_type operands[3]{0, 0, Quadrature::defaultTolerance};
+        for (std::size_t i{0}; i < 2; ++i)
+        {
+            if (m_token.type != TokenType::Comma)
+            {
+                error(m_token, "','");
+            }
+
+            scan();
+            operands[i] = expr();
+        }
+
+        if (m_token.type == TokenType::Comma)
+        {
+            scan();
+            operands[2] = expr();
+        }
+
+        if (m_token.type != TokenType::RightParen)
+        {
+            error(m_token, "',' or ')'");
+        }
+
+        scan();
+        if (m_skip > 0)
+            return value_type{0};
+
+        return Quadrature::integrate(integrand, operands[0], operands[1], operands[2]).value;
+    }
+
+    // <expr> , <expr> , <expr> )
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::condition()
+    {
+        // The branch that is not taken is parsed with m_skip set.
+        const bool taken{truth(expr())};
+        value_type result{0};
+        for (const bool branch : {true, false})
+        {
+            if (m_token.type != TokenType::Comma)
+            {
+                error(m_token, "','");
+            }
+
+            scan();
+            m_skip += (branch == taken) ? 0 : 1;
+            const value_type val{expr()};
+            m_skip -= (branch == taken) ? 0 : 1;
+            if (branch == taken)
+                result = val;
+        }
+
+        if (m_token.type != TokenType::RightParen)
+        {
+            error(m_token, "')'");
+        }
+
+        scan();
+        return result;
+    }
+
+    template<typename CalcType>
+    bool ParserLogic<CalcType>::truth(const value_type& val) const
+    {
+        return !(val == value_type{0});
+    }
+
+    template<typename CalcType>
+    bool ParserLogic<CalcType>::keyword(const char* str) const
+    {
+        return m_token.type == TokenType::Identifier && m_token.value == str;
+    }
+
+    // The tokens up to end outside of parentheses, followed by EndMark.
+    template<typename CalcType>
+    std::vector<Token> ParserLogic<CalcType>::collect(TokenType end)
+    {
+        std::vector<Token> tokens{};
+        std::size_t depth{0};
+        while (depth > 0 || m_token.type != end)
+        {
+            if (m_token.type == TokenType::EndMark || m_token.type == TokenType::Bad ||
+                (depth == 0 && m_token.type == TokenType::RightParen))
+            {
+                error(m_token, (end == TokenType::Comma) ? "','" : "')'");
+            }
+
+            if (m_token.type == TokenType::LeftParen)
+                ++depth;
+            else if (m_token.type == TokenType::RightParen)
+                --depth;
 
+            tokens.push_back(m_token);
+            scan();
+        }
+
+        tokens.emplace_back(TokenType::EndMark, m_token.location, "");
+        return tokens;
+    }
+
+    template<typename CalcType>
+    bool ParserLogic<CalcType>::reserved(const std::string& str) const
+    {
+        if constexpr (Type::isOrdered<CalcType>)
+            return str == "and" || str == "or" || str == "not" || str == "if";
+        else
+            return false;
+    }
+
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::add(value_type lhs,
+                                                                          value_type rhs)
+    {
+        if (m_skip > 0)
+            return lhs;
+
+        if constexpr (Type::hasAdd<CalcType>)
+            return m_calcType.add(lhs, rhs);
+        else
+            return lhs + rhs;
+    }
+
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::subtract(value_type lhs,
+                                                                               value_type rhs)
+    {
+        if (m_skip > 0)
+            return lhs;
+
+        if constexpr (Type::hasSubtract<CalcType>)
+            return m_calcType.subtract(lhs, rhs);
+        else
+            return lhs - rhs;
+    }
+
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::multiply(value_type lhs,
+                                                                               value_type rhs)
+    {
+        if (m_skip > 0)
+            return lhs;
+
+        if constexpr (Type::hasMultiply<CalcType>)
+            return m_calcType.multiply(lhs, rhs);
+        else
+            return lhs * rhs;
+    }
+
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::divide(value_type lhs,
+                                                                             value_type rhs)
+    {
+        if (m_skip > 0)
+            return lhs;
+
+        if constexpr (Type::hasDivide<CalcType>)
+            return m_calcType.divide(lhs, rhs);
+        else
+            return lhs / rhs;
+    }
+
+    template<typename CalcType>
+    typename ParserLogic<CalcType>::value_type ParserLogic<CalcType>::power(value_type lhs,
+                                                                            value_type rhs)
+    {
+        if (m_skip > 0)
+            return lhs;
+
+        if constexpr (Type::hasPower<CalcType>)
+        {
+            return m_calcType.power(lhs, rhs);
+        }
+        else
+        {
+            // std::pow has overloads for all arithmetic types, other types
+            // can provide their own pow found by argument-dependent lookup.
+            using std::pow;
+            return pow(lhs, rhs);
+        }
+    }
+
+    template<typename CalcType>
+    std::optional<typename ParserLogic<CalcType>::value_type>
+    ParserLogic<CalcType>::constant(const std::string& str)
+    {
+        if (m_symbols)
+            if (m_symbols->symbol(str))
+                return m_symbols->constant(str);
+
+        return m_calcType.constant(str);
+    }
+
+    template<typename CalcType>
+    std::optional<typename ParserLogic<CalcType>::func_type>
+    ParserLogic<CalcType>::function(const std::string& str)
+    {
+        if (m_symbols)
+            if (m_symbols->symbol(str))
+                return m_symbols->function(str);
+
+        return m_calcType.function(str);
+    }
+
+    template<typename CalcType>
+    std::optional<Variadic<typename ParserLogic<CalcType>::value_type>>
+    ParserLogic<CalcType>::variadic(const std::string& str)
+    {
+        if (m_symbols)
+            if (m_symbols->symbol(str))
+                return m_symbols->variadic(str);
+
+        if constexpr (Type::hasVariadic<CalcType>)
+            return m_calcType.variadic(str);
+        else
+            return std::nullopt;
+    }
+
+    template<typename CalcType>
+    std::string ParserLogic<CalcType>::line() const
+    {
         const std::string content{m_scanner.scanned()};
         std::size_t start{0};
         const std::size_t findLast{content.find_last_of('\n')};
         if (findLast != std::string::npos)
             start = findLast + 1;
 
-        const std::string line{content.substr(start)};
-        throw ParserError(line, token.location, unexpectedMsg, expectedMsg, token);
+        return content.substr(start);
+    }
+
+    template<typename CalcType>
+    void ParserLogic<CalcType>::error(const Token& token, const std::string& expected) const
+    {
+        const std::string unexpectedMsg{"token of \"" + std::string{tokenStr(token.type)} + "\""};
+        const std::string expectedMsg{(!expected.empty()) ? "Expected " + expected + "!" : ""};
+
+        throw ParserError(line(), token.location, unexpectedMsg, expectedMsg, token);
     }
 
 } // namespace CalcEval
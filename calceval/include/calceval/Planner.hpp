@@ -0,0 +1,267 @@
+//
+//  Planner.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_PLANNER_HPP
+#define CALCEVAL_PLANNER_HPP
+
+// Local Headers
+#include "calceval/Registry.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Engine enum class implementation.
+
+        The ways an expression can be evaluated, from the cheapest to
+        start to the fastest per row.
+    */
+    enum class Engine : std::uint8_t
+    {
+        Parse,    // ParserLogic, parsed again for every evaluation
+        Compiled, // Compiler once, Expression::evaluate per row
+        Batch,    // Compiler once, Expression::evaluateBatch
+        Parallel  // Compiler once, parallelEvaluate on several threads
+    };
+
+    /** Function for converting the Engine to a string format.
+
+        @param  engine  Engine to convert
+        @return         string format of Engine
+    */
+    [[nodiscard]] constexpr std::string_view engineStr(Engine engine)
+    {
+        switch (engine)
+        {
+            case Engine::Parse:
+                return "parse";
+            case Engine::Compiled:
+                return "compiled";
+            case Engine::Batch:
+                return "batch";
+            case Engine::Parallel:
+                return "parallel";
+        }
+        return "unknown";
+    }
+
+    /** Workload struct implementation.
+
+        What the planner knows about an evaluation. The tokens stand in
+        for the number of instructions of the compiled code.
+    */
+    struct Workload
+    {
+        std::size_t tokens{0};
+        std::size_t functions{0};
+        std::size_t variables{0};
+        std::size_t rows{1};
+        std::size_t calls{1};
+        bool compilable{true};
+
+        /** Function for counting the tokens and functions of str.
+
+            Every name followed by a left parenthesis is a function.
+            Throws ScannerError if str can not be scanned.
+
+            @param  str     expression
+            @return         workload with tokens and functions set
+        */
+        [[nodiscard]] static Workload scan(const std::string& str);
+    };
+
+    /** Plan struct implementation.
+
+        The engine and number of threads chosen for a workload, with the
+        estimated cost of every engine, in nanoseconds. The cost is
+        infinity for an engine that can not be used and the one of
+        Engine::Parallel is for the chosen number of threads, or the
+        largest one if another engine is chosen.
+    */
+    struct Plan
+    {
+        Engine engine{Engine::Parse};
+        std::size_t threads{1};
+        std::size_t parallelThreads{1};
+        Workload workload{};
+        std::array<double, 4> costs{};
+
+        /** Function for describing the plan.
+
+            One line with the choice and the workload followed by one
+            line with the estimated cost of every engine.
+
+            @return     description
+        */
+        [[nodiscard]] std::string explain() const;
+    };
+
+    /** Planner class implementation.
+
+        Chooses the engine and number of threads for a workload from a
+        cost model. With n tokens, f functions, r rows and c calls:
+
+            parse       c * (n * parseToken + f * function)
+            compiled    n * compileToken + c * r * (n * instruction + f * function)
+            batch       n * compileToken
+                        + c * (call + r * (n * batchInstruction + f * batchFunction))
+            parallel    as batch with the rows split over t threads, plus
+                        t * threadStart per call
+
+        An expression without variables has the same value for every
+        row, it is evaluated once. Only double can be compiled, other
+        types are always parsed and can not have variables.
+
+        The costs are measured on the host with calibrate(), which takes
+        a few milliseconds. They can be saved with toString() and read
+        back with fromString(), so it does not have to run every time.
+
+        Usage:
+            const CalcEval::Planner planner{CalcEval::Planner::calibrate()};
+            const CalcEval::Plan plan{planner.plan(workload)};
+            std::cout << plan.explain() << '\n';
+            CalcEval::Planner::evaluate(plan, "x*y + sin(x)", {"x", "y"}, columns, results);
+    */
+    class Planner
+    {
+    public:
+        using symbols_type = std::shared_ptr<const SymbolTable<double>>;
+
+        /** Costs struct implementation.
+
+            Measured costs in nanoseconds, per token and row where it
+            applies.
+        */
+        struct Costs
+        {
+            double parseToken;
+            double compileToken;
+            double instruction;
+            double batchInstruction;
+            double function;
+            double batchFunction;
+            double call;
+            double threadStart;
+        };
+
+        /** Costs used without calibration, measured on a laptop.
+
+        */
+        static constexpr Costs defaultCosts{60.0, 250.0, 4.0, 0.8, 20.0, 8.0, 300.0, 25000.0};
+
+        /** Fewest rows per thread of Engine::Parallel.
+
+            Rows are split in whole blocks (see Expression::blockSize).
+        */
+        static constexpr std::size_t minimumRows{1024};
+
+    public:
+        /** Default Planner constructor.
+
+            Uses defaultCosts and one thread per core.
+
+            @return     initialized Planner
+        */
+        Planner();
+
+        /** Planner constructor with costs and threads.
+
+            Throws std::invalid_argument if a cost is negative or not
+            finite.
+
+            @param  costs       costs to use
+            @param  threads     largest number of threads, 0 for one per core
+            @return             initialized Planner
+        */
+        explicit Planner(const Costs& costs, std::size_t threads = 0);
+
+        /** Function for measuring the costs on this host.
+
+            Runs a micro-benchmark of every engine. The thread start is
+            only measured when threads is more than one.
+
+            @param  threads     largest number of threads, 0 for one per core
+            @return             calibrated Planner
+        */
+        [[nodiscard]] static Planner calibrate(std::size_t threads = 0);
+
+        /** Function for reading a Planner written by toString().
+
+            Throws std::invalid_argument if str is not a Planner.
+
+            @param  str     text of the Planner
+            @return         Planner
+        */
+        [[nodiscard]] static Planner fromString(const std::string& str);
+
+        /** Function for choosing the engine for a workload.
+
+            Throws std::invalid_argument if the workload has variables
+            but can not be compiled.
+
+            @param  workload    workload to plan
+            @return             cheapest plan
+        */
+        [[nodiscard]] Plan plan(const Workload& workload) const;
+
+        /** Function for evaluating an expression for every row with a plan.
+
+            results[i] is the value for row i of the columns, the same for
+            every engine. Engine::Parallel creates a ThreadPool with the
+            threads of the plan.
+
+            Throws std::invalid_argument if there is not one column per
+            variable, a column has another size than results or the plan
+            is Engine::Parse with variables. Throws ParserError for the
+            same errors as Parser.
+
+            @param  plan        plan to use
+            @param  str         expression
+            @param  variables   names of the variables
+            @param  columns     values of the variables, one column per variable
+            @param  results     results, one per row
+            @param  symbols     symbols to use
+        */
+        static void evaluate(const Plan& plan, const std::string& str,
+                             const std::vector<std::string>& variables,
+                             Span<const Span<const double>> columns, Span<double> results,
+                             const symbols_type& symbols = nullptr);
+
+        /** Function for writing the costs and threads.
+
+            @return     name=value pairs separated by spaces
+        */
+        [[nodiscard]] std::string toString() const;
+
+        /** Retrieve the costs.
+
+            @return     costs
+        */
+        [[nodiscard]] const Costs& costs() const noexcept;
+
+        /** Retrieve the largest number of threads.
+
+            @return     number of threads
+        */
+        [[nodiscard]] std::size_t threads() const noexcept;
+
+    private:
+        Costs m_costs;
+        std::size_t m_threads;
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_PLANNER_HPP
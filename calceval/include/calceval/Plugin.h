@@ -0,0 +1,100 @@
+/*
+ *  Plugin.h
+ *  CalcEval
+ *
+ *  Created by Robin Gustafsson on 2026-10-18.
+ */
+
+/*  C interface of a function plugin.
+
+    A plugin is a shared object that exports calceval_plugin_entry, which
+    returns a description of its functions and constants. Only C types
+    are used, so a plugin can be built with any compiler, or another
+    language, as long as it follows the C calling convention.
+
+    Minimal plugin:
+
+        #include "calceval/Plugin.h"
+
+        static double twice(double x) { return 2.0 * x; }
+
+        static void twiceBatch(const double* in, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out[i] = 2.0 * in[i];
+        }
+
+        static const calceval_function functions[] = {{"twice", twice, twiceBatch}};
+        static const calceval_plugin plugin = {
+            CALCEVAL_PLUGIN_ABI, "example", functions, 1, NULL, 0};
+
+        CALCEVAL_PLUGIN_EXPORT const calceval_plugin* calceval_plugin_entry(void)
+        {
+            return &plugin;
+        }
+
+    The returned description and the names in it must stay valid until
+    the plugin is unloaded. The functions may be called from several
+    threads at the same time.
+*/
+
+#ifndef CALCEVAL_PLUGIN_H
+#define CALCEVAL_PLUGIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Version of the structs below, changed when they change. */
+#define CALCEVAL_PLUGIN_ABI 1
+
+/* Name of the exported function. */
+#define CALCEVAL_PLUGIN_ENTRY "calceval_plugin_entry"
+
+#if defined(_WIN32)
+#define CALCEVAL_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define CALCEVAL_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/* f(x) for a single value. */
+typedef double (*calceval_scalar_fn)(double x);
+
+/* out[i] = f(in[i]) for i < n. out may be the same memory as in. */
+typedef void (*calceval_batch_fn)(const double* in, double* out, size_t n);
+
+/* A single-argument function, batch is NULL if there is none. */
+typedef struct calceval_function
+{
+    const char* name;
+    calceval_scalar_fn scalar;
+    calceval_batch_fn batch;
+} calceval_function;
+
+typedef struct calceval_constant
+{
+    const char* name;
+    double value;
+} calceval_constant;
+
+typedef struct calceval_plugin
+{
+    uint32_t abi;
+    const char* name;
+    const calceval_function* functions;
+    size_t function_count;
+    const calceval_constant* constants;
+    size_t constant_count;
+} calceval_plugin;
+
+/* Signature of calceval_plugin_entry. */
+typedef const calceval_plugin* (*calceval_plugin_entry_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CALCEVAL_PLUGIN_H */
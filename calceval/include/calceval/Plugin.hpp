@@ -0,0 +1,103 @@
+//
+//  Plugin.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_PLUGIN_HPP
+#define CALCEVAL_PLUGIN_HPP
+
+// Local Headers
+#include "calceval/Plugin.h"
+#include "calceval/Registry.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <string>
+
+namespace CalcEval
+{
+    /** Plugin class implementation.
+
+        A shared object with functions and constants for double, loaded
+        at runtime through the C interface in Plugin.h. addTo() adds them
+        to a Registry, so they are used like any other symbol. A batch
+        version of a function is called by Expression::evaluateBatch once
+        per column instead of the scalar version once per element.
+
+        The shared object is unloaded when the Plugin is destroyed, so the
+        Plugin must outlive every Registry, SymbolTable and Expression
+        that uses its functions.
+
+        Usage:
+            const CalcEval::Plugin plugin{"./libcurves.so"};
+            CalcEval::Registry<double> registry{};
+            plugin.addTo(registry);
+            const CalcEval::Parser parser{registry.freeze()};
+    */
+    class Plugin
+    {
+    public:
+        /** Plugin constructor with path.
+
+            Throws Error if the shared object can not be loaded, does not
+            export calceval_plugin_entry, has another ABI version or
+            describes a function without a name or scalar version.
+
+            @param  path    path of the shared object
+            @return         loaded Plugin
+        */
+        explicit Plugin(std::string path);
+
+        Plugin(const Plugin&) = delete;
+        Plugin& operator=(const Plugin&) = delete;
+        Plugin(Plugin&& other) noexcept;
+        Plugin& operator=(Plugin&& other) noexcept;
+        ~Plugin() noexcept;
+
+        /** Function for adding the functions and constants to registry.
+
+            Throws std::invalid_argument if a name is not valid or
+            already exists in registry.
+
+            @param  registry    registry to add to
+        */
+        void addTo(Registry<double>& registry) const;
+
+        /** Retrieve the name the plugin gives itself.
+
+            @return     name
+        */
+        [[nodiscard]] std::string name() const;
+
+        /** Retrieve the path the plugin was loaded from.
+
+            @return     path
+        */
+        [[nodiscard]] const std::string& path() const noexcept;
+
+        /** Retrieve the number of functions.
+
+            @return     number of functions
+        */
+        [[nodiscard]] std::size_t functionCount() const noexcept;
+
+        /** Retrieve the number of constants.
+
+            @return     number of constants
+        */
+        [[nodiscard]] std::size_t constantCount() const noexcept;
+
+    private:
+        void unload() noexcept;
+
+    private:
+        std::string m_path;
+        void* m_handle{nullptr};
+        const calceval_plugin* m_plugin{nullptr};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_PLUGIN_HPP
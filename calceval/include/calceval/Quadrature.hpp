@@ -0,0 +1,75 @@
+//
+//  Quadrature.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_QUADRATURE_HPP
+#define CALCEVAL_QUADRATURE_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cstddef>
+
+namespace CalcEval::Quadrature
+{
+    /** Adaptive integration, integrate(body, x, a, b, tolerance).
+
+        Every interval is integrated with the 15-point Gauss-Kronrod rule,
+        the difference to the embedded 7-point Gauss rule is the estimated
+        error. The nodes of all intervals that are integrated in a round
+        are evaluated with Expression::evaluateBatch, in chunks spread
+        over the workers of ThreadPool::shared().
+
+        After a round, every interval whose error is larger than its share
+        of the tolerance, in proportion to its width, is halved. This is
+        repeated until the sum of the errors is within the tolerance,
+        relative to the result or absolute when the result is smaller than
+        1. The intervals and the order in which they are summed only depend
+        on the body and the bounds, so the result is the same whatever the
+        number of threads.
+
+        The error is an estimate, a feature of the integrand that lies
+        between the nodes of an interval, such as a narrow peak, can be
+        missed. Bounds that are not finite and a tolerance that is not
+        positive give NaN.
+    */
+    inline constexpr double defaultTolerance{1e-10};
+
+    /** Largest number of intervals, refinement stops before it is reached.
+
+    */
+    inline constexpr std::size_t maxIntervals{1 << 16};
+
+    /** Result struct implementation.
+
+    */
+    struct Result
+    {
+        double value;
+        double error;
+        std::size_t intervals;
+    };
+
+    /** Function for integrating body from a to b.
+
+        @param  body        expression with variables followed by the variable
+                            of integration
+        @param  a           lower bound
+        @param  b           upper bound
+        @param  tolerance   requested error
+        @param  variables   values of the variables before the variable of
+                            integration
+        @return             integral, estimated error and number of intervals
+    */
+    [[nodiscard]] Result integrate(const Expression& body, double a, double b,
+                                   double tolerance = defaultTolerance,
+                                   Span<const double> variables = {});
+
+} // namespace CalcEval::Quadrature
+
+#endif // CALCEVAL_QUADRATURE_HPP
@@ -0,0 +1,322 @@
+//
+//  Reduce.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_REDUCE_HPP
+#define CALCEVAL_REDUCE_HPP
+
+// Local Headers
+#include "calceval/Simd.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace CalcEval::Reduce
+{
+    /** Reductions over a span of doubles.
+
+        Spans with at least simdThreshold elements are reduced with SIMD
+        (see Simd.hpp) using four independent accumulators, shorter spans
+        with a plain loop. Because the SIMD path adds in a different order,
+        sum() and mean() of long spans can differ from a left to right sum
+        in the last bits.
+
+        min() and max() return NaN if any element is NaN.
+        All functions expect at least one element.
+
+        Spans of floats are reduced with a plain loop with four
+        accumulators and never leave float.
+    */
+    inline constexpr std::size_t simdThreshold{4 * Simd::width * 2};
+
+    namespace Detail
+    {
+        // combine folds a pack of values into an accumulator, merge folds two
+        // accumulators and finish folds the lanes of an accumulator. NaN is
+        // tracked separately when TrackNaN is set since min and max lose it.
+        template<bool TrackNaN, typename Combine, typename Merge, typename Finish, typename Scalar>
+        inline double reduce(Span<const double> values, double init, Combine combine, Merge merge,
+                             Finish finish, Scalar scalar) noexcept
+        {
+            const double* ptr{values.data()};
+            const std::size_t n{values.size()};
+            std::size_t i{0};
+            double result{init};
+
+            if (n >= simdThreshold)
+            {
+                const Simd::Pack start{Simd::broadcast(init)};
+                Simd::Pack acc0{start}, acc1{start}, acc2{start}, acc3{start};
+                Simd::Mask nan{Simd::noLanes()};
+
+                constexpr std::size_t step{4 * Simd::width};
+                for (; i + step <= n; i += step)
+                {
+                    const Simd::Pack a{Simd::load(ptr + i)};
+                    const Simd::Pack b{Simd::load(ptr + i + Simd::width)};
+                    const Simd::Pack c{Simd::load(ptr + i + 2 * Simd::width)};
+                    const Simd::Pack d{Simd::load(ptr + i + 3 * Simd::width)};
+                    if constexpr (TrackNaN)
+                        nan = nan | Simd::isNaN(a) | Simd::isNaN(b) | Simd::isNaN(c) |
+                              Simd::isNaN(d);
+                    acc0 = combine(acc0, a);
+                    acc1 = combine(acc1, b);
+                    acc2 = combine(acc2, c);
+                    acc3 = combine(acc3, d);
+                }
+
+                if (Simd::any(nan))
+                    return std::numeric_limits<double>::quiet_NaN();
+
+                result = finish(merge(merge(acc0, acc1), merge(acc2, acc3)));
+            }
+
+            for (; i < n; ++i)
+                result = scalar(result, ptr[i]);
+
+            return result;
+        }
+
+        inline Simd::Pack add(Simd::Pack a, Simd::Pack b) noexcept
+        {
+            return a + b;
+        }
+
+        inline double sumLanes(Simd::Pack a) noexcept
+        {
+            const Simd::Lanes l{Simd::lanes(a)};
+            double result{l.v[0]};
+            for (std::size_t i{1}; i < Simd::width; ++i)
+                result += l.v[i];
+            return result;
+        }
+
+        // Plain loop over floats, four accumulators give the CPU independent
+        // chains and keep the rounding error lower than one accumulator.
+        template<typename Combine>
+        inline float reduce(Span<const float> values, float init, Combine combine) noexcept
+        {
+            const std::size_t n{values.size()};
+            float acc[4]{init, init, init, init};
+
+            std::size_t i{0};
+            for (; i + 4 <= n; i += 4)
+                for (std::size_t j{0}; j < 4; ++j)
+                    acc[j] = combine(acc[j], values[i + j]);
+
+            for (; i < n; ++i)
+                acc[0] = combine(acc[0], values[i]);
+
+            return combine(combine(acc[0], acc[1]), combine(acc[2], acc[3]));
+        }
+
+        inline float minOf(float a, float b) noexcept
+        {
+            return (std::isnan(b) || b < a) ? b : a;
+        }
+
+        inline float maxOf(float a, float b) noexcept
+        {
+            return (std::isnan(b) || b > a) ? b : a;
+        }
+
+    } // namespace Detail
+
+    /** Function for computing the sum.
+
+        @param  values  values to sum
+        @return         sum
+    */
+    inline double sum(Span<const double> values) noexcept
+    {
+        return Detail::reduce<false>(
+            values, 0.0, Detail::add, Detail::add, Detail::sumLanes,
+            [](double a, double b) { return a + b; });
+    }
+
+    /** Function for computing the smallest value.
+
+        @param  values  values
+        @return         smallest value, NaN if any value is NaN
+    */
+    inline double min(Span<const double> values) noexcept
+    {
+        const auto combine = [](Simd::Pack a, Simd::Pack b) { return Simd::min(a, b); };
+        return Detail::reduce<true>(
+            values, std::numeric_limits<double>::infinity(), combine, combine,
+            [](Simd::Pack a) {
+                const Simd::Lanes l{Simd::lanes(a)};
+                double result{l.v[0]};
+                for (std::size_t i{1}; i < Simd::width; ++i)
+                    result = (l.v[i] < result) ? l.v[i] : result;
+                return result;
+            },
+            [](double a, double b) { return (std::isnan(b) || b < a) ? b : a; });
+    }
+
+    /** Function for computing the largest value.
+
+        @param  values  values
+        @return         largest value, NaN if any value is NaN
+    */
+    inline double max(Span<const double> values) noexcept
+    {
+        const auto combine = [](Simd::Pack a, Simd::Pack b) { return Simd::max(a, b); };
+        return Detail::reduce<true>(
+            values, -std::numeric_limits<double>::infinity(), combine, combine,
+            [](Simd::Pack a) {
+                const Simd::Lanes l{Simd::lanes(a)};
+                double result{l.v[0]};
+                for (std::size_t i{1}; i < Simd::width; ++i)
+                    result = (l.v[i] > result) ? l.v[i] : result;
+                return result;
+            },
+            [](double a, double b) { return (std::isnan(b) || b > a) ? b : a; });
+    }
+
+    /** Function for computing the largest absolute value.
+
+        @param  values  values
+        @return         largest absolute value, NaN if any value is NaN
+    */
+    inline double maxAbs(Span<const double> values) noexcept
+    {
+        return Detail::reduce<true>(
+            values, 0.0, [](Simd::Pack a, Simd::Pack b) { return Simd::max(a, Simd::abs(b)); },
+            [](Simd::Pack a, Simd::Pack b) { return Simd::max(a, b); },
+            [](Simd::Pack a) {
+                const Simd::Lanes l{Simd::lanes(a)};
+                double result{l.v[0]};
+                for (std::size_t i{1}; i < Simd::width; ++i)
+                    result = (l.v[i] > result) ? l.v[i] : result;
+                return result;
+            },
+            [](double a, double b) {
+                return (std::isnan(b) || std::fabs(b) > a) ? std::fabs(b) : a;
+            });
+    }
+
+    /** Function for computing the sum of (value * scale)^2.
+
+        @param  values  values
+        @param  scale   scale applied to every value before squaring
+        @return         sum of squares
+    */
+    inline double sumOfSquares(Span<const double> values, double scale) noexcept
+    {
+        const Simd::Pack s{Simd::broadcast(scale)};
+        return Detail::reduce<false>(
+            values, 0.0,
+            [s](Simd::Pack a, Simd::Pack b) {
+                const Simd::Pack x{b * s};
+                return a + x * x;
+            },
+            Detail::add, Detail::sumLanes,
+            [scale](double a, double b) {
+                const double x{b * scale};
+                return a + x * x;
+            });
+    }
+
+    /** Number of values summed left to right by pairwiseSum.
+
+    */
+    inline constexpr std::size_t pairwiseBlock{8};
+
+    /** Function for computing the sum with pairwise summation.
+
+        The values are split in halves until at most pairwiseBlock remain,
+        which are summed left to right. The order of the additions only
+        depends on the number of values, so the halves can be summed by
+        different threads and the result is still the same. The rounding
+        error grows with log(n) instead of n.
+
+        @param  values  values to sum
+        @return         sum, 0 if there are no values
+    */
+    inline double pairwiseSum(Span<const double> values) noexcept
+    {
+        const std::size_t n{values.size()};
+        if (n <= pairwiseBlock)
+        {
+            double result{(n > 0) ? values[0] : 0.0};
+            for (std::size_t i{1}; i < n; ++i)
+                result += values[i];
+            return result;
+        }
+
+        const std::size_t half{n / 2};
+        return pairwiseSum(values.subspan(0, half)) + pairwiseSum(values.subspan(half, n - half));
+    }
+
+    /** Function for computing the sum of floats.
+
+        @param  values  values to sum
+        @return         sum
+    */
+    inline float sum(Span<const float> values) noexcept
+    {
+        return Detail::reduce(values, 0.0f, [](float a, float b) { return a + b; });
+    }
+
+    /** Function for computing the smallest float.
+
+        @param  values  values
+        @return         smallest value, NaN if any value is NaN
+    */
+    inline float min(Span<const float> values) noexcept
+    {
+        return Detail::reduce(values, values[0], Detail::minOf);
+    }
+
+    /** Function for computing the largest float.
+
+        @param  values  values
+        @return         largest value, NaN if any value is NaN
+    */
+    inline float max(Span<const float> values) noexcept
+    {
+        return Detail::reduce(values, values[0], Detail::maxOf);
+    }
+
+    /** Function for computing the largest absolute float.
+
+        @param  values  values
+        @return         largest absolute value, NaN if any value is NaN
+    */
+    inline float maxAbs(Span<const float> values) noexcept
+    {
+        return std::fabs(Detail::reduce(values, 0.0f, [](float a, float b) {
+            return Detail::maxOf(std::fabs(a), std::fabs(b));
+        }));
+    }
+
+    /** Function for computing the sum of (value * scale)^2 for floats.
+
+        @param  values  values
+        @param  scale   scale applied to every value before squaring
+        @return         sum of squares
+    */
+    inline float sumOfSquares(Span<const float> values, float scale) noexcept
+    {
+        float acc[4]{0.0f, 0.0f, 0.0f, 0.0f};
+        std::size_t i{0};
+        for (; i + 4 <= values.size(); i += 4)
+            for (std::size_t j{0}; j < 4; ++j)
+                acc[j] += (values[i + j] * scale) * (values[i + j] * scale);
+
+        for (; i < values.size(); ++i)
+            acc[0] += (values[i] * scale) * (values[i] * scale);
+
+        return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    }
+
+} // namespace CalcEval::Reduce
+
+#endif // CALCEVAL_REDUCE_HPP
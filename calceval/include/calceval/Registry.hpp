@@ -0,0 +1,333 @@
+//
+//  Registry.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_REGISTRY_HPP
+#define CALCEVAL_REGISTRY_HPP
+
+// Local Headers
+#include "calceval/Function.hpp"
+#include "calceval/NameTable.hpp"
+
+// C++ Headers
+#include <cctype>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Symbol struct implementation.
+
+        A constant, a function or a function with several arguments
+        stored in a SymbolTable.
+    */
+    template<typename T>
+    struct Symbol
+    {
+        using func_type = T (*)(T);
+        using batch_type = BatchFunction<T>;
+        using variadic_type = Variadic<T>;
+
+        enum class Kind : std::uint8_t
+        {
+            Constant,
+            Function,
+            Variadic
+        };
+
+        Kind kind{Kind::Constant};
+        T value{};
+        func_type function{nullptr};
+        batch_type batch{nullptr};
+        variadic_type variadic{};
+    };
+
+    template<typename T>
+    class Registry;
+
+    /** SymbolTable class implementation.
+
+        Immutable snapshot of the constants and functions in a Registry.
+
+        It is created by Registry::freeze() and is never modified after
+        that, so any number of threads can look up symbols in it at the
+        same time without locking. A lookup is one hash and (on average)
+        one probe, the cost does not grow with the number of symbols.
+    */
+    template<typename T>
+    class SymbolTable
+    {
+    public:
+        using value_type = T;
+        using func_type = typename Symbol<T>::func_type;
+        using batch_type = typename Symbol<T>::batch_type;
+        using variadic_type = typename Symbol<T>::variadic_type;
+
+    public:
+        /** Function for retrieving a constant by name.
+
+            @param  name    name of constant
+            @return         constant value as an std::optional
+        */
+        [[nodiscard]] std::optional<value_type> constant(std::string_view name) const noexcept
+        {
+            if (const Symbol<T>* symbol = find(name, Symbol<T>::Kind::Constant))
+                return symbol->value;
+
+            return std::nullopt;
+        }
+
+        /** Function for retrieving a function by name.
+
+            @param  name    name of function
+            @return         function as an std::optional
+        */
+        [[nodiscard]] std::optional<func_type> function(std::string_view name) const noexcept
+        {
+            if (const Symbol<T>* symbol = find(name, Symbol<T>::Kind::Function))
+                return symbol->function;
+
+            return std::nullopt;
+        }
+
+        /** Function for retrieving the vectorized version of a function.
+
+            @param  name    name of function
+            @return         batch function, nullptr if the function has none
+        */
+        [[nodiscard]] batch_type batchFunction(std::string_view name) const noexcept
+        {
+            if (const Symbol<T>* symbol = find(name, Symbol<T>::Kind::Function))
+                return symbol->batch;
+
+            return nullptr;
+        }
+
+        /** Function for retrieving a function with several arguments by name.
+
+            @param  name    name of function
+            @return         function as an std::optional
+        */
+        [[nodiscard]] std::optional<variadic_type> variadic(std::string_view name) const noexcept
+        {
+            if (const Symbol<T>* symbol = find(name, Symbol<T>::Kind::Variadic))
+                return symbol->variadic;
+
+            return std::nullopt;
+        }
+
+        /** Function for retrieving a symbol by name.
+
+            @param  name    name of symbol
+            @return         pointer to symbol, nullptr if not found
+        */
+        [[nodiscard]] const Symbol<T>* symbol(std::string_view name) const noexcept
+        {
+            if (auto index = m_names.find(name))
+                return &m_symbols[*index];
+
+            return nullptr;
+        }
+
+        /** Retrieve the interned names.
+
+            @return     names
+        */
+        [[nodiscard]] const NameTable& names() const noexcept
+        {
+            return m_names;
+        }
+
+        /** Retrieve the number of symbols.
+
+            @return     number of symbols
+        */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_symbols.size();
+        }
+
+    private:
+        friend class Registry<T>;
+
+        [[nodiscard]] const Symbol<T>* find(std::string_view name,
+                                            typename Symbol<T>::Kind kind) const noexcept
+        {
+            const Symbol<T>* found{symbol(name)};
+            return (found && found->kind == kind) ? found : nullptr;
+        }
+
+    private:
+        NameTable m_names{};
+        std::vector<Symbol<T>> m_symbols{};
+    };
+
+    /** Registry class implementation.
+
+        Collects constants and functions at runtime, for example when
+        loading them from a configuration at startup. A Registry is not
+        thread-safe, when registration is done freeze() creates an
+        immutable SymbolTable that can be attached to one or more Parser
+        objects and shared between threads.
+
+        Names must be valid identifiers for the Scanner (start with a
+        letter followed by letters or digits) and must be unique.
+        A name in a registry hides the same name in CalcType.
+    */
+    template<typename T>
+    class Registry
+    {
+    public:
+        using value_type = T;
+        using func_type = typename Symbol<T>::func_type;
+        using batch_type = typename Symbol<T>::batch_type;
+        using variadic_type = typename Symbol<T>::variadic_type;
+
+    public:
+        /** Default Registry constructor.
+
+            @return     empty Registry
+        */
+        Registry() = default;
+
+        /** Function for adding a constant.
+
+            Throws std::invalid_argument if the name is not valid or
+            already exists.
+
+            @param  name    name of constant
+            @param  value   value of constant
+        */
+        void addConstant(std::string_view name, value_type value)
+        {
+            Symbol<T> symbol{};
+            symbol.kind = Symbol<T>::Kind::Constant;
+            symbol.value = value;
+            add(name, symbol);
+        }
+
+        /** Function for adding a function.
+
+            Throws std::invalid_argument if the name is not valid,
+            already exists or if func is nullptr.
+
+            batch is an optional vectorized version of func, compiled
+            expressions call it once for a whole column instead of func
+            for every element (see Expression::evaluateBatch).
+
+            @param  name    name of function
+            @param  func    function
+            @param  batch   vectorized version of func, nullptr if none
+        */
+        void addFunction(std::string_view name, func_type func, batch_type batch = nullptr)
+        {
+            if (!func)
+                throw std::invalid_argument("Registry: function \"" + std::string{name} +
+                                            "\" is null");
+
+            Symbol<T> symbol{};
+            symbol.kind = Symbol<T>::Kind::Function;
+            symbol.function = func;
+            symbol.batch = batch;
+            add(name, symbol);
+        }
+
+        /** Function for adding a function with several arguments.
+
+            Throws std::invalid_argument if the name is not valid,
+            already exists, if func is nullptr or if minArgs > maxArgs.
+
+            @param  name        name of function
+            @param  func        function
+            @param  minArgs     least number of arguments
+            @param  maxArgs     most number of arguments
+        */
+        void addVariadic(std::string_view name, typename variadic_type::func_type func,
+                         std::size_t minArgs = 1,
+                         std::size_t maxArgs = variadic_type::unlimited)
+        {
+            if (!func)
+                throw std::invalid_argument("Registry: function \"" + std::string{name} +
+                                            "\" is null");
+            if (minArgs > maxArgs)
+                throw std::invalid_argument("Registry: function \"" + std::string{name} +
+                                            "\" has minArgs > maxArgs");
+
+            Symbol<T> symbol{};
+            symbol.kind = Symbol<T>::Kind::Variadic;
+            symbol.variadic = variadic_type{func, minArgs, maxArgs};
+            add(name, symbol);
+        }
+
+        /** Function to reserve space for count symbols.
+
+            @param  count   number of symbols
+        */
+        void reserve(std::size_t count)
+        {
+            m_table.m_names.reserve(count);
+            m_table.m_symbols.reserve(count);
+        }
+
+        /** Retrieve the number of symbols.
+
+            @return     number of symbols
+        */
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return m_table.size();
+        }
+
+        /** Function for creating an immutable snapshot of the registry.
+
+            The registry can still be modified afterwards, that does not
+            affect snapshots that have already been created.
+
+            @return     snapshot
+        */
+        [[nodiscard]] std::shared_ptr<const SymbolTable<T>> freeze() const
+        {
+            return std::make_shared<const SymbolTable<T>>(m_table);
+        }
+
+    private:
+        void add(std::string_view name, const Symbol<T>& symbol)
+        {
+            if (!validName(name))
+                throw std::invalid_argument("Registry: \"" + std::string{name} +
+                                            "\" is not a valid name");
+
+            if (!m_table.m_names.insert(name).second)
+                throw std::invalid_argument("Registry: \"" + std::string{name} +
+                                            "\" already exists");
+
+            m_table.m_symbols.push_back(symbol);
+        }
+
+        static bool validName(std::string_view name) noexcept
+        {
+            if (name.empty() || !std::isalpha(static_cast<unsigned char>(name.front())))
+                return false;
+
+            for (const char c : name)
+                if (!std::isalnum(static_cast<unsigned char>(c)))
+                    return false;
+
+            return true;
+        }
+
+    private:
+        SymbolTable<T> m_table{};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_REGISTRY_HPP
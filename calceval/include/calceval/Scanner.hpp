@@ -112,11 +112,11 @@ namespace CalcEval
         /** Function to read a symbol from the istream.
 
             There are predefined symbols in the definition.
-            Symbols must be a char.
+            Symbols are a char, or two for <=, >=, == and !=.
 
-            @return     char with associated TokenType, Bad if error
+            @return     symbol with associated TokenType, Bad if error
         */
-        std::optional<std::pair<char, TokenType>> readSymbol();
+        std::optional<std::pair<std::string, TokenType>> readSymbol();
 
         /** Function to throw an error.
 
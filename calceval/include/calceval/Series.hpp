@@ -0,0 +1,73 @@
+//
+//  Series.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_SERIES_HPP
+#define CALCEVAL_SERIES_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace CalcEval::Series
+{
+    /** Sums and products over an index, sum(i = a, b, body) and
+        prod(i = a, b, body).
+
+        The index takes the values a, a + 1, ... up to and including b.
+        The terms are evaluated in blocks of blockSize with
+        Expression::evaluateBatch, the blocks are spread over the workers
+        of ThreadPool::shared().
+
+        Within a block the terms are summed left to right with
+        compensation (Neumaier), or multiplied left to right. The results
+        of the blocks are combined in a pairwise tree. Both the blocks and
+        the tree only depend on the number of terms, so the result is the
+        same whatever the number of threads.
+
+        An empty range gives 0 for a sum and 1 for a product. Bounds that
+        are not finite or ranges with more than 2^53 terms give NaN.
+    */
+    inline constexpr std::size_t blockSize{4096};
+
+    /** Function for counting the terms.
+
+        @param  a   first index
+        @param  b   last index
+        @return     number of terms, std::nullopt if there is no valid range
+    */
+    [[nodiscard]] std::optional<std::uint64_t> count(double a, double b) noexcept;
+
+    /** Function for computing the sum of body over the index.
+
+        @param  body        expression with variables followed by the index
+        @param  a           first index
+        @param  b           last index
+        @param  variables   values of the variables before the index
+        @return             sum
+    */
+    [[nodiscard]] double sum(const Expression& body, double a, double b,
+                             Span<const double> variables = {});
+
+    /** Function for computing the product of body over the index.
+
+        @param  body        expression with variables followed by the index
+        @param  a           first index
+        @param  b           last index
+        @param  variables   values of the variables before the index
+        @return             product
+    */
+    [[nodiscard]] double product(const Expression& body, double a, double b,
+                                 Span<const double> variables = {});
+
+} // namespace CalcEval::Series
+
+#endif // CALCEVAL_SERIES_HPP
@@ -0,0 +1,256 @@
+//
+//  Session.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_SESSION_HPP
+#define CALCEVAL_SESSION_HPP
+
+// Local Headers
+#include "calceval/Error.hpp"
+#include "calceval/Expression.hpp"
+#include "calceval/Registry.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Session class implementation.
+
+        Names defined with "name = expr" that can be used by the other
+        definitions, in any order. Every definition is compiled once and
+        its value is kept, a definition is only evaluated again when a
+        name it uses gets another value.
+
+        The names a definition uses are the edges of a graph. Changing a
+        definition evaluates the definitions that depend on it, directly
+        or through other names, in topological order. When a value does
+        not change, the names after it are not evaluated because of it.
+        A definition that would depend on itself is rejected.
+
+        A definition that uses a name that is not defined, or that
+        depends on one without a value, has an error instead of a value
+        until the name is defined. Names are looked up before the
+        constants and functions of the symbols, so a definition can hide
+        those.
+
+        Usage:
+            CalcEval::Session session{};
+            session.define("rate", "0.05");
+            session.define("total", "1000 * (1 + rate)^10");
+            session.define("rate", "0.04"); // evaluates total again
+            double total{*session.value("total")};
+    */
+    class Session
+    {
+    public:
+        using symbols_type = std::shared_ptr<const SymbolTable<double>>;
+
+    public:
+        /** Session constructor with symbols.
+
+            @param  symbols     symbols to use, nullptr if none
+            @return             empty Session
+        */
+        explicit Session(symbols_type symbols = nullptr);
+
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+        /** Function for splitting "name = expr".
+
+            The = must not be part of ==, so "x == 1" is not an
+            assignment.
+
+            @param  line    line to split
+            @return         name and expression, std::nullopt if not an assignment
+        */
+        [[nodiscard]] static std::optional<std::pair<std::string, std::string>>
+        assignment(std::string_view line);
+
+        /** Function for defining a name, or changing its definition.
+
+            Throws std::invalid_argument if name is not a valid name or is
+            a keyword, ScannerError or ParserError if str can not be
+            compiled and Error if the definition would depend on itself.
+            The session is unchanged when it throws.
+
+            @param  name    name to define
+            @param  str     expression
+            @return         names with another value or error, in the order they were evaluated
+        */
+        std::vector<std::string> define(const std::string& name, const std::string& str);
+
+        /** Function for adding an expression without a name.
+
+            Like define, but key is not a valid name, so the expressions
+            can not use it. For example "#12" for line 12 of a file. The
+            value and error are retrieved with key.
+
+            Throws std::invalid_argument if key is empty or a valid name.
+
+            @param  key     key of the expression
+            @param  str     expression
+            @return         keys and names with another value or error, in evaluation order
+        */
+        std::vector<std::string> defineResult(const std::string& key, const std::string& str);
+
+        /** Function for defining a name or key, also when it has an error.
+
+            Like define and defineResult, but a definition that can not be
+            scanned or compiled is kept with the error. It is compiled
+            again when a name it uses is defined or removed, so the
+            result does not depend on the order of the definitions.
+
+            Throws std::invalid_argument for the same names as define
+            and Error if the definition would depend on itself, the
+            session is unchanged then.
+
+            @param  name    name or key to define
+            @param  str     expression
+            @return         names with another value or error, in the order they were evaluated
+        */
+        std::vector<std::string> keep(const std::string& name, const std::string& str);
+
+        /** Function for defining a name that has an error.
+
+            The name hides constants and functions like any other
+            definition, the definitions that use it get an error. For
+            example a definition that was rejected.
+
+            Throws std::invalid_argument for the same names as define.
+
+            @param  name    name to define
+            @param  error   error of the name
+            @return         names with another value or error, in the order they were evaluated
+        */
+        std::vector<std::string> defineError(const std::string& name, const std::string& error);
+
+        /** Function for removing a definition.
+
+            The definitions that use the name get an error.
+
+            @param  name    name or key to remove
+            @return         names with another value or error, in the order they were evaluated
+        */
+        std::vector<std::string> remove(const std::string& name);
+
+        /** Function for removing every definition.
+
+        */
+        void clear();
+
+        /** Function for evaluating an expression with the names.
+
+            Throws ScannerError or ParserError if str can not be compiled
+            and Error if it uses a name without a value.
+
+            @param  str     expression
+            @return         resulting value
+        */
+        [[nodiscard]] double evaluate(const std::string& str) const;
+
+        /** Retrieve the value of a name.
+
+            @param  name    name
+            @return         value, std::nullopt if not defined or it has an error
+        */
+        [[nodiscard]] std::optional<double> value(const std::string& name) const;
+
+        /** Retrieve the error of a name.
+
+            @param  name    name
+            @return         error, empty if it has a value or is not defined
+        */
+        [[nodiscard]] std::string error(const std::string& name) const;
+
+        /** Retrieve the definitions that use a name.
+
+            @param  name    name
+            @return         names and keys of the definitions that use name
+        */
+        [[nodiscard]] std::vector<std::string> users(const std::string& name) const;
+
+        /** Retrieve if a name is defined.
+
+            @param  name    name
+            @return         true if defined
+        */
+        [[nodiscard]] bool contains(const std::string& name) const;
+
+        /** Retrieve the number of definitions.
+
+            @return     number of definitions
+        */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /** Retrieve the number of times a definition was evaluated.
+
+            @return     evaluations since the Session was created
+        */
+        [[nodiscard]] std::uint64_t evaluations() const noexcept;
+
+    private:
+        struct Definition
+        {
+            std::string name;
+            std::string text;
+            std::vector<std::string> names;         // names used, sorted
+            std::vector<std::string> variables;     // of the expression
+            std::vector<const Definition*> inputs;  // of the variables, nullptr if not defined
+            std::optional<Expression> expression{}; // std::nullopt if not compiled or constant
+            double value{0.0};
+            std::string error{};
+            std::uint64_t visited{0}; // epoch of the last search
+            std::uint64_t changed{0}; // epoch of the last change
+        };
+
+        // Compile errors are kept in the definition if keep is true.
+        std::vector<std::string> assign(const std::string& name, const std::string& str,
+                                        bool keep);
+        // Replaces the definition of name, order is its dependents.
+        std::vector<std::string> replace(const std::string& name, const std::string& str,
+                                         std::vector<std::string> names,
+                                         std::optional<Expression> expression,
+                                         const std::string& error,
+                                         const std::vector<Definition*>& order);
+        // Names used by str, without the indices of sums and integrals where
+        // they are bound.
+        static std::vector<std::string> scan(const std::string& str);
+        bool known(const std::string& name) const;
+        std::vector<std::string> variables(const std::vector<std::string>& names) const;
+        // Dependents of name in topological order, marked as visited.
+        std::vector<Definition*> dependents(const std::string& name);
+        // Points the inputs to the definitions of the variables.
+        void connect(Definition& definition);
+        // Compiles the definition, keeps the error if it does not compile.
+        void link(Definition& definition);
+        // Sets the value, or the error if an input has no value.
+        void evaluate(Definition& definition);
+        // Evaluates the dependents that use a changed name.
+        void update(const std::vector<Definition*>& order, const std::string& name, bool relink,
+                    std::vector<std::string>& changed);
+
+    private:
+        symbols_type m_symbols;
+        std::unordered_map<std::string, Definition> m_definitions{};
+        std::unordered_map<std::string, std::vector<Definition*>> m_users{}; // by name used
+        std::vector<double> m_values{};
+        std::uint64_t m_epoch{0};
+        std::uint64_t m_evaluations{0};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_SESSION_HPP
@@ -0,0 +1,119 @@
+//
+//  ShapeGroups.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_SHAPEGROUPS_HPP
+#define CALCEVAL_SHAPEGROUPS_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Kernel.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Function for grouping expressions by shape.
+
+        Expressions in a group only differ in their constants (see
+        Expression::sameShape). The indices in a group are increasing and
+        the groups are ordered by their first index.
+
+        @param  expressions     expressions to group
+        @return                 indices into expressions, one vector per group
+    */
+    [[nodiscard]] std::vector<std::vector<std::size_t>>
+    groupByShape(Span<const Expression> expressions);
+
+    /** ShapeGroups class implementation.
+
+        Workloads such as parameter scans often consist of many
+        expressions that only differ in their numbers. ShapeGroups groups
+        them by shape once and keeps one expression and the constants of
+        all the others per group. Each group is then evaluated in lockstep
+        with Expression::evaluateLanes, one expression per SIMD lane,
+        instead of running the code once per expression.
+
+        The results are in the order of the expressions and identical to
+        evaluating them one by one.
+
+        Usage:
+            CalcEval::ShapeGroups groups{expressions};
+            std::vector<double> values{groups.evaluate(variables)};
+    */
+    class ShapeGroups
+    {
+    public:
+        /** Default ShapeGroups constructor.
+
+            @return     ShapeGroups without expressions
+        */
+        ShapeGroups() = default;
+
+        /** ShapeGroups constructor with expressions.
+
+            Throws std::invalid_argument if the expressions do not have the
+            same variables or one is not a complete expression.
+
+            @param  expressions     expressions to evaluate
+            @return                 initialized ShapeGroups
+        */
+        explicit ShapeGroups(Span<const Expression> expressions);
+
+        /** Function for evaluating all expressions.
+
+            Throws std::invalid_argument if the number of variables or
+            results does not match.
+
+            @param  variables   values of the variables, the same for all expressions
+            @param  results     value of every expression, in the same order
+            @param  accuracy    accuracy of the functions
+        */
+        void evaluate(Span<const double> variables, Span<double> results,
+                      Kernel::Accuracy accuracy = Kernel::Accuracy::Exact) const;
+
+        /** Function for evaluating all expressions.
+
+            @param  variables   values of the variables, the same for all expressions
+            @param  accuracy    accuracy of the functions
+            @return             value of every expression, in the same order
+        */
+        [[nodiscard]] std::vector<double>
+        evaluate(Span<const double> variables = {},
+                 Kernel::Accuracy accuracy = Kernel::Accuracy::Exact) const;
+
+        /** Retrieve the number of expressions.
+
+            @return     number of expressions
+        */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /** Retrieve the number of groups.
+
+            @return     number of different shapes
+        */
+        [[nodiscard]] std::size_t groupCount() const noexcept;
+
+    private:
+        struct Group
+        {
+            Expression expression;
+            std::vector<std::size_t> indices;
+            std::vector<double> constants; // constant k of lane j at k * lanes + j
+        };
+
+    private:
+        std::vector<Group> m_groups{};
+        std::size_t m_size{0};
+        std::size_t m_variableCount{0};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_SHAPEGROUPS_HPP
@@ -0,0 +1,816 @@
+//
+//  Simd.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_SIMD_HPP
+#define CALCEVAL_SIMD_HPP
+
+// C++ Headers
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(CALCEVAL_NO_SIMD)
+    // Scalar fallback requested.
+#elif defined(__AVX512F__)
+    #define CALCEVAL_SIMD_AVX512 1
+    #include <immintrin.h>
+#elif defined(__AVX2__) || defined(__AVX__)
+    #define CALCEVAL_SIMD_AVX 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CALCEVAL_SIMD_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+namespace CalcEval::Simd
+{
+    /** Pack of doubles in one SIMD register.
+
+        The widest instruction set enabled at compile time is used:
+        AVX-512 (8 lanes), AVX/AVX2 (4 lanes), SSE2 (2 lanes) or a
+        scalar fallback (1 lane). Enable a wider set with the compiler
+        flags (for example -mavx2 or -march=native).
+
+        Mask is the result of a lane-wise comparison and is used with any()
+        and select(), any() and all(). notEqual is true for NaN, the other
+        comparisons are false. Defining CALCEVAL_NO_SIMD forces the scalar fallback.
+
+        Besides the arithmetic, a few bit level helpers are provided for the
+        math kernels (see Kernel.hpp):
+            - round(a)      : nearest integer, ties to even
+            - pow2(n)       : 2^n for integers n in [-1022, 1023]
+            - exponent(a)   : unbiased exponent of a positive normal number
+            - fromBits(u)   : pack with all lanes set to the bit pattern u
+    */
+#if defined(CALCEVAL_SIMD_AVX512)
+    inline constexpr std::size_t width{8};
+    inline constexpr const char* name{"AVX-512"};
+
+    struct Pack
+    {
+        __m512d v;
+    };
+
+    struct Mask
+    {
+        __mmask8 m;
+    };
+
+    // The zero-masked intrinsics are used with all lanes set since GCC 12
+    // warns about an uninitialized value in some of the unmasked ones.
+    inline constexpr __mmask8 allLanes{0xff};
+
+    inline Pack load(const double* ptr) noexcept
+    {
+        return {_mm512_loadu_pd(ptr)};
+    }
+
+    inline void store(double* ptr, Pack a) noexcept
+    {
+        _mm512_storeu_pd(ptr, a.v);
+    }
+
+    inline Pack broadcast(double value) noexcept
+    {
+        return {_mm512_set1_pd(value)};
+    }
+
+    inline Pack operator+(Pack a, Pack b) noexcept
+    {
+        return {_mm512_add_pd(a.v, b.v)};
+    }
+
+    inline Pack operator-(Pack a, Pack b) noexcept
+    {
+        return {_mm512_sub_pd(a.v, b.v)};
+    }
+
+    inline Pack operator*(Pack a, Pack b) noexcept
+    {
+        return {_mm512_mul_pd(a.v, b.v)};
+    }
+
+    inline Pack operator/(Pack a, Pack b) noexcept
+    {
+        return {_mm512_div_pd(a.v, b.v)};
+    }
+
+    inline Pack mulAdd(Pack a, Pack b, Pack c) noexcept
+    {
+        return {_mm512_fmadd_pd(a.v, b.v, c.v)};
+    }
+
+    inline Pack sqrt(Pack a) noexcept
+    {
+        return {_mm512_maskz_sqrt_pd(allLanes, a.v)};
+    }
+
+    inline Pack round(Pack a) noexcept
+    {
+        return {_mm512_maskz_roundscale_pd(allLanes, a.v,
+                                           _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+    }
+
+    inline Pack fromBits(std::uint64_t bits) noexcept
+    {
+        return {_mm512_castsi512_pd(_mm512_set1_epi64(static_cast<long long>(bits)))};
+    }
+
+    inline Pack bitAnd(Pack a, Pack b) noexcept
+    {
+        return {_mm512_castsi512_pd(
+            _mm512_and_si512(_mm512_castpd_si512(a.v), _mm512_castpd_si512(b.v)))};
+    }
+
+    inline Pack bitOr(Pack a, Pack b) noexcept
+    {
+        return {_mm512_castsi512_pd(
+            _mm512_or_si512(_mm512_castpd_si512(a.v), _mm512_castpd_si512(b.v)))};
+    }
+
+    inline Pack bitXor(Pack a, Pack b) noexcept
+    {
+        return {_mm512_castsi512_pd(
+            _mm512_xor_si512(_mm512_castpd_si512(a.v), _mm512_castpd_si512(b.v)))};
+    }
+
+    inline Pack pow2(Pack n) noexcept
+    {
+        // n + 1023 ends up in the low bits of the mantissa.
+        const __m512d biased{_mm512_add_pd(n.v, _mm512_set1_pd(0x1p52 + 1023.0))};
+        const __m512i bits{_mm512_castpd_si512(biased)};
+        return {_mm512_castsi512_pd(_mm512_maskz_slli_epi64(allLanes, bits, 52))};
+    }
+
+    inline Pack exponent(Pack a) noexcept
+    {
+        const __m512i shifted{_mm512_maskz_srli_epi64(allLanes, _mm512_castpd_si512(a.v), 52)};
+        const __m512i bits{_mm512_or_si512(shifted, _mm512_set1_epi64(0x4330000000000000))};
+        return {_mm512_sub_pd(_mm512_castsi512_pd(bits), _mm512_set1_pd(0x1p52 + 1023.0))};
+    }
+
+    inline Pack min(Pack a, Pack b) noexcept
+    {
+        return {_mm512_maskz_min_pd(allLanes, a.v, b.v)};
+    }
+
+    inline Pack max(Pack a, Pack b) noexcept
+    {
+        return {_mm512_maskz_max_pd(allLanes, a.v, b.v)};
+    }
+
+    inline Pack abs(Pack a) noexcept
+    {
+        return {_mm512_castsi512_pd(
+            _mm512_and_si512(_mm512_castpd_si512(a.v), _mm512_set1_epi64(0x7fffffffffffffff)))};
+    }
+
+    inline Mask isNaN(Pack a) noexcept
+    {
+        return {_mm512_cmp_pd_mask(a.v, a.v, _CMP_UNORD_Q)};
+    }
+
+    inline Mask less(Pack a, Pack b) noexcept
+    {
+        return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ)};
+    }
+
+    inline Mask lessEqual(Pack a, Pack b) noexcept
+    {
+        return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ)};
+    }
+
+    inline Mask greater(Pack a, Pack b) noexcept
+    {
+        return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ)};
+    }
+
+    inline Mask equal(Pack a, Pack b) noexcept
+    {
+        return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ)};
+    }
+
+    inline Mask notEqual(Pack a, Pack b) noexcept
+    {
+        return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_NEQ_UQ)};
+    }
+
+    inline Pack select(Mask m, Pack a, Pack b) noexcept
+    {
+        return {_mm512_mask_blend_pd(m.m, b.v, a.v)};
+    }
+
+    inline Mask operator|(Mask a, Mask b) noexcept
+    {
+        return {static_cast<__mmask8>(a.m | b.m)};
+    }
+
+    inline Mask operator&(Mask a, Mask b) noexcept
+    {
+        return {static_cast<__mmask8>(a.m & b.m)};
+    }
+
+    inline bool any(Mask a) noexcept
+    {
+        return a.m != 0;
+    }
+
+    inline bool all(Mask a) noexcept
+    {
+        return a.m == 0xff;
+    }
+
+    inline Mask noLanes() noexcept
+    {
+        return {0};
+    }
+
+#elif defined(CALCEVAL_SIMD_AVX)
+    inline constexpr std::size_t width{4};
+    inline constexpr const char* name{"AVX"};
+
+    struct Pack
+    {
+        __m256d v;
+    };
+
+    struct Mask
+    {
+        __m256d m;
+    };
+
+    inline Pack load(const double* ptr) noexcept
+    {
+        return {_mm256_loadu_pd(ptr)};
+    }
+
+    inline void store(double* ptr, Pack a) noexcept
+    {
+        _mm256_storeu_pd(ptr, a.v);
+    }
+
+    inline Pack broadcast(double value) noexcept
+    {
+        return {_mm256_set1_pd(value)};
+    }
+
+    inline Pack operator+(Pack a, Pack b) noexcept
+    {
+        return {_mm256_add_pd(a.v, b.v)};
+    }
+
+    inline Pack operator-(Pack a, Pack b) noexcept
+    {
+        return {_mm256_sub_pd(a.v, b.v)};
+    }
+
+    inline Pack operator*(Pack a, Pack b) noexcept
+    {
+        return {_mm256_mul_pd(a.v, b.v)};
+    }
+
+    inline Pack operator/(Pack a, Pack b) noexcept
+    {
+        return {_mm256_div_pd(a.v, b.v)};
+    }
+
+    inline Pack mulAdd(Pack a, Pack b, Pack c) noexcept
+    {
+    #if defined(__FMA__)
+        return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+    #else
+        return {_mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v)};
+    #endif
+    }
+
+    inline Pack sqrt(Pack a) noexcept
+    {
+        return {_mm256_sqrt_pd(a.v)};
+    }
+
+    inline Pack round(Pack a) noexcept
+    {
+        return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+    }
+
+    inline Pack fromBits(std::uint64_t bits) noexcept
+    {
+        return {_mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(bits)))};
+    }
+
+    inline Pack bitAnd(Pack a, Pack b) noexcept
+    {
+        return {_mm256_and_pd(a.v, b.v)};
+    }
+
+    inline Pack bitOr(Pack a, Pack b) noexcept
+    {
+        return {_mm256_or_pd(a.v, b.v)};
+    }
+
+    inline Pack bitXor(Pack a, Pack b) noexcept
+    {
+        return {_mm256_xor_pd(a.v, b.v)};
+    }
+
+    namespace Detail
+    {
+        // 64-bit shifts, AVX without AVX2 only has them for 128 bits.
+        template<int Left, int Right>
+        inline __m256d shift(__m256d a) noexcept
+        {
+        #if defined(__AVX2__)
+            const __m256i bits{_mm256_castpd_si256(a)};
+            return _mm256_castsi256_pd(Left ? _mm256_slli_epi64(bits, Left)
+                                            : _mm256_srli_epi64(bits, Right));
+        #else
+            __m128i lo{_mm_castpd_si128(_mm256_castpd256_pd128(a))};
+            __m128i hi{_mm_castpd_si128(_mm256_extractf128_pd(a, 1))};
+            lo = Left ? _mm_slli_epi64(lo, Left) : _mm_srli_epi64(lo, Right);
+            hi = Left ? _mm_slli_epi64(hi, Left) : _mm_srli_epi64(hi, Right);
+            return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_castsi128_pd(lo)),
+                                        _mm_castsi128_pd(hi), 1);
+        #endif
+        }
+
+    } // namespace Detail
+
+    inline Pack pow2(Pack n) noexcept
+    {
+        // n + 1023 ends up in the low bits of the mantissa.
+        return {Detail::shift<52, 0>(_mm256_add_pd(n.v, _mm256_set1_pd(0x1p52 + 1023.0)))};
+    }
+
+    inline Pack exponent(Pack a) noexcept
+    {
+        const __m256d bits{_mm256_or_pd(Detail::shift<0, 52>(a.v), fromBits(0x4330000000000000).v)};
+        return {_mm256_sub_pd(bits, _mm256_set1_pd(0x1p52 + 1023.0))};
+    }
+
+    inline Pack min(Pack a, Pack b) noexcept
+    {
+        return {_mm256_min_pd(a.v, b.v)};
+    }
+
+    inline Pack max(Pack a, Pack b) noexcept
+    {
+        return {_mm256_max_pd(a.v, b.v)};
+    }
+
+    inline Pack abs(Pack a) noexcept
+    {
+        return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)};
+    }
+
+    inline Mask isNaN(Pack a) noexcept
+    {
+        return {_mm256_cmp_pd(a.v, a.v, _CMP_UNORD_Q)};
+    }
+
+    inline Mask less(Pack a, Pack b) noexcept
+    {
+        return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)};
+    }
+
+    inline Mask lessEqual(Pack a, Pack b) noexcept
+    {
+        return {_mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ)};
+    }
+
+    inline Mask greater(Pack a, Pack b) noexcept
+    {
+        return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)};
+    }
+
+    inline Mask equal(Pack a, Pack b) noexcept
+    {
+        return {_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)};
+    }
+
+    inline Mask notEqual(Pack a, Pack b) noexcept
+    {
+        return {_mm256_cmp_pd(a.v, b.v, _CMP_NEQ_UQ)};
+    }
+
+    inline Pack select(Mask m, Pack a, Pack b) noexcept
+    {
+        return {_mm256_blendv_pd(b.v, a.v, m.m)};
+    }
+
+    inline Mask operator|(Mask a, Mask b) noexcept
+    {
+        return {_mm256_or_pd(a.m, b.m)};
+    }
+
+    inline Mask operator&(Mask a, Mask b) noexcept
+    {
+        return {_mm256_and_pd(a.m, b.m)};
+    }
+
+    inline bool any(Mask a) noexcept
+    {
+        return _mm256_movemask_pd(a.m) != 0;
+    }
+
+    inline bool all(Mask a) noexcept
+    {
+        return _mm256_movemask_pd(a.m) == 0xf;
+    }
+
+    inline Mask noLanes() noexcept
+    {
+        return {_mm256_setzero_pd()};
+    }
+
+#elif defined(CALCEVAL_SIMD_SSE2)
+    inline constexpr std::size_t width{2};
+    inline constexpr const char* name{"SSE2"};
+
+    struct Pack
+    {
+        __m128d v;
+    };
+
+    struct Mask
+    {
+        __m128d m;
+    };
+
+    inline Pack load(const double* ptr) noexcept
+    {
+        return {_mm_loadu_pd(ptr)};
+    }
+
+    inline void store(double* ptr, Pack a) noexcept
+    {
+        _mm_storeu_pd(ptr, a.v);
+    }
+
+    inline Pack broadcast(double value) noexcept
+    {
+        return {_mm_set1_pd(value)};
+    }
+
+    inline Pack operator+(Pack a, Pack b) noexcept
+    {
+        return {_mm_add_pd(a.v, b.v)};
+    }
+
+    inline Pack operator-(Pack a, Pack b) noexcept
+    {
+        return {_mm_sub_pd(a.v, b.v)};
+    }
+
+    inline Pack operator*(Pack a, Pack b) noexcept
+    {
+        return {_mm_mul_pd(a.v, b.v)};
+    }
+
+    inline Pack operator/(Pack a, Pack b) noexcept
+    {
+        return {_mm_div_pd(a.v, b.v)};
+    }
+
+    inline Pack mulAdd(Pack a, Pack b, Pack c) noexcept
+    {
+        return {_mm_add_pd(_mm_mul_pd(a.v, b.v), c.v)};
+    }
+
+    inline Pack sqrt(Pack a) noexcept
+    {
+        return {_mm_sqrt_pd(a.v)};
+    }
+
+    inline Pack fromBits(std::uint64_t bits) noexcept
+    {
+        return {_mm_castsi128_pd(_mm_set1_epi64x(static_cast<long long>(bits)))};
+    }
+
+    inline Pack bitAnd(Pack a, Pack b) noexcept
+    {
+        return {_mm_and_pd(a.v, b.v)};
+    }
+
+    inline Pack bitOr(Pack a, Pack b) noexcept
+    {
+        return {_mm_or_pd(a.v, b.v)};
+    }
+
+    inline Pack bitXor(Pack a, Pack b) noexcept
+    {
+        return {_mm_xor_pd(a.v, b.v)};
+    }
+
+    inline Pack pow2(Pack n) noexcept
+    {
+        // n + 1023 ends up in the low bits of the mantissa.
+        const __m128i bits{_mm_castpd_si128(_mm_add_pd(n.v, _mm_set1_pd(0x1p52 + 1023.0)))};
+        return {_mm_castsi128_pd(_mm_slli_epi64(bits, 52))};
+    }
+
+    inline Pack exponent(Pack a) noexcept
+    {
+        const __m128i bits{_mm_or_si128(_mm_srli_epi64(_mm_castpd_si128(a.v), 52),
+                                        _mm_set1_epi64x(0x4330000000000000))};
+        return {_mm_sub_pd(_mm_castsi128_pd(bits), _mm_set1_pd(0x1p52 + 1023.0))};
+    }
+
+    inline Pack min(Pack a, Pack b) noexcept
+    {
+        return {_mm_min_pd(a.v, b.v)};
+    }
+
+    inline Pack max(Pack a, Pack b) noexcept
+    {
+        return {_mm_max_pd(a.v, b.v)};
+    }
+
+    inline Pack abs(Pack a) noexcept
+    {
+        return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)};
+    }
+
+    inline Mask isNaN(Pack a) noexcept
+    {
+        return {_mm_cmpunord_pd(a.v, a.v)};
+    }
+
+    inline Mask less(Pack a, Pack b) noexcept
+    {
+        return {_mm_cmplt_pd(a.v, b.v)};
+    }
+
+    inline Mask lessEqual(Pack a, Pack b) noexcept
+    {
+        return {_mm_cmple_pd(a.v, b.v)};
+    }
+
+    inline Mask greater(Pack a, Pack b) noexcept
+    {
+        return {_mm_cmpgt_pd(a.v, b.v)};
+    }
+
+    inline Mask equal(Pack a, Pack b) noexcept
+    {
+        return {_mm_cmpeq_pd(a.v, b.v)};
+    }
+
+    inline Mask notEqual(Pack a, Pack b) noexcept
+    {
+        return {_mm_cmpneq_pd(a.v, b.v)};
+    }
+
+    inline Pack select(Mask m, Pack a, Pack b) noexcept
+    {
+        return {_mm_or_pd(_mm_and_pd(m.m, a.v), _mm_andnot_pd(m.m, b.v))};
+    }
+
+    inline Pack round(Pack a) noexcept
+    {
+        // Adding and removing 1.5 * 2^52 rounds away the fraction, numbers
+        // at or above 2^52 are already integers.
+        const __m128d magic{_mm_set1_pd(0x1.8p52)};
+        const __m128d rounded{_mm_sub_pd(_mm_add_pd(a.v, magic), magic)};
+        const Mask small{_mm_cmplt_pd(abs(a).v, _mm_set1_pd(0x1p52))};
+        return select(small, {rounded}, a);
+    }
+
+    inline Mask operator|(Mask a, Mask b) noexcept
+    {
+        return {_mm_or_pd(a.m, b.m)};
+    }
+
+    inline Mask operator&(Mask a, Mask b) noexcept
+    {
+        return {_mm_and_pd(a.m, b.m)};
+    }
+
+    inline bool any(Mask a) noexcept
+    {
+        return _mm_movemask_pd(a.m) != 0;
+    }
+
+    inline bool all(Mask a) noexcept
+    {
+        return _mm_movemask_pd(a.m) == 0x3;
+    }
+
+    inline Mask noLanes() noexcept
+    {
+        return {_mm_setzero_pd()};
+    }
+
+#else
+    inline constexpr std::size_t width{1};
+    inline constexpr const char* name{"scalar"};
+
+    struct Pack
+    {
+        double v;
+    };
+
+    struct Mask
+    {
+        bool m;
+    };
+
+    inline Pack load(const double* ptr) noexcept
+    {
+        return {*ptr};
+    }
+
+    inline void store(double* ptr, Pack a) noexcept
+    {
+        *ptr = a.v;
+    }
+
+    inline Pack broadcast(double value) noexcept
+    {
+        return {value};
+    }
+
+    inline Pack operator+(Pack a, Pack b) noexcept
+    {
+        return {a.v + b.v};
+    }
+
+    inline Pack operator-(Pack a, Pack b) noexcept
+    {
+        return {a.v - b.v};
+    }
+
+    inline Pack operator*(Pack a, Pack b) noexcept
+    {
+        return {a.v * b.v};
+    }
+
+    inline Pack operator/(Pack a, Pack b) noexcept
+    {
+        return {a.v / b.v};
+    }
+
+    inline Pack mulAdd(Pack a, Pack b, Pack c) noexcept
+    {
+        return {a.v * b.v + c.v};
+    }
+
+    inline Pack sqrt(Pack a) noexcept
+    {
+        return {std::sqrt(a.v)};
+    }
+
+    inline Pack round(Pack a) noexcept
+    {
+        return {std::nearbyint(a.v)};
+    }
+
+    inline Pack fromBits(std::uint64_t bits) noexcept
+    {
+        Pack out{};
+        std::memcpy(&out.v, &bits, sizeof(double));
+        return out;
+    }
+
+    namespace Detail
+    {
+        inline std::uint64_t bits(Pack a) noexcept
+        {
+            std::uint64_t out{};
+            std::memcpy(&out, &a.v, sizeof(double));
+            return out;
+        }
+
+    } // namespace Detail
+
+    inline Pack bitAnd(Pack a, Pack b) noexcept
+    {
+        return fromBits(Detail::bits(a) & Detail::bits(b));
+    }
+
+    inline Pack bitOr(Pack a, Pack b) noexcept
+    {
+        return fromBits(Detail::bits(a) | Detail::bits(b));
+    }
+
+    inline Pack bitXor(Pack a, Pack b) noexcept
+    {
+        return fromBits(Detail::bits(a) ^ Detail::bits(b));
+    }
+
+    inline Pack pow2(Pack n) noexcept
+    {
+        return {std::ldexp(1.0, static_cast<int>(n.v))};
+    }
+
+    inline Pack exponent(Pack a) noexcept
+    {
+        return {static_cast<double>(static_cast<int>(Detail::bits(a) >> 52) - 1023)};
+    }
+
+    inline Pack min(Pack a, Pack b) noexcept
+    {
+        return {(a.v < b.v) ? a.v : b.v};
+    }
+
+    inline Pack max(Pack a, Pack b) noexcept
+    {
+        return {(a.v > b.v) ? a.v : b.v};
+    }
+
+    inline Pack abs(Pack a) noexcept
+    {
+        return {std::fabs(a.v)};
+    }
+
+    inline Mask isNaN(Pack a) noexcept
+    {
+        return {std::isnan(a.v)};
+    }
+
+    inline Mask less(Pack a, Pack b) noexcept
+    {
+        return {a.v < b.v};
+    }
+
+    inline Mask lessEqual(Pack a, Pack b) noexcept
+    {
+        return {a.v <= b.v};
+    }
+
+    inline Mask greater(Pack a, Pack b) noexcept
+    {
+        return {a.v > b.v};
+    }
+
+    inline Mask equal(Pack a, Pack b) noexcept
+    {
+        return {a.v == b.v};
+    }
+
+    inline Mask notEqual(Pack a, Pack b) noexcept
+    {
+        return {a.v != b.v};
+    }
+
+    inline Pack select(Mask m, Pack a, Pack b) noexcept
+    {
+        return m.m ? a : b;
+    }
+
+    inline Mask operator|(Mask a, Mask b) noexcept
+    {
+        return {a.m || b.m};
+    }
+
+    inline Mask operator&(Mask a, Mask b) noexcept
+    {
+        return {a.m && b.m};
+    }
+
+    inline bool any(Mask a) noexcept
+    {
+        return a.m;
+    }
+
+    inline bool all(Mask a) noexcept
+    {
+        return a.m;
+    }
+
+    inline Mask noLanes() noexcept
+    {
+        return {false};
+    }
+#endif
+
+    inline Pack operator-(Pack a) noexcept
+    {
+        return bitXor(a, fromBits(0x8000000000000000));
+    }
+
+    // Lanes of a Pack in memory.
+    struct Lanes
+    {
+        double v[width];
+    };
+
+    /** Function for storing the lanes of a Pack in an array.
+
+        @param  a   pack
+        @return     lanes
+    */
+    inline Lanes lanes(Pack a) noexcept
+    {
+        Lanes out{};
+        store(out.v, a);
+        return out;
+    }
+
+} // namespace CalcEval::Simd
+
+#endif // CALCEVAL_SIMD_HPP
@@ -0,0 +1,129 @@
+//
+//  Span.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_SPAN_HPP
+#define CALCEVAL_SPAN_HPP
+
+// C++ Headers
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Span class implementation.
+
+        Non-owning view of a contiguous sequence of T, a small
+        subset of std::span since the library is built as C++17.
+    */
+    template<typename T>
+    class Span
+    {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using size_type = std::size_t;
+        using iterator = T*;
+
+    public:
+        /** Default Span constructor.
+
+            @return     empty Span
+        */
+        constexpr Span() noexcept = default;
+
+        /** Span constructor with data and size.
+
+            @param  data    pointer to first element
+            @param  size    number of elements
+            @return         initialized Span
+        */
+        constexpr Span(T* data, size_type size) noexcept : m_data{data}, m_size{size}
+        {
+        }
+
+        /** Span constructor from a vector.
+
+            @param  vec     vector to view
+            @return         initialized Span
+        */
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+        Span(std::vector<U>& vec) noexcept : m_data{vec.data()}, m_size{vec.size()}
+        {
+        }
+
+        /** Span constructor from a const vector.
+
+            @param  vec     vector to view
+            @return         initialized Span
+        */
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+        Span(const std::vector<U>& vec) noexcept : m_data{vec.data()}, m_size{vec.size()}
+        {
+        }
+
+        /** Span constructor from a Span with a convertible element type.
+
+            Mainly used to convert Span<T> to Span<const T>.
+
+            @param  other   span to view
+            @return         initialized Span
+        */
+        template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+        constexpr Span(const Span<U>& other) noexcept : m_data{other.data()}, m_size{other.size()}
+        {
+        }
+
+        [[nodiscard]] constexpr T* data() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr T& operator[](size_type index) const noexcept
+        {
+            return m_data[index];
+        }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr iterator end() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        /** Function for creating a view of a part of the Span.
+
+            @param  offset  first element
+            @param  count   number of elements
+            @return         Span with the elements
+        */
+        [[nodiscard]] constexpr Span subspan(size_type offset, size_type count) const noexcept
+        {
+            return Span{m_data + offset, count};
+        }
+
+    private:
+        T* m_data{nullptr};
+        size_type m_size{0};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_SPAN_HPP
@@ -0,0 +1,188 @@
+//
+//  StaticTable.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_STATICTABLE_HPP
+#define CALCEVAL_STATICTABLE_HPP
+
+// Local Headers
+#include "calceval/Hash.hpp"
+
+// C++ Headers
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace CalcEval
+{
+    /** StaticTable class implementation.
+
+        Immutable name to value table that is built at compile time.
+
+        A seed for the hash function is searched for when the table is
+        constructed so that every name gets its own slot (a perfect hash).
+        A lookup is therefore one hash, one index and one string compare,
+        no matter how many entries the table has.
+
+        Entries keep the order they were given in, so the index of an entry
+        can be used as a stable id for it.
+    */
+    template<typename T, std::size_t N>
+    class StaticTable
+    {
+    public:
+        using value_type = T;
+        using entry_type = std::pair<std::string_view, T>;
+        using slot_type = std::uint16_t;
+
+        static_assert(N < 0xffff, "StaticTable is limited to 65534 entries");
+
+        // Number of slots, kept at four times the entries for a quick seed search.
+        static constexpr std::size_t slotCount{[]() {
+            std::size_t count{4};
+            while (count < N * 4)
+                count *= 2;
+            return count;
+        }()};
+
+    public:
+        /** StaticTable constructor with entries.
+
+            Fails to compile (throws during constant evaluation) if the
+            names are not unique.
+
+            @param  entries     name and value pairs
+            @return             initialized StaticTable
+        */
+        constexpr explicit StaticTable(const std::array<entry_type, N>& entries)
+            : m_entries{entries}, m_seed{findSeed(entries)}, m_slots{buildSlots(entries, m_seed)}
+        {
+        }
+
+        /** Function for finding the value of a name.
+
+            @param  name    name to search for
+            @return         value as an std::optional, std::nullopt if not found
+        */
+        [[nodiscard]] constexpr std::optional<T> find(std::string_view name) const noexcept
+        {
+            if (auto idx = index(name))
+                return m_entries[*idx].second;
+
+            return std::nullopt;
+        }
+
+        /** Function for finding the index of a name.
+
+            @param  name    name to search for
+            @return         index as an std::optional, std::nullopt if not found
+        */
+        [[nodiscard]] constexpr std::optional<std::size_t> index(std::string_view name) const noexcept
+        {
+            if constexpr (N == 0)
+                return std::nullopt;
+
+            const slot_type slot{m_slots[slotOf(name, m_seed)]};
+            if (slot != emptySlot && m_entries[slot].first == name)
+                return static_cast<std::size_t>(slot);
+
+            return std::nullopt;
+        }
+
+        /** Retrieve the entries in the order they were given.
+
+            @return     entries
+        */
+        [[nodiscard]] constexpr const std::array<entry_type, N>& entries() const noexcept
+        {
+            return m_entries;
+        }
+
+        /** Retrieve the number of entries.
+
+            @return     number of entries
+        */
+        [[nodiscard]] static constexpr std::size_t size() noexcept
+        {
+            return N;
+        }
+
+    private:
+        static constexpr slot_type emptySlot{0xffff};
+
+        static constexpr std::size_t slotOf(std::string_view name, std::uint64_t seed) noexcept
+        {
+            return static_cast<std::size_t>(hash(name, seed) & (slotCount - 1));
+        }
+
+        static constexpr std::uint64_t findSeed(const std::array<entry_type, N>& entries)
+        {
+            for (std::size_t i{0}; i < N; ++i)
+                for (std::size_t j{i + 1}; j < N; ++j)
+                    if (entries[i].first == entries[j].first)
+                        throw std::logic_error("StaticTable: duplicate name");
+
+            for (std::uint64_t seed{hashBasis}; seed < hashBasis + 0x10000; ++seed)
+            {
+                std::array<bool, slotCount> used{};
+                bool collision{false};
+                for (std::size_t i{0}; i < N && !collision; ++i)
+                {
+                    const std::size_t slot{slotOf(entries[i].first, seed)};
+                    collision = used[slot];
+                    used[slot] = true;
+                }
+
+                if (!collision)
+                    return seed;
+            }
+
+            throw std::logic_error("StaticTable: no perfect hash seed found");
+        }
+
+        static constexpr std::array<slot_type, slotCount>
+        buildSlots(const std::array<entry_type, N>& entries, std::uint64_t seed)
+        {
+            std::array<slot_type, slotCount> slots{};
+            for (auto& slot : slots)
+                slot = emptySlot;
+
+            for (std::size_t i{0}; i < N; ++i)
+                slots[slotOf(entries[i].first, seed)] = static_cast<slot_type>(i);
+
+            return slots;
+        }
+
+    private:
+        std::array<entry_type, N> m_entries;
+        std::uint64_t m_seed;
+        std::array<slot_type, slotCount> m_slots;
+    };
+
+    /** Function for creating a StaticTable.
+
+        Each entry is a pair of a name and something convertible to T,
+        for example a captureless lambda when T is a function pointer:
+
+            makeStaticTable<double(*)(double)>(std::pair{"sin", [](double x) { ... }});
+
+        @param  entries     name and value pairs
+        @return             StaticTable with the entries
+    */
+    template<typename T, typename... Entries>
+    [[nodiscard]] constexpr StaticTable<T, sizeof...(Entries)> makeStaticTable(const Entries&... entries)
+    {
+        return StaticTable<T, sizeof...(Entries)>{std::array<std::pair<std::string_view, T>, sizeof...(Entries)>{
+            std::pair<std::string_view, T>{entries.first, entries.second}...}};
+    }
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_STATICTABLE_HPP
@@ -0,0 +1,186 @@
+//
+//  Sweep.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_SWEEP_HPP
+#define CALCEVAL_SWEEP_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Kernel.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Sweep class implementation.
+
+        Evaluates an Expression over every point of a grid, the Cartesian
+        product of one axis per variable. The first axis is the outermost
+        loop and the last axis the innermost.
+
+        When created, every subtree of the code that only depends on the
+        outer axes is moved out of the inner loop. It is computed once per
+        iteration of the innermost loop it depends on, and subtrees without
+        variables are computed once. The inner axis is evaluated with
+        Expression::evaluateBatch in blocks of blockSize values, and each
+        block is given to the callback as soon as it is computed.
+
+        The code is not reordered, "2*x*y" is "(2*x)*y" and 2*x is moved,
+        but in "x*y*2" nothing is, so the results are the same as
+        evaluating every point.
+
+        Usage:
+            CalcEval::Sweep sweep{expression, {Sweep::Axis::parse("x=0:1:1000"),
+                                               Sweep::Axis::parse("y=0:10:100")}};
+            sweep.run([](const CalcEval::Sweep::Block& block) { ... });
+    */
+    class Sweep
+    {
+    public:
+        /** Axis struct implementation.
+
+            The values start, start + step, ... up to and including stop.
+            Values are computed as start + i * step, the error does not
+            grow along the axis.
+        */
+        struct Axis
+        {
+            std::string name;
+            double start;
+            double step;
+            double stop;
+
+            /** Function for parsing name=start:step:stop.
+
+                Throws std::invalid_argument if str is not an axis.
+
+                @param  str     text of the axis
+                @return         axis
+            */
+            [[nodiscard]] static Axis parse(std::string_view str);
+
+            /** Retrieve the number of values.
+
+                @return     number of values, 0 if the axis is not valid
+            */
+            [[nodiscard]] std::size_t count() const noexcept;
+
+            /** Retrieve a value.
+
+                @param  index   index of the value
+                @return         start + index * step
+            */
+            [[nodiscard]] double value(std::size_t index) const noexcept;
+        };
+
+        /** Results of one block of the inner axis.
+
+            outer are the values of the outer axes, inner the values of
+            the inner axis and results the result for every inner value.
+        */
+        struct Block
+        {
+            Span<const double> outer;
+            Span<const double> inner;
+            Span<const double> results;
+        };
+
+        using callback_type = std::function<void(const Block&)>;
+
+        /** Largest number of inner values in a Block.
+
+            Only one block of results is kept, it is given to the callback
+            before the next one is computed.
+        */
+        static constexpr std::size_t blockSize{4096};
+
+    public:
+        /** Sweep constructor with expression and axes.
+
+            Throws std::invalid_argument if the expression is not complete,
+            the names of the axes are not the variables of the expression
+            in the same order or an axis has no values.
+
+            @param  expression  expression to evaluate
+            @param  axes        one axis per variable
+            @param  accuracy    accuracy of the inner loop
+            @return             initialized Sweep
+        */
+        Sweep(const Expression& expression, std::vector<Axis> axes,
+              Kernel::Accuracy accuracy = Kernel::Accuracy::Exact);
+
+        /** Function for evaluating every point.
+
+            The blocks are given in order, the inner axis changes fastest.
+
+            @param  callback    called with every block
+        */
+        void run(const callback_type& callback) const;
+
+        /** Retrieve the axes.
+
+            @return     axes
+        */
+        [[nodiscard]] const std::vector<Axis>& axes() const noexcept;
+
+        /** Retrieve the number of points in the grid.
+
+            @return     product of the number of values of the axes
+        */
+        [[nodiscard]] std::uint64_t size() const noexcept;
+
+        /** Retrieve the code run for every point of the grid.
+
+            Moved subtrees are variables after the ones of the axes.
+
+            @return     inner expression
+        */
+        [[nodiscard]] const Expression& inner() const noexcept;
+
+        /** Retrieve the number of subtrees moved out of the inner loop.
+
+            @return     number of moved subtrees
+        */
+        [[nodiscard]] std::size_t hoistedCount() const noexcept;
+
+        /** Retrieve the number of instructions run by run.
+
+            @return     number of instructions
+        */
+        [[nodiscard]] std::uint64_t instructionCount() const noexcept;
+
+    private:
+        // A moved subtree, computed with the values of axes [0, level].
+        struct Hoisted
+        {
+            Expression expression;
+            std::uint32_t slot;
+        };
+
+        // Values of the variables and buffers of the inner loop.
+        struct State;
+
+        void run(std::size_t level, State& state, const callback_type& callback) const;
+
+    private:
+        std::vector<Axis> m_axes;
+        Kernel::Accuracy m_accuracy;
+        std::vector<std::vector<Hoisted>> m_levels{};
+        Expression m_inner{};
+        std::size_t m_variables{0};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_SWEEP_HPP
@@ -0,0 +1,120 @@
+//
+//  Tape.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_TAPE_HPP
+#define CALCEVAL_TAPE_HPP
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Span.hpp"
+
+// C++ Headers
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CalcEval
+{
+    /** Tape class implementation.
+
+        Reverse mode automatic differentiation of an Expression. The
+        gradient with respect to all variables costs one evaluation and
+        one backward sweep, independent of the number of variables (with
+        Dual<N> it is N tangents carried through every operation).
+
+        The tape is a flat array with one node per instruction of the
+        expression, each node has the indices of its operands. An
+        evaluation records the value of every node, the sweep then walks
+        the nodes backwards and adds each adjoint to the adjoints of the
+        operands. Nodes that do not depend on a variable are skipped.
+
+        Derivatives are defined for all operators and for the functions
+        and functions with several arguments of Type::Standard.
+        Comparisons have the derivative 0 and if(c, a, b) the derivative
+        of the branch that is taken, both branches are evaluated. The
+        constructor throws Error if the expression calls another
+        function, since its derivative is not known. At points where a
+        derivative does not exist it is the same as with Type::Dual.
+
+        All memory is allocated by the constructor, so gradient() does
+        not allocate. A Tape is not thread-safe, use one per thread.
+
+        Usage:
+            CalcEval::Tape tape{compiler.compile("x*y + sin(x)", {"x", "y"})};
+            std::vector<double> gradient(2);
+            double value{tape.gradient(std::vector<double>{3.0, 4.0}, gradient)};
+    */
+    class Tape
+    {
+    public:
+        using derivative_type = double (*)(double x, double fx);
+        using partials_type = void (*)(Span<const double> args, double result,
+                                       Span<double> partials);
+
+    public:
+        /** Tape constructor with an expression.
+
+            Throws Error if a function has no known derivative.
+
+            @param  expression  complete expression to differentiate
+            @return             initialized Tape
+        */
+        explicit Tape(Expression expression);
+
+        /** Function for evaluating the value and the gradient.
+
+            Throws std::invalid_argument if variables or gradient do not
+            have one element per variable.
+
+            @param  variables   values of the variables
+            @param  gradient    derivatives with respect to the variables
+            @return             value of the expression
+        */
+        double gradient(Span<const double> variables, Span<double> gradient);
+
+        /** Retrieve the expression.
+
+            @return     expression
+        */
+        [[nodiscard]] const Expression& expression() const noexcept;
+
+        /** Retrieve the number of nodes.
+
+            @return     number of nodes
+        */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+    private:
+        // first and second are operand nodes, for OpCode::Variadic and
+        // OpCode::Select first is the offset of the operands in m_arguments.
+        struct Node
+        {
+            OpCode op;
+            bool active;
+            std::uint32_t index;
+            std::uint32_t first;
+            std::uint32_t second;
+        };
+
+        void forward(const double* variables);
+        void backward(double* gradient);
+
+    private:
+        Expression m_expression;
+        std::vector<Node> m_nodes{};
+        std::vector<std::uint32_t> m_arguments{};
+        std::vector<derivative_type> m_derivatives{};
+        std::vector<partials_type> m_partials{};
+        std::vector<double> m_values{};
+        std::vector<double> m_adjoints{};
+        std::vector<double> m_callValues{};
+        std::vector<double> m_callPartials{};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_TAPE_HPP
@@ -0,0 +1,143 @@
+//
+//  ThreadPool.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_THREADPOOL_HPP
+#define CALCEVAL_THREADPOOL_HPP
+
+// C++ Headers
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CalcEval
+{
+    /** ThreadPool class implementation.
+
+        Fixed number of worker threads with work stealing. Every worker
+        has its own queue of tasks. A worker takes tasks from the front of
+        its own queue and, when it is empty, steals from the back of the
+        queue of another worker. Tasks with very different costs are
+        therefore balanced without a shared queue that all threads contend
+        for.
+
+        Work is given as a range of indices that is split into chunks of
+        grain indices, see parallelFor. The chunks are spread over the
+        queues, so each worker starts with a contiguous part of the range.
+
+        parallelFor can be called from any thread, also from inside a
+        task. A worker that calls it runs the tasks of the new job while
+        it waits, so nested calls do not deadlock. It runs no other tasks
+        then, the task that called parallelFor is not finished.
+    */
+    class ThreadPool
+    {
+    public:
+        /** Signature of the work.
+
+            Called with a chunk [begin, end) and the index of the worker
+            running it, less than size(). A worker runs one chunk of a
+            job at a time, so the index can be used to select per-thread
+            data of the job. A body that calls parallelFor can be waiting
+            while the same worker runs chunks of the nested job, data
+            shared with the nested body must allow that.
+        */
+        using body_type =
+            std::function<void(std::size_t begin, std::size_t end, std::size_t worker)>;
+
+    public:
+        /** ThreadPool constructor with the number of threads.
+
+            @param  threads     number of worker threads, 0 for one per core
+            @return             initialized ThreadPool
+        */
+        explicit ThreadPool(std::size_t threads = 0);
+
+        /** ThreadPool destructor, waits for the workers to finish.
+
+        */
+        ~ThreadPool() noexcept;
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /** Retrieve the pool shared by the library.
+
+            Created on first use with one worker per core. Used by work
+            that is started from inside an evaluation, where no pool can
+            be passed (see Series.hpp).
+
+            @return     shared pool
+        */
+        [[nodiscard]] static ThreadPool& shared();
+
+        /** Retrieve the number of workers.
+
+            @return     number of workers
+        */
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        /** Function for running body over [0, count) in parallel.
+
+            Returns when all chunks are done. If a chunk throws, the other
+            chunks still run and then the exception of the chunk with the
+            lowest begin is rethrown, so the error does not depend on the
+            scheduling.
+
+            @param  count   number of indices
+            @param  grain   indices per chunk, at least 1
+            @param  body    work for a chunk
+        */
+        void parallelFor(std::size_t count, std::size_t grain, const body_type& body);
+
+    private:
+        struct Job
+        {
+            const body_type* body;
+            std::atomic<std::size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+            std::size_t errorBegin;
+        };
+
+        struct Task
+        {
+            Job* job;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void work(std::size_t worker);
+        // Runs a task, only one of job if it is not nullptr.
+        bool runOne(std::size_t worker, const Job* job);
+        void execute(const Task& task, std::size_t worker);
+
+    private:
+        std::vector<std::unique_ptr<Queue>> m_queues{};
+        std::vector<std::thread> m_threads{};
+        std::mutex m_sleepMutex{};
+        std::condition_variable m_wake{};
+        std::atomic<std::size_t> m_pending{0};
+        bool m_stop{false};
+    };
+
+} // namespace CalcEval
+
+#endif // CALCEVAL_THREADPOOL_HPP
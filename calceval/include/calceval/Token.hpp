@@ -44,6 +44,14 @@ namespace CalcEval
         Power,
         LeftParen,
         RightParen,
+        Comma,
+        Assign,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
         EndMark,
         EndOfLine
     };
@@ -115,6 +123,22 @@ namespace CalcEval
                 return "left paren";
             case TokenType::RightParen:
                 return "right paren";
+            case TokenType::Comma:
+                return "comma";
+            case TokenType::Assign:
+                return "assign";
+            case TokenType::Less:
+                return "less";
+            case TokenType::LessEqual:
+                return "less or equal";
+            case TokenType::Greater:
+                return "greater";
+            case TokenType::GreaterEqual:
+                return "greater or equal";
+            case TokenType::Equal:
+                return "equal";
+            case TokenType::NotEqual:
+                return "not equal";
             case TokenType::EndMark:
                 return "end of file";
             case TokenType::EndOfLine:
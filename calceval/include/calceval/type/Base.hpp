@@ -8,8 +8,10 @@
 #ifndef CALCEVAL_TYPE_BASE_HPP
 #define CALCEVAL_TYPE_BASE_HPP
 
+// Local Headers
+#include "calceval/Function.hpp"
+
 // C++ Headers
-#include <functional>
 #include <string>
 #include <string_view>
 #include <optional>
@@ -25,19 +27,64 @@ namespace CalcEval::Type
             - stot : function to convert a string to the type.
             - constant : function to get math constant value from string.
             - function : function to get math function from string.
+            - variadic : function to get math function with several arguments from string.
 
         This makes it extensible so constants and functions can be added
         easily by creating a new type and using it in the parser.
 
+        Functions are plain function pointers (func_type) so that a call
+        from the parser is a direct call. Types with several constants or
+        functions should keep them in a StaticTable so that a lookup is a
+        single hash and compare.
+
+        Nothing is virtual. The parser is instantiated with the most derived
+        type and calls its member functions directly, so a member function in
+        a derived type hides the one in Base. The contract is checked at
+        compile time by Type::isCalcType (see type/Traits.hpp).
+
         Only member function that has to be implemented is stot, the
         other member functions are optional since no constans or functions
-        has to be available in the parser.
+        has to be available in the parser. stot has the signature:
+
+            value_type stot(const std::string& str) noexcept;
+
+        Implementation of stot must not ever throw, the string to convert
+        must be able to be converted. The string will come from the Scanner
+        and that will make sure that it contains a floating point number.
+        The exception is a type that can not represent every number, such
+        as Type::Int64, its stot may throw ArithmeticError instead.
+
+        A type can also have add, subtract, multiply, divide and power
+        member functions that take two value_type and return a value_type,
+        the parser will then use them instead of the built-in operators
+        (see Type::hasAdd in type/Traits.hpp). These may throw
+        ArithmeticError when the result can not be represented.
+
+        Types with double as value_type and without these operator member
+        functions can also be compiled to an Expression and evaluated for
+        many values at once (see Type::isCompilable). Two optional
+        member functions give vectorized versions, a span of values in and
+        a span of results out, used by Expression::evaluateBatch instead
+        of one call per value:
+
+            std::optional<Kernel::func_type> batchFunction(const std::string& name);
+            std::optional<Kernel::binary_type> batchOperator(char op);
+
+        op is one of + - * / ^. A function or operator without a
+        vectorized version is evaluated with the scalar function or the
+        built-in operator (see Type::hasBatchFunction and
+        Type::hasBatchOperator).
+
+        Depending on the method and type used, stot might have rounding
+        issues and other faults with floating numbers in general.
+        Something to keep in mind.
     */
     template<typename CalcType>
     struct Base
     {
         using value_type = CalcType;
-        using func_type = std::function<value_type(value_type)>;
+        using func_type = value_type (*)(value_type);
+        using variadic_type = Variadic<value_type>;
 
         /** Default Base constructor
 
@@ -45,26 +92,6 @@ namespace CalcEval::Type
         */
         Base() noexcept = default;
 
-        /** Destructor for Base
-
-        */
-        virtual ~Base() noexcept = default;
-
-        /** Function for converting a string to the type.
-
-            Implementation of this member function must not ever throw, the string
-            to convert must be able to be converted. The string will come from the
-            Scanner and that will make sure that it contains a floating point number.
-
-            Depending on the method and type used, this function might have rounding
-            issues and other faults with floating numbers in general.
-            Something to keep in mind.
-
-            @param  str     string to convert
-            @return         value
-        */
-        [[nodiscard]] virtual value_type stot(const std::string&) noexcept = 0;
-
         /** Function for retrieving a math constant from certain string.
 
             It returns the value in an std::optional, if no constant can be found it returns
@@ -73,7 +100,7 @@ namespace CalcEval::Type
             @param  str     name of constant
             @return         constant value as an std::optional
         */
-        [[nodiscard]] virtual std::optional<value_type> constant(const std::string&) noexcept
+        [[nodiscard]] std::optional<value_type> constant(const std::string&) noexcept
         {
             return std::nullopt;
         }
@@ -86,7 +113,20 @@ namespace CalcEval::Type
             @param  str     name of function
             @return         math function as an std::optional
         */
-        [[nodiscard]] virtual std::optional<func_type> function(const std::string&) noexcept
+        [[nodiscard]] std::optional<func_type> function(const std::string&) noexcept
+        {
+            return std::nullopt;
+        }
+
+        /** Function for retrieving a math function with several arguments from certain string.
+
+            It returns the function and the number of arguments it accepts in an std::optional,
+            if no math function can be found it returns an std::nullopt.
+
+            @param  str     name of function
+            @return         math function as an std::optional
+        */
+        [[nodiscard]] std::optional<variadic_type> variadic(const std::string&) noexcept
         {
             return std::nullopt;
         }
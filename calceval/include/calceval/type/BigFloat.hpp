@@ -0,0 +1,120 @@
+//
+//  type/BigFloat.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_TYPE_BIGFLOAT_HPP
+#define CALCEVAL_TYPE_BIGFLOAT_HPP
+
+// Local Headers
+#include "Base.hpp"
+#include "calceval/BigFloat.hpp"
+#include "calceval/StaticTable.hpp"
+
+// C++ Headers
+#include <cstdint>
+
+namespace CalcEval::Type
+{
+    /** Type::BigFloat struct implementation.
+
+        Inherits the Type::Base and implements it for CalcEval::BigFloat
+        with Precision bits (128 bits is about 38 decimal digits).
+
+        Literals and constants get Precision bits and the results of the
+        operators and functions keep it. Errors such as division by zero
+        throw ArithmeticError.
+
+        Included constants:
+            - pi
+            - e
+
+        Included functions:
+            - log
+            - log10
+            - exp
+            - sin
+            - cos
+            - tan
+            - sqrt
+
+        Usage:
+            CalcEval::Parser<CalcEval::Type::BigFloat<256>> parser{};
+            std::string value{parser.parse("exp(1)").toString(70)};
+    */
+    template<std::uint32_t Precision = CalcEval::BigFloat::defaultPrecision>
+    struct BigFloat : public Base<CalcEval::BigFloat>
+    {
+        static_assert(Precision >= 2, "Precision must be at least 2 bits");
+
+        using constant_type = value_type (*)(std::uint32_t);
+
+        /** Table with the included constants, computed at the precision.
+
+        */
+        static constexpr auto constants = makeStaticTable<constant_type>(
+            std::pair{"pi", &value_type::pi}, std::pair{"e", &value_type::e});
+
+        /** Table with the included functions.
+
+        */
+        static constexpr auto functions = makeStaticTable<func_type>(
+            std::pair{"log", [](value_type x) { return value_type::log(x); }},
+            std::pair{"log10", [](value_type x) { return value_type::log10(x); }},
+            std::pair{"exp", [](value_type x) { return value_type::exp(x); }},
+            std::pair{"sin", [](value_type x) { return value_type::sin(x); }},
+            std::pair{"cos", [](value_type x) { return value_type::cos(x); }},
+            std::pair{"tan", [](value_type x) { return value_type::tan(x); }},
+            std::pair{"sqrt", [](value_type x) { return value_type::sqrt(x); }});
+
+        /** Function for converting a string to BigFloat.
+
+            Rounded once from the decimal string to Precision bits.
+
+            @param  str     string to convert
+            @return         value
+        */
+        [[nodiscard]] value_type stot(const std::string& str)
+        {
+            return value_type::fromString(str, Precision);
+        }
+
+        /** Function for retrieving a math constant from certain string.
+
+            @param  str     name of constant
+            @return         constant value as an std::optional
+        */
+        [[nodiscard]] std::optional<value_type> constant(const std::string& str)
+        {
+            if (auto func = constants.find(str))
+                return (*func)(Precision);
+            return std::nullopt;
+        }
+
+        /** Function for retrieving a math function from certain string.
+
+            @param  str     name of function
+            @return         math function as an std::optional
+        */
+        [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept
+        {
+            return functions.find(str);
+        }
+
+        /** Function for power, BigFloat has no pow found by lookup.
+
+            @param  lhs     base
+            @param  rhs     exponent
+            @return         lhs^rhs
+        */
+        [[nodiscard]] static value_type power(const value_type& lhs, const value_type& rhs)
+        {
+            return value_type::pow(lhs, rhs);
+        }
+    };
+
+} // namespace CalcEval::Type
+
+#endif // CALCEVAL_TYPE_BIGFLOAT_HPP
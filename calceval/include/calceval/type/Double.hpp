@@ -31,7 +31,7 @@ namespace CalcEval::Type
             @param  str     string to convert
             @return         value
         */
-        [[nodiscard]] value_type stot(const std::string& str) noexcept override
+        [[nodiscard]] value_type stot(const std::string& str) noexcept
         {
             return std::stod(str);
         }
@@ -0,0 +1,225 @@
+//
+//  type/Dual.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_TYPE_DUAL_HPP
+#define CALCEVAL_TYPE_DUAL_HPP
+
+// Local Headers
+#include "Base.hpp"
+#include "Standard.hpp"
+#include "calceval/Dual.hpp"
+#include "calceval/StaticTable.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+namespace CalcEval::Type
+{
+    /** Type::Dual struct implementation.
+
+        Inherits the Type::Base and implements it for CalcEval::Dual<N>,
+        forward mode automatic differentiation with respect to N inputs.
+        Has the same constants and functions as Type::Standard and the
+        values are the same as with it, every operator, function and ^
+        also propagates the derivatives.
+
+        Literals and constants have zero derivatives. The inputs are
+        given as symbols made with CalcEval::Dual<N>::variable, so a single
+        parse gives the value and the gradient. Costs about N + 1 times
+        the arithmetic of Type::Standard.
+
+        Included constants:
+            - pi
+            - e
+
+        Included functions:
+            - log
+            - log10
+            - exp
+            - sin
+            - cos
+            - tan
+            - arcsin
+            - arccos
+            - arctan
+
+        Included functions with several arguments:
+            - min   : derivative of the smallest argument (first if equal)
+            - max   : derivative of the largest argument (first if equal)
+            - sum
+            - mean
+            - hypot
+            - atan2
+
+        Usage:
+            using D = CalcEval::Dual<2>;
+            CalcEval::Registry<D> registry{};
+            registry.addConstant("x", D::variable(3.0, 0));
+            registry.addConstant("y", D::variable(4.0, 1));
+
+            CalcEval::Parser<CalcEval::Type::Dual<2>> parser{registry.freeze()};
+            D f{parser.parse("x*y + sin(x)")};
+            double dfdx{f.derivative(0)}, dfdy{f.derivative(1)};
+    */
+    template<std::size_t N>
+    struct Dual : public Base<CalcEval::Dual<N>>
+    {
+        static_assert(N >= 1, "Dual needs at least one input");
+
+        using typename Base<CalcEval::Dual<N>>::value_type;
+        using typename Base<CalcEval::Dual<N>>::func_type;
+        using typename Base<CalcEval::Dual<N>>::variadic_type;
+
+        /** Table with the included functions.
+
+        */
+        static constexpr auto functions = makeStaticTable<func_type>(
+            std::pair{"log", [](value_type x) { return log(x); }},
+            std::pair{"log10", [](value_type x) { return log10(x); }},
+            std::pair{"exp", [](value_type x) { return exp(x); }},
+            std::pair{"sin", [](value_type x) { return sin(x); }},
+            std::pair{"cos", [](value_type x) { return cos(x); }},
+            std::pair{"tan", [](value_type x) { return tan(x); }},
+            std::pair{"arcsin", [](value_type x) { return asin(x); }},
+            std::pair{"arccos", [](value_type x) { return acos(x); }},
+            std::pair{"arctan", [](value_type x) { return atan(x); }});
+
+        /** Function for the argument with the smallest or largest value.
+
+            @param  args    arguments
+            @param  largest true for max, false for min
+            @return         first argument with the extreme value
+        */
+        static value_type select(Span<const value_type> args, bool largest) noexcept
+        {
+            std::size_t index{0};
+            for (std::size_t i{1}; i < args.size(); ++i)
+            {
+                const double value{args[i].value()};
+                if (largest ? value > args[index].value() : value < args[index].value())
+                    index = i;
+            }
+            return args[index];
+        }
+
+        static value_type sum(Span<const value_type> args) noexcept
+        {
+            value_type result{args[0]};
+            for (std::size_t i{1}; i < args.size(); ++i)
+                result += args[i];
+            return result;
+        }
+
+        /** Function for hypot with any number of arguments.
+
+            The value is scaled as in Type::Standard::hypot and the
+            derivative is sum(x * x') / hypot.
+
+            @param  args    arguments
+            @return         square root of the sum of squares
+        */
+        static value_type hypot(Span<const value_type> args) noexcept
+        {
+            double largest{0.0};
+            for (const value_type& x : args)
+                largest = std::fmax(largest, std::fabs(x.value()));
+
+            double value{largest};
+            if (args.size() == 2)
+            {
+                value = std::hypot(args[0].value(), args[1].value());
+            }
+            else if (largest != 0.0 && !std::isinf(largest) && !std::isnan(largest))
+            {
+                double squares{0.0};
+                for (const value_type& x : args)
+                    squares += (x.value() / largest) * (x.value() / largest);
+                value = largest * std::sqrt(squares);
+            }
+
+            typename value_type::tangent_type tangent{};
+            if (value != 0.0)
+            {
+                for (const value_type& x : args)
+                    for (std::size_t i{0}; i < N; ++i)
+                        tangent[i] += x.value() / value * x.tangent()[i];
+            }
+            return value_type{value, tangent};
+        }
+
+        /** Table with the included functions with several arguments.
+
+        */
+        static constexpr auto variadics = makeStaticTable<variadic_type>(
+            std::pair{"min", variadic_type{[](Span<const value_type> x) {
+                          return select(x, false);
+                      }}},
+            std::pair{"max", variadic_type{[](Span<const value_type> x) {
+                          return select(x, true);
+                      }}},
+            std::pair{"sum", variadic_type{&Dual::sum}},
+            std::pair{"mean", variadic_type{[](Span<const value_type> x) {
+                          return sum(x) / value_type{static_cast<double>(x.size())};
+                      }}},
+            std::pair{"hypot", variadic_type{&Dual::hypot, 2}},
+            std::pair{"atan2", variadic_type{[](Span<const value_type> x) {
+                                                 return atan2(x[0], x[1]);
+                                             },
+                                             2, 2}});
+
+        /** Function for converting a string to a constant.
+
+            Implemented with std::stod as Type::Double.
+
+            @param  str     string to convert
+            @return         value with zero derivatives
+        */
+        [[nodiscard]] value_type stot(const std::string& str) noexcept
+        {
+            return value_type{std::stod(str)};
+        }
+
+        /** Function for retrieving a math constant from certain string.
+
+            Same values as Type::Standard, with zero derivatives.
+
+            @param  str     name of constant
+            @return         constant value as an std::optional
+        */
+        [[nodiscard]] std::optional<value_type> constant(const std::string& str) noexcept
+        {
+            if (auto value = Standard::constants.find(str))
+                return value_type{*value};
+            return std::nullopt;
+        }
+
+        /** Function for retrieving a math function from certain string.
+
+            @param  str     name of function
+            @return         math function as an std::optional
+        */
+        [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept
+        {
+            return functions.find(str);
+        }
+
+        /** Function for retrieving a math function with several arguments from certain string.
+
+            @param  str     name of function
+            @return         math function as an std::optional
+        */
+        [[nodiscard]] std::optional<variadic_type> variadic(const std::string& str) noexcept
+        {
+            return variadics.find(str);
+        }
+    };
+
+} // namespace CalcEval::Type
+
+#endif // CALCEVAL_TYPE_DUAL_HPP
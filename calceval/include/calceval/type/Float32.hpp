@@ -0,0 +1,44 @@
+//
+//  type/Float32.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_TYPE_FLOAT32_HPP
+#define CALCEVAL_TYPE_FLOAT32_HPP
+
+// Local Headers
+#include "Base.hpp"
+
+// C++ Headers
+#include <cstdlib>
+
+namespace CalcEval::Type
+{
+    /** Type::Float32 struct implementation.
+
+        Inherits the Type::Base and implements it for float type.
+
+        stot member function is implemented with std::strtof, so literals
+        are rounded once directly to float and never go through double.
+    */
+    struct Float32 : public Base<float>
+    {
+        /** Function for converting a string to float.
+
+            Implemented with std::strtof. Literals too large for a float
+            become inf and literals too small become 0.
+
+            @param  str     string to convert
+            @return         value
+        */
+        [[nodiscard]] value_type stot(const std::string& str) noexcept
+        {
+            return std::strtof(str.c_str(), nullptr);
+        }
+    };
+
+} // namespace CalcEval::Type
+
+#endif // CALCEVAL_TYPE_FLOAT32_HPP
@@ -0,0 +1,226 @@
+//
+//  type/Int64.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_TYPE_INT64_HPP
+#define CALCEVAL_TYPE_INT64_HPP
+
+// Local Headers
+#include "Base.hpp"
+#include "calceval/Error.hpp"
+
+// C++ Headers
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <system_error>
+
+namespace CalcEval::Type
+{
+    namespace Detail
+    {
+        // Overflow checked arithmetic, returns true on overflow. Uses the
+        // compiler builtins when available, they compile to the operation
+        // followed by a branch on the overflow flag.
+        inline bool addOverflow(std::int64_t a, std::int64_t b, std::int64_t* result) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_add_overflow(a, b, result);
+#else
+            if ((b > 0 && a > std::numeric_limits<std::int64_t>::max() - b) ||
+                (b < 0 && a < std::numeric_limits<std::int64_t>::min() - b))
+                return true;
+            *result = a + b;
+            return false;
+#endif
+        }
+
+        inline bool subOverflow(std::int64_t a, std::int64_t b, std::int64_t* result) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_sub_overflow(a, b, result);
+#else
+            if ((b < 0 && a > std::numeric_limits<std::int64_t>::max() + b) ||
+                (b > 0 && a < std::numeric_limits<std::int64_t>::min() + b))
+                return true;
+            *result = a - b;
+            return false;
+#endif
+        }
+
+        inline bool mulOverflow(std::int64_t a, std::int64_t b, std::int64_t* result) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_mul_overflow(a, b, result);
+#else
+            constexpr std::int64_t max{std::numeric_limits<std::int64_t>::max()};
+            constexpr std::int64_t min{std::numeric_limits<std::int64_t>::min()};
+            if (a > 0)
+            {
+                if ((b > 0) ? a > max / b : b < min / a)
+                    return true;
+            }
+            else if (a < 0)
+            {
+                if ((b > 0) ? a < min / b : (b != 0 && b < max / a))
+                    return true;
+            }
+            *result = a * b;
+            return false;
+#endif
+        }
+
+    } // namespace Detail
+
+    /** Type::Int64 struct implementation.
+
+        Inherits the Type::Base and implements it for std::int64_t with
+        exact integer arithmetic. Every operation is checked and throws
+        ArithmeticError instead of wrapping around or being undefined:
+
+            - a literal that is not an integer (1.5, 1e3) or does not fit.
+            - overflow in +, -, * and ^ (also -x for the smallest value).
+            - division by zero, 0 to a negative power.
+
+        Division truncates towards zero as in C++ (7/2 is 3, -7/2 is -3)
+        and a negative power is the integer division 1/x^n, so it is 0
+        unless x is 1 or -1.
+
+        ^ uses exponentiation by squaring, at most 2*63 multiplications.
+
+        Usage:
+            CalcEval::Parser<CalcEval::Type::Int64> parser{};
+            std::int64_t value{parser.parse("3^39 + 1")};
+    */
+    struct Int64 : public Base<std::int64_t>
+    {
+        /** Function for converting a string to an integer.
+
+            Implemented with std::from_chars, the string must only have
+            decimal digits.
+
+            @param  str     string to convert
+            @return         value
+        */
+        [[nodiscard]] value_type stot(const std::string& str)
+        {
+            value_type value{0};
+            const char* last{str.data() + str.size()};
+            const auto [ptr, ec] = std::from_chars(str.data(), last, value);
+
+            if (ec == std::errc::result_out_of_range)
+                throw ArithmeticError("Integer overflow: literal " + str +
+                                      " does not fit in 64 bits");
+            if (ec != std::errc{} || ptr != last)
+                throw ArithmeticError("Not an integer literal: " + str);
+
+            return value;
+        }
+
+        /** Function for checked addition.
+
+            @param  lhs     left hand side
+            @param  rhs     right hand side
+            @return         lhs + rhs
+        */
+        [[nodiscard]] static value_type add(value_type lhs, value_type rhs)
+        {
+            value_type result{};
+            if (Detail::addOverflow(lhs, rhs, &result))
+                overflow(lhs, " + ", rhs);
+            return result;
+        }
+
+        /** Function for checked subtraction.
+
+            @param  lhs     left hand side
+            @param  rhs     right hand side
+            @return         lhs - rhs
+        */
+        [[nodiscard]] static value_type subtract(value_type lhs, value_type rhs)
+        {
+            value_type result{};
+            if (Detail::subOverflow(lhs, rhs, &result))
+                overflow(lhs, " - ", rhs);
+            return result;
+        }
+
+        /** Function for checked multiplication.
+
+            @param  lhs     left hand side
+            @param  rhs     right hand side
+            @return         lhs * rhs
+        */
+        [[nodiscard]] static value_type multiply(value_type lhs, value_type rhs)
+        {
+            value_type result{};
+            if (Detail::mulOverflow(lhs, rhs, &result))
+                overflow(lhs, " * ", rhs);
+            return result;
+        }
+
+        /** Function for checked division, truncates towards zero.
+
+            @param  lhs     left hand side
+            @param  rhs     right hand side
+            @return         lhs / rhs
+        */
+        [[nodiscard]] static value_type divide(value_type lhs, value_type rhs)
+        {
+            if (rhs == 0)
+                throw ArithmeticError("Division by zero: " + std::to_string(lhs) + " / 0");
+            if (rhs == -1 && lhs == std::numeric_limits<value_type>::min())
+                overflow(lhs, " / ", rhs);
+            return lhs / rhs;
+        }
+
+        /** Function for checked power with exponentiation by squaring.
+
+            @param  base        base
+            @param  exponent    exponent
+            @return             base^exponent
+        */
+        [[nodiscard]] static value_type power(value_type base, value_type exponent)
+        {
+            if (exponent < 0)
+            {
+                if (base == 0)
+                    throw ArithmeticError("Division by zero: 0 ^ " + std::to_string(exponent));
+                if (base == -1)
+                    return (exponent % 2 == 0) ? 1 : -1;
+                return (base == 1) ? 1 : 0;
+            }
+
+            // base is only squared when a higher bit of the exponent is set,
+            // so if the square overflows the result would have as well.
+            const value_type b{base}, e{exponent};
+            value_type result{1};
+            while (true)
+            {
+                if ((exponent & 1) != 0 && Detail::mulOverflow(result, base, &result))
+                    overflow(b, " ^ ", e);
+
+                exponent >>= 1;
+                if (exponent == 0)
+                    return result;
+
+                if (Detail::mulOverflow(base, base, &base))
+                    overflow(b, " ^ ", e);
+            }
+        }
+
+    private:
+        [[noreturn]] static void overflow(value_type lhs, const char* op, value_type rhs)
+        {
+            throw ArithmeticError("Integer overflow: " + std::to_string(lhs) + op +
+                                  std::to_string(rhs));
+        }
+    };
+
+} // namespace CalcEval::Type
+
+#endif // CALCEVAL_TYPE_INT64_HPP
@@ -10,16 +10,16 @@
 
 // Local Headers
 #include "Double.hpp"
-
-// C++ Headers
-#include <map>
+#include "calceval/Kernel.hpp"
+#include "calceval/Reduce.hpp"
+#include "calceval/StaticTable.hpp"
 
 namespace CalcEval::Type
 {
     /** Type::Standard struct implementation.
 
-        Inherits the Type::Double and implements 2 constant values and
-        9 functions.
+        Inherits the Type::Double and implements 2 constant values,
+        9 functions and 6 functions with several arguments.
 
         Included constants:
             - pi : 3.14159265
@@ -36,9 +36,89 @@ namespace CalcEval::Type
             - arccos
             - arctan
 
+        Included functions with several arguments:
+            - min   : smallest argument
+            - max   : largest argument
+            - sum   : sum of the arguments
+            - mean  : arithmetic mean of the arguments
+            - hypot : square root of the sum of squares (at least 2 arguments)
+            - atan2 : arc tangent of y/x using the signs of both (exactly 2 arguments)
+
     */
     struct Standard : public Double
     {
+        /** Table with the included constants.
+
+            Looked up by constant below through a perfect hash, in the same
+            way as the functions. The values have 9 significant digits.
+        */
+        static constexpr auto constants = makeStaticTable<double>(std::pair{"pi", 3.14159265},
+                                                                  std::pair{"e", 2.71828183});
+
+        /** Table with the included functions.
+
+            Function pointers are resolved through a perfect hash, so
+            looking up a function costs a single hash and compare.
+        */
+        static constexpr auto functions = makeStaticTable<func_type>(
+            std::pair{"log", [](double x) { return std::log(x); }},
+            std::pair{"log10", [](double x) { return std::log10(x); }},
+            std::pair{"exp", [](double x) { return std::exp(x); }},
+            std::pair{"sin", [](double x) { return std::sin(x); }},
+            std::pair{"cos", [](double x) { return std::cos(x); }},
+            std::pair{"tan", [](double x) { return std::tan(x); }},
+            std::pair{"arcsin", [](double x) { return std::asin(x); }},
+            std::pair{"arccos", [](double x) { return std::acos(x); }},
+            std::pair{"arctan", [](double x) { return std::atan(x); }});
+
+        /** Table with vectorized versions of the included functions.
+
+            Applies a function to many values at once, see Kernel.hpp
+            for the accuracy of the exact and fast modes.
+        */
+        static constexpr auto batchFunctions = makeStaticTable<Kernel::func_type>(
+            std::pair{"log", &Kernel::log}, std::pair{"log10", &Kernel::log10},
+            std::pair{"exp", &Kernel::exp}, std::pair{"sin", &Kernel::sin},
+            std::pair{"cos", &Kernel::cos}, std::pair{"tan", &Kernel::tan},
+            std::pair{"arcsin", &Kernel::asin}, std::pair{"arccos", &Kernel::acos},
+            std::pair{"arctan", &Kernel::atan});
+
+        /** Function for hypot with any number of arguments.
+
+            Scales by the largest magnitude to avoid overflow and underflow.
+
+            @param  args    arguments
+            @return         square root of the sum of squares
+        */
+        static double hypot(Span<const double> args) noexcept
+        {
+            if (args.size() == 2)
+                return std::hypot(args[0], args[1]);
+
+            const double largest{Reduce::maxAbs(args)};
+            if (largest == 0.0 || std::isinf(largest) || std::isnan(largest))
+                return largest;
+
+            return largest * std::sqrt(Reduce::sumOfSquares(args, 1.0 / largest));
+        }
+
+        /** Table with the included functions with several arguments.
+
+            Reductions over many arguments are vectorized, see Reduce.hpp.
+        */
+        static constexpr auto variadics = makeStaticTable<variadic_type>(
+            std::pair{"min", variadic_type{[](Span<const double> x) { return Reduce::min(x); }}},
+            std::pair{"max", variadic_type{[](Span<const double> x) { return Reduce::max(x); }}},
+            std::pair{"sum", variadic_type{[](Span<const double> x) { return Reduce::sum(x); }}},
+            std::pair{"mean", variadic_type{[](Span<const double> x) {
+                          return Reduce::sum(x) / static_cast<double>(x.size());
+                      }}},
+            std::pair{"hypot", variadic_type{&Standard::hypot, 2}},
+            std::pair{"atan2", variadic_type{[](Span<const double> x) {
+                                                 return std::atan2(x[0], x[1]);
+                                             },
+                                             2, 2}});
+
         /** Function for retrieving a math constant from certain string.
 
             Included constants:
@@ -50,14 +130,9 @@ namespace CalcEval::Type
             @param  str     name of constant
             @return         constant value as an std::optional
         */
-        [[nodiscard]] std::optional<double> constant(const std::string& str) noexcept override
+        [[nodiscard]] std::optional<double> constant(const std::string& str) noexcept
         {
-            if (str == "pi")
-                return 3.14159265;
-            else if (str == "e")
-                return 2.71828183;
-
-            return std::nullopt;
+            return constants.find(str);
         }
 
         /** Function for retrieving a math function from certain string.
@@ -78,27 +153,44 @@ namespace CalcEval::Type
             @param  str     name of function
             @return         math function as an std::optional
         */
-        [[nodiscard]] std::optional<Base<double>::func_type> function(const std::string& str) noexcept override
+        [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept
+        {
+            return functions.find(str);
+        }
+
+        /** Function for retrieving a math function with several arguments from certain string.
+
+            Included functions:
+                - min
+                - max
+                - sum
+                - mean
+                - hypot
+                - atan2
+
+            Otherwise returns std::nullopt.
+
+            @param  str     name of function
+            @return         math function as an std::optional
+        */
+        [[nodiscard]] std::optional<variadic_type> variadic(const std::string& str) noexcept
+        {
+            return variadics.find(str);
+        }
+
+        /** Function for retrieving a vectorized math function from certain string.
+
+            Available for all the single-argument functions.
+
+            Otherwise returns std::nullopt.
+
+            @param  str     name of function
+            @return         vectorized math function as an std::optional
+        */
+        [[nodiscard]] std::optional<Kernel::func_type> batchFunction(
+            const std::string& str) noexcept
         {
-            const std::map<std::string_view, Base<double>::func_type> funcs
-            {
-                std::pair{"log", [](double x) { return std::log(x); }},
-                std::pair{"log10", [](double x) { return std::log10(x); }},
-                std::pair{"exp", [](double x) { return std::exp(x); }},
-                std::pair{"sin", [](double x) { return std::sin(x); }},
-                std::pair{"cos", [](double x) { return std::cos(x); }},
-                std::pair{"tan", [](double x) { return std::tan(x); }},
-                std::pair{"arcsin", [](double x) { return std::asin(x); }},
-                std::pair{"arccos", [](double x) { return std::acos(x); }},
-                std::pair{"arctan", [](double x) { return std::atan(x); }}
-            };
-
-            const auto search = funcs.find(str);
-
-            if (search != funcs.cend())
-                return search->second;
-
-            return std::nullopt;
+            return batchFunctions.find(str);
         }
     };
 
@@ -0,0 +1,127 @@
+//
+//  type/StandardFloat32.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_TYPE_STANDARDFLOAT32_HPP
+#define CALCEVAL_TYPE_STANDARDFLOAT32_HPP
+
+// Local Headers
+#include "Float32.hpp"
+#include "calceval/Reduce.hpp"
+#include "calceval/StaticTable.hpp"
+
+// C++ Headers
+#include <cmath>
+
+namespace CalcEval::Type
+{
+    /** Type::StandardFloat32 struct implementation.
+
+        Single precision version of Type::Standard. Inherits the
+        Type::Float32 and implements the same constants and functions,
+        all of them computed with the float overloads in <cmath>.
+
+        Usage:
+            CalcEval::Parser<CalcEval::Type::StandardFloat32> parser{};
+            float value{parser.parse("sin(pi/4)")};
+    */
+    struct StandardFloat32 : public Float32
+    {
+        /** Table with the included constants.
+
+        */
+        static constexpr auto constants = makeStaticTable<float>(
+            std::pair{"pi", 3.14159265f}, std::pair{"e", 2.71828183f});
+
+        /** Table with the included functions.
+
+        */
+        static constexpr auto functions = makeStaticTable<func_type>(
+            std::pair{"log", [](float x) { return std::log(x); }},
+            std::pair{"log10", [](float x) { return std::log10(x); }},
+            std::pair{"exp", [](float x) { return std::exp(x); }},
+            std::pair{"sin", [](float x) { return std::sin(x); }},
+            std::pair{"cos", [](float x) { return std::cos(x); }},
+            std::pair{"tan", [](float x) { return std::tan(x); }},
+            std::pair{"arcsin", [](float x) { return std::asin(x); }},
+            std::pair{"arccos", [](float x) { return std::acos(x); }},
+            std::pair{"arctan", [](float x) { return std::atan(x); }});
+
+        /** Function for hypot with any number of arguments.
+
+            Scales by the largest magnitude to avoid overflow and underflow.
+
+            @param  args    arguments
+            @return         square root of the sum of squares
+        */
+        static float hypot(Span<const float> args) noexcept
+        {
+            if (args.size() == 2)
+                return std::hypot(args[0], args[1]);
+
+            const float largest{Reduce::maxAbs(args)};
+            if (largest == 0.0f || std::isinf(largest) || std::isnan(largest))
+                return largest;
+
+            return largest * std::sqrt(Reduce::sumOfSquares(args, 1.0f / largest));
+        }
+
+        /** Table with the included functions with several arguments.
+
+        */
+        static constexpr auto variadics = makeStaticTable<variadic_type>(
+            std::pair{"min", variadic_type{[](Span<const float> x) { return Reduce::min(x); }}},
+            std::pair{"max", variadic_type{[](Span<const float> x) { return Reduce::max(x); }}},
+            std::pair{"sum", variadic_type{[](Span<const float> x) { return Reduce::sum(x); }}},
+            std::pair{"mean", variadic_type{[](Span<const float> x) {
+                          return Reduce::sum(x) / static_cast<float>(x.size());
+                      }}},
+            std::pair{"hypot", variadic_type{&StandardFloat32::hypot, 2}},
+            std::pair{"atan2", variadic_type{[](Span<const float> x) {
+                                                 return std::atan2(x[0], x[1]);
+                                             },
+                                             2, 2}});
+
+        /** Function for retrieving a math constant from certain string.
+
+            Same constants as Type::Standard.
+
+            @param  str     name of constant
+            @return         constant value as an std::optional
+        */
+        [[nodiscard]] std::optional<float> constant(const std::string& str) noexcept
+        {
+            return constants.find(str);
+        }
+
+        /** Function for retrieving a math function from certain string.
+
+            Same functions as Type::Standard.
+
+            @param  str     name of function
+            @return         math function as an std::optional
+        */
+        [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept
+        {
+            return functions.find(str);
+        }
+
+        /** Function for retrieving a math function with several arguments from certain string.
+
+            Same functions as Type::Standard.
+
+            @param  str     name of function
+            @return         math function as an std::optional
+        */
+        [[nodiscard]] std::optional<variadic_type> variadic(const std::string& str) noexcept
+        {
+            return variadics.find(str);
+        }
+    };
+
+} // namespace CalcEval::Type
+
+#endif // CALCEVAL_TYPE_STANDARDFLOAT32_HPP
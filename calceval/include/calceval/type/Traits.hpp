@@ -0,0 +1,260 @@
+//
+//  type/Traits.hpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+#ifndef CALCEVAL_TYPE_TRAITS_HPP
+#define CALCEVAL_TYPE_TRAITS_HPP
+
+// Local Headers
+#include "calceval/Function.hpp"
+#include "calceval/Kernel.hpp"
+
+// C++ Headers
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace CalcEval::Type
+{
+    namespace Detail
+    {
+        // Detection idiom, see std::experimental::is_detected.
+        template<typename, template<typename...> class Op, typename... Args>
+        struct Detector : std::false_type
+        {
+        };
+
+        template<template<typename...> class Op, typename... Args>
+        struct Detector<std::void_t<Op<Args...>>, Op, Args...> : std::true_type
+        {
+        };
+
+        template<typename T>
+        using ValueType = typename T::value_type;
+
+        template<typename T>
+        using Stot = decltype(std::declval<T&>().stot(std::declval<const std::string&>()));
+
+        template<typename T>
+        using Constant = decltype(std::declval<T&>().constant(std::declval<const std::string&>()));
+
+        template<typename T>
+        using Function = decltype(std::declval<T&>().function(std::declval<const std::string&>()));
+
+        template<typename T>
+        using VariadicFunction =
+            decltype(std::declval<T&>().variadic(std::declval<const std::string&>()));
+
+        template<typename T>
+        using BatchFunction =
+            decltype(std::declval<T&>().batchFunction(std::declval<const std::string&>()));
+
+        template<typename T>
+        using BatchOperator = decltype(std::declval<T&>().batchOperator(std::declval<char>()));
+
+        template<typename T>
+        using FunctionCall =
+            decltype((*std::declval<Function<T>&>())(std::declval<typename T::value_type>()));
+
+        template<typename T>
+        using Add = decltype(std::declval<T&>().add(std::declval<typename T::value_type>(),
+                                                    std::declval<typename T::value_type>()));
+
+        template<typename T>
+        using Subtract = decltype(std::declval<T&>().subtract(
+            std::declval<typename T::value_type>(), std::declval<typename T::value_type>()));
+
+        template<typename T>
+        using Multiply = decltype(std::declval<T&>().multiply(
+            std::declval<typename T::value_type>(), std::declval<typename T::value_type>()));
+
+        template<typename T>
+        using Divide = decltype(std::declval<T&>().divide(std::declval<typename T::value_type>(),
+                                                          std::declval<typename T::value_type>()));
+
+        template<typename T>
+        using Power = decltype(std::declval<T&>().power(std::declval<typename T::value_type>(),
+                                                        std::declval<typename T::value_type>()));
+
+        template<typename T>
+        using Less = decltype(std::declval<const typename T::value_type&>() <
+                              std::declval<const typename T::value_type&>());
+
+        template<typename T>
+        using Equal = decltype(std::declval<const typename T::value_type&>() ==
+                               std::declval<const typename T::value_type&>());
+
+        // Op<T> is valid and returns something convertible to value_type.
+        template<template<typename> class Op, typename T>
+        constexpr bool returnsValue()
+        {
+            if constexpr (Detector<void, ValueType, T>::value && Detector<void, Op, T>::value)
+                return std::is_convertible_v<Op<T>, typename T::value_type>;
+            else
+                return false;
+        }
+
+    } // namespace Detail
+
+    /** Checks if Op<Args...> is a valid expression.
+
+    */
+    template<template<typename...> class Op, typename... Args>
+    inline constexpr bool isDetected = Detail::Detector<void, Op, Args...>::value;
+
+    /** Checks if T has a stot member function that returns value_type.
+
+    */
+    template<typename T>
+    inline constexpr bool hasStot = []() {
+        if constexpr (isDetected<Detail::ValueType, T> && isDetected<Detail::Stot, T>)
+            return std::is_convertible_v<Detail::Stot<T>, typename T::value_type>;
+        else
+            return false;
+    }();
+
+    /** Checks if T has a constant member function that returns std::optional<value_type>.
+
+    */
+    template<typename T>
+    inline constexpr bool hasConstant = []() {
+        if constexpr (isDetected<Detail::ValueType, T> && isDetected<Detail::Constant, T>)
+            return std::is_same_v<std::decay_t<Detail::Constant<T>>,
+                                  std::optional<typename T::value_type>>;
+        else
+            return false;
+    }();
+
+    /** Checks if T has a function member function returning an std::optional with
+        something that can be called with a value_type and returns a value_type.
+
+    */
+    template<typename T>
+    inline constexpr bool hasFunction = []() {
+        if constexpr (isDetected<Detail::ValueType, T> && isDetected<Detail::FunctionCall, T>)
+            return std::is_convertible_v<Detail::FunctionCall<T>, typename T::value_type>;
+        else
+            return false;
+    }();
+
+    /** Checks if T has a variadic member function that returns
+        std::optional<Variadic<value_type>>. This one is optional.
+
+    */
+    template<typename T>
+    inline constexpr bool hasVariadic = []() {
+        if constexpr (isDetected<Detail::ValueType, T> && isDetected<Detail::VariadicFunction, T>)
+            return std::is_same_v<std::decay_t<Detail::VariadicFunction<T>>,
+                                  std::optional<Variadic<typename T::value_type>>>;
+        else
+            return false;
+    }();
+
+    /** Checks if T has a batchFunction member function that returns
+        std::optional<Kernel::func_type>, a vectorized version of a function
+        used when evaluating an Expression over many values. This one is
+        optional.
+
+    */
+    template<typename T>
+    inline constexpr bool hasBatchFunction = []() {
+        if constexpr (isDetected<Detail::BatchFunction, T>)
+            return std::is_same_v<std::decay_t<Detail::BatchFunction<T>>,
+                                  std::optional<Kernel::func_type>>;
+        else
+            return false;
+    }();
+
+    /** Checks if T has a batchOperator member function that takes one of
+        the chars + - * / ^ and returns std::optional<Kernel::binary_type>,
+        a vectorized version of the operator used when evaluating an
+        Expression over many values. This one is optional, operators
+        without a vectorized version use the built-in SIMD code.
+
+    */
+    template<typename T>
+    inline constexpr bool hasBatchOperator = []() {
+        if constexpr (isDetected<Detail::BatchOperator, T>)
+            return std::is_same_v<std::decay_t<Detail::BatchOperator<T>>,
+                                  std::optional<Kernel::binary_type>>;
+        else
+            return false;
+    }();
+
+    /** Checks if T has add, subtract, multiply, divide and power member
+        functions that take two value_type and return a value_type. These are
+        optional, one by one, and are used by the parser instead of the
+        operators + - * / and pow when available, for example to check for
+        overflow. Unary minus is a multiplication by -1.
+
+    */
+    template<typename T>
+    inline constexpr bool hasAdd = Detail::returnsValue<Detail::Add, T>();
+
+    template<typename T>
+    inline constexpr bool hasSubtract = Detail::returnsValue<Detail::Subtract, T>();
+
+    template<typename T>
+    inline constexpr bool hasMultiply = Detail::returnsValue<Detail::Multiply, T>();
+
+    template<typename T>
+    inline constexpr bool hasDivide = Detail::returnsValue<Detail::Divide, T>();
+
+    template<typename T>
+    inline constexpr bool hasPower = Detail::returnsValue<Detail::Power, T>();
+
+    /** Checks if value_type of T can be compared with < and ==. Needed to
+        step the index of sum and prod from the first to the last value,
+        and for comparisons and conditionals.
+
+    */
+    template<typename T>
+    inline constexpr bool isOrdered = []() {
+        if constexpr (isDetected<Detail::Less, T> && isDetected<Detail::Equal, T>)
+            return std::is_convertible_v<Detail::Less<T>, bool> &&
+                   std::is_convertible_v<Detail::Equal<T>, bool>;
+        else
+            return false;
+    }();
+
+    /** Checks if T fulfills the contract of a CalcType.
+
+        The parser calls these member functions directly on T without
+        any virtual dispatch, so T is usually derived from Type::Base
+        which provides value_type and default constant and function.
+    */
+    template<typename T>
+    inline constexpr bool isCalcType = std::is_default_constructible_v<T> && hasStot<T> &&
+                                       hasConstant<T> && hasFunction<T>;
+
+    /** Checks if T can be compiled to an Expression. The compiled code
+        works on double and uses the built-in operators, so T must have
+        double as value_type and none of add, subtract, multiply, divide
+        and power, otherwise the result would not be the same as from the
+        parser.
+
+    */
+    template<typename T>
+    inline constexpr bool isCompilable = []() {
+        if constexpr (isCalcType<T>)
+            return std::is_same_v<typename T::value_type, double> && !hasAdd<T> &&
+                   !hasSubtract<T> && !hasMultiply<T> && !hasDivide<T> && !hasPower<T>;
+        else
+            return false;
+    }();
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+    /** Concept version of isCalcType when concepts are available.
+
+    */
+    template<typename T>
+    concept CalcType = isCalcType<T>;
+#endif
+
+} // namespace CalcEval::Type
+
+#endif // CALCEVAL_TYPE_TRAITS_HPP
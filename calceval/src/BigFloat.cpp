@@ -0,0 +1,1371 @@
+//
+//  BigFloat.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/BigFloat.hpp"
+#include "calceval/Error.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace CalcEval
+{
+    namespace Detail
+    {
+        LimbVector::LimbVector(const LimbVector& other)
+        {
+            assign(other.data(), other.size());
+        }
+
+        LimbVector::LimbVector(LimbVector&& other) noexcept
+            : m_size{other.m_size}, m_capacity{other.m_capacity}, m_heap{std::move(other.m_heap)},
+              m_inline{other.m_inline}
+        {
+            other.m_size = 0;
+            other.m_capacity = inlineCapacity;
+        }
+
+        LimbVector& LimbVector::operator=(const LimbVector& other)
+        {
+            if (this != &other)
+                assign(other.data(), other.size());
+            return *this;
+        }
+
+        LimbVector& LimbVector::operator=(LimbVector&& other) noexcept
+        {
+            if (this != &other)
+            {
+                m_size = other.m_size;
+                m_capacity = other.m_capacity;
+                m_heap = std::move(other.m_heap);
+                m_inline = other.m_inline;
+                other.m_size = 0;
+                other.m_capacity = inlineCapacity;
+            }
+            return *this;
+        }
+
+        void LimbVector::assign(const value_type* limbs, std::size_t count)
+        {
+            // Keep the memory if it is large enough, drop it if inline is.
+            if (count <= inlineCapacity && m_heap)
+            {
+                m_heap.reset();
+                m_capacity = inlineCapacity;
+            }
+            m_size = 0;
+            reserve(count);
+            if (count > 0)
+                std::memmove(data(), limbs, count * sizeof(value_type));
+            m_size = count;
+        }
+
+        void LimbVector::resize(std::size_t size)
+        {
+            // Moved back inline when it fits, rounding often shortens a value.
+            if (size <= inlineCapacity && m_heap)
+            {
+                m_size = std::min(size, m_size);
+                std::memcpy(m_inline.data(), m_heap.get(), m_size * sizeof(value_type));
+                m_heap.reset();
+                m_capacity = inlineCapacity;
+            }
+
+            reserve(size);
+            if (size > m_size)
+                std::fill(data() + m_size, data() + size, value_type{0});
+            m_size = size;
+        }
+
+        void LimbVector::eraseFront(std::size_t count) noexcept
+        {
+            count = std::min(count, m_size);
+            if (count > 0)
+                std::memmove(data(), data() + count, (m_size - count) * sizeof(value_type));
+            m_size -= count;
+        }
+
+        void LimbVector::reserve(std::size_t capacity)
+        {
+            if (capacity <= m_capacity)
+                return;
+
+            std::unique_ptr<value_type[]> heap{new value_type[capacity]};
+            if (m_size > 0)
+                std::memcpy(heap.get(), data(), m_size * sizeof(value_type));
+            m_heap = std::move(heap);
+            m_capacity = capacity;
+        }
+
+    } // namespace Detail
+
+    ///////////////////////////////////////////////////////////////////////////////
+
+    namespace
+    {
+        using limb_type = BigFloat::limb_type;
+        constexpr std::uint64_t base{std::uint64_t{1} << 32};
+        constexpr std::size_t karatsubaThreshold{32};
+
+        // Operands longer than this make the operations allocate.
+        constexpr std::size_t stackLimbs{64};
+
+        // Zeroed temporary limbs, on the stack when short.
+        class Buffer
+        {
+        public:
+            explicit Buffer(std::size_t size) : m_heap(size > stackLimbs ? size : 0)
+            {
+                std::fill(m_stack.begin(), m_stack.end(), limb_type{0});
+            }
+
+            [[nodiscard]] limb_type* data() noexcept
+            {
+                return m_heap.empty() ? m_stack.data() : m_heap.data();
+            }
+
+        private:
+            std::array<limb_type, stackLimbs> m_stack;
+            std::vector<limb_type> m_heap;
+        };
+
+        limb_type low(std::uint64_t value) noexcept
+        {
+            return static_cast<limb_type>(value & 0xffffffffu);
+        }
+
+        limb_type high(std::uint64_t value) noexcept
+        {
+            return static_cast<limb_type>(value >> 32);
+        }
+
+        // Number of bits needed for value, 0 for 0.
+        int bitWidth(std::uint64_t value) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return (value == 0) ? 0 : 64 - __builtin_clzll(value);
+#else
+            int width{0};
+            while (value != 0)
+            {
+                ++width;
+                value >>= 1;
+            }
+            return width;
+#endif
+        }
+
+        std::size_t limbsFor(std::uint32_t precision) noexcept
+        {
+            return (std::size_t{precision} + 31) / 32;
+        }
+
+        // Floor division by 32 that also works for negative values.
+        std::int64_t limbOf(std::int64_t bit) noexcept
+        {
+            return (bit >= 0) ? bit / 32 : -((-bit + 31) / 32);
+        }
+
+        // a += b, returns the carry out. a has n limbs, b has m <= n limbs.
+        limb_type addTo(limb_type* a, std::size_t n, const limb_type* b, std::size_t m) noexcept
+        {
+            std::uint64_t carry{0};
+            for (std::size_t i{0}; i < n; ++i)
+            {
+                carry += std::uint64_t{a[i]} + ((i < m) ? b[i] : 0u);
+                a[i] = low(carry);
+                carry >>= 32;
+                if (i >= m && carry == 0)
+                    break;
+            }
+            return static_cast<limb_type>(carry);
+        }
+
+        // a -= b with a >= b. a has n limbs, b has m <= n limbs.
+        void subtractFrom(limb_type* a, std::size_t n, const limb_type* b, std::size_t m) noexcept
+        {
+            std::uint64_t borrow{0};
+            for (std::size_t i{0}; i < n; ++i)
+            {
+                const std::uint64_t sub{((i < m) ? b[i] : 0u) + borrow};
+                borrow = (std::uint64_t{a[i]} < sub) ? 1 : 0;
+                a[i] = low(std::uint64_t{a[i]} + (borrow << 32) - sub);
+                if (i >= m && borrow == 0)
+                    break;
+            }
+        }
+
+        int compare(const limb_type* a, const limb_type* b, std::size_t n) noexcept
+        {
+            for (std::size_t i{n}; i-- > 0;)
+                if (a[i] != b[i])
+                    return (a[i] < b[i]) ? -1 : 1;
+            return 0;
+        }
+
+        // out[0, n + m) = a * b, out must be zeroed.
+        void schoolbook(const limb_type* a, std::size_t n, const limb_type* b, std::size_t m,
+                        limb_type* out) noexcept
+        {
+            for (std::size_t i{0}; i < n; ++i)
+            {
+                std::uint64_t carry{0};
+                for (std::size_t j{0}; j < m; ++j)
+                {
+                    carry += std::uint64_t{a[i]} * b[j] + out[i + j];
+                    out[i + j] = low(carry);
+                    carry >>= 32;
+                }
+                out[i + m] = low(carry);
+            }
+        }
+
+        // out[0, 2n) = a * b with both n limbs, out must be zeroed.
+        void karatsuba(const limb_type* a, const limb_type* b, std::size_t n, limb_type* out)
+        {
+            if (n < karatsubaThreshold)
+            {
+                schoolbook(a, n, b, n, out);
+                return;
+            }
+
+            // a = a1 * B^h + a0, b = b1 * B^h + b0
+            // a * b = z2 * B^2h + (z1 - z2 - z0) * B^h + z0
+            const std::size_t h{n / 2}, hi{n - h};
+            std::vector<limb_type> z0(2 * h), z1(2 * (hi + 1)), sa(hi + 1), sb(hi + 1);
+
+            karatsuba(a, b, h, z0.data());
+            karatsuba(a + h, b + h, hi, out + 2 * h);
+
+            std::copy(a + h, a + n, sa.begin());
+            std::copy(b + h, b + n, sb.begin());
+            addTo(sa.data(), hi + 1, a, h);
+            addTo(sb.data(), hi + 1, b, h);
+            karatsuba(sa.data(), sb.data(), hi + 1, z1.data());
+
+            subtractFrom(z1.data(), z1.size(), z0.data(), z0.size());
+            subtractFrom(z1.data(), z1.size(), out + 2 * h, 2 * hi);
+
+            std::copy(z0.begin(), z0.end(), out);
+            std::size_t used{z1.size()};
+            while (used > 0 && z1[used - 1] == 0)
+                --used;
+            addTo(out + h, 2 * n - h, z1.data(), used);
+        }
+
+        // out[0, n + m) = a * b, out must be zeroed.
+        void multiply(const limb_type* a, std::size_t n, const limb_type* b, std::size_t m,
+                      limb_type* out)
+        {
+            if (n < m)
+            {
+                std::swap(a, b);
+                std::swap(n, m);
+            }
+
+            // Karatsuba when the operands are long and of about the same
+            // length, the shorter is padded with zeros.
+            if (m >= karatsubaThreshold && 2 * m >= n)
+            {
+                std::vector<limb_type> padded(n, 0), product(2 * n, 0);
+                std::copy(b, b + m, padded.begin());
+                karatsuba(a, padded.data(), n, product.data());
+                std::copy(product.begin(), product.begin() + static_cast<std::ptrdiff_t>(n + m),
+                          out);
+            }
+            else
+            {
+                schoolbook(a, n, b, m, out);
+            }
+        }
+
+        // q[0, m - n + 1) = u / v, returns true if the remainder is not zero.
+        // u has m limbs, v has n <= m limbs and v[n - 1] != 0 (Knuth algorithm D).
+        bool divide(const limb_type* u, std::size_t m, const limb_type* v, std::size_t n,
+                    limb_type* q)
+        {
+            if (n == 1)
+            {
+                std::uint64_t rem{0};
+                for (std::size_t j{m}; j-- > 0;)
+                {
+                    rem = (rem << 32) | u[j];
+                    q[j] = low(rem / v[0]);
+                    rem %= v[0];
+                }
+                return rem != 0;
+            }
+
+            // Normalize so that the top bit of the divisor is set.
+            const int shift{32 - bitWidth(v[n - 1])};
+            Buffer vnBuffer{n}, unBuffer{m + 1};
+            limb_type* vn{vnBuffer.data()};
+            limb_type* un{unBuffer.data()};
+
+            const auto shifted = [shift](const limb_type* limbs, std::size_t i) {
+                return low((std::uint64_t{limbs[i]} << shift) |
+                           (std::uint64_t{limbs[i - 1]} >> (32 - shift)));
+            };
+
+            for (std::size_t i{n - 1}; i > 0; --i)
+                vn[i] = shifted(v, i);
+            vn[0] = low(std::uint64_t{v[0]} << shift);
+
+            un[m] = high(std::uint64_t{u[m - 1]} << shift);
+            for (std::size_t i{m - 1}; i > 0; --i)
+                un[i] = shifted(u, i);
+            un[0] = low(std::uint64_t{u[0]} << shift);
+
+            for (std::size_t j{m - n + 1}; j-- > 0;)
+            {
+                // Estimate the quotient limb from the top two limbs, it is at
+                // most two too large after the correction.
+                const std::uint64_t top{(std::uint64_t{un[j + n]} << 32) | un[j + n - 1]};
+                std::uint64_t qhat{top / vn[n - 1]};
+                std::uint64_t rhat{top % vn[n - 1]};
+                while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+                {
+                    --qhat;
+                    rhat += vn[n - 1];
+                    if (rhat >= base)
+                        break;
+                }
+
+                // un[j, j + n] -= qhat * vn
+                std::uint64_t carry{0}, borrow{0};
+                for (std::size_t i{0}; i < n; ++i)
+                {
+                    const std::uint64_t product{qhat * vn[i] + carry};
+                    carry = product >> 32;
+                    const std::uint64_t sub{(product & 0xffffffffu) + borrow};
+                    borrow = (std::uint64_t{un[i + j]} < sub) ? 1 : 0;
+                    un[i + j] = low(std::uint64_t{un[i + j]} + (borrow << 32) - sub);
+                }
+                const std::uint64_t sub{carry + borrow};
+                const bool negative{std::uint64_t{un[j + n]} < sub};
+                un[j + n] = low(std::uint64_t{un[j + n]} - sub);
+
+                // Added back when qhat was one too large, rare.
+                if (negative)
+                {
+                    --qhat;
+                    un[j + n] += addTo(un + j, n, vn, n);
+                }
+
+                q[j] = low(qhat);
+            }
+
+            for (std::size_t i{0}; i < n; ++i)
+                if (un[i] != 0)
+                    return true;
+            return false;
+        }
+
+        struct Cache
+        {
+            std::uint32_t precision{0};
+            BigFloat value{};
+        };
+
+        // Constants are computed with some extra bits so that a cached value
+        // can be rounded to any lower precision.
+        template<typename Compute>
+        BigFloat cached(Cache& cache, std::uint32_t precision, Compute compute)
+        {
+            if (cache.precision < precision)
+            {
+                const std::uint32_t wanted{std::max(precision, cache.precision * 2) + 32};
+                cache.value = compute(wanted);
+                cache.precision = wanted;
+            }
+            return cache.value.withPrecision(precision);
+        }
+
+    } // namespace
+
+    ///////////////////////////////////////////////////////////////////////////////
+
+    BigFloat::BigFloat(std::int64_t value)
+    {
+        const auto bits{static_cast<std::uint64_t>(value)};
+        const std::uint64_t magnitude{(value < 0) ? std::uint64_t{0} - bits : bits};
+        const std::array<limb_type, 2> limbs{low(magnitude), high(magnitude)};
+        m_limbs.assign(limbs.data(), 2);
+        m_negative = value < 0;
+        trim();
+    }
+
+    BigFloat BigFloat::fromDouble(double value)
+    {
+        if (!std::isfinite(value))
+            throw ArithmeticError("Not a finite number");
+
+        int exponent{0};
+        const double fraction{std::frexp(std::fabs(value), &exponent)};
+        const auto mantissa{static_cast<std::int64_t>(std::ldexp(fraction, 53))};
+        BigFloat result{ldexp(BigFloat{mantissa}, exponent - 53)};
+        result.m_negative = value < 0.0 && !result.isZero();
+        return result;
+    }
+
+    BigFloat BigFloat::fromString(const std::string& str, std::uint32_t precision)
+    {
+        std::vector<limb_type> digits{};
+        std::int64_t exponent{0};
+        std::size_t i{0}, count{0};
+        bool fraction{false};
+
+        // Digits are collected 9 at a time into an integer.
+        limb_type chunk{0}, scale{1};
+        const auto flush = [&digits, &chunk, &scale]() {
+            std::uint64_t carry{chunk};
+            for (limb_type& limb : digits)
+            {
+                carry += std::uint64_t{limb} * scale;
+                limb = low(carry);
+                carry >>= 32;
+            }
+            if (carry != 0)
+                digits.push_back(low(carry));
+            chunk = 0;
+            scale = 1;
+        };
+
+        for (; i < str.size(); ++i)
+        {
+            const char c{str[i]};
+            if (c == '.' && !fraction)
+            {
+                fraction = true;
+                continue;
+            }
+            if (c < '0' || c > '9')
+                break;
+
+            chunk = chunk * 10 + static_cast<limb_type>(c - '0');
+            scale *= 10;
+            ++count;
+            if (fraction)
+                --exponent;
+            if (scale == 1000000000)
+                flush();
+        }
+        flush();
+
+        if (i < str.size() && (str[i] == 'e' || str[i] == 'E'))
+        {
+            ++i;
+            const bool negative{i < str.size() && str[i] == '-'};
+            if (i < str.size() && (str[i] == '-' || str[i] == '+'))
+                ++i;
+
+            std::int64_t value{0};
+            const std::size_t start{i};
+            for (; i < str.size() && str[i] >= '0' && str[i] <= '9'; ++i)
+                value = std::min<std::int64_t>(value * 10 + (str[i] - '0'), 1000000000);
+            if (i == start)
+                count = 0;
+            exponent += negative ? -value : value;
+        }
+
+        if (count == 0 || i != str.size())
+            throw ArithmeticError("Not a number literal: " + str);
+
+        const std::uint32_t working{precision + 64};
+        BigFloat result{make(digits.data(), digits.size(), 0, false, working, false)};
+        if (exponent > 0)
+            result *= pow10(exponent, working);
+        else if (exponent < 0)
+            result /= pow10(-exponent, working);
+
+        return result.withPrecision(precision);
+    }
+
+    std::uint32_t BigFloat::precision() const noexcept
+    {
+        return m_precision;
+    }
+
+    BigFloat BigFloat::withPrecision(std::uint32_t precision) const
+    {
+        BigFloat result{*this};
+        result.m_precision = precision;
+        result.round(false);
+        return result;
+    }
+
+    bool BigFloat::isZero() const noexcept
+    {
+        return m_limbs.empty();
+    }
+
+    bool BigFloat::isNegative() const noexcept
+    {
+        return m_negative;
+    }
+
+    bool BigFloat::isInteger() const noexcept
+    {
+        return m_exponent >= 0;
+    }
+
+    bool BigFloat::isInline() const noexcept
+    {
+        return m_limbs.isInline();
+    }
+
+    std::optional<std::int64_t> BigFloat::toInt64() const noexcept
+    {
+        if (isZero())
+            return 0;
+        if (!isInteger() || magnitude() > 64)
+            return std::nullopt;
+
+        std::uint64_t value{0};
+        for (std::size_t i{m_limbs.size()}; i-- > 0;)
+            value = (value << 32) | m_limbs[i];
+        value <<= 32 * m_exponent;
+
+        // The magnitude of the smallest int64 is one more than the largest.
+        constexpr std::uint64_t limit{std::uint64_t{1} << 63};
+        if (value > limit || (value == limit && !m_negative))
+            return std::nullopt;
+        return m_negative ? static_cast<std::int64_t>(std::uint64_t{0} - value)
+                          : static_cast<std::int64_t>(value);
+    }
+
+    double BigFloat::toDouble() const noexcept
+    {
+        if (isZero())
+            return 0.0;
+
+        const std::int64_t mag{magnitude()};
+        if (mag > 1100)
+            return m_negative ? -std::numeric_limits<double>::infinity()
+                              : std::numeric_limits<double>::infinity();
+        if (mag < -1100)
+            return m_negative ? -0.0 : 0.0;
+
+        // At most 53 bits after rounding, so the sum below is exact.
+        BigFloat rounded{*this};
+        rounded.m_precision = 53;
+        rounded.round(false);
+
+        double result{0.0};
+        for (std::size_t i{rounded.m_limbs.size()}; i-- > 0;)
+        {
+            const std::int64_t position{rounded.m_exponent + static_cast<std::int64_t>(i)};
+            result += std::ldexp(static_cast<double>(rounded.m_limbs[i]),
+                                 static_cast<int>(32 * position));
+        }
+        return m_negative ? -result : result;
+    }
+
+    std::string BigFloat::toString(std::size_t digits) const
+    {
+        if (isZero())
+            return "0";
+
+        const std::uint32_t precision{workingPrecision(*this)};
+        if (digits == 0)
+            digits = std::max<std::size_t>(1, static_cast<std::size_t>(precision * 0.30103));
+
+        // scaled = |x| * 10^(digits - 1 - e10) rounded to an integer with
+        // exactly digits digits, e10 is adjusted if the estimate was off.
+        const auto working{static_cast<std::uint32_t>(static_cast<double>(digits) * 3.33) + 64};
+        const BigFloat absolute{abs(*this).withPrecision(working)};
+        auto e10{static_cast<std::int64_t>(
+            std::floor(static_cast<double>(magnitude() - 1) * 0.30102999566398120))};
+        const BigFloat upper{pow10(static_cast<std::int64_t>(digits), working)};
+        const BigFloat lower{pow10(static_cast<std::int64_t>(digits) - 1, working)};
+
+        BigFloat scaled{};
+        for (int tries{0}; tries < 4; ++tries)
+        {
+            const std::int64_t shift{static_cast<std::int64_t>(digits) - 1 - e10};
+            scaled = (shift >= 0) ? absolute * pow10(shift, working)
+                                  : absolute / pow10(-shift, working);
+            scaled = scaled.roundToInteger();
+            if (scaled >= upper)
+                ++e10;
+            else if (scaled < lower)
+                --e10;
+            else
+                break;
+        }
+
+        // Integer to decimal, 9 digits at a time from the lowest.
+        std::vector<limb_type> limbs(static_cast<std::size_t>(scaled.m_exponent), 0);
+        const limb_type* mantissa{scaled.m_limbs.data()};
+        limbs.insert(limbs.end(), mantissa, mantissa + scaled.m_limbs.size());
+        std::string decimal{};
+        while (!limbs.empty())
+        {
+            std::uint64_t rem{0};
+            for (std::size_t j{limbs.size()}; j-- > 0;)
+            {
+                rem = (rem << 32) | limbs[j];
+                limbs[j] = low(rem / 1000000000);
+                rem %= 1000000000;
+            }
+            while (!limbs.empty() && limbs.back() == 0)
+                limbs.pop_back();
+
+            for (int k{0}; k < 9; ++k)
+            {
+                decimal.push_back(static_cast<char>('0' + rem % 10));
+                rem /= 10;
+            }
+        }
+        while (decimal.size() > digits)
+            decimal.pop_back();
+        std::reverse(decimal.begin(), decimal.end());
+
+        const auto trimZeros = [](std::string str) {
+            while (!str.empty() && str.back() == '0')
+                str.pop_back();
+            return str;
+        };
+
+        std::string result{m_negative ? "-" : ""};
+        if (e10 >= -5 && e10 < static_cast<std::int64_t>(digits))
+        {
+            if (e10 >= 0)
+            {
+                const auto point{static_cast<std::size_t>(e10 + 1)};
+                const std::string fractionPart{trimZeros(decimal.substr(point))};
+                result += decimal.substr(0, point);
+                if (!fractionPart.empty())
+                    result += "." + fractionPart;
+            }
+            else
+            {
+                result += "0." + std::string(static_cast<std::size_t>(-e10 - 1), '0') +
+                          trimZeros(decimal);
+            }
+        }
+        else
+        {
+            const std::string fractionPart{trimZeros(decimal.substr(1))};
+            const std::string exponent{std::to_string((e10 < 0) ? -e10 : e10)};
+            result += decimal.substr(0, 1);
+            if (!fractionPart.empty())
+                result += "." + fractionPart;
+            result += (e10 < 0) ? "e-" : "e+";
+            result += (exponent.size() < 2) ? "0" + exponent : exponent;
+        }
+
+        return result;
+    }
+
+    BigFloat BigFloat::operator-() const
+    {
+        BigFloat result{*this};
+        result.m_negative = !m_negative && !isZero();
+        return result;
+    }
+
+    BigFloat& BigFloat::operator+=(const BigFloat& rhs)
+    {
+        return *this = add(*this, rhs, false);
+    }
+
+    BigFloat& BigFloat::operator-=(const BigFloat& rhs)
+    {
+        return *this = add(*this, rhs, true);
+    }
+
+    BigFloat& BigFloat::operator*=(const BigFloat& rhs)
+    {
+        return *this = *this * rhs;
+    }
+
+    BigFloat& BigFloat::operator/=(const BigFloat& rhs)
+    {
+        return *this = *this / rhs;
+    }
+
+    BigFloat operator+(const BigFloat& lhs, const BigFloat& rhs)
+    {
+        return BigFloat::add(lhs, rhs, false);
+    }
+
+    BigFloat operator-(const BigFloat& lhs, const BigFloat& rhs)
+    {
+        return BigFloat::add(lhs, rhs, true);
+    }
+
+    BigFloat operator*(const BigFloat& lhs, const BigFloat& rhs)
+    {
+        const std::uint32_t precision{BigFloat::resultPrecision(lhs, rhs)};
+        if (lhs.isZero() || rhs.isZero())
+            return BigFloat{}.withPrecision(precision);
+
+        const std::size_t n{lhs.m_limbs.size()}, m{rhs.m_limbs.size()};
+        Buffer product{n + m};
+        multiply(lhs.m_limbs.data(), n, rhs.m_limbs.data(), m, product.data());
+        return BigFloat::make(product.data(), n + m, lhs.m_exponent + rhs.m_exponent,
+                              lhs.m_negative != rhs.m_negative, precision, false);
+    }
+
+    BigFloat operator/(const BigFloat& lhs, const BigFloat& rhs)
+    {
+        if (rhs.isZero())
+            throw ArithmeticError("Division by zero");
+
+        const std::uint32_t precision{BigFloat::resultPrecision(lhs, rhs)};
+        if (lhs.isZero())
+            return BigFloat{}.withPrecision(precision);
+
+        // The dividend is shifted so that the quotient gets at least two
+        // limbs more than the precision, the remainder decides the rounding.
+        const std::size_t n{lhs.m_limbs.size()}, m{rhs.m_limbs.size()};
+        const std::size_t wanted{limbsFor(precision) + 2};
+        const std::size_t shift{(n < wanted + m) ? wanted + m - n : 0};
+
+        Buffer dividend{n + shift}, quotient{n + shift - m + 1};
+        std::copy(lhs.m_limbs.data(), lhs.m_limbs.data() + n, dividend.data() + shift);
+        const bool sticky{
+            divide(dividend.data(), n + shift, rhs.m_limbs.data(), m, quotient.data())};
+
+        return BigFloat::make(quotient.data(), n + shift - m + 1,
+                              lhs.m_exponent - static_cast<std::int64_t>(shift) - rhs.m_exponent,
+                              lhs.m_negative != rhs.m_negative, precision, sticky);
+    }
+
+    bool operator==(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        return lhs.m_negative == rhs.m_negative && BigFloat::compareMagnitude(lhs, rhs) == 0;
+    }
+
+    bool operator!=(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    bool operator<(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        if (lhs.m_negative != rhs.m_negative)
+            return lhs.m_negative;
+
+        const int order{BigFloat::compareMagnitude(lhs, rhs)};
+        return lhs.m_negative ? order > 0 : order < 0;
+    }
+
+    bool operator<=(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        return !(rhs < lhs);
+    }
+
+    bool operator>(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+
+    bool operator>=(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        return !(lhs < rhs);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+
+    BigFloat BigFloat::abs(const BigFloat& x)
+    {
+        BigFloat result{x};
+        result.m_negative = false;
+        return result;
+    }
+
+    BigFloat BigFloat::ldexp(const BigFloat& x, std::int64_t exponent)
+    {
+        if (x.isZero())
+            return x;
+
+        const std::int64_t limbs{limbOf(exponent)};
+        const auto bits{static_cast<int>(exponent - 32 * limbs)};
+
+        BigFloat result{x};
+        result.m_exponent += limbs;
+        if (bits != 0)
+        {
+            const std::size_t n{result.m_limbs.size()};
+            result.m_limbs.resize(n + 1);
+            for (std::size_t i{n + 1}; i-- > 0;)
+            {
+                const std::uint64_t current{(i < n) ? result.m_limbs[i] : 0u};
+                const std::uint64_t below{(i > 0) ? result.m_limbs[i - 1] : 0u};
+                result.m_limbs[i] = low((current << bits) | (below >> (32 - bits)));
+            }
+            result.trim();
+        }
+        return result;
+    }
+
+    BigFloat BigFloat::sqrt(const BigFloat& x)
+    {
+        if (x.m_negative)
+            throw ArithmeticError("Square root of a negative number");
+        if (x.isZero())
+            return x;
+
+        // Newton iteration y = (y + x / y) / 2 from the double estimate of the
+        // root of the mantissa, every iteration doubles the correct bits.
+        const std::uint32_t precision{workingPrecision(x)};
+        const std::uint32_t working{precision + 32};
+        std::int64_t exponent{x.magnitude()};
+        exponent -= exponent % 2;
+        const BigFloat m{ldexp(x, -exponent).withPrecision(working)};
+
+        BigFloat y{fromDouble(std::sqrt(m.toDouble())).withPrecision(working)};
+        for (std::uint32_t bits{50}; bits < 2 * working; bits *= 2)
+            y = ldexp(y + m / y, -1);
+
+        return ldexp(y, exponent / 2).withPrecision(precision);
+    }
+
+    BigFloat BigFloat::exp(const BigFloat& x)
+    {
+        const std::uint32_t precision{workingPrecision(x)};
+        if (x.isZero())
+            return BigFloat{1}.withPrecision(precision);
+
+        if (x.magnitude() > 40)
+        {
+            if (!x.m_negative)
+                throw ArithmeticError("Overflow in exp");
+            return BigFloat{}.withPrecision(precision);
+        }
+
+        // x = n * ln2 + r with |r| <= ln2 / 2, then r is halved k times so
+        // that the Taylor series converges fast and the result is squared
+        // k times. Each squaring loses a bit, the working precision has them.
+        const auto k{static_cast<std::uint32_t>(std::sqrt(static_cast<double>(precision)) / 2) + 1};
+        const std::uint32_t working{precision + k + 96};
+        const auto n{static_cast<std::int64_t>(std::llround(x.toDouble() / 0.69314718055994531))};
+
+        BigFloat r{x.withPrecision(working) - BigFloat{n} * ln2(working)};
+        r = ldexp(r, -static_cast<std::int64_t>(k));
+
+        BigFloat sum{BigFloat{1}.withPrecision(working)};
+        BigFloat term{sum};
+        for (std::int64_t i{1};; ++i)
+        {
+            term = term * r / BigFloat{i};
+            if (term.tinyComparedTo(sum))
+                break;
+            sum += term;
+        }
+
+        for (std::uint32_t i{0}; i < k; ++i)
+            sum = sum * sum;
+
+        return ldexp(sum, n).withPrecision(precision);
+    }
+
+    BigFloat BigFloat::log(const BigFloat& x)
+    {
+        if (x.m_negative || x.isZero())
+            throw ArithmeticError("Logarithm of a non-positive number");
+
+        // x = m * 2^e with m in [1/sqrt(2), sqrt(2)), log(m) = 2 * atanh(z)
+        // with z = (m - 1) / (m + 1). m - 1 is exact so log(x) keeps its
+        // relative precision also when x is close to 1.
+        const std::uint32_t precision{workingPrecision(x)};
+        const std::uint32_t working{precision + 64};
+        std::int64_t e{x.magnitude()};
+        BigFloat m{ldexp(x, -e).withPrecision(working)};
+        if (m.toDouble() < 0.70710678118654752)
+        {
+            m = ldexp(m, 1);
+            --e;
+        }
+
+        const BigFloat one{BigFloat{1}.withPrecision(working)};
+        BigFloat result{ldexp(atanh((m - one) / (m + one)), 1)};
+        if (e != 0)
+            result += BigFloat{e} * ln2(working + 64);
+
+        return result.withPrecision(precision);
+    }
+
+    BigFloat BigFloat::log10(const BigFloat& x)
+    {
+        static thread_local Cache ln10{};
+        const std::uint32_t precision{workingPrecision(x)};
+        const std::uint32_t working{precision + 32};
+        const BigFloat denominator{cached(ln10, working, [](std::uint32_t p) {
+            return log(BigFloat{10}.withPrecision(p));
+        })};
+        return (log(x.withPrecision(working)) / denominator).withPrecision(precision);
+    }
+
+    BigFloat BigFloat::sin(const BigFloat& x)
+    {
+        const std::uint32_t precision{workingPrecision(x)};
+        int quadrant{0};
+        const BigFloat r{reduce(x, precision + 32, quadrant)};
+
+        BigFloat result{};
+        switch (quadrant)
+        {
+            case 0: result = sinSeries(r); break;
+            case 1: result = cosSeries(r); break;
+            case 2: result = -sinSeries(r); break;
+            default: result = -cosSeries(r); break;
+        }
+        return result.withPrecision(precision);
+    }
+
+    BigFloat BigFloat::cos(const BigFloat& x)
+    {
+        const std::uint32_t precision{workingPrecision(x)};
+        int quadrant{0};
+        const BigFloat r{reduce(x, precision + 32, quadrant)};
+
+        BigFloat result{};
+        switch (quadrant)
+        {
+            case 0: result = cosSeries(r); break;
+            case 1: result = -sinSeries(r); break;
+            case 2: result = -cosSeries(r); break;
+            default: result = sinSeries(r); break;
+        }
+        return result.withPrecision(precision);
+    }
+
+    BigFloat BigFloat::tan(const BigFloat& x)
+    {
+        const std::uint32_t precision{workingPrecision(x)};
+        int quadrant{0};
+        const BigFloat r{reduce(x, precision + 32, quadrant)};
+
+        const BigFloat s{sinSeries(r)}, c{cosSeries(r)};
+        const BigFloat result{(quadrant % 2 == 0) ? s / c : -(c / s)};
+        return result.withPrecision(precision);
+    }
+
+    BigFloat BigFloat::pow(const BigFloat& base, const BigFloat& exponent)
+    {
+        const std::uint32_t precision{resultPrecision(base, exponent)};
+        if (exponent.isZero())
+            return BigFloat{1}.withPrecision(precision);
+
+        if (const auto n = exponent.toInt64();
+            n && *n > std::numeric_limits<std::int64_t>::min())
+        {
+            // Every multiplication rounds, two bits per bit of n covers it.
+            auto count{static_cast<std::uint64_t>((*n < 0) ? -*n : *n)};
+            const auto bits{static_cast<std::uint32_t>(bitWidth(count))};
+            const std::uint32_t working{precision + 2 * bits + 32};
+            BigFloat result{BigFloat{1}.withPrecision(working)};
+            BigFloat square{base.withPrecision(working)};
+            while (true)
+            {
+                if ((count & 1) != 0)
+                    result *= square;
+                count >>= 1;
+                if (count == 0)
+                    break;
+                square *= square;
+            }
+
+            if (*n < 0)
+            {
+                if (result.isZero())
+                    throw ArithmeticError("Division by zero");
+                result = BigFloat{1} / result;
+            }
+            return result.withPrecision(precision);
+        }
+
+        if (base.m_negative)
+            throw ArithmeticError("Negative number to a non-integer power");
+        if (base.isZero())
+        {
+            if (exponent.m_negative)
+                throw ArithmeticError("Division by zero");
+            return base.withPrecision(precision);
+        }
+
+        // The error of y * log(x) is scaled by its size in exp.
+        const double estimate{exponent.toDouble() * std::log(base.toDouble())};
+        const auto extra{
+            static_cast<std::uint32_t>(std::max(0.0, std::log2(std::fabs(estimate) + 1.0)))};
+        const std::uint32_t working{precision + extra + 32};
+        const BigFloat product{exponent.withPrecision(working) * log(base.withPrecision(working))};
+        return exp(product).withPrecision(precision);
+    }
+
+    BigFloat BigFloat::pi(std::uint32_t precision)
+    {
+        static thread_local Cache cache{};
+        return cached(cache, precision, [](std::uint32_t p) {
+            // Machin: pi = 16 * arctan(1/5) - 4 * arctan(1/239)
+            return BigFloat{16} * arctanInverse(5, p + 16) -
+                   BigFloat{4} * arctanInverse(239, p + 16);
+        });
+    }
+
+    BigFloat BigFloat::e(std::uint32_t precision)
+    {
+        static thread_local Cache cache{};
+        return cached(cache, precision,
+                      [](std::uint32_t p) { return exp(BigFloat{1}.withPrecision(p)); });
+    }
+
+    BigFloat BigFloat::ln2(std::uint32_t precision)
+    {
+        static thread_local Cache cache{};
+        return cached(cache, precision, [](std::uint32_t p) {
+            // ln2 = 2 * atanh(1/3)
+            const BigFloat third{BigFloat{1}.withPrecision(p + 16) / BigFloat{3}};
+            return ldexp(atanh(third), 1);
+        });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+
+    BigFloat BigFloat::make(const limb_type* limbs, std::size_t count, std::int64_t exponent,
+                            bool negative, std::uint32_t precision, bool sticky)
+    {
+        while (count > 0 && limbs[count - 1] == 0)
+            --count;
+        while (count > 0 && limbs[0] == 0)
+        {
+            ++limbs;
+            --count;
+            ++exponent;
+        }
+
+        // Only the limbs that can affect the rounding are kept.
+        const std::size_t keep{limbsFor(precision) + 2};
+        if (count > keep)
+        {
+            const std::size_t drop{count - keep};
+            for (std::size_t i{0}; i < drop && !sticky; ++i)
+                sticky = limbs[i] != 0;
+            limbs += drop;
+            count = keep;
+            exponent += static_cast<std::int64_t>(drop);
+        }
+
+        BigFloat result{};
+        result.m_limbs.assign(limbs, count);
+        result.m_exponent = exponent;
+        result.m_negative = negative && count > 0;
+        result.m_precision = precision;
+        result.round(sticky);
+        return result;
+    }
+
+    BigFloat BigFloat::add(const BigFloat& lhs, const BigFloat& rhs, bool subtract)
+    {
+        const std::uint32_t precision{resultPrecision(lhs, rhs)};
+        const bool rhsNegative{rhs.m_negative != subtract};
+        if (rhs.isZero())
+            return lhs.withPrecision(precision);
+        if (lhs.isZero())
+        {
+            BigFloat result{rhs.withPrecision(precision)};
+            result.m_negative = rhsNegative;
+            return result;
+        }
+
+        // Both operands are placed in a window that ends at the highest limb
+        // and is three limbs longer than the precision. Limbs below it can
+        // only affect the rounding, they are folded into the lowest bit.
+        const auto end = [](const BigFloat& x) {
+            return x.m_exponent + static_cast<std::int64_t>(x.m_limbs.size());
+        };
+        const std::int64_t top{std::max(end(lhs), end(rhs))};
+        const std::int64_t window{top - static_cast<std::int64_t>(limbsFor(precision)) - 3};
+        const std::int64_t bottom{std::max(window, std::min(lhs.m_exponent, rhs.m_exponent))};
+        const auto n{static_cast<std::size_t>(top - bottom + 1)};
+
+        Buffer a{n}, b{n};
+        const auto place = [bottom](const BigFloat& x, limb_type* out) {
+            bool sticky{false};
+            for (std::size_t i{0}; i < x.m_limbs.size(); ++i)
+            {
+                const std::int64_t position{x.m_exponent + static_cast<std::int64_t>(i)};
+                if (position >= bottom)
+                    out[position - bottom] = x.m_limbs[i];
+                else
+                    sticky = sticky || x.m_limbs[i] != 0;
+            }
+            if (sticky)
+                out[0] |= 1;
+        };
+        place(lhs, a.data());
+        place(rhs, b.data());
+
+        bool negative{lhs.m_negative};
+        if (lhs.m_negative == rhsNegative)
+        {
+            addTo(a.data(), n, b.data(), n);
+            return make(a.data(), n, bottom, negative, precision, false);
+        }
+
+        const int order{compare(a.data(), b.data(), n)};
+        if (order == 0)
+            return BigFloat{}.withPrecision(precision);
+        if (order > 0)
+        {
+            subtractFrom(a.data(), n, b.data(), n);
+            return make(a.data(), n, bottom, negative, precision, false);
+        }
+
+        subtractFrom(b.data(), n, a.data(), n);
+        return make(b.data(), n, bottom, rhsNegative, precision, false);
+    }
+
+    int BigFloat::compareMagnitude(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        if (lhs.isZero() || rhs.isZero())
+            return (lhs.isZero() ? 0 : 1) - (rhs.isZero() ? 0 : 1);
+
+        const std::int64_t a{lhs.magnitude()}, b{rhs.magnitude()};
+        if (a != b)
+            return (a < b) ? -1 : 1;
+
+        const std::int64_t top{lhs.m_exponent + static_cast<std::int64_t>(lhs.m_limbs.size())};
+        const std::int64_t bottom{std::min(lhs.m_exponent, rhs.m_exponent)};
+        const auto limbAt = [](const BigFloat& x, std::int64_t position) -> limb_type {
+            const std::int64_t i{position - x.m_exponent};
+            return (i >= 0 && i < static_cast<std::int64_t>(x.m_limbs.size()))
+                       ? x.m_limbs[static_cast<std::size_t>(i)]
+                       : 0u;
+        };
+
+        for (std::int64_t position{top - 1}; position >= bottom; --position)
+        {
+            const limb_type x{limbAt(lhs, position)}, y{limbAt(rhs, position)};
+            if (x != y)
+                return (x < y) ? -1 : 1;
+        }
+        return 0;
+    }
+
+    std::uint32_t BigFloat::resultPrecision(const BigFloat& lhs, const BigFloat& rhs) noexcept
+    {
+        const std::uint32_t precision{std::max(lhs.m_precision, rhs.m_precision)};
+        return (precision == 0) ? defaultPrecision : precision;
+    }
+
+    std::uint32_t BigFloat::workingPrecision(const BigFloat& x) noexcept
+    {
+        return (x.m_precision == 0) ? defaultPrecision : x.m_precision;
+    }
+
+    BigFloat BigFloat::atanh(const BigFloat& z)
+    {
+        // z + z^3/3 + z^5/5 + ..., |z| is small enough for it to converge fast.
+        const BigFloat z2{z * z};
+        BigFloat power{z}, sum{z};
+        for (std::int64_t k{3};; k += 2)
+        {
+            power *= z2;
+            const BigFloat term{power / BigFloat{k}};
+            if (term.tinyComparedTo(sum))
+                break;
+            sum += term;
+        }
+        return sum;
+    }
+
+    BigFloat BigFloat::arctanInverse(std::uint32_t n, std::uint32_t precision)
+    {
+        // arctan(1/n) = 1/n - 1/(3n^3) + 1/(5n^5) - ...
+        const BigFloat n2{std::int64_t{n} * n};
+        BigFloat power{BigFloat{1}.withPrecision(precision) / BigFloat{std::int64_t{n}}};
+        BigFloat sum{power};
+        for (std::int64_t k{3};; k += 2)
+        {
+            power /= n2;
+            const BigFloat term{power / BigFloat{k}};
+            if (term.tinyComparedTo(sum))
+                break;
+            if ((k / 2) % 2 == 1)
+                sum -= term;
+            else
+                sum += term;
+        }
+        return sum;
+    }
+
+    BigFloat BigFloat::sinSeries(const BigFloat& x)
+    {
+        // x - x^3/3! + x^5/5! - ...
+        const BigFloat x2{x * x};
+        BigFloat term{x}, sum{x};
+        for (std::int64_t k{2};; k += 2)
+        {
+            term = -(term * x2 / BigFloat{k * (k + 1)});
+            if (term.tinyComparedTo(sum))
+                break;
+            sum += term;
+        }
+        return sum;
+    }
+
+    BigFloat BigFloat::cosSeries(const BigFloat& x)
+    {
+        // 1 - x^2/2! + x^4/4! - ...
+        const BigFloat x2{x * x};
+        BigFloat term{BigFloat{1}.withPrecision(workingPrecision(x))}, sum{term};
+        for (std::int64_t k{1};; k += 2)
+        {
+            term = -(term * x2 / BigFloat{k * (k + 1)});
+            if (term.tinyComparedTo(sum))
+                break;
+            sum += term;
+        }
+        return sum;
+    }
+
+    BigFloat BigFloat::reduce(const BigFloat& x, std::uint32_t precision, int& quadrant)
+    {
+        quadrant = 0;
+        if (x.isZero() || std::fabs(x.toDouble()) < 0.78539816339744831)
+            return x.withPrecision(precision);
+
+        // x = q * pi/2 + r with |r| <= pi/4. pi needs as many extra bits as
+        // x has integer bits to keep the precision of r.
+        const std::int64_t integerBits{x.magnitude()};
+        if (integerBits > 65536)
+            throw ArithmeticError("Argument too large for a trigonometric function");
+
+        const auto working{static_cast<std::uint32_t>(precision + integerBits + 64)};
+        const BigFloat halfPi{ldexp(pi(working), -1)};
+        const BigFloat wide{x.withPrecision(working)};
+        const BigFloat q{(wide / halfPi).roundToInteger()};
+
+        if (!q.isZero() && q.m_exponent == 0)
+        {
+            const auto bits{static_cast<int>(q.m_limbs[0] & 3u)};
+            quadrant = q.m_negative ? (4 - bits) % 4 : bits;
+        }
+
+        return (wide - q * halfPi).withPrecision(precision);
+    }
+
+    BigFloat BigFloat::pow10(std::int64_t exponent, std::uint32_t precision)
+    {
+        return pow(BigFloat{10}.withPrecision(precision), BigFloat{exponent});
+    }
+
+    std::int64_t BigFloat::magnitude() const noexcept
+    {
+        return 32 * (m_exponent + static_cast<std::int64_t>(m_limbs.size()) - 1) +
+               bitWidth(m_limbs.back());
+    }
+
+    bool BigFloat::tinyComparedTo(const BigFloat& sum) const noexcept
+    {
+        const auto precision{static_cast<std::int64_t>(workingPrecision(sum))};
+        return isZero() || (!sum.isZero() && magnitude() < sum.magnitude() - precision - 2);
+    }
+
+    BigFloat BigFloat::roundToInteger() const
+    {
+        BigFloat result{*this};
+        result.roundAt(0, false);
+        return result;
+    }
+
+    void BigFloat::roundAt(std::int64_t position, bool sticky)
+    {
+        // Bits below position are removed, rounded to nearest, ties to even.
+        const std::int64_t first{position - 32 * m_exponent};
+        const auto total{static_cast<std::int64_t>(32 * m_limbs.size())};
+        if (first <= 0 || isZero())
+            return;
+
+        if (first > total)
+        {
+            m_limbs.resize(0);
+            m_exponent = 0;
+            m_negative = false;
+            return;
+        }
+
+        const auto bit = [this](std::int64_t index) -> bool {
+            const auto i{static_cast<std::size_t>(index / 32)};
+            return i < m_limbs.size() && ((m_limbs[i] >> (index % 32)) & 1u) != 0;
+        };
+
+        const bool roundBit{bit(first - 1)};
+        const auto roundLimb{static_cast<std::size_t>((first - 1) / 32)};
+        const limb_type roundMask{(limb_type{1} << ((first - 1) % 32)) - 1};
+        sticky = sticky || (m_limbs[roundLimb] & roundMask) != 0;
+        for (std::size_t i{0}; i < roundLimb && !sticky; ++i)
+            sticky = m_limbs[i] != 0;
+
+        const bool up{roundBit && (sticky || bit(first))};
+
+        // Clear everything below first.
+        const auto firstLimb{static_cast<std::size_t>(first / 32)};
+        for (std::size_t i{0}; i < std::min(firstLimb, m_limbs.size()); ++i)
+            m_limbs[i] = 0;
+        if (firstLimb < m_limbs.size())
+            m_limbs[firstLimb] &= ~((limb_type{1} << (first % 32)) - 1);
+
+        if (up)
+        {
+            if (firstLimb >= m_limbs.size())
+                m_limbs.resize(firstLimb + 1);
+            const std::uint64_t one{std::uint64_t{1} << (first % 32)};
+            std::uint64_t carry{one};
+            for (std::size_t i{firstLimb}; i < m_limbs.size() && carry != 0; ++i)
+            {
+                carry += m_limbs[i];
+                m_limbs[i] = low(carry);
+                carry >>= 32;
+            }
+            if (carry != 0)
+            {
+                m_limbs.resize(m_limbs.size() + 1);
+                m_limbs[m_limbs.size() - 1] = low(carry);
+            }
+        }
+
+        trim();
+    }
+
+    void BigFloat::round(bool sticky)
+    {
+        if (m_precision != 0 && !isZero())
+            roundAt(magnitude() - m_precision, sticky);
+    }
+
+    void BigFloat::trim() noexcept
+    {
+        std::size_t size{m_limbs.size()};
+        while (size > 0 && m_limbs[size - 1] == 0)
+            --size;
+
+        std::size_t zeros{0};
+        while (zeros < size && m_limbs[zeros] == 0)
+            ++zeros;
+        m_limbs.eraseFront(zeros);
+        m_limbs.resize(size - zeros);
+        m_exponent += static_cast<std::int64_t>(zeros);
+
+        if (m_limbs.empty())
+        {
+            m_exponent = 0;
+            m_negative = false;
+        }
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,643 @@
+//
+//  Document.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Document.hpp"
+#include "calceval/Hash.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace CalcEval
+{
+    namespace
+    {
+        constexpr std::size_t npos{std::string::npos};
+
+        // Lines of a block, a block with more than twice as many is split.
+        constexpr std::size_t blockLines{512};
+
+        // The text after the last '\n' is a line if last is true.
+        std::vector<std::string_view> split(std::string_view text, bool last)
+        {
+            std::vector<std::string_view> lines{};
+            std::size_t start{0};
+            for (std::size_t end{text.find('\n')}; end != npos; end = text.find('\n', start))
+            {
+                lines.push_back(text.substr(start, end - start));
+                start = end + 1;
+            }
+            if (last)
+                lines.push_back(text.substr(start));
+            return lines;
+        }
+
+        bool blank(std::string_view line) noexcept
+        {
+            return std::all_of(line.begin(), line.end(),
+                               [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+        }
+
+        std::string_view trim(std::string_view line) noexcept
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            return line;
+        }
+
+        bool same(const Document::Result& a, const Document::Result& b) noexcept
+        {
+            return a.error == b.error && a.value.has_value() == b.value.has_value() &&
+                   (!a.value || *a.value == *b.value ||
+                    (std::isnan(*a.value) && std::isnan(*b.value)));
+        }
+
+    } // namespace
+
+    Document::Document(symbols_type symbols) : m_session{std::move(symbols)}
+    {
+        // Id 0 is for the blank lines, new content is one of them.
+        m_states.emplace_back();
+        m_places.emplace_back();
+        m_blocks.push_back(std::make_unique<Block>());
+        m_blocks.back()->text = "\n";
+        m_blocks.back()->lines.push_back({hash(""), 0, 0});
+    }
+
+    std::vector<Document::Result> Document::update(std::string_view content)
+    {
+        // The content is compared as if it ended with '\n', like the text
+        // of the last block. Whole blocks are compared with memcmp, then
+        // the lines of the block with the difference.
+        const std::size_t size{content.size() + 1};
+        const auto equal = [content, size](std::string_view text, std::size_t at) {
+            if (at + text.size() > size)
+                return false;
+            const std::size_t count{std::min(text.size(), content.size() - at)};
+            return count == 0 || std::memcmp(text.data(), content.data() + at, count) == 0;
+        };
+
+        // The lines before and after the change are the same.
+        std::size_t first{0};
+        std::size_t prefix{0};
+        std::size_t k{0};
+        for (; k < m_blocks.size() && equal(m_blocks[k]->text, prefix); ++k)
+        {
+            first += m_blocks[k]->lines.size();
+            prefix += m_blocks[k]->text.size();
+        }
+        if (k == m_blocks.size() && prefix == size)
+            return {};
+        for (std::size_t i{0}; k < m_blocks.size() && i < m_blocks[k]->lines.size(); ++i)
+        {
+            const std::string_view line{view(*m_blocks[k], i)};
+            if (!equal(line, prefix))
+                break;
+            ++first;
+            prefix += line.size();
+        }
+
+        std::size_t last{this->size()};
+        std::size_t suffix{size};
+        for (std::size_t b{m_blocks.size()}; b-- > 0;)
+        {
+            const Block& block{*m_blocks[b]};
+            if (block.first >= first && suffix >= prefix + block.text.size() &&
+                equal(block.text, suffix - block.text.size()))
+            {
+                last = block.first;
+                suffix -= block.text.size();
+                continue;
+            }
+
+            for (std::size_t i{block.lines.size()}; i > 0 && block.first + i > first; --i)
+            {
+                const std::string_view line{view(block, i - 1)};
+                if (suffix < prefix + line.size() || !equal(line, suffix - line.size()))
+                    break;
+                last = block.first + i - 1;
+                suffix -= line.size();
+            }
+            break;
+        }
+
+        // The first line of the suffix is a line of the content too if a
+        // '\n' is before it.
+        if (suffix > prefix && suffix < size && content[suffix - 1] != '\n')
+        {
+            const Block& block{*m_blocks[this->block(last)]};
+            suffix += view(block, last - block.first).size();
+            ++last;
+        }
+
+        const std::size_t from{std::min(prefix, content.size())};
+        return splice(first, last - first,
+                      content.substr(from, std::min(suffix, content.size()) - from),
+                      suffix == size && prefix < size);
+    }
+
+    std::vector<Document::Result> Document::replace(std::size_t offset, std::size_t count,
+                                                    std::string_view text)
+    {
+        const Block& back{*m_blocks.back()};
+        const std::size_t size{back.offset + back.text.size() - 1};
+        if (offset > size || count > size - offset)
+            throw std::invalid_argument("Document: there are no " + std::to_string(count) +
+                                        " chars at " + std::to_string(offset));
+
+        // The lines from the one with offset to the one with offset + count
+        // are replaced, with the text before and after the range.
+        const auto find = [this](std::size_t at) {
+            const Block& block{*m_blocks[blockAt(at)]};
+            const auto it{std::upper_bound(
+                block.lines.begin(), block.lines.end(), at - block.offset,
+                [](std::size_t start, const Line& line) { return start < line.start; })};
+            return std::make_pair(&block, static_cast<std::size_t>(it - block.lines.begin()) - 1);
+        };
+        const auto [head, i] = find(offset);
+        const auto [tail, j] = find(offset + count);
+        const std::size_t end{tail->lines[j].start + view(*tail, j).size()};
+
+        std::string lines{head->text, head->lines[i].start,
+                          offset - head->offset - head->lines[i].start};
+        lines += text;
+        lines.append(tail->text, offset + count - tail->offset,
+                     end - (offset + count - tail->offset));
+        const std::size_t first{head->first + i};
+        return splice(first, tail->first + j + 1 - first, lines, false);
+    }
+
+    std::vector<Document::Result> Document::splice(std::size_t first, std::size_t count,
+                                                   std::string_view str, bool last)
+    {
+        const std::size_t b0{block(first)};
+        const std::size_t b1{(count == 0) ? b0 : block(first + count - 1)};
+        std::vector<Line> old{};
+        std::vector<std::string_view> oldLines{};
+        for (std::size_t b{b0}; b <= b1; ++b)
+        {
+            const Block& block{*m_blocks[b]};
+            const std::size_t end{std::min(block.lines.size(), first + count - block.first)};
+            for (std::size_t i{(b == b0) ? first - block.first : 0}; i < end; ++i)
+            {
+                const std::string_view line{view(block, i)};
+                old.push_back(block.lines[i]);
+                oldLines.push_back(line.substr(0, line.size() - 1));
+            }
+        }
+        const std::vector<std::string_view> newLines{split(str, last)};
+
+        // Lines that are still there keep their id, found by hash.
+        std::unordered_multimap<std::uint64_t, std::size_t> index{};
+        for (std::size_t i{0}; i < old.size(); ++i)
+            if (old[i].id != 0)
+                index.emplace(old[i].hash, i);
+
+        std::vector<bool> kept(old.size(), false);
+        std::vector<Line> lines(newLines.size(), Line{0, 0, 0});
+        std::vector<std::size_t> added{};
+        for (std::size_t j{0}; j < newLines.size(); ++j)
+        {
+            lines[j].hash = hash(newLines[j]);
+            if (blank(newLines[j]))
+                continue;
+
+            auto [it, end] = index.equal_range(lines[j].hash);
+            for (; it != end; ++it)
+            {
+                if (!kept[it->second] && oldLines[it->second] == newLines[j])
+                {
+                    kept[it->second] = true;
+                    lines[j].id = old[it->second].id;
+                    break;
+                }
+            }
+            if (it == end)
+                added.push_back(j);
+        }
+
+        // A changed line that defines the same name is defined again, so
+        // the lines that use it only see another value.
+        std::unordered_map<std::string, std::size_t> renamed{};
+        std::vector<std::string> names{};
+        for (std::size_t i{0}; i < old.size(); ++i)
+        {
+            const std::uint32_t id{old[i].id};
+            if (id == 0 || m_states[id].name.empty())
+                continue;
+
+            names.push_back(m_states[id].name);
+            if (!kept[i])
+                renamed.emplace(m_states[id].name, i);
+        }
+
+        std::vector<std::uint32_t> touched{};
+        std::vector<std::uint32_t> redefined{};
+        for (const std::size_t j : added)
+        {
+            const std::string_view text{trim(newLines[j])};
+            const auto assignment{Session::assignment(text)};
+            const auto it{(assignment) ? renamed.find(assignment->first) : renamed.end()};
+            if (it == renamed.end())
+            {
+                lines[j].id = allocate();
+                assign(lines[j].id, text);
+            }
+            else
+            {
+                lines[j].id = old[it->second].id;
+                kept[it->second] = true;
+                renamed.erase(it);
+                m_states[lines[j].id].text = assignment->second;
+            }
+
+            if (assignment)
+                names.push_back(assignment->first);
+            redefined.push_back(lines[j].id);
+            touched.push_back(lines[j].id);
+        }
+
+        std::vector<std::uint32_t> removed{};
+        for (std::size_t i{0}; i < old.size(); ++i)
+            if (old[i].id != 0 && !kept[i])
+                removed.push_back(old[i].id);
+
+        // The blocks with the lines are made again with the lines before
+        // and after them, and split if they get too large. The blocks
+        // after them only move.
+        const Block& head{*m_blocks[b0]};
+        const Block& tail{*m_blocks[b1]};
+        const auto start = [](const Block& block, std::size_t i) {
+            return (i < block.lines.size()) ? block.lines[i].start : block.text.size();
+        };
+        const std::size_t before{first - head.first};
+        const std::size_t after{first + count - tail.first};
+        std::string text{head.text, 0, start(head, before)};
+        std::vector<Line> all(head.lines.begin(),
+                              head.lines.begin() + static_cast<std::ptrdiff_t>(before));
+        for (std::size_t j{0}; j < lines.size(); ++j)
+        {
+            lines[j].start = text.size();
+            all.push_back(lines[j]);
+            text += newLines[j];
+            text += '\n';
+        }
+        const std::size_t moved{start(tail, after)};
+        for (std::size_t i{after}; i < tail.lines.size(); ++i)
+        {
+            all.push_back(tail.lines[i]);
+            all.back().start = all.back().start - moved + text.size();
+        }
+        text.append(tail.text, moved);
+
+        std::vector<std::unique_ptr<Block>> blocks{};
+        const std::size_t parts{(all.size() > 2 * blockLines)
+                                    ? (all.size() + blockLines - 1) / blockLines
+                                    : std::min<std::size_t>(all.size(), 1)};
+        for (std::size_t p{0}; p < parts; ++p)
+        {
+            const std::size_t from{all.size() * p / parts};
+            const std::size_t to{all.size() * (p + 1) / parts};
+            const std::size_t offset{all[from].start};
+            auto block{std::make_unique<Block>()};
+            block->text = text.substr(offset, ((to < all.size()) ? all[to].start : text.size()) -
+                                                  offset);
+            block->lines.assign(all.begin() + static_cast<std::ptrdiff_t>(from),
+                                all.begin() + static_cast<std::ptrdiff_t>(to));
+            for (Line& line : block->lines)
+                line.start -= offset;
+            blocks.push_back(std::move(block));
+        }
+
+        const auto at{m_blocks.begin() + static_cast<std::ptrdiff_t>(b0)};
+        m_blocks.erase(at, at + static_cast<std::ptrdiff_t>(b1 - b0 + 1));
+        m_blocks.insert(m_blocks.begin() + static_cast<std::ptrdiff_t>(b0),
+                        std::make_move_iterator(blocks.begin()),
+                        std::make_move_iterator(blocks.end()));
+        for (std::size_t b{b0}; b < m_blocks.size(); ++b)
+        {
+            Block& block{*m_blocks[b]};
+            block.first = (b == 0) ? 0 : m_blocks[b - 1]->first + m_blocks[b - 1]->lines.size();
+            block.offset = (b == 0) ? 0 : m_blocks[b - 1]->offset + m_blocks[b - 1]->text.size();
+            if (b < b0 + parts)
+                for (std::size_t i{0}; i < block.lines.size(); ++i)
+                    if (block.lines[i].id != 0)
+                        m_places[block.lines[i].id] = {&block, i};
+        }
+
+        // The Session is changed when the lines are in place, a name is
+        // used from the first line that defines it.
+        std::vector<std::string> changed{};
+        for (const std::uint32_t id : removed)
+        {
+            State& state{m_states[id]};
+            if (state.name.empty())
+            {
+                const std::vector<std::string> result{m_session.remove(key(id))};
+                changed.insert(changed.end(), result.begin(), result.end());
+            }
+            else
+            {
+                std::vector<std::uint32_t>& ids{m_holders[state.name].ids};
+                ids.erase(std::find(ids.begin(), ids.end(), id));
+            }
+
+            state = State{};
+            m_places[id] = Place{};
+            m_free.push_back(id);
+        }
+
+        std::sort(redefined.begin(), redefined.end());
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        std::vector<std::pair<std::size_t, std::uint32_t>> pending{};
+        for (const std::string& name : names)
+            resolve(name, redefined, pending, changed, touched);
+        for (const std::uint32_t id : redefined)
+            if (m_states[id].name.empty())
+                pending.emplace_back(position(id), id);
+
+        // In order, as for new content.
+        std::sort(pending.begin(), pending.end());
+        for (const auto& line : pending)
+            define(line.second, changed);
+
+        for (const std::string& name : changed)
+            if (const std::uint32_t id{line(name)}; id != 0)
+                touched.push_back(id);
+        untangle(touched);
+
+        std::vector<std::pair<std::size_t, std::uint32_t>> positions{};
+        for (const std::uint32_t id : touched)
+            if (m_places[id].block)
+                positions.emplace_back(position(id), id);
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+        std::vector<Result> results{};
+        results.reserve(positions.size());
+        for (const auto& [line, id] : positions)
+            results.push_back(result(line, id));
+        return results;
+    }
+
+    std::size_t Document::block(std::size_t line) const
+    {
+        const auto it{std::upper_bound(m_blocks.begin(), m_blocks.end(), line,
+                                       [](std::size_t index, const std::unique_ptr<Block>& block) {
+                                           return index < block->first;
+                                       })};
+        return static_cast<std::size_t>(it - m_blocks.begin()) - 1;
+    }
+
+    std::size_t Document::blockAt(std::size_t offset) const
+    {
+        const auto it{std::upper_bound(m_blocks.begin(), m_blocks.end(), offset,
+                                       [](std::size_t at, const std::unique_ptr<Block>& block) {
+                                           return at < block->offset;
+                                       })};
+        return static_cast<std::size_t>(it - m_blocks.begin()) - 1;
+    }
+
+    std::string_view Document::view(const Block& block, std::size_t index)
+    {
+        const std::size_t start{block.lines[index].start};
+        const std::size_t end{(index + 1 < block.lines.size()) ? block.lines[index + 1].start
+                                                               : block.text.size()};
+        return std::string_view{block.text}.substr(start, end - start);
+    }
+
+    std::string Document::key(std::uint32_t id) const
+    {
+        const State& state{m_states[id]};
+        return (state.name.empty()) ? "#" + std::to_string(id) : state.name;
+    }
+
+    Document::Result Document::result(std::size_t index, std::uint32_t id) const
+    {
+        if (id == 0)
+            return {index + 1, std::nullopt, {}};
+
+        const State& state{m_states[id]};
+        if (!state.error.empty())
+            return {index + 1, std::nullopt, state.error};
+
+        const std::string name{key(id)};
+        return {index + 1, m_session.value(name), m_session.error(name)};
+    }
+
+    std::uint32_t Document::allocate()
+    {
+        if (!m_free.empty())
+        {
+            const std::uint32_t id{m_free.back()};
+            m_free.pop_back();
+            return id;
+        }
+
+        m_states.emplace_back();
+        m_places.emplace_back();
+        return static_cast<std::uint32_t>(m_states.size() - 1);
+    }
+
+    void Document::assign(std::uint32_t id, std::string_view text)
+    {
+        State& state{m_states[id]};
+        state = State{};
+        if (const auto assignment = Session::assignment(text))
+        {
+            state.name = assignment->first;
+            state.text = assignment->second;
+            m_holders[state.name].ids.push_back(id);
+        }
+        else
+        {
+            state.text = text;
+        }
+    }
+
+    void Document::resolve(const std::string& name, const std::vector<std::uint32_t>& redefined,
+                           std::vector<std::pair<std::size_t, std::uint32_t>>& pending,
+                           std::vector<std::string>& changed, std::vector<std::uint32_t>& touched)
+    {
+        const auto it{m_holders.find(name)};
+        if (it == m_holders.end())
+            return;
+
+        Holders& holders{it->second};
+        if (holders.ids.empty())
+        {
+            if (holders.active != 0)
+            {
+                const std::vector<std::string> result{m_session.remove(name)};
+                changed.insert(changed.end(), result.begin(), result.end());
+            }
+            m_holders.erase(it);
+            return;
+        }
+
+        std::sort(holders.ids.begin(), holders.ids.end(),
+                  [this](std::uint32_t a, std::uint32_t b) { return position(a) < position(b); });
+        const std::string error{name + " is defined on another line"};
+        for (std::size_t k{1}; k < holders.ids.size(); ++k)
+        {
+            State& state{m_states[holders.ids[k]]};
+            if (state.error != error)
+                touched.push_back(holders.ids[k]);
+            state.error = error;
+            state.rejected = false;
+        }
+
+        const std::uint32_t id{holders.ids.front()};
+        if (id != holders.active || std::binary_search(redefined.begin(), redefined.end(), id))
+        {
+            holders.active = id;
+            pending.emplace_back(position(id), id);
+            touched.push_back(id);
+        }
+    }
+
+    void Document::define(std::uint32_t id, std::vector<std::string>& changed)
+    {
+        State& state{m_states[id]};
+        const std::string name{key(id)};
+        state.error.clear();
+        state.rejected = false;
+        try
+        {
+            const std::vector<std::string> names{m_session.keep(name, state.text)};
+            changed.insert(changed.end(), names.begin(), names.end());
+        }
+        catch (const Error& e)
+        {
+            // Would depend on itself, the name has the error.
+            state.rejected = true;
+            m_rejected.push_back(id);
+            const std::vector<std::string> names{m_session.defineError(name, e.what())};
+            changed.insert(changed.end(), names.begin(), names.end());
+        }
+        catch (const std::exception& e)
+        {
+            // A name that can not be defined, it is never in the Session.
+            state.error = e.what();
+            changed.push_back(name);
+        }
+    }
+
+    void Document::untangle(std::vector<std::uint32_t>& touched)
+    {
+        std::vector<std::uint32_t> rejected{};
+        for (const std::uint32_t id : m_rejected)
+            if (m_states[id].rejected)
+                rejected.push_back(id);
+        std::sort(rejected.begin(), rejected.end());
+        rejected.erase(std::unique(rejected.begin(), rejected.end()), rejected.end());
+        m_rejected.clear();
+        if (rejected.empty())
+            return;
+
+        // The lines that use them, directly or through other names, are
+        // found depth first and removed before the names they use, so
+        // no other line is evaluated. The other lines do not use them,
+        // they are the same as for new content.
+        struct Frame
+        {
+            std::uint32_t id;
+            std::vector<std::string> users;
+            std::size_t next;
+        };
+        std::vector<std::uint32_t> order{};
+        std::vector<bool> visited(m_states.size(), false);
+        for (const std::uint32_t id : rejected)
+        {
+            if (visited[id])
+                continue;
+
+            visited[id] = true;
+            std::vector<Frame> stack{{id, m_session.users(key(id)), 0}};
+            while (!stack.empty())
+            {
+                Frame& frame{stack.back()};
+                if (frame.next < frame.users.size())
+                {
+                    const std::uint32_t user{line(frame.users[frame.next++])};
+                    if (user != 0 && !visited[user])
+                    {
+                        visited[user] = true;
+                        stack.push_back({user, m_session.users(key(user)), 0});
+                    }
+                    continue;
+                }
+
+                order.push_back(frame.id);
+                stack.pop_back();
+            }
+        }
+
+        std::vector<Result> before{};
+        for (const std::uint32_t id : order)
+        {
+            before.push_back(result(position(id), id));
+            (void)m_session.remove(key(id));
+        }
+
+        // In order, as for new content, the lines with another result than
+        // before are added.
+        std::vector<std::pair<std::size_t, std::size_t>> lines{};
+        for (std::size_t k{0}; k < order.size(); ++k)
+            lines.emplace_back(position(order[k]), k);
+        std::sort(lines.begin(), lines.end());
+        std::vector<std::string> changed{};
+        for (const auto& [index, k] : lines)
+            define(order[k], changed);
+        for (const auto& [index, k] : lines)
+            if (!same(result(index, order[k]), before[k]))
+                touched.push_back(order[k]);
+    }
+
+    std::uint32_t Document::line(const std::string& name) const
+    {
+        if (name.front() == '#')
+            return static_cast<std::uint32_t>(std::stoul(name.substr(1)));
+
+        const auto it{m_holders.find(name)};
+        return (it != m_holders.end()) ? it->second.active : 0;
+    }
+
+    std::size_t Document::position(std::uint32_t id) const
+    {
+        return m_places[id].block->first + m_places[id].index;
+    }
+
+    Document::Result Document::result(std::size_t line) const
+    {
+        if (line == 0 || line > size())
+            throw std::invalid_argument("Document: there is no line " + std::to_string(line));
+
+        const Block& in{*m_blocks[block(line - 1)]};
+        return result(line - 1, in.lines[line - 1 - in.first].id);
+    }
+
+    std::size_t Document::size() const noexcept
+    {
+        const Block& last{*m_blocks.back()};
+        return last.first + last.lines.size();
+    }
+
+    const Session& Document::session() const noexcept
+    {
+        return m_session;
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,773 @@
+//
+//  Expression.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Expression.hpp"
+#include "calceval/Interpreter.hpp"
+#include "calceval/Quadrature.hpp"
+#include "calceval/Series.hpp"
+#include "calceval/Simd.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace CalcEval
+{
+    namespace
+    {
+        // A value on the stack of evaluateBatch, either a block with one
+        // value per row or, if data is nullptr, one value for all rows.
+        struct Slot
+        {
+            const double* data;
+            double value;
+        };
+
+        // out[i] = op(a[i], b[i]) for a block where at least one of a and b
+        // is not a single value. op is called with both Simd::Pack and
+        // double, so the lanes and the tail get the same operation.
+        template<typename Op>
+        void binary(Slot a, Slot b, double* out, std::size_t n, Op op) noexcept
+        {
+            std::size_t i{0};
+            if (a.data && b.data)
+            {
+                for (; i + Simd::width <= n; i += Simd::width)
+                    Simd::store(out + i, op(Simd::load(a.data + i), Simd::load(b.data + i)));
+                for (; i < n; ++i)
+                    out[i] = op(a.data[i], b.data[i]);
+            }
+            else if (a.data)
+            {
+                const Simd::Pack bs{Simd::broadcast(b.value)};
+                for (; i + Simd::width <= n; i += Simd::width)
+                    Simd::store(out + i, op(Simd::load(a.data + i), bs));
+                for (; i < n; ++i)
+                    out[i] = op(a.data[i], b.value);
+            }
+            else
+            {
+                const Simd::Pack as{Simd::broadcast(a.value)};
+                for (; i + Simd::width <= n; i += Simd::width)
+                    Simd::store(out + i, op(as, Simd::load(b.data + i)));
+                for (; i < n; ++i)
+                    out[i] = op(a.value, b.data[i]);
+            }
+        }
+
+        // A comparison that gives 1 where it is true and 0 where not, for
+        // Simd::Pack and double like the operators in binary.
+        template<typename Scalar, typename Vector>
+        struct Comparison
+        {
+            Scalar scalar;
+            Vector vector;
+
+            double operator()(double a, double b) const noexcept
+            {
+                return scalar(a, b) ? 1.0 : 0.0;
+            }
+
+            Simd::Pack operator()(Simd::Pack a, Simd::Pack b) const noexcept
+            {
+                return Simd::select(vector(a, b), Simd::broadcast(1.0), Simd::broadcast(0.0));
+            }
+        };
+
+        template<typename Scalar, typename Vector>
+        Comparison<Scalar, Vector> compare(Scalar scalar, Vector vector) noexcept
+        {
+            return {scalar, vector};
+        }
+
+        // Adds value to the running hash of the shape, see push.
+        inline std::uint64_t mix(std::uint64_t h, std::uint64_t value) noexcept
+        {
+            h = (h ^ value) * 0x9e3779b97f4a7c15ull;
+            return h ^ (h >> 32);
+        }
+
+        inline double at(const Slot& slot, std::size_t i) noexcept
+        {
+            return slot.data ? slot.data[i] : slot.value;
+        }
+
+        inline Simd::Pack pack(const Slot& slot, std::size_t i) noexcept
+        {
+            return slot.data ? Simd::load(slot.data + i) : Simd::broadcast(slot.value);
+        }
+
+        // out[i] = (c[i] != 0) ? a[i] : b[i], both a and b are computed and
+        // the lanes are picked with a mask instead of a branch.
+        void select(Slot c, Slot a, Slot b, double* out, std::size_t n) noexcept
+        {
+            const Simd::Pack zero{Simd::broadcast(0.0)};
+            std::size_t i{0};
+            for (; i + Simd::width <= n; i += Simd::width)
+                Simd::store(out + i, Simd::select(Simd::equal(pack(c, i), zero), pack(b, i),
+                                                  pack(a, i)));
+            for (; i < n; ++i)
+                out[i] = (at(c, i) != 0.0) ? at(a, i) : at(b, i);
+        }
+
+        // Evaluates the rows of results in blocks. constant(index, start) and
+        // variable(index, start) give the slot of an operand for the block
+        // starting at row start, which makes it possible to use the same
+        // code for columns of variables (evaluateBatch) and of constants
+        // (evaluateLanes).
+        template<typename Constant, typename Variable>
+        void runBatch(const Expression& expression, Constant constant, Variable variable,
+                      Span<double> results, Kernel::Accuracy accuracy)
+        {
+            const std::size_t rows{results.size()};
+            const std::vector<Instruction>& code{expression.code()};
+            std::size_t maxCount{0};
+            for (const Expression::Call& call : expression.variadics())
+                maxCount = std::max<std::size_t>(maxCount, call.count);
+
+            // Every stack position has its own block, the last instruction
+            // writes directly to results.
+            const std::size_t block{expression.blockSize()};
+            std::vector<double> blocks(expression.stackSize() * block);
+            std::vector<Slot> stack(expression.stackSize());
+            std::vector<double> arguments(maxCount);
+            std::vector<Slot> inputs(expression.variableCount());
+            std::vector<double> values(expression.variableCount());
+
+            // A single value operand of a vectorized operator is repeated
+            // for the block.
+            bool hooks{false};
+            for (const OpCode op : {OpCode::Add, OpCode::Subtract, OpCode::Multiply,
+                                    OpCode::Divide, OpCode::Power})
+                hooks = hooks || expression.batchOperator(op);
+            std::vector<double> repeated((hooks) ? block : 0);
+
+            const auto add = [](auto a, auto b) { return a + b; };
+            const auto subtract = [](auto a, auto b) { return a - b; };
+            const auto multiply = [](auto a, auto b) { return a * b; };
+            const auto divide = [](auto a, auto b) { return a / b; };
+            const auto less = compare([](double a, double b) { return a < b; },
+                                      [](Simd::Pack a, Simd::Pack b) { return Simd::less(a, b); });
+            const auto lessEqual =
+                compare([](double a, double b) { return a <= b; },
+                        [](Simd::Pack a, Simd::Pack b) { return Simd::lessEqual(a, b); });
+            const auto greater =
+                compare([](double a, double b) { return a > b; },
+                        [](Simd::Pack a, Simd::Pack b) { return Simd::greater(a, b); });
+            const auto greaterEqual =
+                compare([](double a, double b) { return a >= b; },
+                        [](Simd::Pack a, Simd::Pack b) { return Simd::lessEqual(b, a); });
+            const auto equal =
+                compare([](double a, double b) { return a == b; },
+                        [](Simd::Pack a, Simd::Pack b) { return Simd::equal(a, b); });
+            const auto notEqual =
+                compare([](double a, double b) { return a != b; },
+                        [](Simd::Pack a, Simd::Pack b) { return Simd::notEqual(a, b); });
+
+            for (std::size_t start{0}; start < rows; start += block)
+            {
+                const std::size_t n{std::min(block, rows - start)};
+                std::size_t top{0};
+
+                for (std::size_t k{0}; k < code.size(); ++k)
+                {
+                    const Instruction& instruction{code[k]};
+                    const auto destination = [&](std::size_t position) {
+                        return (k + 1 == code.size()) ? results.data() + start
+                                                        : blocks.data() + position * block;
+                    };
+
+                    switch (instruction.op)
+                    {
+                        case OpCode::Constant:
+                            stack[top++] = constant(instruction.index, start);
+                            break;
+                        case OpCode::Variable:
+                            stack[top++] = variable(instruction.index, start);
+                            break;
+                        case OpCode::Negate:
+                        {
+                            Slot& a{stack[top - 1]};
+                            if (!a.data)
+                            {
+                                a.value = a.value * -1.0;
+                                break;
+                            }
+                            double* out{destination(top - 1)};
+                            binary(a, {nullptr, -1.0}, out, n, multiply);
+                            a.data = out;
+                            break;
+                        }
+                        case OpCode::Add:
+                        case OpCode::Subtract:
+                        case OpCode::Multiply:
+                        case OpCode::Divide:
+                        case OpCode::Power:
+                        {
+                            const Slot b{stack[--top]};
+                            Slot& a{stack[top - 1]};
+                            const OpCode op{instruction.op};
+                            if (!a.data && !b.data)
+                            {
+                                // Same value for all rows, computed once.
+                                const double x{a.value}, y{b.value};
+                                a.value = (op == OpCode::Add)        ? x + y
+                                          : (op == OpCode::Subtract) ? x - y
+                                          : (op == OpCode::Multiply) ? x * y
+                                          : (op == OpCode::Divide)   ? x / y
+                                                                     : std::pow(x, y);
+                                break;
+                            }
+
+                            double* out{destination(top - 1)};
+                            if (const Kernel::binary_type batch{expression.batchOperator(op)})
+                            {
+                                const auto column = [&](const Slot& slot) {
+                                    if (slot.data)
+                                        return Span<const double>{slot.data, n};
+                                    std::fill_n(repeated.begin(), n, slot.value);
+                                    return Span<const double>{repeated.data(), n};
+                                };
+                                batch(column(a), column(b), Span<double>{out, n}, accuracy);
+                            }
+                            else if (op == OpCode::Add)
+                                binary(a, b, out, n, add);
+                            else if (op == OpCode::Subtract)
+                                binary(a, b, out, n, subtract);
+                            else if (op == OpCode::Multiply)
+                                binary(a, b, out, n, multiply);
+                            else if (op == OpCode::Divide)
+                                binary(a, b, out, n, divide);
+                            else
+                                for (std::size_t i{0}; i < n; ++i)
+                                    out[i] = std::pow(at(a, i), at(b, i));
+                            a = {out, 0.0};
+                            break;
+                        }
+                        case OpCode::Less:
+                        case OpCode::LessEqual:
+                        case OpCode::Greater:
+                        case OpCode::GreaterEqual:
+                        case OpCode::Equal:
+                        case OpCode::NotEqual:
+                        {
+                            const Slot b{stack[--top]};
+                            Slot& a{stack[top - 1]};
+                            const OpCode op{instruction.op};
+                            if (!a.data && !b.data)
+                            {
+                                const double x{a.value}, y{b.value};
+                                a.value = (op == OpCode::Less)           ? less(x, y)
+                                          : (op == OpCode::LessEqual)    ? lessEqual(x, y)
+                                          : (op == OpCode::Greater)      ? greater(x, y)
+                                          : (op == OpCode::GreaterEqual) ? greaterEqual(x, y)
+                                          : (op == OpCode::Equal)        ? equal(x, y)
+                                                                         : notEqual(x, y);
+                                break;
+                            }
+
+                            double* out{destination(top - 1)};
+                            if (op == OpCode::Less)
+                                binary(a, b, out, n, less);
+                            else if (op == OpCode::LessEqual)
+                                binary(a, b, out, n, lessEqual);
+                            else if (op == OpCode::Greater)
+                                binary(a, b, out, n, greater);
+                            else if (op == OpCode::GreaterEqual)
+                                binary(a, b, out, n, greaterEqual);
+                            else if (op == OpCode::Equal)
+                                binary(a, b, out, n, equal);
+                            else
+                                binary(a, b, out, n, notEqual);
+                            a = {out, 0.0};
+                            break;
+                        }
+                        case OpCode::Then:
+                        case OpCode::Else:
+                            // Both branches are evaluated, see Select.
+                            break;
+                        case OpCode::Select:
+                        {
+                            top -= 2;
+                            Slot& c{stack[top - 1]};
+                            const Slot a{stack[top]}, b{stack[top + 1]};
+                            double* out{destination(top - 1)};
+                            if (!c.data)
+                            {
+                                // Same branch for all rows. A block of the
+                                // branch belongs to a position above this one,
+                                // it is copied before it is overwritten.
+                                const Slot& taken{(c.value != 0.0) ? a : b};
+                                if (taken.data)
+                                    std::copy(taken.data, taken.data + n, out);
+                                c = taken.data ? Slot{out, 0.0} : taken;
+                                break;
+                            }
+
+                            select(c, a, b, out, n);
+                            c = {out, 0.0};
+                            break;
+                        }
+                        case OpCode::Function:
+                        {
+                            const Expression::Function& func{
+                                expression.functions()[instruction.index]};
+                            Slot& a{stack[top - 1]};
+                            if (!a.data)
+                            {
+                                a.value = func.function(a.value);
+                                break;
+                            }
+
+                            double* out{destination(top - 1)};
+                            if (func.batch)
+                                func.batch(Span<const double>{a.data, n}, Span<double>{out, n},
+                                           accuracy);
+                            else if (func.array)
+                                func.array(a.data, out, n);
+                            else
+                                for (std::size_t i{0}; i < n; ++i)
+                                    out[i] = func.function(a.data[i]);
+                            a.data = out;
+                            break;
+                        }
+                        case OpCode::Variadic:
+                        {
+                            const Expression::Call& call{expression.variadics()[instruction.index]};
+                            top -= call.count;
+                            const Slot* args{stack.data() + top};
+                            const bool single{std::none_of(args, args + call.count,
+                                                           [](const Slot& s) { return s.data; })};
+
+                            // Row by row, the arguments of a row are read before
+                            // its result is written.
+                            double* out{destination(top)};
+                            for (std::size_t i{0}; i < (single ? 1 : n); ++i)
+                            {
+                                for (std::uint32_t j{0}; j < call.count; ++j)
+                                    arguments[j] = at(args[j], i);
+                                out[i] = call.function(
+                                    Span<const double>{arguments.data(), call.count});
+                            }
+
+                            stack[top++] = single ? Slot{nullptr, out[0]} : Slot{out, 0.0};
+                            break;
+                        }
+                        case OpCode::Reduce:
+                        {
+                            // Row by row, with the values of the variables of
+                            // the row.
+                            const Expression::Reduction& reduction{
+                                expression.reductions()[instruction.index]};
+                            top -= reduction.count;
+                            const Slot* args{stack.data() + top};
+                            bool single{std::none_of(args, args + reduction.count,
+                                                     [](const Slot& s) { return s.data; })};
+                            for (std::uint32_t v{0}; v < values.size(); ++v)
+                            {
+                                inputs[v] = variable(v, start);
+                                single = single && !inputs[v].data;
+                            }
+
+                            double operands[3]{};
+                            double* out{destination(top)};
+                            for (std::size_t i{0}; i < (single ? 1 : n); ++i)
+                            {
+                                for (std::uint32_t j{0}; j < reduction.count; ++j)
+                                    operands[j] = at(args[j], i);
+                                for (std::size_t v{0}; v < values.size(); ++v)
+                                    values[v] = at(inputs[v], i);
+                                out[i] = reduction.evaluate(
+                                    Span<const double>{operands, reduction.count}, values);
+                            }
+
+                            stack[top++] = single ? Slot{nullptr, out[0]} : Slot{out, 0.0};
+                            break;
+                        }
+                    }
+                }
+
+                // A result that is a single value or a variable is not in results yet.
+                const Slot& result{stack[0]};
+                double* out{results.data() + start};
+                if (!result.data)
+                    std::fill(out, out + n, result.value);
+                else if (result.data != out)
+                    std::copy(result.data, result.data + n, out);
+            }
+        }
+
+        // Functions of an Expression for Interpreter::run.
+        struct Calls
+        {
+            const Expression& expression;
+
+            double function(std::uint32_t index, double x) const
+            {
+                return expression.functions()[index].function(x);
+            }
+
+            std::uint32_t arguments(const Instruction& instruction) const noexcept
+            {
+                return (instruction.op == OpCode::Variadic)
+                           ? expression.variadics()[instruction.index].count
+                           : expression.reductions()[instruction.index].count;
+            }
+
+            double variadic(std::uint32_t index, Span<const double> arguments) const
+            {
+                return expression.variadics()[index].function(arguments);
+            }
+
+            double reduce(std::uint32_t index, Span<const double> operands,
+                          const double* variables) const
+            {
+                return expression.reductions()[index].evaluate(
+                    operands, Span<const double>{variables, expression.variableCount()});
+            }
+        };
+
+    } // namespace
+
+    Expression::Expression(const std::vector<std::string>& variables)
+    {
+        m_variables.reserve(variables.size());
+        for (const std::string& name : variables)
+        {
+            if (!m_variables.insert(name).second)
+                throw std::invalid_argument("Expression: variable \"" + name +
+                                            "\" already exists");
+            m_shapeHash = mix(m_shapeHash, hash(name));
+        }
+    }
+
+    void Expression::pushConstant(double value)
+    {
+        push(OpCode::Constant, static_cast<std::uint32_t>(m_constants.size()), 0);
+        m_constants.push_back(value);
+    }
+
+    void Expression::pushVariable(std::uint32_t index)
+    {
+        if (index >= m_variables.size())
+            throw std::invalid_argument("Expression: no variable " + std::to_string(index));
+
+        push(OpCode::Variable, index, 0);
+    }
+
+    void Expression::pushOperator(OpCode op)
+    {
+        if (op < OpCode::Negate || op > OpCode::Select)
+            throw std::invalid_argument("Expression: not an operator");
+
+        if (op == OpCode::Select)
+        {
+            link();
+            push(op, 0, 3);
+            m_markers -= 2;
+            return;
+        }
+
+        const bool marker{op == OpCode::Then || op == OpCode::Else};
+        push(op, 0, (op == OpCode::Negate || marker) ? 1 : 2);
+        if (marker)
+            ++m_markers;
+    }
+
+    void Expression::link()
+    {
+        // The operands of the Select must be c, Then, a, Else and b.
+        const std::size_t n{m_starts.size()};
+        if (n < 3 || m_code[m_starts[n - 2] - 1].op != OpCode::Then ||
+            m_code[m_starts[n - 1] - 1].op != OpCode::Else)
+            throw std::invalid_argument("Expression: select without then and else");
+
+        // Then skips a and Else, Else skips b and the Select.
+        const std::uint32_t then{m_starts[n - 2] - 1};
+        const std::uint32_t otherwise{m_starts[n - 1] - 1};
+        m_code[then].index = otherwise - then;
+        m_code[otherwise].index = static_cast<std::uint32_t>(m_code.size()) - otherwise;
+    }
+
+    void Expression::pushFunction(std::string_view name, func_type function,
+                                  Kernel::func_type batch, batch_type array)
+    {
+        push(OpCode::Function, static_cast<std::uint32_t>(m_functions.size()), 1);
+        m_functions.push_back({std::string{name}, function, batch, array});
+        m_shapeHash = mix(m_shapeHash, hash(name));
+    }
+
+    void Expression::pushVariadic(std::string_view name, variadic_type function,
+                                  std::uint32_t count)
+    {
+        if (count == 0)
+            throw std::invalid_argument("Expression: call without arguments");
+
+        push(OpCode::Variadic, static_cast<std::uint32_t>(m_variadics.size()), count);
+        m_variadics.push_back({std::string{name}, function, count});
+        m_shapeHash = mix(m_shapeHash, hash(name));
+    }
+
+    void Expression::pushReduction(std::string_view name, Reduction::Kind kind, Expression body)
+    {
+        if (!body.complete())
+            throw std::invalid_argument("Expression: body is not a complete expression");
+        // A variable with the name of the last one is hidden, named '#'
+        // and its index.
+        const auto last{static_cast<std::uint32_t>(m_variables.size())};
+        bool variables{body.m_variables.size() == m_variables.size() + 1};
+        for (std::uint32_t i{0}; variables && i < last; ++i)
+            variables = body.m_variables.name(i) == m_variables.name(i) ||
+                        (m_variables.name(i) == body.m_variables.name(last) &&
+                         body.m_variables.name(i) == "#" + std::to_string(i));
+        if (!variables)
+            throw std::invalid_argument("Expression: body must have the variables and one more");
+
+        const std::uint32_t count{(kind == Reduction::Kind::Integral) ? 3u : 2u};
+        push(OpCode::Reduce, static_cast<std::uint32_t>(m_reductions.size()), count);
+        m_shapeHash =
+            mix(m_shapeHash, hash(name) ^ body.shapeHash() ^ static_cast<std::uint64_t>(kind));
+        m_reductions.push_back(
+            {std::string{name}, kind, count, std::make_shared<const Expression>(std::move(body))});
+    }
+
+    void Expression::setBatchOperator(OpCode op, Kernel::binary_type batch)
+    {
+        if (op < OpCode::Add || op > OpCode::Power)
+            throw std::invalid_argument("Expression: only Add to Power have a batch operator");
+
+        m_operators[static_cast<std::size_t>(op) - static_cast<std::size_t>(OpCode::Add)] = batch;
+    }
+
+    Kernel::binary_type Expression::batchOperator(OpCode op) const noexcept
+    {
+        if (op < OpCode::Add || op > OpCode::Power)
+            return nullptr;
+
+        return m_operators[static_cast<std::size_t>(op) - static_cast<std::size_t>(OpCode::Add)];
+    }
+
+    void Expression::push(OpCode op, std::uint32_t index, std::size_t pops)
+    {
+        if (m_depth < pops)
+            throw std::invalid_argument("Expression: too few values on the stack");
+
+        const auto start{(pops > 0) ? m_starts[m_starts.size() - pops]
+                                    : static_cast<std::uint32_t>(m_code.size())};
+        m_starts.resize(m_starts.size() - pops);
+        m_starts.push_back(start);
+
+        m_code.push_back({op, index});
+        const std::uint64_t code{static_cast<std::uint8_t>(op)};
+        m_shapeHash = mix(m_shapeHash, (code << 32) | index);
+        m_depth = m_depth - pops + 1;
+        if (m_depth > m_stackSize)
+            m_stackSize = m_depth;
+    }
+
+    double Expression::evaluate(Span<const double> variables) const
+    {
+        if (variables.size() != m_variables.size())
+            throw std::invalid_argument("Expression: expected " +
+                                        std::to_string(m_variables.size()) + " variable(s), got " +
+                                        std::to_string(variables.size()));
+        if (!complete())
+            throw std::invalid_argument("Expression: code is not a complete expression");
+
+        // Most expressions are shallow, those do not allocate.
+        constexpr std::size_t localSize{64};
+        if (m_stackSize <= localSize)
+        {
+            std::array<double, localSize> stack;
+            return run(0, m_code.size(), stack.data(), variables.data());
+        }
+
+        std::vector<double> stack(m_stackSize);
+        return run(0, m_code.size(), stack.data(), variables.data());
+    }
+
+    double Expression::run(std::size_t begin, std::size_t end, double* stack,
+                           const double* variables) const
+    {
+        return Interpreter::run(m_code.data(), begin, end, m_constants.data(), stack, variables,
+                                Calls{*this});
+    }
+
+    void Expression::evaluateBatch(Span<const Span<const double>> columns, Span<double> results,
+                                   Kernel::Accuracy accuracy) const
+    {
+        const std::size_t rows{results.size()};
+        if (columns.size() != m_variables.size())
+            throw std::invalid_argument("Expression: expected " +
+                                        std::to_string(m_variables.size()) + " column(s), got " +
+                                        std::to_string(columns.size()));
+        for (const Span<const double>& column : columns)
+            if (column.size() != rows && column.size() != 1)
+                throw std::invalid_argument("Expression: column with " +
+                                            std::to_string(column.size()) + " value(s), expected " +
+                                            std::to_string(rows));
+        if (!complete())
+            throw std::invalid_argument("Expression: code is not a complete expression");
+
+        runBatch(
+            *this, [this](std::uint32_t index, std::size_t) -> Slot {
+                return {nullptr, m_constants[index]};
+            },
+            [&columns](std::uint32_t index, std::size_t start) -> Slot {
+                const Span<const double>& column{columns[index]};
+                if (column.size() == 1)
+                    return {nullptr, column[0]};
+                return {column.data() + start, 0.0};
+            },
+            results, accuracy);
+    }
+
+    void Expression::evaluateLanes(Span<const Span<const double>> constants,
+                                   Span<const double> variables, Span<double> results,
+                                   Kernel::Accuracy accuracy) const
+    {
+        const std::size_t lanes{results.size()};
+        if (constants.size() != m_constants.size())
+            throw std::invalid_argument("Expression: expected " +
+                                        std::to_string(m_constants.size()) +
+                                        " constant column(s), got " +
+                                        std::to_string(constants.size()));
+        for (const Span<const double>& column : constants)
+            if (column.size() != lanes)
+                throw std::invalid_argument("Expression: column with " +
+                                            std::to_string(column.size()) + " value(s), expected " +
+                                            std::to_string(lanes));
+        if (variables.size() != m_variables.size())
+            throw std::invalid_argument("Expression: expected " +
+                                        std::to_string(m_variables.size()) + " variable(s), got " +
+                                        std::to_string(variables.size()));
+        if (!complete())
+            throw std::invalid_argument("Expression: code is not a complete expression");
+
+        runBatch(
+            *this,
+            [&constants](std::uint32_t index, std::size_t start) -> Slot {
+                return {constants[index].data() + start, 0.0};
+            },
+            [&variables](std::uint32_t index, std::size_t) -> Slot {
+                return {nullptr, variables[index]};
+            },
+            results, accuracy);
+    }
+
+    bool Expression::sameShape(const Expression& other) const noexcept
+    {
+        const auto sameInstruction = [](const Instruction& a, const Instruction& b) {
+            return a.op == b.op && a.index == b.index;
+        };
+        const auto sameFunction = [](const Function& a, const Function& b) {
+            return a.function == b.function && a.batch == b.batch && a.array == b.array;
+        };
+        const auto sameCall = [](const Call& a, const Call& b) {
+            return a.function == b.function && a.count == b.count;
+        };
+        // The constants of a body are not lanes, they must be the same.
+        const auto sameReduction = [](const Reduction& a, const Reduction& b) {
+            return a.kind == b.kind && a.body->sameShape(*b.body) &&
+                   a.body->constants() == b.body->constants();
+        };
+
+        if (m_variables.size() != other.m_variables.size() || m_operators != other.m_operators)
+            return false;
+        for (std::uint32_t i{0}; i < m_variables.size(); ++i)
+            if (m_variables.name(i) != other.m_variables.name(i))
+                return false;
+
+        return std::equal(m_code.begin(), m_code.end(), other.m_code.begin(),
+                          other.m_code.end(), sameInstruction) &&
+               std::equal(m_functions.begin(), m_functions.end(), other.m_functions.begin(),
+                          other.m_functions.end(), sameFunction) &&
+               std::equal(m_variadics.begin(), m_variadics.end(), other.m_variadics.begin(),
+                          other.m_variadics.end(), sameCall) &&
+               std::equal(m_reductions.begin(), m_reductions.end(), other.m_reductions.begin(),
+                          other.m_reductions.end(), sameReduction);
+    }
+
+    std::uint64_t Expression::shapeHash() const noexcept
+    {
+        return m_shapeHash;
+    }
+
+    std::size_t Expression::blockSize() const noexcept
+    {
+        constexpr std::size_t bytes{16 * 1024};
+        const std::size_t rows{bytes / (sizeof(double) * std::max<std::size_t>(m_stackSize, 1))};
+        return std::clamp<std::size_t>(rows, 64, 1024) & ~std::size_t{7};
+    }
+
+    const std::vector<Instruction>& Expression::code() const noexcept
+    {
+        return m_code;
+    }
+
+    const std::vector<double>& Expression::constants() const noexcept
+    {
+        return m_constants;
+    }
+
+    const std::vector<Expression::Function>& Expression::functions() const noexcept
+    {
+        return m_functions;
+    }
+
+    const std::vector<Expression::Call>& Expression::variadics() const noexcept
+    {
+        return m_variadics;
+    }
+
+    double Expression::Reduction::evaluate(Span<const double> operands,
+                                           Span<const double> variables) const
+    {
+        switch (kind)
+        {
+            case Kind::Sum:
+                return Series::sum(*body, operands[0], operands[1], variables);
+            case Kind::Product:
+                return Series::product(*body, operands[0], operands[1], variables);
+            case Kind::Integral:
+                return Quadrature::integrate(*body, operands[0], operands[1], operands[2],
+                                             variables)
+                    .value;
+        }
+
+        return 0.0;
+    }
+
+    const std::vector<Expression::Reduction>& Expression::reductions() const noexcept
+    {
+        return m_reductions;
+    }
+
+    const NameTable& Expression::variables() const noexcept
+    {
+        return m_variables;
+    }
+
+    std::size_t Expression::variableCount() const noexcept
+    {
+        return m_variables.size();
+    }
+
+    std::size_t Expression::stackSize() const noexcept
+    {
+        return m_stackSize;
+    }
+
+    bool Expression::complete() const noexcept
+    {
+        return m_depth == 1 && m_markers == 0;
+    }
+
+} // namespace CalcEval
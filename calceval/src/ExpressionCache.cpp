@@ -0,0 +1,235 @@
+//
+//  ExpressionCache.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/ExpressionCache.hpp"
+#include "calceval/Hash.hpp"
+
+// C++ Headers
+#include <cctype>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace CalcEval
+{
+    namespace
+    {
+        // Characters of names and numbers, see Scanner.
+        bool word(char c) noexcept
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '_';
+        }
+
+        // Characters that form a token with a following =.
+        bool relation(char c) noexcept
+        {
+            return c == '<' || c == '>' || c == '=' || c == '!';
+        }
+
+        // Estimate of the bytes used by expression, the reductions count
+        // their bodies, which may be shared with other expressions.
+        std::size_t bytes(const Expression& expression) noexcept
+        {
+            std::size_t total{sizeof(Expression) +
+                              expression.code().capacity() * sizeof(Instruction) +
+                              expression.constants().capacity() * sizeof(double) +
+                              expression.variableCount() * 32};
+            for (const Expression::Function& function : expression.functions())
+                total += sizeof(Expression::Function) + function.name.capacity();
+            for (const Expression::Call& call : expression.variadics())
+                total += sizeof(Expression::Call) + call.name.capacity();
+            for (const Expression::Reduction& reduction : expression.reductions())
+                total += sizeof(Expression::Reduction) + reduction.name.capacity() +
+                         ((reduction.body) ? bytes(*reduction.body) : 0);
+            return total;
+        }
+
+    } // namespace
+
+    ExpressionCache::ExpressionCache(std::size_t capacity, std::size_t shards)
+        : m_capacity{capacity}, m_shards(shards)
+    {
+        if (shards == 0)
+            throw std::invalid_argument("ExpressionCache: there must be at least one shard");
+    }
+
+    std::string ExpressionCache::canonical(std::string_view str)
+    {
+        std::string result{};
+        result.reserve(str.size());
+        bool space{false};
+        for (const char c : str)
+        {
+            if (std::isspace(static_cast<unsigned char>(c)))
+            {
+                space = true;
+                continue;
+            }
+
+            if (space && !result.empty())
+            {
+                const char last{result.back()};
+                if ((word(last) && word(c)) || (relation(last) && c == '='))
+                    result.push_back(' ');
+            }
+            space = false;
+            result.push_back(c);
+        }
+        return result;
+    }
+
+    std::string ExpressionCache::key(std::string_view str,
+                                     const std::vector<std::string>& variables)
+    {
+        // The variables after a character that is not in an expression.
+        std::string result{canonical(str)};
+        for (const std::string& variable : variables)
+        {
+            result.push_back('\n');
+            result += variable;
+        }
+        return result;
+    }
+
+    std::shared_ptr<const Expression>
+    ExpressionCache::find(std::string_view str, const std::vector<std::string>& variables) const
+    {
+        const std::string k{key(str, variables)};
+        const std::uint64_t h{hash(k)};
+        const Shard& shard{m_shards[h % m_shards.size()]};
+
+        {
+            const std::shared_lock lock{shard.mutex};
+            const auto it{shard.index.find(h)};
+            if (it != shard.index.end())
+            {
+                const Entry& entry{*shard.slots[it->second]};
+                if (entry.key == k)
+                {
+                    entry.used.store(true, std::memory_order_relaxed);
+                    shard.hits.fetch_add(1, std::memory_order_relaxed);
+                    return entry.expression;
+                }
+            }
+        }
+
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    std::shared_ptr<const Expression>
+    ExpressionCache::insert(std::string_view str, const std::vector<std::string>& variables,
+                            Expression expression)
+    {
+        auto entry{std::make_unique<Entry>()};
+        entry->key = key(str, variables);
+        entry->expression = std::make_shared<const Expression>(std::move(expression));
+        entry->bytes = sizeof(Entry) + entry->key.capacity() + bytes(*entry->expression);
+
+        const std::uint64_t h{hash(entry->key)};
+        Shard& shard{m_shards[h % m_shards.size()]};
+        const std::size_t limit{m_capacity / m_shards.size()};
+        if (entry->bytes > limit)
+            return entry->expression;
+
+        const std::unique_lock lock{shard.mutex};
+        const auto it{shard.index.find(h)};
+        if (it != shard.index.end())
+        {
+            Entry& old{*shard.slots[it->second]};
+            if (old.key == entry->key)
+                return old.expression;
+
+            // Another key with the same hash, the newer one is kept.
+            shard.bytes -= old.bytes;
+            shard.slots[it->second].reset();
+            shard.free.push_back(it->second);
+            shard.index.erase(it);
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        evict(shard, limit - entry->bytes);
+
+        // A free slot, or a new one at the end.
+        std::size_t slot{shard.slots.size()};
+        if (shard.free.empty())
+        {
+            shard.slots.emplace_back();
+        }
+        else
+        {
+            slot = shard.free.back();
+            shard.free.pop_back();
+        }
+
+        std::shared_ptr<const Expression> result{entry->expression};
+        shard.bytes += entry->bytes;
+        shard.slots[slot] = std::move(entry);
+        shard.index.emplace(h, slot);
+        return result;
+    }
+
+    void ExpressionCache::evict(Shard& shard, std::size_t bytes)
+    {
+        // Every entry is passed at most twice, once to clear its mark.
+        while (shard.bytes > bytes)
+        {
+            std::unique_ptr<Entry>& entry{shard.slots[shard.hand]};
+            if (entry && entry->used.exchange(false, std::memory_order_relaxed))
+            {
+                shard.hand = (shard.hand + 1) % shard.slots.size();
+                continue;
+            }
+
+            if (entry)
+            {
+                shard.index.erase(hash(entry->key));
+                shard.bytes -= entry->bytes;
+                shard.free.push_back(shard.hand);
+                entry.reset();
+                shard.evictions.fetch_add(1, std::memory_order_relaxed);
+            }
+            shard.hand = (shard.hand + 1) % shard.slots.size();
+        }
+    }
+
+    void ExpressionCache::clear()
+    {
+        for (Shard& shard : m_shards)
+        {
+            const std::unique_lock lock{shard.mutex};
+            shard.index.clear();
+            shard.slots.clear();
+            shard.free.clear();
+            shard.hand = 0;
+            shard.bytes = 0;
+        }
+    }
+
+    ExpressionCache::Statistics ExpressionCache::statistics() const
+    {
+        Statistics statistics{0, 0, 0, 0, 0};
+        for (const Shard& shard : m_shards)
+        {
+            statistics.hits += shard.hits.load(std::memory_order_relaxed);
+            statistics.misses += shard.misses.load(std::memory_order_relaxed);
+            statistics.evictions += shard.evictions.load(std::memory_order_relaxed);
+
+            const std::shared_lock lock{shard.mutex};
+            statistics.entries += shard.index.size();
+            statistics.bytes += shard.bytes;
+        }
+        return statistics;
+    }
+
+    std::size_t ExpressionCache::capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+} // namespace CalcEval
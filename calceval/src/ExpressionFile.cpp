@@ -0,0 +1,772 @@
+//
+//  ExpressionFile.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/ExpressionFile.hpp"
+#include "calceval/Hash.hpp"
+#include "calceval/Interpreter.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CalcEval
+{
+    namespace
+    {
+        constexpr char magic[8]{'C', 'A', 'L', 'C', 'E', 'V', 'A', 'L'};
+        constexpr std::uint32_t endianMarker{0x01020304};
+
+        struct Header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t endian;
+            std::uint64_t type;    // see typeKey
+            std::uint64_t sources; // see ExpressionFile::sourceHash
+            std::uint64_t expressions;
+            std::uint64_t records;
+            std::uint64_t functions;
+            std::uint64_t reductions;
+            std::uint64_t instructions;
+            std::uint64_t constants;
+            std::uint64_t strings;  // bytes, without the padding
+            std::uint64_t payload;  // hash of everything after the header
+            std::uint64_t checksum; // hash of the header before this field
+        };
+
+        // Function with count 0, function with several arguments otherwise.
+        struct FunctionEntry
+        {
+            std::uint64_t name;
+            std::uint32_t nameLength;
+            std::uint32_t count;
+        };
+
+        struct ReductionEntry
+        {
+            std::uint64_t name;
+            std::uint32_t nameLength;
+            std::uint32_t kind;
+            std::uint32_t count;
+            std::uint32_t body; // record
+        };
+
+        // The instructions are evaluated where they are in the file.
+        static_assert(sizeof(OpCode) == 1 && sizeof(Instruction) == 8 &&
+                          offsetof(Instruction, op) == 0 && offsetof(Instruction, index) == 4,
+                      "ExpressionFile: unexpected layout of Instruction");
+        static_assert(sizeof(Header) % 8 == 0 && sizeof(FunctionEntry) == 16 &&
+                          sizeof(ReductionEntry) == 24 && sizeof(double) == 8,
+                      "ExpressionFile: sections must be aligned to 8 bytes");
+
+        constexpr std::uint32_t opCodes{static_cast<std::uint32_t>(OpCode::Reduce) + 1};
+
+        // Key of the type and of what the instructions mean.
+        std::uint64_t typeKey(std::string_view type)
+        {
+            std::string key{type};
+            key += '\n' + std::to_string(ExpressionFile::formatVersion) + ' ' +
+                   std::to_string(opCodes) + ' ' + std::to_string(sizeof(Instruction));
+            return hash(key);
+        }
+
+        std::uint64_t headerChecksum(const Header& header)
+        {
+            return hash(std::string_view{reinterpret_cast<const char*>(&header),
+                                         offsetof(Header, checksum)});
+        }
+
+        template<typename T>
+        void append(std::string& out, const std::vector<T>& values)
+        {
+            out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+
+        // Functions of a file for Interpreter::run.
+        struct Calls
+        {
+            const std::vector<Expression::Function>& functions;
+            const std::vector<Expression::Call>& variadics;
+            const std::vector<Expression::Reduction>& reductions;
+            std::size_t variableCount;
+
+            double function(std::uint32_t index, double x) const
+            {
+                return functions[index].function(x);
+            }
+
+            std::uint32_t arguments(const Instruction& instruction) const noexcept
+            {
+                return (instruction.op == OpCode::Variadic) ? variadics[instruction.index].count
+                                                            : reductions[instruction.index].count;
+            }
+
+            double variadic(std::uint32_t index, Span<const double> arguments) const
+            {
+                return variadics[index].function(arguments);
+            }
+
+            double reduce(std::uint32_t index, Span<const double> operands,
+                          const double* variables) const
+            {
+                return reductions[index].evaluate(operands,
+                                                  Span<const double>{variables, variableCount});
+            }
+        };
+
+    } // namespace
+
+    struct ExpressionFile::Record
+    {
+        std::uint64_t code;      // first instruction
+        std::uint64_t constants; // first constant
+        std::uint64_t variables; // names separated by '\0', in the strings
+        std::uint32_t codeCount;
+        std::uint32_t constantCount;
+        std::uint32_t variableCount;
+        std::uint32_t variablesLength;
+        std::uint32_t stackSize;
+        std::uint32_t reserved;
+    };
+
+    struct ExpressionFile::Mapping
+    {
+        const char* data{nullptr};
+        std::size_t bytes{0};
+#if defined(_WIN32)
+        HANDLE file{INVALID_HANDLE_VALUE};
+        HANDLE mapping{nullptr};
+#endif
+
+        explicit Mapping(const std::string& path)
+        {
+#if defined(_WIN32)
+            file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            LARGE_INTEGER size{};
+            if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size))
+                fail(path, "could not be opened");
+            bytes = static_cast<std::size_t>(size.QuadPart);
+            if (bytes < sizeof(Header))
+                fail(path, "is too small");
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            const void* view{(mapping) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr};
+            if (!view)
+                fail(path, "could not be mapped");
+            data = static_cast<const char*>(view);
+#else
+            const int fd{::open(path.c_str(), O_RDONLY)};
+            if (fd < 0)
+                throw Error("ExpressionFile: \"" + path + "\" could not be opened");
+
+            // The mapping stays valid after the descriptor is closed.
+            struct stat status{};
+            const bool opened{::fstat(fd, &status) == 0};
+            bytes = (opened) ? static_cast<std::size_t>(status.st_size) : 0;
+            void* view{(bytes >= sizeof(Header))
+                           ? ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0)
+                           : MAP_FAILED};
+            ::close(fd);
+            if (!opened || bytes < sizeof(Header))
+                throw Error("ExpressionFile: \"" + path + "\" is too small");
+            if (view == MAP_FAILED)
+                throw Error("ExpressionFile: \"" + path + "\" could not be mapped");
+            data = static_cast<const char*>(view);
+#endif
+        }
+
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+
+        ~Mapping()
+        {
+#if defined(_WIN32)
+            release();
+#else
+            ::munmap(const_cast<char*>(data), bytes);
+#endif
+        }
+
+#if defined(_WIN32)
+        void release() noexcept
+        {
+            if (data)
+                UnmapViewOfFile(data);
+            if (mapping)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+        }
+
+        [[noreturn]] void fail(const std::string& path, const std::string& what)
+        {
+            release();
+            throw Error("ExpressionFile: \"" + path + "\" " + what);
+        }
+#endif
+    };
+
+    ExpressionFile::ExpressionFile(std::string path, std::string_view type, std::uint64_t sources,
+                                   const resolver_type& resolve)
+        : m_path{std::move(path)}, m_mapping{std::make_unique<Mapping>(m_path)}
+    {
+        const auto fail = [this](const std::string& what) {
+            return Error("ExpressionFile: \"" + m_path + "\" " + what);
+        };
+
+        const char* data{m_mapping->data};
+        const std::size_t bytes{m_mapping->bytes};
+        Header header{};
+        std::memcpy(&header, data, sizeof(Header));
+        if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+            throw fail("is not an expression file");
+        if (header.checksum != headerChecksum(header))
+            throw fail("has a damaged header");
+        if (header.version != formatVersion)
+            throw fail("has format version " + std::to_string(header.version) + ", expected " +
+                       std::to_string(formatVersion));
+        if (header.endian != endianMarker)
+            throw fail("has another byte order");
+        if (header.type != typeKey(type))
+            throw fail("was written for another type");
+        if (header.sources != sources)
+            throw fail("was written for other sources");
+
+        // The counts are checked one section at a time so they can not overflow.
+        std::size_t offset{sizeof(Header)};
+        const auto section = [&](std::uint64_t count, std::size_t size) {
+            if (count > (bytes - offset) / size)
+                throw fail("is truncated");
+            const char* start{data + offset};
+            offset += static_cast<std::size_t>(count) * size;
+            return start;
+        };
+        const char* records{section(header.records, sizeof(Record))};
+        const char* functions{section(header.functions, sizeof(FunctionEntry))};
+        const char* reductions{section(header.reductions, sizeof(ReductionEntry))};
+        const char* code{section(header.instructions, sizeof(Instruction))};
+        const char* constants{section(header.constants, sizeof(double))};
+        const char* strings{section(header.strings, 1)};
+        offset = (offset + 7) & ~std::size_t{7};
+        if (offset != bytes)
+            throw fail("has the wrong size");
+        if (header.payload != hash(std::string_view{data + sizeof(Header), bytes - sizeof(Header)}))
+            throw fail("is damaged");
+        if (header.expressions > header.records)
+            throw fail("has too few records");
+
+        // The mapping is aligned to a page and every section to 8 bytes.
+        m_records = reinterpret_cast<const Record*>(records);
+        m_code = reinterpret_cast<const Instruction*>(code);
+        m_constants = reinterpret_cast<const double*>(constants);
+        m_strings = strings;
+        m_size = static_cast<std::size_t>(header.expressions);
+        m_recordCount = static_cast<std::size_t>(header.records);
+        m_codeCount = static_cast<std::size_t>(header.instructions);
+        m_constantCount = static_cast<std::size_t>(header.constants);
+        m_stringBytes = static_cast<std::size_t>(header.strings);
+
+        const auto name = [&](std::uint64_t start, std::uint32_t length) {
+            if (start > m_stringBytes || length > m_stringBytes - start)
+                throw fail("has a name outside of the file");
+            return std::string{m_strings + start, length};
+        };
+
+        // The arguments of the functions, to check the code before resolving them.
+        std::vector<FunctionEntry> entries(static_cast<std::size_t>(header.functions));
+        std::memcpy(entries.data(), functions, entries.size() * sizeof(FunctionEntry));
+        m_functions.resize(entries.size());
+        m_variadics.resize(entries.size());
+        for (std::size_t i{0}; i < entries.size(); ++i)
+        {
+            m_variadics[i].name = name(entries[i].name, entries[i].nameLength);
+            m_variadics[i].count = entries[i].count;
+        }
+
+        std::vector<ReductionEntry> sums(static_cast<std::size_t>(header.reductions));
+        std::memcpy(sums.data(), reductions, sums.size() * sizeof(ReductionEntry));
+        std::vector<std::uint32_t> bodies{};
+        bodies.reserve(sums.size());
+        m_reductions.resize(sums.size());
+        for (std::size_t i{0}; i < sums.size(); ++i)
+        {
+            const ReductionEntry& entry{sums[i]};
+            if (entry.kind > static_cast<std::uint32_t>(Expression::Reduction::Kind::Integral) ||
+                entry.body < m_size || entry.body >= m_recordCount)
+                throw fail("has an invalid reduction");
+
+            Expression::Reduction& reduction{m_reductions[i]};
+            reduction.name = name(entry.name, entry.nameLength);
+            reduction.kind = static_cast<Expression::Reduction::Kind>(entry.kind);
+            reduction.count = (reduction.kind == Expression::Reduction::Kind::Integral) ? 3 : 2;
+            if (entry.count != reduction.count)
+                throw fail("has an invalid reduction");
+            bodies.push_back(entry.body);
+        }
+
+        for (std::size_t i{0}; i < m_recordCount; ++i)
+            validate(m_records[i], bodies);
+
+        // The functions are looked up by name, they are not in the file.
+        for (std::size_t i{0}; i < entries.size(); ++i)
+        {
+            const std::string function{m_variadics[i].name};
+            const std::uint32_t count{m_variadics[i].count};
+            std::string probe{function + "(x"};
+            for (std::uint32_t k{1}; k < count; ++k)
+                probe += ", x";
+            probe += ")";
+
+            Expression compiled{};
+            try
+            {
+                compiled = resolve(probe);
+            }
+            catch (const Error&)
+            {
+                throw fail("uses the unknown function " + function);
+            }
+
+            if (count == 0 && compiled.functions().size() == 1 &&
+                compiled.functions()[0].name == function)
+                m_functions[i] = compiled.functions()[0];
+            else if (count > 0 && compiled.variadics().size() == 1 &&
+                     compiled.variadics()[0].name == function)
+                m_variadics[i] = compiled.variadics()[0];
+            else
+                throw fail("uses the unknown function " + function);
+        }
+        const Expression operators{resolve("x")};
+        for (std::size_t op{0}; op < m_operators.size(); ++op)
+            m_operators[op] = operators.batchOperator(
+                static_cast<OpCode>(op + static_cast<std::size_t>(OpCode::Add)));
+
+        // Series and Quadrature evaluate the bodies in batches, so they are
+        // copied. The nested reductions of a body come after it.
+        try
+        {
+            for (std::size_t i{sums.size()}; i-- > 0;)
+                m_reductions[i].body = std::make_shared<const Expression>(
+                    materialize(m_records[bodies[i]], i + 1));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            throw fail(std::string{"has an invalid body: "} + e.what());
+        }
+    }
+
+    ExpressionFile::ExpressionFile(ExpressionFile&&) noexcept = default;
+    ExpressionFile& ExpressionFile::operator=(ExpressionFile&&) noexcept = default;
+    ExpressionFile::~ExpressionFile() = default;
+
+    void ExpressionFile::validate(const Record& record,
+                                  const std::vector<std::uint32_t>& bodies) const
+    {
+        const auto fail = [this](const std::string& what) {
+            return Error("ExpressionFile: \"" + m_path + "\" " + what);
+        };
+        if (record.code > m_codeCount || record.codeCount > m_codeCount - record.code ||
+            record.constants > m_constantCount ||
+            record.constantCount > m_constantCount - record.constants ||
+            record.variables > m_stringBytes ||
+            record.variablesLength > m_stringBytes - record.variables)
+            throw fail("has a record outside of the file");
+
+        // Then, Else and Select are matched on a stack of branches, both
+        // branches leave one value, so the depth is known everywhere.
+        struct Branch
+        {
+            std::size_t depth;  // before the branches
+            std::size_t target; // of the pending Then or Else
+            bool second;        // after the Else
+        };
+        std::vector<Branch> branches{};
+        std::size_t depth{0};
+        std::size_t largest{0};
+        const auto pop = [&](std::size_t count) {
+            if (depth < count)
+                throw fail("has code that pops an empty stack");
+            depth -= count;
+        };
+
+        const unsigned char* code{reinterpret_cast<const unsigned char*>(m_code + record.code)};
+        for (std::size_t k{0}; k < record.codeCount; ++k)
+        {
+            // The op is read as a byte until it is known to be an OpCode.
+            std::uint8_t op{0};
+            std::uint32_t index{0};
+            std::memcpy(&op, code + k * sizeof(Instruction) + offsetof(Instruction, op), 1);
+            std::memcpy(&index, code + k * sizeof(Instruction) + offsetof(Instruction, index),
+                        sizeof(index));
+            if (op >= opCodes)
+                throw fail("has an unknown instruction");
+
+            std::size_t pops{0};
+            switch (static_cast<OpCode>(op))
+            {
+                case OpCode::Constant:
+                    if (index >= record.constantCount)
+                        throw fail("has an invalid constant");
+                    break;
+                case OpCode::Variable:
+                    if (index >= record.variableCount)
+                        throw fail("has an invalid variable");
+                    break;
+                case OpCode::Negate:
+                case OpCode::Function:
+                    if (static_cast<OpCode>(op) == OpCode::Function &&
+                        (index >= m_variadics.size() || m_variadics[index].count != 0))
+                        throw fail("has an invalid function");
+                    pops = 1;
+                    break;
+                case OpCode::Then:
+                    pop(1);
+                    branches.push_back({depth, k + index, false});
+                    continue;
+                case OpCode::Else:
+                    if (branches.empty() || branches.back().second ||
+                        branches.back().target != k || depth != branches.back().depth + 1)
+                        throw fail("has an invalid if");
+                    branches.back() = {branches.back().depth, k + index, true};
+                    depth = branches.back().depth;
+                    continue;
+                case OpCode::Select:
+                    if (branches.empty() || !branches.back().second ||
+                        branches.back().target != k || depth != branches.back().depth + 1)
+                        throw fail("has an invalid if");
+                    branches.pop_back();
+                    continue;
+                case OpCode::Variadic:
+                    if (index >= m_variadics.size() || m_variadics[index].count == 0)
+                        throw fail("has an invalid function");
+                    pops = m_variadics[index].count;
+                    break;
+                case OpCode::Reduce:
+                    if (index >= m_reductions.size() ||
+                        m_records[bodies[index]].variableCount != record.variableCount + 1)
+                        throw fail("has an invalid reduction");
+                    pops = m_reductions[index].count;
+                    break;
+                default:
+                    // Add to NotEqual.
+                    pops = 2;
+                    break;
+            }
+
+            pop(pops);
+            ++depth;
+            largest = std::max(largest, depth);
+        }
+
+        if (!branches.empty() || depth != 1 || largest > record.stackSize)
+            throw fail("has incomplete code");
+    }
+
+    Expression ExpressionFile::materialize(const Record& record, std::size_t first) const
+    {
+        std::vector<std::string> names{};
+        const std::string_view variables{m_strings + record.variables, record.variablesLength};
+        for (std::size_t start{0}; start < variables.size();)
+        {
+            const std::size_t end{std::min(variables.find('\0', start), variables.size())};
+            names.emplace_back(variables.substr(start, end - start));
+            start = end + 1;
+        }
+        if (names.size() != record.variableCount)
+            throw std::invalid_argument("wrong number of variables");
+
+        Expression expression{names};
+        for (std::size_t k{0}; k < record.codeCount; ++k)
+        {
+            const Instruction& instruction{m_code[record.code + k]};
+            switch (instruction.op)
+            {
+                case OpCode::Constant:
+                    expression.pushConstant(m_constants[record.constants + instruction.index]);
+                    break;
+                case OpCode::Variable:
+                    expression.pushVariable(instruction.index);
+                    break;
+                case OpCode::Function:
+                {
+                    const Expression::Function& function{m_functions[instruction.index]};
+                    expression.pushFunction(function.name, function.function, function.batch,
+                                            function.array);
+                    break;
+                }
+                case OpCode::Variadic:
+                {
+                    const Expression::Call& call{m_variadics[instruction.index]};
+                    expression.pushVariadic(call.name, call.function, call.count);
+                    break;
+                }
+                case OpCode::Reduce:
+                {
+                    // A body that contains itself would never end.
+                    if (instruction.index < first)
+                        throw std::invalid_argument("reduction in its own body");
+                    const Expression::Reduction& reduction{m_reductions[instruction.index]};
+                    expression.pushReduction(reduction.name, reduction.kind, *reduction.body);
+                    break;
+                }
+                default:
+                    expression.pushOperator(instruction.op);
+                    break;
+            }
+        }
+
+        for (std::size_t op{0}; op < m_operators.size(); ++op)
+            expression.setBatchOperator(
+                static_cast<OpCode>(op + static_cast<std::size_t>(OpCode::Add)), m_operators[op]);
+        return expression;
+    }
+
+    void ExpressionFile::write(const std::string& path, const std::vector<Expression>& expressions,
+                               std::string_view type, std::uint64_t sources)
+    {
+        static_assert(sizeof(Record) == 48, "ExpressionFile: unexpected Record size");
+
+        std::vector<Record> records{};
+        std::vector<FunctionEntry> functions{};
+        std::vector<ReductionEntry> reductions{};
+        std::string code{};
+        std::vector<double> constants{};
+        std::string strings{};
+
+        // Functions are stored once per name and number of arguments.
+        std::map<std::pair<std::string_view, std::uint32_t>, std::uint32_t> ids{};
+        const auto function = [&](std::string_view name, std::uint32_t count) {
+            const auto [it, inserted] =
+                ids.emplace(std::make_pair(name, count), static_cast<std::uint32_t>(ids.size()));
+            if (inserted)
+            {
+                functions.push_back({strings.size(), static_cast<std::uint32_t>(name.size()),
+                                     count});
+                strings += name;
+            }
+            return it->second;
+        };
+
+        // The bodies of the reductions are records after the expressions.
+        std::vector<const Expression*> pending{};
+        for (const Expression& expression : expressions)
+            pending.push_back(&expression);
+
+        for (std::size_t r{0}; r < pending.size(); ++r)
+        {
+            const Expression& expression{*pending[r]};
+            Record record{};
+            record.code = code.size() / sizeof(Instruction);
+            record.constants = constants.size();
+            record.variables = strings.size();
+            for (std::uint32_t i{0}; i < expression.variableCount(); ++i)
+            {
+                if (i > 0)
+                    strings.push_back('\0');
+                strings += expression.variables().name(i);
+            }
+            record.codeCount = static_cast<std::uint32_t>(expression.code().size());
+            record.constantCount = static_cast<std::uint32_t>(expression.constants().size());
+            record.variableCount = static_cast<std::uint32_t>(expression.variableCount());
+            record.variablesLength = static_cast<std::uint32_t>(strings.size() - record.variables);
+            record.stackSize = static_cast<std::uint32_t>(expression.stackSize());
+            records.push_back(record);
+
+            std::vector<std::uint32_t> sums{};
+            for (const Expression::Reduction& reduction : expression.reductions())
+            {
+                sums.push_back(static_cast<std::uint32_t>(reductions.size()));
+                reductions.push_back({strings.size(),
+                                      static_cast<std::uint32_t>(reduction.name.size()),
+                                      static_cast<std::uint32_t>(reduction.kind), reduction.count,
+                                      static_cast<std::uint32_t>(pending.size())});
+                strings += reduction.name;
+                pending.push_back(reduction.body.get());
+            }
+
+            for (const Instruction& instruction : expression.code())
+            {
+                std::uint32_t index{instruction.index};
+                if (instruction.op == OpCode::Function)
+                    index = function(expression.functions()[index].name, 0);
+                else if (instruction.op == OpCode::Variadic)
+                    index = function(expression.variadics()[index].name,
+                                     expression.variadics()[index].count);
+                else if (instruction.op == OpCode::Reduce)
+                    index = sums[index];
+
+                // Written byte by byte so the padding is 0.
+                char bytes[sizeof(Instruction)]{};
+                std::memcpy(bytes + offsetof(Instruction, op), &instruction.op, 1);
+                std::memcpy(bytes + offsetof(Instruction, index), &index, sizeof(index));
+                code.append(bytes, sizeof(bytes));
+            }
+            constants.insert(constants.end(), expression.constants().begin(),
+                             expression.constants().end());
+        }
+
+        std::string payload{};
+        append(payload, records);
+        append(payload, functions);
+        append(payload, reductions);
+        payload += code;
+        append(payload, constants);
+        payload += strings;
+        payload.resize((payload.size() + 7) & ~std::size_t{7}, '\0');
+
+        Header header{};
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = formatVersion;
+        header.endian = endianMarker;
+        header.type = typeKey(type);
+        header.sources = sources;
+        header.expressions = expressions.size();
+        header.records = records.size();
+        header.functions = functions.size();
+        header.reductions = reductions.size();
+        header.instructions = code.size() / sizeof(Instruction);
+        header.constants = constants.size();
+        header.strings = strings.size();
+        header.payload = hash(payload);
+        header.checksum = headerChecksum(header);
+
+        // Renamed over path when complete, readers see the old or the new file.
+        const std::string temporary{path + ".tmp"};
+        {
+            std::ofstream out{temporary, std::ios::binary | std::ios::trunc};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            if (!out.flush())
+            {
+                std::error_code ignored{};
+                std::filesystem::remove(temporary, ignored);
+                throw Error("ExpressionFile: could not write \"" + temporary + "\"");
+            }
+        }
+
+        std::error_code error{};
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+        {
+            std::error_code ignored{};
+            std::filesystem::remove(temporary, ignored);
+            throw Error("ExpressionFile: could not write \"" + path + "\": " + error.message());
+        }
+    }
+
+    std::uint64_t ExpressionFile::sourceHash(const std::vector<std::string>& sources,
+                                             const std::vector<std::string>& variables,
+                                             const SymbolTable<double>* symbols)
+    {
+        // Separated by characters that are not in an expression.
+        std::uint64_t h{hashBasis};
+        for (const std::string& str : sources)
+            h = hash(str + '\n', h);
+        h = hash("\x01", h);
+        for (const std::string& variable : variables)
+            h = hash(variable + '\n', h);
+        if (!symbols)
+            return h;
+
+        // By name, the order they were registered in does not change the code.
+        std::vector<std::pair<std::string_view, double>> constants{};
+        const NameTable& names{symbols->names()};
+        for (NameTable::index_type i{0}; i < names.size(); ++i)
+            if (const auto value = symbols->constant(names.name(i)))
+                constants.emplace_back(names.name(i), *value);
+        std::sort(constants.begin(), constants.end());
+
+        h = hash("\x02", h);
+        for (const auto& [name, value] : constants)
+        {
+            char bytes[sizeof(double)];
+            std::memcpy(bytes, &value, sizeof(double));
+            h = hash(std::string{name} + '\n', h);
+            h = hash(std::string_view{bytes, sizeof(bytes)}, h);
+        }
+        return h;
+    }
+
+    const ExpressionFile::Record& ExpressionFile::record(std::size_t index) const
+    {
+        if (index >= m_size)
+            throw std::invalid_argument("ExpressionFile: no expression " + std::to_string(index));
+        return m_records[index];
+    }
+
+    double ExpressionFile::evaluate(std::size_t index, Span<const double> variables) const
+    {
+        const Record& r{record(index)};
+        if (variables.size() != r.variableCount)
+            throw std::invalid_argument("ExpressionFile: expected " +
+                                        std::to_string(r.variableCount) + " variable(s), got " +
+                                        std::to_string(variables.size()));
+
+        const Instruction* code{m_code + r.code};
+        const double* constants{m_constants + r.constants};
+        const Calls calls{m_functions, m_variadics, m_reductions, r.variableCount};
+
+        // Same as Expression::evaluate, shallow expressions do not allocate.
+        constexpr std::size_t localSize{64};
+        if (r.stackSize <= localSize)
+        {
+            std::array<double, localSize> stack;
+            return Interpreter::run(code, 0, r.codeCount, constants, stack.data(),
+                                    variables.data(), calls);
+        }
+
+        std::vector<double> stack(r.stackSize);
+        return Interpreter::run(code, 0, r.codeCount, constants, stack.data(), variables.data(),
+                                calls);
+    }
+
+    Expression ExpressionFile::expression(std::size_t index) const
+    {
+        return materialize(record(index), 0);
+    }
+
+    std::size_t ExpressionFile::size() const noexcept
+    {
+        return m_size;
+    }
+
+    std::size_t ExpressionFile::variableCount(std::size_t index) const
+    {
+        return record(index).variableCount;
+    }
+
+    const std::string& ExpressionFile::path() const noexcept
+    {
+        return m_path;
+    }
+
+    std::size_t ExpressionFile::bytes() const noexcept
+    {
+        return m_mapping->bytes;
+    }
+
+    bool ExpressionFile::rebuilt() const noexcept
+    {
+        return m_rebuilt;
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,616 @@
+//
+//  Kernel.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Kernel.hpp"
+#include "calceval/Simd.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+// The polynomials and range reductions follow fdlibm (Sun Microsystems),
+// with the branches replaced by lane-wise selects.
+
+namespace CalcEval::Kernel
+{
+    namespace
+    {
+        using Simd::Pack;
+
+        inline Pack set(double value) noexcept
+        {
+            return Simd::broadcast(value);
+        }
+
+        // Clears the low 32 bits, used to split a number in a high and a low part.
+        inline Pack high(Pack a) noexcept
+        {
+            return Simd::bitAnd(a, Simd::fromBits(0xffffffff00000000));
+        }
+
+        // Evaluates every lane of a with the scalar function.
+        template<typename Func>
+        inline Pack perLane(Pack a, Func func) noexcept
+        {
+            Simd::Lanes l{Simd::lanes(a)};
+            for (std::size_t i{0}; i < Simd::width; ++i)
+                l.v[i] = func(l.v[i]);
+            return Simd::load(l.v);
+        }
+
+        // Applies the kernel to every element, the tail is padded to a full pack
+        // so that an element gets the same result regardless of its position.
+        template<typename Func>
+        inline void apply(Span<const double> values, Span<double> results, Func kernel) noexcept
+        {
+            const double* in{values.data()};
+            double* out{results.data()};
+            const std::size_t n{values.size()};
+
+            // Two packs per iteration gives the CPU two independent chains.
+            std::size_t i{0};
+            for (; i + 2 * Simd::width <= n; i += 2 * Simd::width)
+            {
+                const Pack a{kernel(Simd::load(in + i))};
+                const Pack b{kernel(Simd::load(in + i + Simd::width))};
+                Simd::store(out + i, a);
+                Simd::store(out + i + Simd::width, b);
+            }
+            for (; i + Simd::width <= n; i += Simd::width)
+                Simd::store(out + i, kernel(Simd::load(in + i)));
+
+            if (i < n)
+            {
+                Simd::Lanes tail{};
+                for (std::size_t j{0}; j < Simd::width; ++j)
+                    tail.v[j] = (i + j < n) ? in[i + j] : 1.0;
+
+                tail = Simd::lanes(kernel(Simd::load(tail.v)));
+                for (std::size_t j{0}; i + j < n; ++j)
+                    out[i + j] = tail.v[j];
+            }
+        }
+
+        template<typename Func>
+        inline void exact(Span<const double> values, Span<double> results, Func func) noexcept
+        {
+            for (std::size_t i{0}; i < values.size(); ++i)
+                results[i] = func(values[i]);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // exp
+
+        constexpr double ln2Hi{6.93147180369123816490e-01};
+        constexpr double ln2Lo{1.90821492927058770002e-10};
+
+        Pack exp(Pack x) noexcept
+        {
+            // Outside of [-746, 710] the result is 0 or inf.
+            const Pack xc{Simd::min(Simd::max(x, set(-746.0)), set(710.0))};
+
+            // x = k * ln2 + r, |r| <= 0.5 * ln2.
+            const Pack k{Simd::round(xc * set(1.44269504088896338700e+00))};
+            const Pack r{(xc - k * set(ln2Hi)) - k * set(ln2Lo)};
+
+            // Taylor polynomial of degree 13, the truncation error is below 2^-57.
+            Pack p{Simd::mulAdd(r, set(1.0 / 6227020800.0), set(1.0 / 479001600.0))};
+            p = Simd::mulAdd(r, p, set(1.0 / 39916800.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 3628800.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 362880.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 40320.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 5040.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 720.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 120.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 24.0));
+            p = Simd::mulAdd(r, p, set(1.0 / 6.0));
+            p = Simd::mulAdd(r, p, set(0.5));
+            const Pack y{set(1.0) + Simd::mulAdd(r * r, p, r)};
+
+            // Scale by 2^k in two steps so that subnormal and overflowing
+            // results are rounded once.
+            const Pack k1{Simd::round(k * set(0.5) - set(0.25))};
+            const Pack result{y * Simd::pow2(k1) * Simd::pow2(k - k1)};
+
+            return Simd::select(Simd::isNaN(x), x, result);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // log and log10
+
+        // Splits x in 2^k * (1 + f) with sqrt(2)/2 <= 1 + f < sqrt(2) and
+        // returns log(1 + f) - f + hfsq, where hfsq = f^2 / 2.
+        Pack logParts(Pack x, Pack& k, Pack& f, Pack& hfsq) noexcept
+        {
+            constexpr double Lg1{6.666666666666735130e-01};
+            constexpr double Lg2{3.999999999940941908e-01};
+            constexpr double Lg3{2.857142874366239149e-01};
+            constexpr double Lg4{2.222219843214978396e-01};
+            constexpr double Lg5{1.818357216161805012e-01};
+            constexpr double Lg6{1.531383769920937332e-01};
+            constexpr double Lg7{1.479819860511658591e-01};
+
+            // Subnormal numbers are scaled up to get a normalized mantissa.
+            const Simd::Mask subnormal{Simd::less(x, set(std::numeric_limits<double>::min()))};
+            const Pack xs{Simd::select(subnormal, x * set(0x1p54), x)};
+            k = Simd::exponent(xs) - Simd::select(subnormal, set(54.0), set(0.0));
+
+            Pack m{Simd::bitOr(Simd::bitAnd(xs, Simd::fromBits(0x000fffffffffffff)),
+                               Simd::fromBits(0x3ff0000000000000))};
+            const Simd::Mask big{Simd::greater(m, set(1.41421356237309504880))};
+            m = Simd::select(big, m * set(0.5), m);
+            k = Simd::select(big, k + set(1.0), k);
+
+            f = m - set(1.0);
+            hfsq = set(0.5) * f * f;
+
+            const Pack s{f / (set(2.0) + f)};
+            const Pack z{s * s};
+            const Pack w{z * z};
+            const Pack t1{w * Simd::mulAdd(w, Simd::mulAdd(w, set(Lg6), set(Lg4)), set(Lg2))};
+            const Pack t2{z * Simd::mulAdd(
+                                  w, Simd::mulAdd(w, Simd::mulAdd(w, set(Lg7), set(Lg5)), set(Lg3)),
+                                  set(Lg1))};
+            return s * (hfsq + t2 + t1);
+        }
+
+        // log(0) = -inf, log(x < 0) = NaN, log(inf) = inf.
+        Pack logSpecial(Pack x, Pack result) noexcept
+        {
+            constexpr double inf{std::numeric_limits<double>::infinity()};
+            result = Simd::select(Simd::equal(x, set(0.0)), set(-inf), result);
+            result = Simd::select(Simd::less(x, set(0.0)),
+                                  set(std::numeric_limits<double>::quiet_NaN()), result);
+            result = Simd::select(Simd::equal(x, set(inf)), x, result);
+            return Simd::select(Simd::isNaN(x), x, result);
+        }
+
+        Pack log(Pack x) noexcept
+        {
+            Pack k{}, f{}, hfsq{};
+            const Pack r{logParts(x, k, f, hfsq)};
+            const Pack result{k * set(ln2Hi) - ((hfsq - (r + k * set(ln2Lo))) - f)};
+            return logSpecial(x, result);
+        }
+
+        Pack log10(Pack x) noexcept
+        {
+            constexpr double ivln10Hi{4.34294481878168880939e-01};
+            constexpr double ivln10Lo{2.50829467116452752298e-11};
+            constexpr double log10_2Hi{3.01029995663611771306e-01};
+            constexpr double log10_2Lo{3.69423907715893078616e-13};
+
+            Pack k{}, f{}, hfsq{};
+            const Pack r{logParts(x, k, f, hfsq)};
+
+            // log(1 + f) = hi + lo with hi exactly representable in 32 bits.
+            const Pack hi{high(f - hfsq)};
+            const Pack lo{(f - hi) - hfsq + r};
+
+            Pack valHi{hi * set(ivln10Hi)};
+            const Pack y2{k * set(log10_2Hi)};
+            Pack valLo{k * set(log10_2Lo) + (lo + hi) * set(ivln10Lo) + lo * set(ivln10Hi)};
+
+            const Pack w{y2 + valHi};
+            valLo = valLo + ((y2 - w) + valHi);
+            valHi = w;
+
+            return logSpecial(x, valLo + valHi);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // sin, cos and tan
+
+        // Largest |x| reduced in SIMD, 2^20 * pi / 2.
+        constexpr double trigLimit{0x1.921fb54442d18p20};
+
+        // sin(x + y) for |x| <= pi/4, y is a tail of x.
+        Pack sinKernel(Pack x, Pack y) noexcept
+        {
+            constexpr double S1{-1.66666666666666324348e-01};
+            constexpr double S2{8.33333333332248946124e-03};
+            constexpr double S3{-1.98412698298579493134e-04};
+            constexpr double S4{2.75573137070700676789e-06};
+            constexpr double S5{-2.50507602534068634195e-08};
+            constexpr double S6{1.58969099521155010221e-10};
+
+            const Pack z{x * x};
+            const Pack v{z * x};
+            Pack r{Simd::mulAdd(z, set(S6), set(S5))};
+            r = Simd::mulAdd(z, r, set(S4));
+            r = Simd::mulAdd(z, r, set(S3));
+            r = Simd::mulAdd(z, r, set(S2));
+            return x - ((z * (set(0.5) * y - v * r) - y) - v * set(S1));
+        }
+
+        // cos(x + y) for |x| <= pi/4, y is a tail of x.
+        Pack cosKernel(Pack x, Pack y) noexcept
+        {
+            constexpr double C1{4.16666666666666019037e-02};
+            constexpr double C2{-1.38888888888741095749e-03};
+            constexpr double C3{2.48015872894767294178e-05};
+            constexpr double C4{-2.75573143513906633035e-07};
+            constexpr double C5{2.08757232129817482790e-09};
+            constexpr double C6{-1.13596475577881948265e-11};
+
+            const Pack z{x * x};
+            Pack r{Simd::mulAdd(z, set(C6), set(C5))};
+            r = Simd::mulAdd(z, r, set(C4));
+            r = Simd::mulAdd(z, r, set(C3));
+            r = Simd::mulAdd(z, r, set(C2));
+            r = Simd::mulAdd(z, r, set(C1));
+            r = z * r;
+
+            // cos = (1 - qx) - ((z/2 - qx) - (z*r - x*y)) where qx is chosen to
+            // keep 1 - qx exact, see fdlibm k_cos.c.
+            const Pack ax{Simd::abs(x)};
+            Pack qx{Simd::select(Simd::greater(ax, set(0.78125)), set(0.28125),
+                                 high(ax * set(0.25)))};
+            qx = Simd::select(Simd::less(ax, set(0.3)), set(0.0), qx);
+
+            const Pack hz{set(0.5) * z - qx};
+            const Pack a{set(1.0) - qx};
+            return a - (hz - (z * r - x * y));
+        }
+
+        // tan(x + y) for |x| <= pi/4, or -1 / tan(x + y) in the lanes set in odd.
+        Pack tanKernel(Pack x, Pack y, Simd::Mask odd) noexcept
+        {
+            constexpr double T[]{3.33333333333334091986e-01,  1.33333333333201242699e-01,
+                                 5.39682539762260521377e-02,  2.18694882948595424599e-02,
+                                 8.86323982359930005737e-03,  3.59207910759131235356e-03,
+                                 1.45620945432529025516e-03,  5.88041240820264096874e-04,
+                                 2.46463134818469906812e-04,  7.81794442939557092300e-05,
+                                 7.14072491382608190305e-05,  -1.85586374855275456654e-05,
+                                 2.59073051863633712884e-05};
+            constexpr double pio4{7.85398163397448278999e-01};
+            constexpr double pio4Lo{3.06161699786838301793e-17};
+
+            // Near pi/4, tan(x) = tan(pi/4 - (pi/4 - |x|)) is computed instead.
+            const Simd::Mask big{Simd::greater(Simd::abs(x), set(0x1.59428p-1))};
+            const Simd::Mask negative{Simd::less(x, set(0.0))};
+            const Pack xs{Simd::select(negative, -x, x)};
+            const Pack ys{Simd::select(negative, -y, y)};
+            x = Simd::select(big, (set(pio4) - xs) + (set(pio4Lo) - ys), x);
+            y = Simd::select(big, set(0.0), y);
+
+            const Pack z{x * x};
+            const Pack w{z * z};
+            Pack r{Simd::mulAdd(w, set(T[11]), set(T[9]))};
+            r = Simd::mulAdd(w, r, set(T[7]));
+            r = Simd::mulAdd(w, r, set(T[5]));
+            r = Simd::mulAdd(w, r, set(T[3]));
+            r = Simd::mulAdd(w, r, set(T[1]));
+            Pack v{Simd::mulAdd(w, set(T[12]), set(T[10]))};
+            v = Simd::mulAdd(w, v, set(T[8]));
+            v = Simd::mulAdd(w, v, set(T[6]));
+            v = Simd::mulAdd(w, v, set(T[4]));
+            v = Simd::mulAdd(w, v, set(T[2]));
+            v = z * v;
+
+            const Pack s{z * x};
+            r = y + z * (s * (r + v) + y);
+            r = r + set(T[0]) * s;
+            const Pack sum{x + r};
+
+            // Near pi/4: (1 - 2 * (x - (w^2 / (w + v) - r))) with v = 1 or -1.
+            const Pack iy{Simd::select(odd, set(-1.0), set(1.0))};
+            Pack near{iy - set(2.0) * (x - (sum * sum / (sum + iy) - r))};
+            near = Simd::select(negative, -near, near);
+
+            // -1 / (x + r) with the low parts carried separately.
+            const Pack zh{high(sum)};
+            const Pack vl{r - (zh - x)};
+            const Pack a{set(-1.0) / sum};
+            const Pack t{high(a)};
+            const Pack inverse{t + a * (set(1.0) + t * zh + t * vl)};
+
+            return Simd::select(big, near, Simd::select(odd, inverse, sum));
+        }
+
+        // Reduces x to y0 + y1 = x - n * pi/2, |y0 + y1| <= pi/4, and returns
+        // n mod 4. Good to 118 bits for |x| <= trigLimit.
+        Pack reduce(Pack x, Pack& y0, Pack& y1) noexcept
+        {
+            constexpr double pio2_1{1.57079632673412561417e+00};
+            constexpr double pio2_2{6.07710050630396597660e-11};
+            constexpr double pio2_2t{2.02226624879595063154e-21};
+            constexpr double pio2_3{2.02226624871116645580e-21};
+            constexpr double pio2_3t{8.47842766036889956997e-32};
+
+            const Pack n{Simd::round(x * set(6.36619772367581382433e-01))};
+
+            Pack r{x - n * set(pio2_1)};
+            Pack t{r};
+            Pack w{n * set(pio2_2)};
+            r = t - w;
+            w = n * set(pio2_2t) - ((t - r) - w);
+
+            t = r;
+            w = n * set(pio2_3);
+            r = t - w;
+            w = n * set(pio2_3t) - ((t - r) - w);
+
+            y0 = r - w;
+            y1 = (r - y0) - w;
+
+            // n mod 4 without integer instructions, n is an integer below 2^21.
+            return n - set(4.0) * Simd::round(n * set(0.25) - set(0.375));
+        }
+
+        Pack sin(Pack x) noexcept
+        {
+            if (!Simd::all(Simd::lessEqual(Simd::abs(x), set(trigLimit))))
+                return perLane(x, [](double v) { return std::sin(v); });
+
+            Pack y0{}, y1{};
+            const Pack q{reduce(x, y0, y1)};
+            const Pack s{sinKernel(y0, y1)};
+            const Pack c{cosKernel(y0, y1)};
+
+            // Quadrant 0: sin, 1: cos, 2: -sin, 3: -cos.
+            const Simd::Mask odd{Simd::equal(q, set(1.0)) | Simd::equal(q, set(3.0))};
+            const Pack result{Simd::select(odd, c, s)};
+            return Simd::select(Simd::greater(q, set(1.5)), -result, result);
+        }
+
+        Pack cos(Pack x) noexcept
+        {
+            if (!Simd::all(Simd::lessEqual(Simd::abs(x), set(trigLimit))))
+                return perLane(x, [](double v) { return std::cos(v); });
+
+            Pack y0{}, y1{};
+            const Pack q{reduce(x, y0, y1)};
+            const Pack s{sinKernel(y0, y1)};
+            const Pack c{cosKernel(y0, y1)};
+
+            // Quadrant 0: cos, 1: -sin, 2: -cos, 3: sin.
+            const Simd::Mask odd{Simd::equal(q, set(1.0)) | Simd::equal(q, set(3.0))};
+            const Pack result{Simd::select(odd, s, c)};
+            const Simd::Mask negate{Simd::equal(q, set(1.0)) | Simd::equal(q, set(2.0))};
+            return Simd::select(negate, -result, result);
+        }
+
+        Pack tan(Pack x) noexcept
+        {
+            if (!Simd::all(Simd::lessEqual(Simd::abs(x), set(trigLimit))))
+                return perLane(x, [](double v) { return std::tan(v); });
+
+            Pack y0{}, y1{};
+            const Pack q{reduce(x, y0, y1)};
+            const Simd::Mask odd{Simd::equal(q, set(1.0)) | Simd::equal(q, set(3.0))};
+            return tanKernel(y0, y1, odd);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // arcsin, arccos and arctan
+
+        constexpr double pio2Hi{1.57079632679489655800e+00};
+        constexpr double pio2Lo{6.12323399573676603587e-17};
+        constexpr double pio4Hi{7.85398163397448278999e-01};
+
+        // Rational approximation of (asin(x) - x) / x^3 in t = x^2.
+        Pack asinRational(Pack t) noexcept
+        {
+            constexpr double pS0{1.66666666666666657415e-01};
+            constexpr double pS1{-3.25565818622400915405e-01};
+            constexpr double pS2{2.01212532134862925881e-01};
+            constexpr double pS3{-4.00555345006794114027e-02};
+            constexpr double pS4{7.91534994289814532176e-04};
+            constexpr double pS5{3.47933107596021167570e-05};
+            constexpr double qS1{-2.40339491173441421878e+00};
+            constexpr double qS2{2.02094576023350569471e+00};
+            constexpr double qS3{-6.88283971605453293030e-01};
+            constexpr double qS4{7.70381505559019352791e-02};
+
+            Pack p{Simd::mulAdd(t, set(pS5), set(pS4))};
+            p = Simd::mulAdd(t, p, set(pS3));
+            p = Simd::mulAdd(t, p, set(pS2));
+            p = Simd::mulAdd(t, p, set(pS1));
+            p = Simd::mulAdd(t, p, set(pS0));
+            p = t * p;
+
+            Pack q{Simd::mulAdd(t, set(qS4), set(qS3))};
+            q = Simd::mulAdd(t, q, set(qS2));
+            q = Simd::mulAdd(t, q, set(qS1));
+            q = Simd::mulAdd(t, q, set(1.0));
+
+            return p / q;
+        }
+
+        Pack asin(Pack x) noexcept
+        {
+            const Pack ax{Simd::abs(x)};
+            const Simd::Mask small{Simd::less(ax, set(0.5))};
+
+            // |x| < 0.5: asin(x) = x + x * R(x^2).
+            // |x| >= 0.5: asin(x) = pi/2 - 2 * asin(sqrt((1 - |x|) / 2)).
+            const Pack t{Simd::select(small, x * x, (set(1.0) - ax) * set(0.5))};
+            const Pack R{asinRational(t)};
+            const Pack s{Simd::sqrt(t)};
+
+            const Pack nearOne{set(pio2Hi) - (set(2.0) * (s + s * R) - set(pio2Lo))};
+
+            const Pack w{high(s)};
+            const Pack c{(t - w * w) / (s + w)};
+            const Pack p{set(2.0) * s * R - (set(pio2Lo) - set(2.0) * c)};
+            const Pack q{set(pio4Hi) - set(2.0) * w};
+            const Pack middle{set(pio4Hi) - (p - q)};
+
+            Pack result{Simd::select(Simd::less(ax, set(0.975)), middle, nearOne)};
+            result = Simd::select(Simd::less(x, set(0.0)), -result, result);
+            return Simd::select(small, x + x * R, result);
+        }
+
+        Pack acos(Pack x) noexcept
+        {
+            constexpr double pi{3.14159265358979311600e+00};
+
+            const Pack ax{Simd::abs(x)};
+            const Simd::Mask small{Simd::less(ax, set(0.5))};
+
+            // |x| < 0.5: acos(x) = pi/2 - asin(x).
+            // |x| >= 0.5: acos(x) = 2 * asin(sqrt((1 - x) / 2)) mirrored for x < 0.
+            const Pack t{Simd::select(small, x * x, (set(1.0) - ax) * set(0.5))};
+            const Pack R{asinRational(t)};
+            const Pack s{Simd::sqrt(t)};
+
+            const Pack center{set(pio2Hi) - (x - (set(pio2Lo) - x * R))};
+            const Pack negative{set(pi) - set(2.0) * (s + (R * s - set(pio2Lo)))};
+
+            const Pack df{high(s)};
+            const Pack c{(t - df * df) / (s + df)};
+            const Pack positive{set(2.0) * (df + (R * s + c))};
+
+            Pack result{Simd::select(Simd::less(x, set(0.0)), negative, positive)};
+            result = Simd::select(Simd::equal(x, set(1.0)), set(0.0), result);
+            return Simd::select(small, center, result);
+        }
+
+        Pack atan(Pack x) noexcept
+        {
+            constexpr double aT0{3.33333333333329318027e-01};
+            constexpr double aT1{-1.99999999998764832476e-01};
+            constexpr double aT2{1.42857142725034663711e-01};
+            constexpr double aT3{-1.11111104054623557880e-01};
+            constexpr double aT4{9.09088713343650656196e-02};
+            constexpr double aT5{-7.69187620504482999495e-02};
+            constexpr double aT6{6.66107313738753120669e-02};
+            constexpr double aT7{-5.83357013379057348645e-02};
+            constexpr double aT8{4.97687799461593236017e-02};
+            constexpr double aT9{-3.65315727442169155270e-02};
+            constexpr double aT10{1.62858201153657823623e-02};
+
+            const Pack ax{Simd::abs(x)};
+
+            // Reduce |x| with atan(x) = atan(c) + atan((x - c) / (1 + x * c))
+            // for c in {0, 0.5, 1, 1.5, inf}. NaN ends up in the last range.
+            Pack num{set(-1.0)}, den{ax};
+            Pack hi{set(pio2Hi)}, lo{set(6.12323399573676603587e-17)};
+
+            Simd::Mask m{Simd::less(ax, set(2.4375))};
+            num = Simd::select(m, ax - set(1.5), num);
+            den = Simd::select(m, set(1.0) + set(1.5) * ax, den);
+            hi = Simd::select(m, set(9.82793723247329054082e-01), hi);
+            lo = Simd::select(m, set(1.39033110312309984516e-17), lo);
+
+            m = Simd::less(ax, set(1.1875));
+            num = Simd::select(m, ax - set(1.0), num);
+            den = Simd::select(m, ax + set(1.0), den);
+            hi = Simd::select(m, set(7.85398163397448278999e-01), hi);
+            lo = Simd::select(m, set(3.06161699786838301793e-17), lo);
+
+            m = Simd::less(ax, set(0.6875));
+            num = Simd::select(m, set(2.0) * ax - set(1.0), num);
+            den = Simd::select(m, set(2.0) + ax, den);
+            hi = Simd::select(m, set(4.63647609000806093515e-01), hi);
+            lo = Simd::select(m, set(2.26987774529616870924e-17), lo);
+
+            m = Simd::less(ax, set(0.4375));
+            num = Simd::select(m, ax, num);
+            den = Simd::select(m, set(1.0), den);
+            hi = Simd::select(m, set(0.0), hi);
+            lo = Simd::select(m, set(0.0), lo);
+
+            const Pack r{num / den};
+            const Pack z{r * r};
+            const Pack w{z * z};
+
+            Pack s1{Simd::mulAdd(w, set(aT10), set(aT8))};
+            s1 = Simd::mulAdd(w, s1, set(aT6));
+            s1 = Simd::mulAdd(w, s1, set(aT4));
+            s1 = Simd::mulAdd(w, s1, set(aT2));
+            s1 = Simd::mulAdd(w, s1, set(aT0));
+            s1 = z * s1;
+
+            Pack s2{Simd::mulAdd(w, set(aT9), set(aT7))};
+            s2 = Simd::mulAdd(w, s2, set(aT5));
+            s2 = Simd::mulAdd(w, s2, set(aT3));
+            s2 = Simd::mulAdd(w, s2, set(aT1));
+            s2 = w * s2;
+
+            const Pack result{hi - ((r * (s1 + s2) - lo) - r)};
+            return Simd::select(Simd::less(x, set(0.0)), -result, result);
+        }
+
+    } // namespace
+
+    void log(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::log(x); });
+        else
+            apply(values, results, [](Pack x) { return log(x); });
+    }
+
+    void log10(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::log10(x); });
+        else
+            apply(values, results, [](Pack x) { return log10(x); });
+    }
+
+    void exp(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::exp(x); });
+        else
+            apply(values, results, [](Pack x) { return exp(x); });
+    }
+
+    void sin(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::sin(x); });
+        else
+            apply(values, results, [](Pack x) { return sin(x); });
+    }
+
+    void cos(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::cos(x); });
+        else
+            apply(values, results, [](Pack x) { return cos(x); });
+    }
+
+    void tan(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::tan(x); });
+        else
+            apply(values, results, [](Pack x) { return tan(x); });
+    }
+
+    void asin(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::asin(x); });
+        else
+            apply(values, results, [](Pack x) { return asin(x); });
+    }
+
+    void acos(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::acos(x); });
+        else
+            apply(values, results, [](Pack x) { return acos(x); });
+    }
+
+    void atan(Span<const double> values, Span<double> results, Accuracy accuracy) noexcept
+    {
+        if (accuracy == Accuracy::Exact)
+            exact(values, results, [](double x) { return std::atan(x); });
+        else
+            apply(values, results, [](Pack x) { return atan(x); });
+    }
+
+} // namespace CalcEval::Kernel
@@ -0,0 +1,103 @@
+//
+//  NameTable.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/NameTable.hpp"
+#include "calceval/Hash.hpp"
+
+// C++ Headers
+#include <stdexcept>
+
+namespace CalcEval
+{
+    std::pair<NameTable::index_type, bool> NameTable::insert(std::string_view name)
+    {
+        if (auto index = find(name))
+            return {*index, false};
+
+        if (m_names.size() >= emptySlot - 1 || m_arena.size() + name.size() > 0xffffffff)
+            throw std::length_error("NameTable is full");
+
+        // Keep the table at most half full.
+        if ((m_names.size() + 1) * 2 > m_slots.size())
+            rehash((m_slots.empty()) ? 16 : m_slots.size() * 2);
+
+        const auto index{static_cast<index_type>(m_names.size())};
+        m_names.push_back(
+            {static_cast<std::uint32_t>(m_arena.size()), static_cast<std::uint32_t>(name.size())});
+        m_arena.append(name);
+
+        const std::uint64_t h{hash(name)};
+        const std::size_t mask{m_slots.size() - 1};
+        std::size_t i{static_cast<std::size_t>(h) & mask};
+        while (m_slots[i].index != emptySlot)
+            i = (i + 1) & mask;
+
+        m_slots[i] = Slot{h, index};
+        return {index, true};
+    }
+
+    std::optional<NameTable::index_type> NameTable::find(std::string_view name) const noexcept
+    {
+        if (m_slots.empty())
+            return std::nullopt;
+
+        const std::uint64_t h{hash(name)};
+        const std::size_t mask{m_slots.size() - 1};
+        for (std::size_t i{static_cast<std::size_t>(h) & mask}; m_slots[i].index != emptySlot;
+             i = (i + 1) & mask)
+        {
+            if (m_slots[i].hash == h && this->name(m_slots[i].index) == name)
+                return m_slots[i].index;
+        }
+
+        return std::nullopt;
+    }
+
+    std::string_view NameTable::name(index_type index) const noexcept
+    {
+        const Name& n{m_names[index]};
+        return std::string_view{m_arena}.substr(n.offset, n.length);
+    }
+
+    std::size_t NameTable::size() const noexcept
+    {
+        return m_names.size();
+    }
+
+    void NameTable::reserve(std::size_t count)
+    {
+        m_names.reserve(count);
+
+        std::size_t slotCount{16};
+        while (slotCount < count * 2)
+            slotCount *= 2;
+
+        if (slotCount > m_slots.size())
+            rehash(slotCount);
+    }
+
+    void NameTable::rehash(std::size_t slotCount)
+    {
+        std::vector<Slot> slots(slotCount, Slot{0, emptySlot});
+        const std::size_t mask{slotCount - 1};
+
+        for (const Slot& slot : m_slots)
+        {
+            if (slot.index == emptySlot)
+                continue;
+
+            std::size_t i{static_cast<std::size_t>(slot.hash) & mask};
+            while (slots[i].index != emptySlot)
+                i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+
+        m_slots = std::move(slots);
+    }
+
+} // namespace CalcEval
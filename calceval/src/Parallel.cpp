@@ -0,0 +1,47 @@
+//
+//  Parallel.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parallel.hpp"
+
+// C++ Headers
+#include <stdexcept>
+
+namespace CalcEval
+{
+    void parallelEvaluate(ThreadPool& pool, const Expression& expression,
+                          Span<const Span<const double>> columns, Span<double> results,
+                          Kernel::Accuracy accuracy)
+    {
+        const std::size_t rows{results.size()};
+        if (columns.size() != expression.variableCount())
+            throw std::invalid_argument("parallelEvaluate: expected " +
+                                        std::to_string(expression.variableCount()) +
+                                        " column(s), got " + std::to_string(columns.size()));
+        for (const Span<const double>& column : columns)
+            if (column.size() != rows)
+                throw std::invalid_argument("parallelEvaluate: column with " +
+                                            std::to_string(column.size()) +
+                                            " value(s), expected " + std::to_string(rows));
+
+        // About eight chunks per worker, for balance when the cost of the
+        // rows differs (pow and functions depend on the values).
+        const std::size_t block{expression.blockSize()};
+        const std::size_t blocks{(rows + block - 1) / block};
+        const std::size_t grain{block * std::max<std::size_t>(blocks / (pool.size() * 8), 1)};
+
+        pool.parallelFor(rows, grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+            std::vector<Span<const double>> chunk{};
+            chunk.reserve(columns.size());
+            for (const Span<const double>& column : columns)
+                chunk.push_back(column.subspan(begin, end - begin));
+
+            expression.evaluateBatch(chunk, results.subspan(begin, end - begin), accuracy);
+        });
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,263 @@
+//
+//  ParallelExpression.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/ParallelExpression.hpp"
+#include "calceval/Reduce.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace CalcEval
+{
+    namespace
+    {
+        // Nesting of split operators is limited, deeper subtrees run on one
+        // thread. Also keeps the recursion of build and evaluate bounded.
+        constexpr std::size_t maxDepth{64};
+
+        // Rough cost of an instruction relative to an addition.
+        std::uint64_t weight(const Instruction& instruction) noexcept
+        {
+            switch (instruction.op)
+            {
+                case OpCode::Divide:
+                    return 4;
+                case OpCode::Power:
+                case OpCode::Function:
+                    return 20;
+                case OpCode::Variadic:
+                    return 8;
+                case OpCode::Reduce:
+                    // Unknown number of terms, at least one chunk of its own.
+                    return ParallelExpression::defaultThreshold;
+                default:
+                    return 1;
+            }
+        }
+
+        bool additive(OpCode op) noexcept
+        {
+            return op == OpCode::Add || op == OpCode::Subtract;
+        }
+
+        bool multiplicative(OpCode op) noexcept
+        {
+            return op == OpCode::Multiply || op == OpCode::Divide;
+        }
+
+        // Subtrees that are run as one piece of code: values, and if(c, a, b)
+        // since only the taken branch is evaluated.
+        bool leaf(OpCode op) noexcept
+        {
+            return op == OpCode::Constant || op == OpCode::Variable || op == OpCode::Then ||
+                   op == OpCode::Else || op == OpCode::Select;
+        }
+
+    } // namespace
+
+    ParallelExpression::ParallelExpression(Expression expression, std::uint64_t threshold)
+        : m_expression{std::move(expression)}, m_threshold{threshold}
+    {
+        if (!m_expression.complete())
+            throw std::invalid_argument("ParallelExpression: code is not a complete expression");
+        if (m_threshold == 0)
+            throw std::invalid_argument("ParallelExpression: threshold must be at least 1");
+
+        const std::vector<Instruction>& code{m_expression.code()};
+        if (code.size() >= noNode)
+            throw std::invalid_argument("ParallelExpression: expression is too large");
+
+        // start[k] is the first instruction of the subtree that ends with
+        // code[k] and cost[k] the cost of code[0, k).
+        std::vector<std::uint32_t> start(code.size());
+        std::vector<std::uint64_t> cost(code.size() + 1, 0);
+        std::vector<std::uint32_t> starts{};
+        for (std::size_t k{0}; k < code.size(); ++k)
+        {
+            const Instruction& instruction{code[k]};
+            std::size_t pops{0};
+            if (instruction.op == OpCode::Negate || instruction.op == OpCode::Function ||
+                instruction.op == OpCode::Then || instruction.op == OpCode::Else)
+                pops = 1;
+            else if (instruction.op == OpCode::Select)
+                pops = 3;
+            else if (instruction.op == OpCode::Variadic)
+                pops = m_expression.variadics()[instruction.index].count;
+            else if (instruction.op == OpCode::Reduce)
+                pops = m_expression.reductions()[instruction.index].count;
+            else if (instruction.op != OpCode::Constant && instruction.op != OpCode::Variable)
+                pops = 2;
+
+            start[k] = (pops > 0) ? starts[starts.size() - pops] : static_cast<std::uint32_t>(k);
+            starts.resize(starts.size() - pops);
+            starts.push_back(start[k]);
+            cost[k + 1] = cost[k] + weight(instruction);
+        }
+
+        if (cost.back() >= m_threshold && !leaf(code.back().op))
+            m_root = build(code.size() - 1, 0, start, cost);
+    }
+
+    std::uint32_t ParallelExpression::build(std::size_t root, std::size_t depth,
+                                            const std::vector<std::uint32_t>& start,
+                                            const std::vector<std::uint64_t>& cost)
+    {
+        const std::vector<Instruction>& code{m_expression.code()};
+        const OpCode op{code[root].op};
+        Node node{root, {}, 1};
+
+        // The subtree that ends just before code[end].
+        const auto operand = [&start](std::size_t end, OpCode combine) {
+            return Operand{start[end - 1], static_cast<std::uint32_t>(end), noNode, combine};
+        };
+
+        if (additive(op) || multiplicative(op))
+        {
+            // Right operands from the last, down the left side of the chain.
+            const auto same = (additive(op)) ? additive : multiplicative;
+            std::size_t k{root};
+            while (same(code[k].op))
+            {
+                node.operands.push_back(operand(k, code[k].op));
+                k = node.operands.back().begin - 1;
+            }
+            node.operands.push_back(operand(k + 1, additive(op) ? OpCode::Add : OpCode::Multiply));
+            std::reverse(node.operands.begin(), node.operands.end());
+        }
+        else
+        {
+            std::size_t count{1};
+            if (op == OpCode::Power)
+                count = 2;
+            else if (op == OpCode::Variadic)
+                count = m_expression.variadics()[code[root].index].count;
+            else if (op == OpCode::Reduce)
+                count = m_expression.reductions()[code[root].index].count;
+
+            std::size_t end{root};
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                node.operands.push_back(operand(end, op));
+                end = node.operands.back().begin;
+            }
+            std::reverse(node.operands.begin(), node.operands.end());
+        }
+
+        std::uint64_t total{0};
+        for (Operand& o : node.operands)
+        {
+            const std::uint64_t c{cost[o.end] - cost[o.begin]};
+            total += c;
+            if (c >= m_threshold && depth + 1 < maxDepth && !leaf(code[o.end - 1].op))
+                o.node = build(o.end - 1, depth + 1, start, cost);
+        }
+
+        // Chunks of operands of about threshold cost.
+        const std::size_t n{node.operands.size()};
+        node.grain = static_cast<std::size_t>(
+            std::clamp<std::uint64_t>(m_threshold * n / std::max<std::uint64_t>(total, 1), 1, n));
+
+        m_nodes.push_back(std::move(node));
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    double ParallelExpression::evaluate(ThreadPool& pool, Span<const double> variables,
+                                        Association association) const
+    {
+        if (variables.size() != m_expression.variableCount())
+            throw std::invalid_argument("ParallelExpression: expected " +
+                                        std::to_string(m_expression.variableCount()) +
+                                        " variable(s), got " + std::to_string(variables.size()));
+
+        if (m_root == noNode)
+            return m_expression.evaluate(variables);
+
+        return evaluate(pool, m_nodes[m_root], variables.data(), association);
+    }
+
+    double ParallelExpression::evaluate(ThreadPool& pool, const Node& node,
+                                        const double* variables, Association association) const
+    {
+        const std::size_t n{node.operands.size()};
+        std::vector<double> values(n);
+        const auto run = [&](std::size_t begin, std::size_t end, std::size_t) {
+            std::vector<double> stack(m_expression.stackSize());
+            for (std::size_t i{begin}; i < end; ++i)
+            {
+                const Operand& o{node.operands[i]};
+                values[i] = (o.node != noNode)
+                                ? evaluate(pool, m_nodes[o.node], variables, association)
+                                : m_expression.run(o.begin, o.end, stack.data(), variables);
+            }
+        };
+
+        if (n == 1)
+            run(0, 1, 0);
+        else
+            pool.parallelFor(n, node.grain, run);
+
+        const Instruction& instruction{m_expression.code()[node.root]};
+        switch (instruction.op)
+        {
+            case OpCode::Add:
+            case OpCode::Subtract:
+            {
+                if (association == Association::Pairwise)
+                {
+                    // a - b is exactly a + -b.
+                    for (std::size_t i{1}; i < n; ++i)
+                        if (node.operands[i].op == OpCode::Subtract)
+                            values[i] = -values[i];
+                    return Reduce::pairwiseSum(values);
+                }
+
+                double result{values[0]};
+                for (std::size_t i{1}; i < n; ++i)
+                    result = (node.operands[i].op == OpCode::Add) ? result + values[i]
+                                                                  : result - values[i];
+                return result;
+            }
+            case OpCode::Multiply:
+            case OpCode::Divide:
+            {
+                double result{values[0]};
+                for (std::size_t i{1}; i < n; ++i)
+                    result = (node.operands[i].op == OpCode::Multiply) ? result * values[i]
+                                                                       : result / values[i];
+                return result;
+            }
+            case OpCode::Power:
+                return std::pow(values[0], values[1]);
+            case OpCode::Negate:
+                return values[0] * -1.0;
+            case OpCode::Function:
+                return m_expression.functions()[instruction.index].function(values[0]);
+            case OpCode::Variadic:
+                return m_expression.variadics()[instruction.index].function(values);
+            case OpCode::Reduce:
+                return m_expression.reductions()[instruction.index].evaluate(
+                    values, Span<const double>{variables, m_expression.variableCount()});
+            default:
+                return values[0];
+        }
+    }
+
+    const Expression& ParallelExpression::expression() const noexcept
+    {
+        return m_expression;
+    }
+
+    std::size_t ParallelExpression::splitCount() const noexcept
+    {
+        return m_nodes.size();
+    }
+
+} // namespace CalcEval
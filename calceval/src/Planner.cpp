@@ -0,0 +1,414 @@
+//
+//  Planner.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Planner.hpp"
+#include "calceval/Compiler.hpp"
+#include "calceval/Parallel.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Scanner.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace CalcEval
+{
+    namespace
+    {
+        constexpr double infinity{std::numeric_limits<double>::infinity()};
+
+        // Names of the costs in toString, in the order of Planner::Costs.
+        constexpr std::array<const char*, 8> names{
+            "parseToken", "compileToken",  "instruction", "batchInstruction",
+            "function",   "batchFunction", "call",        "threadStart"};
+
+        std::array<double*, 8> fields(Planner::Costs& costs) noexcept
+        {
+            return {&costs.parseToken, &costs.compileToken,  &costs.instruction,
+                    &costs.batchInstruction, &costs.function, &costs.batchFunction,
+                    &costs.call, &costs.threadStart};
+        }
+
+        std::size_t cores() noexcept
+        {
+            return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        // Fastest of a few runs of body, in nanoseconds. The fastest run is
+        // the one least disturbed by other work on the host.
+        template<typename Body>
+        double fastest(Body body)
+        {
+            double best{infinity};
+            for (int run{0}; run < 5; ++run)
+            {
+                const auto start{std::chrono::steady_clock::now()};
+                body();
+                const std::chrono::duration<double, std::nano> time{
+                    std::chrono::steady_clock::now() - start};
+                best = std::min(best, time.count());
+            }
+            return best;
+        }
+
+        std::string duration(double ns)
+        {
+            if (std::isinf(ns))
+                return "-";
+
+            std::ostringstream oss{};
+            oss << std::setprecision(3);
+            if (ns < 1e3)
+                oss << ns << " ns";
+            else if (ns < 1e6)
+                oss << ns / 1e3 << " us";
+            else if (ns < 1e9)
+                oss << ns / 1e6 << " ms";
+            else
+                oss << ns / 1e9 << " s";
+            return oss.str();
+        }
+
+        std::string count(std::size_t n, const char* what)
+        {
+            return std::to_string(n) + " " + what + ((n == 1) ? "" : "s");
+        }
+
+    } // namespace
+
+    Workload Workload::scan(const std::string& str)
+    {
+        std::istringstream iss{str};
+        Scanner scanner{iss};
+        Workload workload{};
+        bool name{false};
+        for (Token token{scanner.scan()};
+             token.type != TokenType::EndMark && token.type != TokenType::EndOfLine;
+             token = scanner.scan())
+        {
+            ++workload.tokens;
+            if (name && token.type == TokenType::LeftParen)
+                ++workload.functions;
+            name = (token.type == TokenType::Identifier);
+        }
+        return workload;
+    }
+
+    std::string Plan::explain() const
+    {
+        std::ostringstream oss{};
+        oss << engineStr(engine) << " on " << count(threads, "thread") << ": "
+            << count(workload.tokens, "token") << ", " << count(workload.functions, "function")
+            << ", " << count(workload.variables, "variable") << ", "
+            << count(workload.rows, "row") << ", " << count(workload.calls, "call") << '\n';
+
+        for (std::size_t i{0}; i < costs.size(); ++i)
+        {
+            const auto other{static_cast<Engine>(i)};
+            oss << ((i == 0) ? "" : ", ") << engineStr(other);
+            if (other == Engine::Parallel && !std::isinf(costs[i]))
+                oss << " (" << count(parallelThreads, "thread") << ")";
+            oss << ' ' << duration(costs[i]);
+        }
+        return oss.str();
+    }
+
+    Planner::Planner() : Planner{defaultCosts}
+    {
+    }
+
+    Planner::Planner(const Costs& costs, std::size_t threads)
+        : m_costs{costs}, m_threads{(threads == 0) ? cores() : threads}
+    {
+        for (const double* cost : fields(m_costs))
+            if (!std::isfinite(*cost) || *cost < 0.0)
+                throw std::invalid_argument("Planner: costs must be finite and not negative");
+    }
+
+    Planner Planner::calibrate(std::size_t threads)
+    {
+        if (threads == 0)
+            threads = cores();
+
+        // The same arithmetic with and without variables, and a function.
+        const std::string arithmetic{"x*1.25 + y/3 - (x - y)*0.5"};
+        const std::string constant{"1.5*1.25 + 0.5/3 - (1.5 - 0.5)*0.5"};
+        const std::string function{"sin(x)"};
+        const auto tokens{static_cast<double>(Workload::scan(arithmetic).tokens)};
+        const auto functionTokens{static_cast<double>(Workload::scan(function).tokens)};
+
+        constexpr std::size_t repeats{64};
+        constexpr std::size_t rows{4096};
+        std::vector<double> x(rows), y(rows), results(rows);
+        for (std::size_t i{0}; i < rows; ++i)
+        {
+            x[i] = 0.001 * static_cast<double>(i);
+            y[i] = 1.0 - 0.0005 * static_cast<double>(i);
+        }
+        const std::vector<Span<const double>> columns{x, y};
+        const std::vector<Span<const double>> single{Span<const double>{x.data(), 1},
+                                                     Span<const double>{y.data(), 1}};
+        double sink{0.0};
+
+        Costs costs{defaultCosts};
+        const Parser<> parser{};
+        costs.parseToken = fastest([&]() {
+                               for (std::size_t i{0}; i < repeats; ++i)
+                                   sink += parser.parse(constant);
+                           }) /
+                           (static_cast<double>(repeats) * tokens);
+
+        const Compiler<> compiler{};
+        costs.compileToken = fastest([&]() {
+                                 for (std::size_t i{0}; i < repeats; ++i)
+                                     sink += static_cast<double>(
+                                         compiler.compile(arithmetic, {"x", "y"}).stackSize());
+                             }) /
+                             (static_cast<double>(repeats) * tokens);
+
+        const Expression expression{compiler.compile(arithmetic, {"x", "y"})};
+        const Expression sine{compiler.compile(function, {"x"})};
+        const auto perRow = [&](const Expression& e, Span<const Span<const double>> values) {
+            return fastest([&]() {
+                       std::vector<double> row(values.size());
+                       for (std::size_t i{0}; i < rows; ++i)
+                       {
+                           for (std::size_t j{0}; j < values.size(); ++j)
+                               row[j] = values[j][i];
+                           sink += e.evaluate(row);
+                       }
+                   }) /
+                   static_cast<double>(rows);
+        };
+        const auto perBatch = [&](const Expression& e, Span<const Span<const double>> values) {
+            return fastest([&]() {
+                e.evaluateBatch(values, results);
+                sink += results.back();
+            });
+        };
+
+        costs.instruction = perRow(expression, columns) / tokens;
+        costs.function =
+            std::max(perRow(sine, Span<const Span<const double>>{columns.data(), 1}) -
+                         functionTokens * costs.instruction,
+                     0.0);
+
+        costs.call = fastest([&]() {
+            expression.evaluateBatch(single, Span<double>{results.data(), 1});
+            sink += results[0];
+        });
+        costs.batchInstruction =
+            std::max(perBatch(expression, columns) - costs.call, 0.0) /
+            (static_cast<double>(rows) * tokens);
+        costs.batchFunction =
+            std::max(perBatch(sine, Span<const Span<const double>>{columns.data(), 1}) -
+                         costs.call,
+                     0.0) /
+                static_cast<double>(rows) -
+            functionTokens * costs.batchInstruction;
+        costs.batchFunction = std::max(costs.batchFunction, 0.0);
+
+        // A pool is started and stopped for every call of evaluate.
+        if (threads > 1)
+            costs.threadStart = fastest([&]() {
+                                    ThreadPool pool{threads};
+                                    pool.parallelFor(threads, 1,
+                                                     [](std::size_t, std::size_t, std::size_t) {});
+                                }) /
+                                static_cast<double>(threads);
+
+        // Keeps the evaluations from being optimized away.
+        volatile double keep{sink};
+        static_cast<void>(keep);
+
+        return Planner{costs, threads};
+    }
+
+    Planner Planner::fromString(const std::string& str)
+    {
+        Costs costs{};
+        std::array<bool, names.size()> found{};
+        std::size_t threads{0};
+
+        std::istringstream iss{str};
+        std::string pair{};
+        while (iss >> pair)
+        {
+            const std::size_t equal{pair.find('=')};
+            const std::string name{pair.substr(0, equal)};
+            const std::string value{(equal == std::string::npos) ? "" : pair.substr(equal + 1)};
+
+            std::size_t end{0};
+            double number{0.0};
+            try
+            {
+                number = std::stod(value, &end);
+            }
+            catch (const std::exception&)
+            {
+                end = 0;
+            }
+            if (end == 0 || end != value.size())
+                throw std::invalid_argument("Planner: \"" + pair + "\" is not name=value");
+
+            if (name == "threads")
+            {
+                if (number < 1.0 || number != std::floor(number))
+                    throw std::invalid_argument("Planner: threads must be a positive integer");
+                threads = static_cast<std::size_t>(number);
+                continue;
+            }
+
+            const auto it{std::find_if(names.begin(), names.end(),
+                                       [&name](const char* n) { return name == n; })};
+            if (it == names.end())
+                throw std::invalid_argument("Planner: unknown cost \"" + name + "\"");
+            const auto index{static_cast<std::size_t>(it - names.begin())};
+            *fields(costs)[index] = number;
+            found[index] = true;
+        }
+
+        for (std::size_t i{0}; i < names.size(); ++i)
+            if (!found[i])
+                throw std::invalid_argument(std::string{"Planner: missing cost \""} + names[i] +
+                                            "\"");
+        if (threads == 0)
+            throw std::invalid_argument("Planner: missing threads");
+
+        return Planner{costs, threads};
+    }
+
+    Plan Planner::plan(const Workload& workload) const
+    {
+        if (workload.variables > 0 && !workload.compilable)
+            throw std::invalid_argument("Planner: variables need a type that can be compiled");
+
+        // Without variables every row has the same value.
+        const auto n{static_cast<double>(workload.tokens)};
+        const auto f{static_cast<double>(workload.functions)};
+        const std::size_t rows{(workload.variables > 0) ? workload.rows : 1};
+        const auto r{static_cast<double>(rows)};
+        const auto c{static_cast<double>(workload.calls)};
+        const Costs& k{m_costs};
+
+        Plan plan{};
+        plan.workload = workload;
+        plan.costs.fill(infinity);
+        if (workload.variables == 0)
+            plan.costs[0] = c * (n * k.parseToken + f * k.function);
+
+        if (workload.compilable)
+        {
+            const double compile{n * k.compileToken};
+            const double row{n * k.batchInstruction + f * k.batchFunction};
+            plan.costs[1] = compile + c * r * (n * k.instruction + f * k.function);
+            plan.costs[2] = compile + c * (k.call + r * row);
+
+            // More threads until there are too few rows for each.
+            const std::size_t most{std::min(m_threads, rows / minimumRows)};
+            for (std::size_t t{2}; t <= most; ++t)
+            {
+                const auto threads{static_cast<double>(t)};
+                const double cost{compile +
+                                  c * (k.call + threads * k.threadStart + r * row / threads)};
+                if (cost < plan.costs[3])
+                {
+                    plan.costs[3] = cost;
+                    plan.parallelThreads = t;
+                }
+            }
+        }
+
+        // The first of equal costs, the simplest engine.
+        const auto cheapest{std::min_element(plan.costs.begin(), plan.costs.end())};
+        plan.engine = static_cast<Engine>(cheapest - plan.costs.begin());
+        plan.threads = (plan.engine == Engine::Parallel) ? plan.parallelThreads : 1;
+        return plan;
+    }
+
+    void Planner::evaluate(const Plan& plan, const std::string& str,
+                           const std::vector<std::string>& variables,
+                           Span<const Span<const double>> columns, Span<double> results,
+                           const symbols_type& symbols)
+    {
+        if (columns.size() != variables.size())
+            throw std::invalid_argument("Planner: expected " + std::to_string(variables.size()) +
+                                        " column(s), got " + std::to_string(columns.size()));
+        for (const Span<const double>& column : columns)
+            if (column.size() != results.size())
+                throw std::invalid_argument("Planner: column with " +
+                                            std::to_string(column.size()) +
+                                            " value(s), expected " +
+                                            std::to_string(results.size()));
+
+        if (plan.engine == Engine::Parse)
+        {
+            if (!variables.empty())
+                throw std::invalid_argument("Planner: parse can not evaluate variables");
+            const double value{Parser<>{symbols}.parse(str)};
+            std::fill(results.begin(), results.end(), value);
+            return;
+        }
+
+        const Expression expression{Compiler<>{symbols}.compile(str, variables)};
+        switch (plan.engine)
+        {
+            case Engine::Compiled:
+            {
+                std::vector<double> row(columns.size());
+                for (std::size_t i{0}; i < results.size(); ++i)
+                {
+                    for (std::size_t j{0}; j < columns.size(); ++j)
+                        row[j] = columns[j][i];
+                    results[i] = expression.evaluate(row);
+                }
+                break;
+            }
+            case Engine::Parallel:
+            {
+                ThreadPool pool{plan.threads};
+                parallelEvaluate(pool, expression, columns, results);
+                break;
+            }
+            default:
+                expression.evaluateBatch(columns, results);
+                break;
+        }
+    }
+
+    std::string Planner::toString() const
+    {
+        std::ostringstream oss{};
+        oss << std::setprecision(std::numeric_limits<double>::max_digits10);
+        Costs costs{m_costs};
+        const std::array<double*, 8> values{fields(costs)};
+        for (std::size_t i{0}; i < names.size(); ++i)
+            oss << names[i] << '=' << *values[i] << ' ';
+        oss << "threads=" << m_threads;
+        return oss.str();
+    }
+
+    const Planner::Costs& Planner::costs() const noexcept
+    {
+        return m_costs;
+    }
+
+    std::size_t Planner::threads() const noexcept
+    {
+        return m_threads;
+    }
+
+} // namespace CalcEval
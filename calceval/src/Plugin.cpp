@@ -0,0 +1,171 @@
+//
+//  Plugin.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Plugin.hpp"
+#include "calceval/Error.hpp"
+
+// C++ Headers
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace CalcEval
+{
+    namespace
+    {
+        void* open(const std::string& path, std::string& error)
+        {
+#if defined(_WIN32)
+            void* handle{reinterpret_cast<void*>(LoadLibraryA(path.c_str()))};
+            if (!handle)
+                error = "error " + std::to_string(GetLastError());
+#else
+            void* handle{dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)};
+            if (!handle)
+                error = dlerror();
+#endif
+            return handle;
+        }
+
+        calceval_plugin_entry_fn entry(void* handle)
+        {
+#if defined(_WIN32)
+            return reinterpret_cast<calceval_plugin_entry_fn>(
+                GetProcAddress(static_cast<HMODULE>(handle), CALCEVAL_PLUGIN_ENTRY));
+#else
+            return reinterpret_cast<calceval_plugin_entry_fn>(dlsym(handle, CALCEVAL_PLUGIN_ENTRY));
+#endif
+        }
+
+        void close(void* handle) noexcept
+        {
+#if defined(_WIN32)
+            FreeLibrary(static_cast<HMODULE>(handle));
+#else
+            dlclose(handle);
+#endif
+        }
+
+    } // namespace
+
+    Plugin::Plugin(std::string path) : m_path{std::move(path)}
+    {
+        std::string error{};
+        m_handle = open(m_path, error);
+        if (!m_handle)
+            throw Error("Plugin: could not load \"" + m_path + "\": " + error);
+
+        // Closed again if the description is not valid.
+        try
+        {
+            const calceval_plugin_entry_fn function{entry(m_handle)};
+            if (!function)
+                throw Error("Plugin: \"" + m_path + "\" does not export " CALCEVAL_PLUGIN_ENTRY);
+
+            m_plugin = function();
+            if (!m_plugin)
+                throw Error("Plugin: \"" + m_path + "\" returned no description");
+            if (m_plugin->abi != CALCEVAL_PLUGIN_ABI)
+                throw Error("Plugin: \"" + m_path + "\" has ABI version " +
+                            std::to_string(m_plugin->abi) + ", expected " +
+                            std::to_string(CALCEVAL_PLUGIN_ABI));
+            if ((m_plugin->function_count > 0 && !m_plugin->functions) ||
+                (m_plugin->constant_count > 0 && !m_plugin->constants))
+                throw Error("Plugin: \"" + m_path + "\" has no list of symbols");
+
+            for (std::size_t i{0}; i < m_plugin->function_count; ++i)
+            {
+                const calceval_function& func{m_plugin->functions[i]};
+                if (!func.name || !func.scalar)
+                    throw Error("Plugin: function " + std::to_string(i) + " of \"" + m_path +
+                                "\" has no name or scalar version");
+            }
+            for (std::size_t i{0}; i < m_plugin->constant_count; ++i)
+                if (!m_plugin->constants[i].name)
+                    throw Error("Plugin: constant " + std::to_string(i) + " of \"" + m_path +
+                                "\" has no name");
+        }
+        catch (...)
+        {
+            unload();
+            throw;
+        }
+    }
+
+    Plugin::Plugin(Plugin&& other) noexcept
+        : m_path{std::move(other.m_path)},
+          m_handle{std::exchange(other.m_handle, nullptr)},
+          m_plugin{std::exchange(other.m_plugin, nullptr)}
+    {
+    }
+
+    Plugin& Plugin::operator=(Plugin&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unload();
+            m_path = std::move(other.m_path);
+            m_handle = std::exchange(other.m_handle, nullptr);
+            m_plugin = std::exchange(other.m_plugin, nullptr);
+        }
+        return *this;
+    }
+
+    Plugin::~Plugin() noexcept
+    {
+        unload();
+    }
+
+    void Plugin::addTo(Registry<double>& registry) const
+    {
+        if (!m_plugin)
+            return;
+
+        registry.reserve(registry.size() + m_plugin->function_count + m_plugin->constant_count);
+        for (std::size_t i{0}; i < m_plugin->function_count; ++i)
+        {
+            const calceval_function& func{m_plugin->functions[i]};
+            registry.addFunction(func.name, func.scalar, func.batch);
+        }
+        for (std::size_t i{0}; i < m_plugin->constant_count; ++i)
+            registry.addConstant(m_plugin->constants[i].name, m_plugin->constants[i].value);
+    }
+
+    std::string Plugin::name() const
+    {
+        return (m_plugin && m_plugin->name) ? std::string{m_plugin->name} : std::string{};
+    }
+
+    const std::string& Plugin::path() const noexcept
+    {
+        return m_path;
+    }
+
+    std::size_t Plugin::functionCount() const noexcept
+    {
+        return (m_plugin) ? m_plugin->function_count : 0;
+    }
+
+    std::size_t Plugin::constantCount() const noexcept
+    {
+        return (m_plugin) ? m_plugin->constant_count : 0;
+    }
+
+    void Plugin::unload() noexcept
+    {
+        if (m_handle)
+            close(m_handle);
+        m_handle = nullptr;
+        m_plugin = nullptr;
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,185 @@
+//
+//  Quadrature.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Quadrature.hpp"
+#include "calceval/Reduce.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace CalcEval::Quadrature
+{
+    namespace
+    {
+        // Nodes of the 15-point Kronrod rule on [-1, 1], the positive half
+        // from the outside in. Odd entries are the nodes of the 7-point
+        // Gauss rule.
+        constexpr std::size_t nodes{15};
+        constexpr double xgk[8]{0.991455371120812639206854697526329,
+                                0.949107912342758524526189684047851,
+                                0.864864423359769072789712788640926,
+                                0.741531185599394439863864773280788,
+                                0.586087235467691130294144845693013,
+                                0.405845151377397166906606412076961,
+                                0.207784955007898467600689403773245,
+                                0.000000000000000000000000000000000};
+        constexpr double wgk[8]{0.022935322010529224963732008058970,
+                                0.063092092629978553290700663189204,
+                                0.104790010322250183839876322541518,
+                                0.140653259715525918745189590510238,
+                                0.169004726639267902826583426598550,
+                                0.190350578064785409913256402421014,
+                                0.204432940075298892414161999234649,
+                                0.209482141084727828012999174891714};
+        constexpr double wg[4]{0.129484966168869693270611432679082,
+                               0.279705391489276667901467771423780,
+                               0.381830050505118944950369775488975,
+                               0.417959183673469387755102040816327};
+
+        // Intervals per call to evaluateBatch.
+        constexpr std::size_t chunk{256};
+
+        struct Interval
+        {
+            double a;
+            double b;
+            double value;
+            double error;
+        };
+
+        // Integrates intervals[work[k]] for k in [begin, end).
+        void integrate(const Expression& body, Span<const double> variables,
+                       std::vector<Interval>& intervals, const std::vector<std::size_t>& work,
+                       std::size_t begin, std::size_t end)
+        {
+            const std::size_t rows{(end - begin) * nodes};
+            std::vector<double> buffer((variables.size() + 2) * rows);
+            std::vector<Span<const double>> columns(variables.size() + 1);
+            for (std::size_t v{0}; v < variables.size(); ++v)
+            {
+                double* column{buffer.data() + v * rows};
+                std::fill(column, column + rows, variables[v]);
+                columns[v] = Span<const double>{column, rows};
+            }
+
+            // Nodes from left to right, node 7 is the center.
+            double* x{buffer.data() + variables.size() * rows};
+            for (std::size_t k{begin}; k < end; ++k)
+            {
+                const Interval& interval{intervals[work[k]]};
+                const double center{0.5 * (interval.a + interval.b)};
+                const double half{0.5 * (interval.b - interval.a)};
+                double* row{x + (k - begin) * nodes};
+                for (std::size_t j{0}; j < 8; ++j)
+                {
+                    row[j] = center - half * xgk[j];
+                    row[nodes - 1 - j] = center + half * xgk[j];
+                }
+            }
+            columns[variables.size()] = Span<const double>{x, rows};
+
+            double* f{x + rows};
+            body.evaluateBatch(columns, Span<double>{f, rows});
+
+            for (std::size_t k{begin}; k < end; ++k)
+            {
+                Interval& interval{intervals[work[k]]};
+                const double* y{f + (k - begin) * nodes};
+                double kronrod{wgk[7] * y[7]};
+                double gauss{wg[3] * y[7]};
+                for (std::size_t j{0}; j < 7; ++j)
+                {
+                    const double pair{y[j] + y[nodes - 1 - j]};
+                    kronrod += wgk[j] * pair;
+                    if (j % 2 == 1)
+                        gauss += wg[j / 2] * pair;
+                }
+
+                const double half{0.5 * (interval.b - interval.a)};
+                interval.value = kronrod * half;
+                interval.error = std::fabs((kronrod - gauss) * half);
+            }
+        }
+
+    } // namespace
+
+    Result integrate(const Expression& body, double a, double b, double tolerance,
+                     Span<const double> variables)
+    {
+        constexpr double nan{std::numeric_limits<double>::quiet_NaN()};
+        if (!std::isfinite(a) || !std::isfinite(b) || !(tolerance > 0.0))
+            return {nan, nan, 0};
+        if (a == b)
+            return {0.0, 0.0, 0};
+
+        std::vector<Interval> intervals{{a, b, 0.0, 0.0}};
+        std::vector<std::size_t> work{0};
+        std::vector<double> values{};
+        std::vector<double> errors{};
+        const double width{std::fabs(b - a)};
+
+        while (true)
+        {
+            const auto run = [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t first{begin}; first < end; first += chunk)
+                    integrate(body, variables, intervals, work, first,
+                              std::min(end, first + chunk));
+            };
+            if (work.size() <= chunk)
+                run(0, work.size(), 0);
+            else
+                ThreadPool::shared().parallelFor(work.size(), chunk, run);
+
+            // Summed from left to right in a fixed pairwise tree.
+            values.resize(intervals.size());
+            errors.resize(intervals.size());
+            for (std::size_t i{0}; i < intervals.size(); ++i)
+            {
+                values[i] = intervals[i].value;
+                errors[i] = intervals[i].error;
+            }
+            const Result result{Reduce::pairwiseSum(values), Reduce::pairwiseSum(errors),
+                                intervals.size()};
+
+            const double target{tolerance * std::max(1.0, std::fabs(result.value))};
+            if (result.error <= target)
+                return result;
+
+            // Halve the intervals with more than their share of the error.
+            std::vector<Interval> next{};
+            work.clear();
+            for (const Interval& interval : intervals)
+            {
+                const double share{target * std::fabs(interval.b - interval.a) / width};
+                const double middle{0.5 * (interval.a + interval.b)};
+                const bool split{interval.error > share && middle != interval.a &&
+                                 middle != interval.b};
+                if (!split)
+                {
+                    next.push_back(interval);
+                    continue;
+                }
+
+                work.push_back(next.size());
+                next.push_back({interval.a, middle, 0.0, 0.0});
+                work.push_back(next.size());
+                next.push_back({middle, interval.b, 0.0, 0.0});
+            }
+
+            // Nothing left to refine, or too many intervals.
+            if (work.empty() || next.size() > maxIntervals)
+                return result;
+            intervals = std::move(next);
+        }
+    }
+
+} // namespace CalcEval::Quadrature
@@ -62,10 +62,10 @@ namespace CalcEval
         }
         else if (auto symbol = readSymbol())
         {
+            const auto length{static_cast<Location::value_type>(symbol->first.size())};
             if (symbol->second != TokenType::Bad)
             {
-                return Token{
-                    symbol->second, {m_cLoc.line, m_cLoc.column - 1}, std::string{symbol->first}};
+                return Token{symbol->second, {m_cLoc.line, m_cLoc.column - length}, symbol->first};
             }
             else
             {
@@ -156,23 +156,40 @@ namespace CalcEval
         return std::nullopt;
     }
 
-    std::optional<std::pair<char, TokenType>> Scanner::readSymbol()
+    std::optional<std::pair<std::string, TokenType>> Scanner::readSymbol()
     {
         char symbol{};
         if (m_stream >> symbol)
         {
             ++m_cLoc.column;
-            constexpr std::array<std::pair<char, TokenType>, 7> toMatch{
+
+            // Symbols of two chars, a single '!' is bad.
+            constexpr std::array<std::pair<char, TokenType>, 4> toMatchEqual{
+                std::pair{'<', TokenType::LessEqual}, std::pair{'>', TokenType::GreaterEqual},
+                std::pair{'=', TokenType::Equal}, std::pair{'!', TokenType::NotEqual}};
+            const auto withEqual = std::find_if(
+                toMatchEqual.cbegin(), toMatchEqual.cend(),
+                [&](const auto& pair) { return pair.first == symbol; });
+            if (withEqual != toMatchEqual.cend() && m_stream.peek() == '=')
+            {
+                m_stream.ignore(1);
+                ++m_cLoc.column;
+                return std::pair{std::string{symbol, '='}, withEqual->second};
+            }
+
+            constexpr std::array<std::pair<char, TokenType>, 11> toMatch{
                 std::pair{'+', TokenType::Plus},      std::pair{'-', TokenType::Minus},
                 std::pair{'*', TokenType::Multiply},  std::pair{'/', TokenType::Divide},
                 std::pair{'^', TokenType::Power},     std::pair{'(', TokenType::LeftParen},
-                std::pair{')', TokenType::RightParen}};
+                std::pair{')', TokenType::RightParen}, std::pair{',', TokenType::Comma},
+                std::pair{'=', TokenType::Assign},    std::pair{'<', TokenType::Less},
+                std::pair{'>', TokenType::Greater}};
             const auto search = std::find_if(toMatch.cbegin(), toMatch.cend(),
                                             [&](const auto& pair) { return pair.first == symbol; });
             if (search != toMatch.cend())
-                return *search;
+                return std::pair{std::string{symbol}, search->second};
 
-            return std::pair{symbol, TokenType::Bad};
+            return std::pair{std::string{symbol}, TokenType::Bad};
         }
 
         return std::nullopt;
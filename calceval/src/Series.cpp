@@ -0,0 +1,132 @@
+//
+//  Series.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Series.hpp"
+#include "calceval/Reduce.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace CalcEval::Series
+{
+    namespace
+    {
+        // Sum with the rounding error of every addition kept in c.
+        double compensatedSum(Span<const double> values) noexcept
+        {
+            double s{values[0]};
+            double c{0.0};
+            for (std::size_t i{1}; i < values.size(); ++i)
+            {
+                const double v{values[i]};
+                const double t{s + v};
+                c += (std::fabs(s) >= std::fabs(v)) ? (s - t) + v : (v - t) + s;
+                s = t;
+            }
+
+            // The compensation is NaN after an infinite term.
+            return std::isfinite(s) ? s + c : s;
+        }
+
+        double product(Span<const double> values) noexcept
+        {
+            double p{values[0]};
+            for (std::size_t i{1}; i < values.size(); ++i)
+                p *= values[i];
+            return p;
+        }
+
+        double pairwiseProduct(Span<const double> values) noexcept
+        {
+            if (values.size() <= Reduce::pairwiseBlock)
+                return product(values);
+
+            const std::size_t half{values.size() / 2};
+            return pairwiseProduct(values.subspan(0, half)) *
+                   pairwiseProduct(values.subspan(half, values.size() - half));
+        }
+
+        double reduce(const Expression& body, double a, double b, Span<const double> variables,
+                      bool isProduct)
+        {
+            const std::optional<std::uint64_t> n{count(a, b)};
+            if (!n)
+                return std::numeric_limits<double>::quiet_NaN();
+            if (*n == 0)
+                return isProduct ? 1.0 : 0.0;
+
+            const std::size_t terms{static_cast<std::size_t>(*n)};
+            const std::size_t blocks{(terms - 1) / blockSize + 1};
+            std::vector<double> partials(blocks);
+
+            const auto run = [&](std::size_t begin, std::size_t end, std::size_t) {
+                // One column per variable, the same value in every row, and
+                // the index last.
+                std::vector<double> buffer((variables.size() + 2) * blockSize);
+                std::vector<Span<const double>> columns(variables.size() + 1);
+                for (std::size_t block{begin}; block < end; ++block)
+                {
+                    const std::size_t first{block * blockSize};
+                    const std::size_t m{std::min(blockSize, terms - first)};
+                    for (std::size_t v{0}; v < variables.size(); ++v)
+                    {
+                        double* column{buffer.data() + v * blockSize};
+                        std::fill(column, column + m, variables[v]);
+                        columns[v] = Span<const double>{column, m};
+                    }
+
+                    double* index{buffer.data() + variables.size() * blockSize};
+                    for (std::size_t k{0}; k < m; ++k)
+                        index[k] = a + static_cast<double>(first + k);
+                    columns[variables.size()] = Span<const double>{index, m};
+
+                    const Span<double> values{index + blockSize, m};
+                    body.evaluateBatch(columns, values);
+                    partials[block] = isProduct ? product(values) : compensatedSum(values);
+                }
+            };
+
+            if (blocks == 1)
+                run(0, 1, 0);
+            else
+                ThreadPool::shared().parallelFor(blocks, 1, run);
+
+            return isProduct ? pairwiseProduct(partials) : Reduce::pairwiseSum(partials);
+        }
+
+    } // namespace
+
+    std::optional<std::uint64_t> count(double a, double b) noexcept
+    {
+        if (!std::isfinite(a) || !std::isfinite(b))
+            return std::nullopt;
+        if (b < a)
+            return 0;
+
+        // Exact integers in double end at 2^53.
+        const double d{std::floor(b - a)};
+        if (d >= 9007199254740992.0)
+            return std::nullopt;
+        return static_cast<std::uint64_t>(d) + 1;
+    }
+
+    double sum(const Expression& body, double a, double b, Span<const double> variables)
+    {
+        return reduce(body, a, b, variables, false);
+    }
+
+    double product(const Expression& body, double a, double b, Span<const double> variables)
+    {
+        return reduce(body, a, b, variables, true);
+    }
+
+} // namespace CalcEval::Series
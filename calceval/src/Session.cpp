@@ -0,0 +1,499 @@
+//
+//  Session.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Session.hpp"
+#include "calceval/Compiler.hpp"
+#include "calceval/Scanner.hpp"
+#include "calceval/type/Standard.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace CalcEval
+{
+    namespace
+    {
+        // Names the Compiler gives a meaning, they can not be defined.
+        bool keyword(std::string_view name) noexcept
+        {
+            return name == "and" || name == "or" || name == "not" || name == "if" ||
+                   name == "sum" || name == "prod" || name == "integrate";
+        }
+
+        // Same as Registry, a letter followed by letters and digits.
+        bool validName(std::string_view name) noexcept
+        {
+            if (name.empty() || !std::isalpha(static_cast<unsigned char>(name.front())))
+                return false;
+
+            return std::all_of(name.begin(), name.end(),
+                               [](char c) { return std::isalnum(static_cast<unsigned char>(c)); });
+        }
+
+        bool same(double a, double b) noexcept
+        {
+            return a == b || (std::isnan(a) && std::isnan(b));
+        }
+
+    } // namespace
+
+    Session::Session(symbols_type symbols) : m_symbols{std::move(symbols)}
+    {
+    }
+
+    std::optional<std::pair<std::string, std::string>> Session::assignment(std::string_view line)
+    {
+        std::size_t k{0};
+        while (k < line.size() && std::isspace(static_cast<unsigned char>(line[k])))
+            ++k;
+        const std::size_t start{k};
+        while (k < line.size() && std::isalnum(static_cast<unsigned char>(line[k])))
+            ++k;
+        const std::string_view name{line.substr(start, k - start)};
+        while (k < line.size() && std::isspace(static_cast<unsigned char>(line[k])))
+            ++k;
+
+        if (!validName(name) || k >= line.size() || line[k] != '=' ||
+            (k + 1 < line.size() && line[k + 1] == '='))
+            return std::nullopt;
+
+        return std::make_pair(std::string{name}, std::string{line.substr(k + 1)});
+    }
+
+    std::vector<std::string> Session::scan(const std::string& str)
+    {
+        std::istringstream iss{str};
+        Scanner scanner{iss};
+        std::vector<Token> tokens{};
+        for (Token token{scanner.scan()};
+             token.type != TokenType::EndMark && token.type != TokenType::EndOfLine;
+             token = scanner.scan())
+            tokens.push_back(token);
+
+        // The index of sum and prod, the name before '=', is bound in the
+        // body and the variable of integrate in the integrand. Every use
+        // of the name there is an index, also in a nested sum or integral.
+        std::vector<bool> bound(tokens.size(), false);
+        const auto at = [&tokens](std::size_t k, TokenType type) {
+            return k < tokens.size() && tokens[k].type == type;
+        };
+        // Index of the next ',' or ')' of the arguments that start at k.
+        const auto next = [&tokens](std::size_t k) {
+            std::size_t depth{0};
+            for (; k < tokens.size(); ++k)
+            {
+                if (tokens[k].type == TokenType::LeftParen)
+                    ++depth;
+                else if (depth > 0 && tokens[k].type == TokenType::RightParen)
+                    --depth;
+                else if (depth == 0 && (tokens[k].type == TokenType::Comma ||
+                                        tokens[k].type == TokenType::RightParen))
+                    break;
+            }
+            return k;
+        };
+        const auto bind = [&tokens, &bound](std::size_t first, std::size_t last,
+                                            const std::string& name) {
+            for (std::size_t k{first}; k < last && k < tokens.size(); ++k)
+                if (tokens[k].type == TokenType::Identifier && tokens[k].value == name)
+                    bound[k] = true;
+        };
+        for (std::size_t k{0}; k + 1 < tokens.size(); ++k)
+        {
+            const std::string& name{tokens[k].value};
+            if (tokens[k].type != TokenType::Identifier || !at(k + 1, TokenType::LeftParen))
+                continue;
+
+            if ((name == "sum" || name == "prod") && at(k + 2, TokenType::Identifier) &&
+                at(k + 3, TokenType::Assign))
+            {
+                const std::size_t body{next(next(k + 4) + 1) + 1};
+                bound[k + 2] = true;
+                bind(body, next(body), tokens[k + 2].value);
+            }
+            else if (name == "integrate")
+            {
+                const std::size_t comma{next(k + 2)};
+                if (at(comma, TokenType::Comma) && at(comma + 1, TokenType::Identifier))
+                {
+                    bound[comma + 1] = true;
+                    bind(k + 2, comma, tokens[comma + 1].value);
+                }
+            }
+        }
+
+        std::vector<std::string> names{};
+        for (std::size_t k{0}; k < tokens.size(); ++k)
+            if (tokens[k].type == TokenType::Identifier && !bound[k] && !keyword(tokens[k].value))
+                names.push_back(tokens[k].value);
+
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        return names;
+    }
+
+    bool Session::known(const std::string& name) const
+    {
+        if (m_symbols && m_symbols->symbol(name))
+            return true;
+
+        Type::Standard standard{};
+        return standard.constant(name) || standard.function(name) || standard.variadic(name);
+    }
+
+    std::vector<std::string> Session::variables(const std::vector<std::string>& names) const
+    {
+        // Names that are not defined are variables too, so the expression
+        // compiles before they are.
+        std::vector<std::string> result{};
+        for (const std::string& name : names)
+            if (m_definitions.count(name) != 0 || !known(name))
+                result.push_back(name);
+        return result;
+    }
+
+    std::vector<std::string> Session::define(const std::string& name, const std::string& str)
+    {
+        if (!validName(name) || keyword(name))
+            throw std::invalid_argument("Session: \"" + name + "\" is not a valid name");
+
+        return assign(name, str, false);
+    }
+
+    std::vector<std::string> Session::defineResult(const std::string& key, const std::string& str)
+    {
+        if (key.empty() || validName(key))
+            throw std::invalid_argument("Session: \"" + key + "\" is a name, not a key");
+
+        return assign(key, str, false);
+    }
+
+    std::vector<std::string> Session::keep(const std::string& name, const std::string& str)
+    {
+        if (name.empty() || (validName(name) && keyword(name)))
+            throw std::invalid_argument("Session: \"" + name + "\" is not a valid name");
+
+        return assign(name, str, true);
+    }
+
+    std::vector<std::string> Session::defineError(const std::string& name,
+                                                  const std::string& error)
+    {
+        if (!validName(name) || keyword(name))
+            throw std::invalid_argument("Session: \"" + name + "\" is not a valid name");
+
+        // Uses no names, so it can not be part of a cycle.
+        ++m_epoch;
+        const std::vector<Definition*> order{dependents(name)};
+        return replace(name, {}, {}, std::nullopt, error, order);
+    }
+
+    std::vector<std::string> Session::assign(const std::string& name, const std::string& str,
+                                             bool keep)
+    {
+        std::vector<std::string> names{};
+        std::string error{};
+        try
+        {
+            names = scan(str);
+        }
+        catch (const Error& e)
+        {
+            if (!keep)
+                throw;
+            error = e.what();
+        }
+
+        // A cycle needs a name used by the definition that depends on it.
+        ++m_epoch;
+        const std::vector<Definition*> order{dependents(name)};
+        for (const std::string& used : names)
+        {
+            const auto it{m_definitions.find(used)};
+            if (used == name || (it != m_definitions.end() && it->second.visited == m_epoch))
+                throw Error("Session: " + name + " would depend on itself through " + used);
+        }
+
+        std::optional<Expression> expression{};
+        if (error.empty())
+        {
+            try
+            {
+                expression = Compiler<>{m_symbols}.compile(str, variables(names));
+            }
+            catch (const Error& e)
+            {
+                if (!keep)
+                    throw;
+                error = e.what();
+            }
+        }
+
+        return replace(name, str, std::move(names), std::move(expression), error, order);
+    }
+
+    std::vector<std::string> Session::replace(const std::string& name, const std::string& str,
+                                              std::vector<std::string> names,
+                                              std::optional<Expression> expression,
+                                              const std::string& error,
+                                              const std::vector<Definition*>& order)
+    {
+        const auto [it, created] = m_definitions.try_emplace(name);
+        Definition& definition{it->second};
+        const double value{definition.value};
+        const std::string old{definition.error};
+        definition.name = name;
+        for (const std::string& used : definition.names)
+        {
+            std::vector<Definition*>& users{m_users[used]};
+            users.erase(std::find(users.begin(), users.end(), &definition));
+        }
+        for (const std::string& used : names)
+            m_users[used].push_back(&definition);
+
+        definition.text = str;
+        definition.names = std::move(names);
+        definition.variables = variables(definition.names);
+        definition.expression = std::move(expression);
+        definition.error = error;
+        connect(definition);
+
+        // The name is always reported, its users only see a new value.
+        std::vector<std::string> changed{name};
+        evaluate(definition);
+        if (created || definition.error != old ||
+            (old.empty() && !same(definition.value, value)))
+            definition.changed = m_epoch;
+
+        // The users of a new name see it for the first time.
+        update(order, name, created, changed);
+        return changed;
+    }
+
+    std::vector<std::string> Session::remove(const std::string& name)
+    {
+        const auto it{m_definitions.find(name)};
+        if (it == m_definitions.end())
+            return {};
+
+        ++m_epoch;
+        const std::vector<Definition*> order{dependents(name)};
+        for (const std::string& used : it->second.names)
+        {
+            std::vector<Definition*>& users{m_users[used]};
+            users.erase(std::find(users.begin(), users.end(), &it->second));
+        }
+        m_definitions.erase(it);
+
+        std::vector<std::string> changed{};
+        update(order, name, true, changed);
+        return changed;
+    }
+
+    std::vector<Session::Definition*> Session::dependents(const std::string& name)
+    {
+        const auto users = [this](const std::string& used) -> const std::vector<Definition*>* {
+            const auto it{m_users.find(used)};
+            return (it != m_users.end()) ? &it->second : nullptr;
+        };
+
+        // Depth first, a definition is added after everything that uses it.
+        struct Frame
+        {
+            Definition* definition;
+            const std::vector<Definition*>* users;
+            std::size_t next;
+        };
+        std::vector<Definition*> order{};
+        std::vector<Frame> stack{{nullptr, users(name), 0}};
+        while (!stack.empty())
+        {
+            Frame& frame{stack.back()};
+            if (frame.users && frame.next < frame.users->size())
+            {
+                Definition* user{(*frame.users)[frame.next++]};
+                if (user->visited != m_epoch)
+                {
+                    user->visited = m_epoch;
+                    stack.push_back({user, users(user->name), 0});
+                }
+                continue;
+            }
+
+            if (frame.definition)
+                order.push_back(frame.definition);
+            stack.pop_back();
+        }
+
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    void Session::connect(Definition& definition)
+    {
+        definition.inputs.clear();
+        for (const std::string& variable : definition.variables)
+        {
+            const auto input{m_definitions.find(variable)};
+            definition.inputs.push_back((input != m_definitions.end()) ? &input->second : nullptr);
+        }
+    }
+
+    void Session::link(Definition& definition)
+    {
+        definition.variables = variables(definition.names);
+        connect(definition);
+
+        try
+        {
+            definition.expression = Compiler<>{m_symbols}.compile(definition.text,
+                                                                  definition.variables);
+            definition.error.clear();
+        }
+        catch (const Error& e)
+        {
+            definition.expression.reset();
+            definition.error = e.what();
+        }
+    }
+
+    void Session::evaluate(Definition& definition)
+    {
+        ++m_evaluations;
+        if (!definition.expression)
+            return;
+
+        // Only compiled again when it changes, the value is all that is used.
+        if (definition.inputs.empty())
+        {
+            definition.error.clear();
+            definition.value = definition.expression->evaluate();
+            definition.expression.reset();
+            return;
+        }
+
+        definition.error.clear();
+        m_values.resize(definition.inputs.size());
+        for (std::size_t i{0}; i < definition.inputs.size(); ++i)
+        {
+            const Definition* input{definition.inputs[i]};
+            if (!input)
+            {
+                definition.error = definition.variables[i] + " is not defined";
+                return;
+            }
+            if (!input->error.empty())
+            {
+                definition.error = "depends on " + input->name + ", which has no value";
+                return;
+            }
+            m_values[i] = input->value;
+        }
+
+        definition.value = definition.expression->evaluate(m_values);
+    }
+
+    void Session::update(const std::vector<Definition*>& order, const std::string& name,
+                         bool relink, std::vector<std::string>& changed)
+    {
+        for (Definition* definition : order)
+        {
+            const double value{definition->value};
+            const std::string error{definition->error};
+
+            // Users of a name that was added or removed compile again, the
+            // name is a variable or a constant or function now.
+            const bool direct{std::binary_search(definition->names.begin(),
+                                                 definition->names.end(), name)};
+            if (relink && direct)
+                link(*definition);
+
+            // Only when a name it uses has another value.
+            bool input{relink && direct};
+            for (const Definition* used : definition->inputs)
+                input = input || (used && used->changed == m_epoch);
+            if (!input)
+                continue;
+
+            evaluate(*definition);
+            if (definition->error != error || (error.empty() && !same(definition->value, value)))
+            {
+                definition->changed = m_epoch;
+                changed.push_back(definition->name);
+            }
+        }
+    }
+
+    void Session::clear()
+    {
+        m_definitions.clear();
+        m_users.clear();
+    }
+
+    double Session::evaluate(const std::string& str) const
+    {
+        const std::vector<std::string> vars{variables(scan(str))};
+        const Expression expression{Compiler<>{m_symbols}.compile(str, vars)};
+
+        std::vector<double> values{};
+        for (const std::string& variable : vars)
+        {
+            const auto it{m_definitions.find(variable)};
+            if (it == m_definitions.end())
+                throw Error("Session: " + variable + " is not defined");
+            if (!it->second.error.empty())
+                throw Error("Session: " + variable + " has no value: " + it->second.error);
+            values.push_back(it->second.value);
+        }
+        return expression.evaluate(values);
+    }
+
+    std::optional<double> Session::value(const std::string& name) const
+    {
+        const auto it{m_definitions.find(name)};
+        if (it == m_definitions.end() || !it->second.error.empty())
+            return std::nullopt;
+
+        return it->second.value;
+    }
+
+    std::string Session::error(const std::string& name) const
+    {
+        const auto it{m_definitions.find(name)};
+        return (it == m_definitions.end()) ? std::string{} : it->second.error;
+    }
+
+    std::vector<std::string> Session::users(const std::string& name) const
+    {
+        std::vector<std::string> result{};
+        if (const auto it{m_users.find(name)}; it != m_users.end())
+            for (const Definition* user : it->second)
+                result.push_back(user->name);
+        return result;
+    }
+
+    bool Session::contains(const std::string& name) const
+    {
+        return m_definitions.count(name) != 0;
+    }
+
+    std::size_t Session::size() const noexcept
+    {
+        return m_definitions.size();
+    }
+
+    std::uint64_t Session::evaluations() const noexcept
+    {
+        return m_evaluations;
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,139 @@
+//
+//  ShapeGroups.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/ShapeGroups.hpp"
+
+// C++ Headers
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace CalcEval
+{
+    std::vector<std::vector<std::size_t>> groupByShape(Span<const Expression> expressions)
+    {
+        std::vector<std::vector<std::size_t>> groups{};
+
+        // Groups with the same hash, which almost always is one group.
+        std::unordered_map<std::uint64_t, std::vector<std::size_t>> byHash{};
+        for (std::size_t i{0}; i < expressions.size(); ++i)
+        {
+            const Expression& expression{expressions[i]};
+            std::vector<std::size_t>& candidates{byHash[expression.shapeHash()]};
+
+            bool found{false};
+            for (const std::size_t group : candidates)
+            {
+                if (expressions[groups[group].front()].sameShape(expression))
+                {
+                    groups[group].push_back(i);
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+            {
+                candidates.push_back(groups.size());
+                groups.push_back({i});
+            }
+        }
+
+        return groups;
+    }
+
+    ShapeGroups::ShapeGroups(Span<const Expression> expressions) : m_size{expressions.size()}
+    {
+        for (std::size_t i{0}; i < expressions.size(); ++i)
+        {
+            const Expression& expression{expressions[i]};
+            if (!expression.complete())
+                throw std::invalid_argument("ShapeGroups: expression " + std::to_string(i) +
+                                            " is not a complete expression");
+            if (expression.variables().size() != expressions[0].variables().size())
+                throw std::invalid_argument("ShapeGroups: expression " + std::to_string(i) +
+                                            " has other variables");
+            for (std::uint32_t v{0}; v < expression.variables().size(); ++v)
+                if (expression.variables().name(v) != expressions[0].variables().name(v))
+                    throw std::invalid_argument("ShapeGroups: expression " + std::to_string(i) +
+                                                " has other variables");
+        }
+        if (!expressions.empty())
+            m_variableCount = expressions[0].variableCount();
+
+        for (std::vector<std::size_t>& indices : groupByShape(expressions))
+        {
+            const Expression& first{expressions[indices.front()]};
+            const std::size_t count{first.constants().size()};
+            const std::size_t lanes{indices.size()};
+
+            std::vector<double> constants(count * lanes);
+            for (std::size_t j{0}; j < lanes; ++j)
+            {
+                const std::vector<double>& values{expressions[indices[j]].constants()};
+                for (std::size_t k{0}; k < count; ++k)
+                    constants[k * lanes + j] = values[k];
+            }
+
+            m_groups.push_back({first, std::move(indices), std::move(constants)});
+        }
+    }
+
+    void ShapeGroups::evaluate(Span<const double> variables, Span<double> results,
+                               Kernel::Accuracy accuracy) const
+    {
+        if (variables.size() != m_variableCount)
+            throw std::invalid_argument("ShapeGroups: expected " +
+                                        std::to_string(m_variableCount) + " variable(s), got " +
+                                        std::to_string(variables.size()));
+        if (results.size() != m_size)
+            throw std::invalid_argument("ShapeGroups: expected " + std::to_string(m_size) +
+                                        " result(s), got " + std::to_string(results.size()));
+
+        std::vector<Span<const double>> columns{};
+        std::vector<double> lanes{};
+        for (const Group& group : m_groups)
+        {
+            const std::size_t width{group.indices.size()};
+            if (width == 1)
+            {
+                results[group.indices.front()] = group.expression.evaluate(variables);
+                continue;
+            }
+
+            columns.clear();
+            for (std::size_t k{0}; k < group.expression.constants().size(); ++k)
+                columns.push_back(Span<const double>{group.constants.data() + k * width, width});
+
+            lanes.resize(width);
+            group.expression.evaluateLanes(columns, variables, lanes, accuracy);
+            for (std::size_t j{0}; j < width; ++j)
+                results[group.indices[j]] = lanes[j];
+        }
+    }
+
+    std::vector<double> ShapeGroups::evaluate(Span<const double> variables,
+                                              Kernel::Accuracy accuracy) const
+    {
+        std::vector<double> results(m_size);
+        evaluate(variables, results, accuracy);
+        return results;
+    }
+
+    std::size_t ShapeGroups::size() const noexcept
+    {
+        return m_size;
+    }
+
+    std::size_t ShapeGroups::groupCount() const noexcept
+    {
+        return m_groups.size();
+    }
+
+} // namespace CalcEval
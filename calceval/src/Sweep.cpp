@@ -0,0 +1,394 @@
+//
+//  Sweep.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Sweep.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace CalcEval
+{
+    namespace
+    {
+        constexpr std::uint32_t noParent{0xffffffff};
+
+        // Number of values an instruction pops from the stack.
+        std::uint32_t pops(const Expression& expression, const Instruction& instruction) noexcept
+        {
+            switch (instruction.op)
+            {
+                case OpCode::Constant:
+                case OpCode::Variable:
+                    return 0;
+                case OpCode::Negate:
+                case OpCode::Function:
+                case OpCode::Then:
+                case OpCode::Else:
+                    return 1;
+                case OpCode::Select:
+                    return 3;
+                case OpCode::Variadic:
+                    return expression.variadics()[instruction.index].count;
+                case OpCode::Reduce:
+                    return expression.reductions()[instruction.index].count;
+                default:
+                    return 2;
+            }
+        }
+
+        // Highest variable below outer used by body or the bodies in it, -1
+        // if none.
+        int uses(const Expression& body, std::uint32_t outer)
+        {
+            int level{-1};
+            for (const Instruction& instruction : body.code())
+                if (instruction.op == OpCode::Variable && instruction.index < outer)
+                    level = std::max(level, static_cast<int>(instruction.index));
+            for (const Expression::Reduction& reduction : body.reductions())
+                level = std::max(level, uses(*reduction.body, outer));
+            return level;
+        }
+
+        Expression rebase(const Expression& body, std::uint32_t axes,
+                          const std::vector<std::string>& slots);
+
+        // Appends instruction of source to out, variables keep their index.
+        void append(Expression& out, const Expression& source, const Instruction& instruction,
+                    std::uint32_t axes, const std::vector<std::string>& slots)
+        {
+            switch (instruction.op)
+            {
+                case OpCode::Constant:
+                    out.pushConstant(source.constants()[instruction.index]);
+                    break;
+                case OpCode::Variable:
+                    out.pushVariable(instruction.index);
+                    break;
+                case OpCode::Function:
+                {
+                    const Expression::Function& func{source.functions()[instruction.index]};
+                    out.pushFunction(func.name, func.function, func.batch, func.array);
+                    break;
+                }
+                case OpCode::Variadic:
+                {
+                    const Expression::Call& call{source.variadics()[instruction.index]};
+                    out.pushVariadic(call.name, call.function, call.count);
+                    break;
+                }
+                case OpCode::Reduce:
+                {
+                    const Expression::Reduction& reduction{source.reductions()[instruction.index]};
+                    out.pushReduction(reduction.name, reduction.kind,
+                                      rebase(*reduction.body, axes, slots));
+                    break;
+                }
+                default:
+                    out.pushOperator(instruction.op);
+                    break;
+            }
+        }
+
+        // The vectorized operators of from, if it has any.
+        void copyOperators(Expression& to, const Expression& from)
+        {
+            for (OpCode op : {OpCode::Add, OpCode::Subtract, OpCode::Multiply, OpCode::Divide,
+                              OpCode::Power})
+                to.setBatchOperator(op, from.batchOperator(op));
+        }
+
+        // The body of a reduction with the slots after the axes. The
+        // indices of the reductions around it, and its own, follow them.
+        Expression rebase(const Expression& body, std::uint32_t axes,
+                          const std::vector<std::string>& slots)
+        {
+            std::vector<std::string> names{};
+            for (std::uint32_t i{0}; i < axes; ++i)
+                names.emplace_back(body.variables().name(i));
+            names.insert(names.end(), slots.begin(), slots.end());
+            for (std::uint32_t i{axes}; i < body.variableCount(); ++i)
+                names.emplace_back(body.variables().name(i));
+
+            const auto offset{static_cast<std::uint32_t>(slots.size())};
+            Expression result{names};
+            copyOperators(result, body);
+            for (const Instruction& instruction : body.code())
+            {
+                if (instruction.op == OpCode::Variable && instruction.index >= axes)
+                    result.pushVariable(instruction.index + offset);
+                else
+                    append(result, body, instruction, axes, slots);
+            }
+            return result;
+        }
+
+    } // namespace
+
+    struct Sweep::State
+    {
+        std::vector<double> values;
+        std::vector<Span<const double>> columns;
+        std::vector<double> inner;
+        std::vector<double> results;
+    };
+
+    Sweep::Axis Sweep::Axis::parse(std::string_view str)
+    {
+        const auto invalid = [str]() {
+            return std::invalid_argument("Sweep: \"" + std::string{str} +
+                                         "\" is not name=start:step:stop");
+        };
+
+        const std::size_t equal{str.find('=')};
+        if (equal == 0 || equal == std::string_view::npos)
+            throw invalid();
+
+        Axis axis{std::string{str.substr(0, equal)}, 0.0, 0.0, 0.0};
+        double* fields[3]{&axis.start, &axis.step, &axis.stop};
+        std::string_view rest{str.substr(equal + 1)};
+        for (std::size_t i{0}; i < 3; ++i)
+        {
+            const std::size_t colon{rest.find(':')};
+            if ((i < 2) == (colon == std::string_view::npos))
+                throw invalid();
+
+            const std::string field{rest.substr(0, colon)};
+            char* end{nullptr};
+            *fields[i] = std::strtod(field.c_str(), &end);
+            if (field.empty() || end != field.c_str() + field.size())
+                throw invalid();
+            if (i < 2)
+                rest.remove_prefix(colon + 1);
+        }
+
+        return axis;
+    }
+
+    std::size_t Sweep::Axis::count() const noexcept
+    {
+        if (!std::isfinite(start) || !std::isfinite(step) || !std::isfinite(stop) || step == 0.0)
+            return 0;
+
+        // A little slack so that 0:0.1:1 ends with 1 despite rounding.
+        const double steps{(stop - start) / step + 1e-9};
+        if (!(steps >= 0.0) || steps >= 9007199254740992.0)
+            return 0;
+        return static_cast<std::size_t>(std::floor(steps)) + 1;
+    }
+
+    double Sweep::Axis::value(std::size_t index) const noexcept
+    {
+        return start + static_cast<double>(index) * step;
+    }
+
+    Sweep::Sweep(const Expression& expression, std::vector<Axis> axes, Kernel::Accuracy accuracy)
+        : m_axes{std::move(axes)}, m_accuracy{accuracy}
+    {
+        if (!expression.complete())
+            throw std::invalid_argument("Sweep: code is not a complete expression");
+
+        const std::size_t n{m_axes.size()};
+        if (n == 0 || n != expression.variableCount())
+            throw std::invalid_argument("Sweep: expected " +
+                                        std::to_string(expression.variableCount()) +
+                                        " axes, got " + std::to_string(n));
+        for (std::uint32_t i{0}; i < n; ++i)
+        {
+            const Axis& axis{m_axes[i]};
+            if (expression.variables().name(i) != axis.name)
+                throw std::invalid_argument("Sweep: axis \"" + axis.name + "\" is not variable " +
+                                            std::to_string(i) + " of the expression");
+            if (axis.count() == 0)
+                throw std::invalid_argument("Sweep: axis \"" + axis.name + "\" has no values");
+        }
+
+        // The last axis every instruction depends on, -1 for none, and the
+        // instruction that pops its value.
+        const std::vector<Instruction>& code{expression.code()};
+        std::vector<int> level(code.size(), -1);
+        std::vector<std::uint32_t> parent(code.size(), noParent);
+        std::vector<std::uint32_t> stack{};
+        for (std::uint32_t k{0}; k < code.size(); ++k)
+        {
+            const Instruction& instruction{code[k]};
+            if (instruction.op == OpCode::Variable)
+                level[k] = static_cast<int>(instruction.index);
+            else if (instruction.op == OpCode::Reduce)
+                level[k] = uses(*expression.reductions()[instruction.index].body,
+                                static_cast<std::uint32_t>(n));
+
+            const std::uint32_t count{pops(expression, instruction)};
+            for (std::uint32_t j{0}; j < count; ++j)
+            {
+                const std::uint32_t child{stack[stack.size() - 1 - j]};
+                parent[child] = k;
+                level[k] = std::max(level[k], level[child]);
+            }
+            stack.resize(stack.size() - count);
+            stack.push_back(k);
+        }
+
+        // Program 0 is the inner loop. A subtree that depends on fewer axes
+        // than the program of its parent gets a program of its own, run in
+        // the loop of its last axis, or once if it has none. The markers of
+        // if(c, a, b) stay with their Select, c, a and b may still move.
+        struct Program
+        {
+            int level;
+            std::uint32_t root;
+        };
+        std::vector<Program> programs{{static_cast<int>(n) - 1, noParent}};
+        std::vector<std::uint32_t> owner(code.size());
+        for (std::uint32_t k{static_cast<std::uint32_t>(code.size())}; k-- > 0;)
+        {
+            const std::uint32_t up{(parent[k] == noParent) ? 0 : owner[parent[k]]};
+            const OpCode op{code[k].op};
+            const bool leaf{op == OpCode::Constant || op == OpCode::Variable ||
+                            op == OpCode::Then || op == OpCode::Else};
+            if (!leaf && level[k] < programs[up].level)
+            {
+                owner[k] = static_cast<std::uint32_t>(programs.size());
+                programs.push_back({level[k], k});
+            }
+            else
+            {
+                owner[k] = up;
+            }
+        }
+
+        // The values of moved subtrees are variables after the axes.
+        std::vector<std::string> names{};
+        for (const Axis& axis : m_axes)
+            names.push_back(axis.name);
+        std::vector<std::string> slots{};
+        std::vector<std::uint32_t> slot(programs.size(), 0);
+        for (std::size_t q{1}; q < programs.size(); ++q)
+        {
+            if (programs[q].level < 0)
+                continue;
+            slot[q] = static_cast<std::uint32_t>(n + slots.size());
+            slots.push_back("#" + std::to_string(slots.size()));
+        }
+        names.insert(names.end(), slots.begin(), slots.end());
+        m_variables = names.size();
+
+        // Every program in postfix order. A complete subtree is a constant
+        // or a variable in the program of its parent.
+        Expression empty{names};
+        copyOperators(empty, expression);
+        std::vector<Expression> expressions(programs.size(), empty);
+        const std::vector<double> zeros(names.size(), 0.0);
+        for (std::uint32_t k{0}; k < code.size(); ++k)
+        {
+            const std::uint32_t q{owner[k]};
+            append(expressions[q], expression, code[k], static_cast<std::uint32_t>(n), slots);
+            if (q == 0 || programs[q].root != k)
+                continue;
+
+            const std::uint32_t up{(parent[k] == noParent) ? 0 : owner[parent[k]]};
+            if (programs[q].level < 0)
+                expressions[up].pushConstant(expressions[q].evaluate(zeros));
+            else
+                expressions[up].pushVariable(slot[q]);
+        }
+
+        m_inner = std::move(expressions[0]);
+        m_levels.resize(n);
+        for (std::size_t q{1}; q < programs.size(); ++q)
+            if (programs[q].level >= 0)
+                m_levels[static_cast<std::size_t>(programs[q].level)].push_back(
+                    {std::move(expressions[q]), slot[q]});
+    }
+
+    void Sweep::run(const callback_type& callback) const
+    {
+        State state{std::vector<double>(m_variables, 0.0),
+                    std::vector<Span<const double>>(m_variables),
+                    std::vector<double>(std::min(m_axes.back().count(), blockSize)),
+                    std::vector<double>(std::min(m_axes.back().count(), blockSize))};
+
+        // The other variables have a single value for a whole block.
+        for (std::size_t v{0}; v < m_variables; ++v)
+            state.columns[v] = Span<const double>{state.values.data() + v, 1};
+
+        run(0, state, callback);
+    }
+
+    void Sweep::run(std::size_t level, State& state, const callback_type& callback) const
+    {
+        const Axis& axis{m_axes[level]};
+        const std::size_t count{axis.count()};
+        if (level + 1 < m_axes.size())
+        {
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                state.values[level] = axis.value(i);
+                for (const Hoisted& hoisted : m_levels[level])
+                    state.values[hoisted.slot] = hoisted.expression.evaluate(state.values);
+                run(level + 1, state, callback);
+            }
+            return;
+        }
+
+        for (std::size_t first{0}; first < count; first += blockSize)
+        {
+            const std::size_t m{std::min(blockSize, count - first)};
+            for (std::size_t i{0}; i < m; ++i)
+                state.inner[i] = axis.value(first + i);
+
+            const Span<const double> inner{state.inner.data(), m};
+            const Span<double> results{state.results.data(), m};
+            state.columns[level] = inner;
+            m_inner.evaluateBatch(state.columns, results, m_accuracy);
+            callback({Span<const double>{state.values.data(), level}, inner, results});
+        }
+    }
+
+    const std::vector<Sweep::Axis>& Sweep::axes() const noexcept
+    {
+        return m_axes;
+    }
+
+    std::uint64_t Sweep::size() const noexcept
+    {
+        std::uint64_t points{1};
+        for (const Axis& axis : m_axes)
+            points *= axis.count();
+        return points;
+    }
+
+    const Expression& Sweep::inner() const noexcept
+    {
+        return m_inner;
+    }
+
+    std::size_t Sweep::hoistedCount() const noexcept
+    {
+        std::size_t count{0};
+        for (const std::vector<Hoisted>& hoisted : m_levels)
+            count += hoisted.size();
+        return count;
+    }
+
+    std::uint64_t Sweep::instructionCount() const noexcept
+    {
+        std::uint64_t points{1};
+        std::uint64_t count{0};
+        for (std::size_t level{0}; level < m_axes.size(); ++level)
+        {
+            points *= m_axes[level].count();
+            for (const Hoisted& hoisted : m_levels[level])
+                count += hoisted.expression.code().size() * points;
+        }
+        return count + m_inner.code().size() * points;
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,382 @@
+//
+//  Tape.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Tape.hpp"
+#include "calceval/Error.hpp"
+#include "calceval/StaticTable.hpp"
+#include "calceval/type/Standard.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace CalcEval
+{
+    // Derivatives of the functions in Type::Standard, x is the argument
+    // and fx the value of the function.
+    static constexpr auto derivatives = makeStaticTable<Tape::derivative_type>(
+        std::pair{"log", [](double x, double) { return 1.0 / x; }},
+        std::pair{"log10", [](double x, double) { return 1.0 / (x * std::log(10.0)); }},
+        std::pair{"exp", [](double, double fx) { return fx; }},
+        std::pair{"sin", [](double x, double) { return std::cos(x); }},
+        std::pair{"cos", [](double x, double) { return -std::sin(x); }},
+        std::pair{"tan", [](double, double fx) { return 1.0 + fx * fx; }},
+        std::pair{"arcsin", [](double x, double) { return 1.0 / std::sqrt(1.0 - x * x); }},
+        std::pair{"arccos", [](double x, double) { return -1.0 / std::sqrt(1.0 - x * x); }},
+        std::pair{"arctan", [](double x, double) { return 1.0 / (1.0 + x * x); }});
+
+    // min and max: the first argument with the value of the result.
+    static void selected(Span<const double> args, double result, Span<double> partials)
+    {
+        bool found{false};
+        for (std::size_t i{0}; i < args.size(); ++i)
+        {
+            partials[i] = (!found && args[i] == result) ? 1.0 : 0.0;
+            found = found || args[i] == result;
+        }
+    }
+
+    // Partial derivatives of the functions with several arguments in Type::Standard.
+    static constexpr auto partials = makeStaticTable<Tape::partials_type>(
+        std::pair{"min", &selected}, std::pair{"max", &selected},
+        std::pair{"sum",
+                  [](Span<const double> args, double, Span<double> p) {
+                      std::fill(p.begin(), p.begin() + args.size(), 1.0);
+                  }},
+        std::pair{"mean",
+                  [](Span<const double> args, double, Span<double> p) {
+                      const double n{static_cast<double>(args.size())};
+                      std::fill(p.begin(), p.begin() + args.size(), 1.0 / n);
+                  }},
+        std::pair{"hypot",
+                  [](Span<const double> args, double result, Span<double> p) {
+                      for (std::size_t i{0}; i < args.size(); ++i)
+                          p[i] = (result != 0.0) ? args[i] / result : 0.0;
+                  }},
+        std::pair{"atan2", [](Span<const double> args, double, Span<double> p) {
+                      const double y{args[0]}, x{args[1]};
+                      const double r2{x * x + y * y};
+                      p[0] = x / r2;
+                      p[1] = -y / r2;
+                  }});
+
+    ///////////////////////////////////////////////////////////////////////////////
+
+    Tape::Tape(Expression expression) : m_expression{std::move(expression)}
+    {
+        if (!m_expression.complete())
+            throw std::invalid_argument("Tape: code is not a complete expression");
+
+        // Functions are only differentiated if they are the ones in
+        // Type::Standard and not a symbol with the same name.
+        for (const Expression::Function& func : m_expression.functions())
+        {
+            const auto standard = Type::Standard::functions.find(func.name);
+            const auto derivative = derivatives.find(func.name);
+            if (!standard || *standard != func.function || !derivative)
+                throw Error("Tape: no derivative for function \"" + func.name + "\"");
+            m_derivatives.push_back(*derivative);
+        }
+
+        for (const Expression::Reduction& reduction : m_expression.reductions())
+            throw Error("Tape: no derivative for function \"" + reduction.name + "\"");
+
+        std::size_t maxCount{0};
+        for (const Expression::Call& call : m_expression.variadics())
+        {
+            const auto standard = Type::Standard::variadics.find(call.name);
+            const auto partial = partials.find(call.name);
+            if (!standard || standard->function != call.function || !partial)
+                throw Error("Tape: no derivative for function \"" + call.name + "\"");
+            m_partials.push_back(*partial);
+            maxCount = std::max<std::size_t>(maxCount, call.count);
+        }
+
+        // Replay the stack with node indices instead of values to find
+        // the operands of every node.
+        const std::vector<Instruction>& code{m_expression.code()};
+        std::vector<std::uint32_t> stack{};
+        stack.reserve(m_expression.stackSize());
+        m_nodes.reserve(code.size());
+
+        for (const Instruction& instruction : code)
+        {
+            Node node{instruction.op, false, instruction.index, 0, 0};
+            switch (instruction.op)
+            {
+                case OpCode::Constant:
+                    break;
+                case OpCode::Variable:
+                    node.active = true;
+                    break;
+                case OpCode::Negate:
+                case OpCode::Function:
+                case OpCode::Then:
+                case OpCode::Else:
+                    node.first = stack.back();
+                    stack.pop_back();
+                    node.active = m_nodes[node.first].active;
+                    break;
+                case OpCode::Add:
+                case OpCode::Subtract:
+                case OpCode::Multiply:
+                case OpCode::Divide:
+                case OpCode::Power:
+                    node.second = stack.back();
+                    stack.pop_back();
+                    node.first = stack.back();
+                    stack.pop_back();
+                    node.active = m_nodes[node.first].active || m_nodes[node.second].active;
+                    break;
+                case OpCode::Less:
+                case OpCode::LessEqual:
+                case OpCode::Greater:
+                case OpCode::GreaterEqual:
+                case OpCode::Equal:
+                case OpCode::NotEqual:
+                    // Piecewise constant, the derivative is 0.
+                    node.second = stack.back();
+                    stack.pop_back();
+                    node.first = stack.back();
+                    stack.pop_back();
+                    break;
+                case OpCode::Select:
+                    // The condition and both branches, only the branches
+                    // have a derivative.
+                    node.first = static_cast<std::uint32_t>(m_arguments.size());
+                    m_arguments.insert(m_arguments.end(), stack.end() - 3, stack.end());
+                    stack.resize(stack.size() - 3);
+                    node.active = m_nodes[m_arguments[node.first + 1]].active ||
+                                  m_nodes[m_arguments[node.first + 2]].active;
+                    break;
+                case OpCode::Variadic:
+                {
+                    const std::uint32_t count{m_expression.variadics()[instruction.index].count};
+                    node.first = static_cast<std::uint32_t>(m_arguments.size());
+                    for (std::size_t i{stack.size() - count}; i < stack.size(); ++i)
+                    {
+                        m_arguments.push_back(stack[i]);
+                        node.active = node.active || m_nodes[stack[i]].active;
+                    }
+                    stack.resize(stack.size() - count);
+                    break;
+                }
+                case OpCode::Reduce:
+                    // Rejected above.
+                    break;
+            }
+
+            stack.push_back(static_cast<std::uint32_t>(m_nodes.size()));
+            m_nodes.push_back(node);
+        }
+
+        m_values.resize(m_nodes.size());
+        m_adjoints.resize(m_nodes.size());
+        m_callValues.resize(maxCount);
+        m_callPartials.resize(maxCount);
+    }
+
+    double Tape::gradient(Span<const double> variables, Span<double> gradient)
+    {
+        const std::size_t count{m_expression.variableCount()};
+        if (variables.size() != count || gradient.size() != count)
+            throw std::invalid_argument("Tape: expected " + std::to_string(count) +
+                                        " variable(s) and derivative(s)");
+
+        forward(variables.data());
+        std::fill(gradient.begin(), gradient.end(), 0.0);
+        backward(gradient.data());
+        return m_values.back();
+    }
+
+    // Computes every node the same way as Expression::evaluate, so the
+    // value is identical.
+    void Tape::forward(const double* variables)
+    {
+        const std::vector<double>& constants{m_expression.constants()};
+        double* values{m_values.data()};
+
+        for (std::size_t i{0}; i < m_nodes.size(); ++i)
+        {
+            const Node& node{m_nodes[i]};
+            switch (node.op)
+            {
+                case OpCode::Constant:
+                    values[i] = constants[node.index];
+                    break;
+                case OpCode::Variable:
+                    values[i] = variables[node.index];
+                    break;
+                case OpCode::Negate:
+                    values[i] = values[node.first] * -1.0;
+                    break;
+                case OpCode::Add:
+                    values[i] = values[node.first] + values[node.second];
+                    break;
+                case OpCode::Subtract:
+                    values[i] = values[node.first] - values[node.second];
+                    break;
+                case OpCode::Multiply:
+                    values[i] = values[node.first] * values[node.second];
+                    break;
+                case OpCode::Divide:
+                    values[i] = values[node.first] / values[node.second];
+                    break;
+                case OpCode::Power:
+                    values[i] = std::pow(values[node.first], values[node.second]);
+                    break;
+                case OpCode::Less:
+                    values[i] = (values[node.first] < values[node.second]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::LessEqual:
+                    values[i] = (values[node.first] <= values[node.second]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::Greater:
+                    values[i] = (values[node.first] > values[node.second]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::GreaterEqual:
+                    values[i] = (values[node.first] >= values[node.second]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::Equal:
+                    values[i] = (values[node.first] == values[node.second]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::NotEqual:
+                    values[i] = (values[node.first] != values[node.second]) ? 1.0 : 0.0;
+                    break;
+                case OpCode::Then:
+                case OpCode::Else:
+                    values[i] = values[node.first];
+                    break;
+                case OpCode::Select:
+                {
+                    // Both branches are computed, the value is the taken one.
+                    const std::uint32_t* args{m_arguments.data() + node.first};
+                    values[i] = (values[args[0]] != 0.0) ? values[args[1]] : values[args[2]];
+                    break;
+                }
+                case OpCode::Function:
+                    values[i] = m_expression.functions()[node.index].function(values[node.first]);
+                    break;
+                case OpCode::Variadic:
+                {
+                    const Expression::Call& call{m_expression.variadics()[node.index]};
+                    for (std::uint32_t j{0}; j < call.count; ++j)
+                        m_callValues[j] = values[m_arguments[node.first + j]];
+                    values[i] = call.function(Span<const double>{m_callValues.data(), call.count});
+                    break;
+                }
+                case OpCode::Reduce:
+                    break;
+            }
+        }
+    }
+
+    void Tape::backward(double* gradient)
+    {
+        const double* values{m_values.data()};
+        double* adjoints{m_adjoints.data()};
+        std::fill(m_adjoints.begin(), m_adjoints.end(), 0.0);
+        adjoints[m_nodes.size() - 1] = 1.0;
+
+        for (std::size_t i{m_nodes.size()}; i-- > 0;)
+        {
+            const Node& node{m_nodes[i]};
+            const double adjoint{adjoints[i]};
+            if (!node.active || adjoint == 0.0)
+                continue;
+
+            switch (node.op)
+            {
+                case OpCode::Constant:
+                    break;
+                case OpCode::Variable:
+                    gradient[node.index] += adjoint;
+                    break;
+                case OpCode::Negate:
+                    adjoints[node.first] -= adjoint;
+                    break;
+                case OpCode::Add:
+                    adjoints[node.first] += adjoint;
+                    adjoints[node.second] += adjoint;
+                    break;
+                case OpCode::Subtract:
+                    adjoints[node.first] += adjoint;
+                    adjoints[node.second] -= adjoint;
+                    break;
+                case OpCode::Multiply:
+                    adjoints[node.first] += adjoint * values[node.second];
+                    adjoints[node.second] += adjoint * values[node.first];
+                    break;
+                case OpCode::Divide:
+                    adjoints[node.first] += adjoint / values[node.second];
+                    adjoints[node.second] -= adjoint * values[i] / values[node.second];
+                    break;
+                case OpCode::Power:
+                {
+                    // Same cases as pow for Dual, each term only if its
+                    // operand depends on a variable.
+                    const double a{values[node.first]}, b{values[node.second]};
+                    if (m_nodes[node.first].active && b != 0.0)
+                        adjoints[node.first] += adjoint * b * std::pow(a, b - 1.0);
+                    if (m_nodes[node.second].active && !(a == 0.0 && b > 0.0))
+                        adjoints[node.second] += adjoint * values[i] * std::log(a);
+                    break;
+                }
+                case OpCode::Less:
+                case OpCode::LessEqual:
+                case OpCode::Greater:
+                case OpCode::GreaterEqual:
+                case OpCode::Equal:
+                case OpCode::NotEqual:
+                    break;
+                case OpCode::Then:
+                case OpCode::Else:
+                    adjoints[node.first] += adjoint;
+                    break;
+                case OpCode::Select:
+                {
+                    // Only the taken branch.
+                    const std::uint32_t* args{m_arguments.data() + node.first};
+                    adjoints[(values[args[0]] != 0.0) ? args[1] : args[2]] += adjoint;
+                    break;
+                }
+                case OpCode::Function:
+                    adjoints[node.first] +=
+                        adjoint * m_derivatives[node.index](values[node.first], values[i]);
+                    break;
+                case OpCode::Variadic:
+                {
+                    const std::uint32_t count{m_expression.variadics()[node.index].count};
+                    for (std::uint32_t j{0}; j < count; ++j)
+                        m_callValues[j] = values[m_arguments[node.first + j]];
+                    m_partials[node.index](Span<const double>{m_callValues.data(), count},
+                                           values[i],
+                                           Span<double>{m_callPartials.data(), count});
+                    for (std::uint32_t j{0}; j < count; ++j)
+                        adjoints[m_arguments[node.first + j]] += adjoint * m_callPartials[j];
+                    break;
+                }
+                case OpCode::Reduce:
+                    break;
+            }
+        }
+    }
+
+    const Expression& Tape::expression() const noexcept
+    {
+        return m_expression;
+    }
+
+    std::size_t Tape::size() const noexcept
+    {
+        return m_nodes.size();
+    }
+
+} // namespace CalcEval
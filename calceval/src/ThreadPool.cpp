@@ -0,0 +1,193 @@
+//
+//  ThreadPool.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/ThreadPool.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace CalcEval
+{
+    namespace
+    {
+        // The pool and index of the worker running on this thread, used to
+        // let a worker that calls parallelFor help instead of blocking.
+        thread_local const ThreadPool* t_pool{nullptr};
+        thread_local std::size_t t_worker{0};
+
+    } // namespace
+
+    ThreadPool::ThreadPool(std::size_t threads)
+    {
+        if (threads == 0)
+            threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+        m_queues.reserve(threads);
+        for (std::size_t i{0}; i < threads; ++i)
+            m_queues.push_back(std::make_unique<Queue>());
+
+        m_threads.reserve(threads);
+        for (std::size_t i{0}; i < threads; ++i)
+            m_threads.emplace_back([this, i]() { work(i); });
+    }
+
+    ThreadPool::~ThreadPool() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+
+        for (std::thread& thread : m_threads)
+            thread.join();
+    }
+
+    ThreadPool& ThreadPool::shared()
+    {
+        static ThreadPool pool{};
+        return pool;
+    }
+
+    std::size_t ThreadPool::size() const noexcept
+    {
+        return m_threads.size();
+    }
+
+    void ThreadPool::parallelFor(std::size_t count, std::size_t grain, const body_type& body)
+    {
+        if (grain == 0)
+            throw std::invalid_argument("ThreadPool: grain must be at least 1");
+        if (count == 0)
+            return;
+
+        const std::size_t chunks{(count - 1) / grain + 1};
+        Job job{&body, {chunks}, {}, {}, nullptr, std::numeric_limits<std::size_t>::max()};
+
+        // Counted before the tasks are visible, so a worker that takes one
+        // never sees fewer pending tasks than are queued.
+        {
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            m_pending += chunks;
+        }
+
+        // Worker q gets the chunks [q*chunks/size, (q+1)*chunks/size).
+        const std::size_t workers{m_queues.size()};
+        for (std::size_t q{0}; q < workers; ++q)
+        {
+            const std::size_t first{q * chunks / workers};
+            const std::size_t last{(q + 1) * chunks / workers};
+            if (first == last)
+                continue;
+
+            Queue& queue{*m_queues[q]};
+            std::lock_guard<std::mutex> lock{queue.mutex};
+            for (std::size_t c{first}; c < last; ++c)
+                queue.tasks.push_back({&job, c * grain, std::min(count, (c + 1) * grain)});
+        }
+        m_wake.notify_all();
+
+        if (t_pool == this)
+        {
+            // A worker of this pool, run tasks of the job until it is
+            // done. Other tasks could be chunks of the job that is waiting
+            // here, with the same worker index.
+            while (job.remaining.load(std::memory_order_acquire) != 0)
+                if (!runOne(t_worker, &job))
+                    std::this_thread::yield();
+        }
+
+        // The last task may still hold the mutex after remaining is zero,
+        // the job must not be destroyed before it is released.
+        std::unique_lock<std::mutex> lock{job.mutex};
+        job.done.wait(lock, [&job]() { return job.remaining.load() == 0; });
+
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+    void ThreadPool::work(std::size_t worker)
+    {
+        t_pool = this;
+        t_worker = worker;
+
+        while (true)
+        {
+            if (runOne(worker, nullptr))
+                continue;
+
+            std::unique_lock<std::mutex> lock{m_sleepMutex};
+            m_wake.wait(lock, [this]() { return m_stop || m_pending.load() != 0; });
+            if (m_stop && m_pending.load() == 0)
+                return;
+        }
+    }
+
+    bool ThreadPool::runOne(std::size_t worker, const Job* job)
+    {
+        // Own queue from the front, other queues from the back.
+        const auto match = [job](const Task& task) { return !job || task.job == job; };
+        const std::size_t workers{m_queues.size()};
+        for (std::size_t k{0}; k < workers; ++k)
+        {
+            Queue& queue{*m_queues[(worker + k) % workers]};
+            std::unique_lock<std::mutex> lock{queue.mutex};
+            Task task{};
+            if (k == 0)
+            {
+                const auto it{std::find_if(queue.tasks.begin(), queue.tasks.end(), match)};
+                if (it == queue.tasks.end())
+                    continue;
+                task = *it;
+                queue.tasks.erase(it);
+            }
+            else
+            {
+                const auto it{std::find_if(queue.tasks.rbegin(), queue.tasks.rend(), match)};
+                if (it == queue.tasks.rend())
+                    continue;
+                task = *it;
+                queue.tasks.erase(std::next(it).base());
+            }
+            lock.unlock();
+
+            m_pending.fetch_sub(1);
+            execute(task, worker);
+            return true;
+        }
+
+        return false;
+    }
+
+    void ThreadPool::execute(const Task& task, std::size_t worker)
+    {
+        Job& job{*task.job};
+        std::exception_ptr error{};
+        try
+        {
+            (*job.body)(task.begin, task.end, worker);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock{job.mutex};
+        if (error && task.begin < job.errorBegin)
+        {
+            job.error = error;
+            job.errorBegin = task.begin;
+        }
+        if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            job.done.notify_all();
+    }
+
+} // namespace CalcEval
@@ -0,0 +1,280 @@
+//
+//  tests/BatchTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Expression.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/StaticTable.hpp"
+#include "calceval/Sweep.hpp"
+#include "calceval/type/Base.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool identical(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+// Columns for x and y with some special values.
+static std::vector<std::vector<double>> makeColumns(std::size_t rows)
+{
+    std::mt19937_64 rng{42};
+    std::uniform_real_distribution<double> dist{-4.0, 4.0};
+    std::vector<std::vector<double>> columns(2, std::vector<double>(rows));
+    for (std::size_t i{0}; i < rows; ++i)
+    {
+        columns[0][i] = dist(rng);
+        columns[1][i] = (i % 97 == 0) ? 0.0 : dist(rng);
+    }
+    return columns;
+}
+
+static void requireIdentical(const CalcEval::Expression& expression,
+                             const std::vector<std::vector<double>>& columns)
+{
+    const std::size_t rows{columns[0].size()};
+    std::vector<double> results(rows);
+    const std::vector<CalcEval::Span<const double>> spans{columns[0], columns[1]};
+    expression.evaluateBatch(spans, results);
+
+    for (std::size_t i{0}; i < rows; ++i)
+    {
+        const std::vector<double> row{columns[0][i], columns[1][i]};
+        const double expected{expression.evaluate(row)};
+        if (!identical(results[i], expected))
+        {
+            INFO("row " << i);
+            REQUIRE(results[i] == expected);
+        }
+    }
+}
+
+TEST_CASE("Batch is identical to evaluate")
+{
+    const CalcEval::Compiler compiler{};
+    for (const std::string str :
+         {"x", "y", "2.5", "-x", "-(2*3)", "x+y", "x-y*2", "2/y", "x/y", "x^2", "2^x", "x^y",
+          "-x^-y", "(x+1)*(y-1)/(x*y+3)", "sin(x)*cos(y)+exp(x/4)-log(y)+log10(x*x)",
+          "tan(x)+arcsin(x/4)-arccos(y/4)+arctan(x*y)", "sin(1)+x", "pi*e*x",
+          "max(x, y, 0)+min(x, 1)-mean(x, y, 2)", "sum(1, 2, 3)*x", "hypot(x, y, 1)",
+          "atan2(y, x)", "max(1, 2)", "1/0+x", "((((x+1)*2+3)*4+5)*6+7)*(y-((1-x)*(2-y)))"})
+    {
+        INFO(str);
+        const CalcEval::Expression expression{compiler.compile(str, {"x", "y"})};
+
+        // Sizes around the block size and the SIMD width.
+        const std::size_t block{expression.blockSize()};
+        for (const std::size_t rows : {std::size_t{1}, std::size_t{7}, block - 1, block,
+                                       3 * block + 5})
+            requireIdentical(expression, makeColumns(rows));
+    }
+}
+
+TEST_CASE("Batch with symbols and fast functions")
+{
+    CalcEval::Registry<double> registry{};
+    registry.addFunction("half", [](double v) { return v / 2.0; });
+    const CalcEval::Compiler compiler{registry.freeze()};
+    const CalcEval::Expression expression{compiler.compile("half(x)+sin(y)", {"x", "y"})};
+    REQUIRE(expression.functions()[0].batch == nullptr);
+    REQUIRE(expression.functions()[1].batch != nullptr);
+
+    const std::vector<std::vector<double>> columns{makeColumns(1000)};
+    requireIdentical(expression, columns);
+
+    // Fast kernels are within 1 ULP.
+    const std::vector<CalcEval::Span<const double>> spans{columns[0], columns[1]};
+    std::vector<double> results(1000);
+    expression.evaluateBatch(spans, results, CalcEval::Kernel::Accuracy::Fast);
+    for (std::size_t i{0}; i < results.size(); ++i)
+    {
+        const double expected{columns[0][i] / 2.0 + std::sin(columns[1][i])};
+        REQUIRE(std::fabs(results[i] - expected) <= 1e-14);
+    }
+}
+
+TEST_CASE("Batch errors")
+{
+    const CalcEval::Expression expression{CalcEval::Compiler{}.compile("x+y", {"x", "y"})};
+    const std::vector<double> x(10), y(9);
+    std::vector<double> results(10);
+
+    const std::vector<CalcEval::Span<const double>> one{x};
+    REQUIRE_THROWS_AS(expression.evaluateBatch(one, results), std::invalid_argument);
+    const std::vector<CalcEval::Span<const double>> sizes{x, y};
+    REQUIRE_THROWS_AS(expression.evaluateBatch(sizes, results), std::invalid_argument);
+
+    // No rows is not an error.
+    expression.evaluateBatch(std::vector<CalcEval::Span<const double>>{{}, {}}, {});
+}
+
+TEST_CASE("Batch with a single value")
+{
+    const CalcEval::Expression expression{
+        CalcEval::Compiler{}.compile("x*y+sin(y)-max(x,y)", {"x", "y"})};
+    std::vector<double> x(1000);
+    for (std::size_t i{0}; i < x.size(); ++i)
+        x[i] = 0.01 * static_cast<double>(i) - 5.0;
+    const std::vector<double> y{0.75};
+
+    // The same as a full column with the value in every row.
+    const std::vector<double> full(x.size(), y[0]);
+    std::vector<double> results(x.size()), expected(x.size());
+    expression.evaluateBatch(std::vector<CalcEval::Span<const double>>{x, y}, results);
+    expression.evaluateBatch(std::vector<CalcEval::Span<const double>>{x, full}, expected);
+    REQUIRE(results == expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Counts the calls of its vectorized function and operators.
+struct Counting : public CalcEval::Type::Base<double>
+{
+    static inline std::size_t functionCalls{0};
+    static inline std::size_t operatorCalls{0};
+
+    [[nodiscard]] double stot(const std::string& str) noexcept
+    {
+        return std::stod(str);
+    }
+
+    [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept
+    {
+        static constexpr auto funcs = CalcEval::makeStaticTable<func_type>(
+            std::pair{"twice", [](double x) { return 2.0 * x; }},
+            std::pair{"cube", [](double x) { return x * x * x; }});
+
+        return funcs.find(str);
+    }
+
+    [[nodiscard]] std::optional<CalcEval::Kernel::func_type>
+    batchFunction(const std::string& str) noexcept
+    {
+        if (str != "twice")
+            return std::nullopt;
+
+        return [](CalcEval::Span<const double> values, CalcEval::Span<double> results,
+                  CalcEval::Kernel::Accuracy) {
+            ++functionCalls;
+            for (std::size_t i{0}; i < values.size(); ++i)
+                results[i] = 2.0 * values[i];
+        };
+    }
+
+    [[nodiscard]] std::optional<CalcEval::Kernel::binary_type> batchOperator(char op) noexcept
+    {
+        if (op == '*')
+            return [](CalcEval::Span<const double> a, CalcEval::Span<const double> b,
+                      CalcEval::Span<double> results, CalcEval::Kernel::Accuracy) {
+                ++operatorCalls;
+                for (std::size_t i{0}; i < results.size(); ++i)
+                    results[i] = a[i] * b[i];
+            };
+        if (op == '^')
+            return [](CalcEval::Span<const double> a, CalcEval::Span<const double> b,
+                      CalcEval::Span<double> results, CalcEval::Kernel::Accuracy) {
+                ++operatorCalls;
+                for (std::size_t i{0}; i < results.size(); ++i)
+                    results[i] = std::pow(a[i], b[i]);
+            };
+
+        return std::nullopt;
+    }
+};
+
+static_assert(CalcEval::Type::isCalcType<Counting>);
+static_assert(CalcEval::Type::hasBatchFunction<Counting>);
+static_assert(CalcEval::Type::hasBatchOperator<Counting>);
+static_assert(!CalcEval::Type::hasBatchOperator<CalcEval::Type::Standard>);
+
+TEST_CASE("Batch hooks of the type")
+{
+    const CalcEval::Compiler<Counting> compiler{};
+    const CalcEval::Expression expression{
+        compiler.compile("twice(x)*y + cube(x)^2 - x/y", {"x", "y"})};
+    REQUIRE(expression.batchOperator(CalcEval::OpCode::Multiply) != nullptr);
+    REQUIRE(expression.batchOperator(CalcEval::OpCode::Power) != nullptr);
+    REQUIRE(expression.batchOperator(CalcEval::OpCode::Add) == nullptr);
+    REQUIRE(expression.functions()[0].batch != nullptr);
+    REQUIRE(expression.functions()[1].batch == nullptr);
+
+    SECTION("Identical to evaluate")
+    {
+        const std::size_t block{expression.blockSize()};
+        for (const std::size_t rows : {std::size_t{1}, block, 3 * block + 5})
+            requireIdentical(expression, makeColumns(rows));
+    }
+
+    SECTION("Called once per block")
+    {
+        const std::size_t block{expression.blockSize()};
+        const std::vector<std::vector<double>> columns{makeColumns(4 * block)};
+        const std::vector<CalcEval::Span<const double>> spans{columns[0], columns[1]};
+        std::vector<double> results(4 * block);
+
+        Counting::functionCalls = 0;
+        Counting::operatorCalls = 0;
+        expression.evaluateBatch(spans, results);
+        REQUIRE(Counting::functionCalls == 4);
+        REQUIRE(Counting::operatorCalls == 8);
+
+        // A single value operand is repeated for the hook.
+        const std::vector<double> y{0.5};
+        const std::vector<double> full(4 * block, 0.5);
+        std::vector<double> expected(4 * block);
+        expression.evaluateBatch(std::vector<CalcEval::Span<const double>>{columns[0], y}, results);
+        expression.evaluateBatch(std::vector<CalcEval::Span<const double>>{columns[0], full},
+                                 expected);
+        REQUIRE(results == expected);
+    }
+
+    SECTION("Sweep")
+    {
+        const std::vector<CalcEval::Sweep::Axis> axes{CalcEval::Sweep::Axis::parse("x=1:1:3"),
+                                                      CalcEval::Sweep::Axis::parse("y=1:0.5:40")};
+        const CalcEval::Sweep sweep{expression, axes};
+        Counting::operatorCalls = 0;
+        sweep.run([&](const CalcEval::Sweep::Block& block) {
+            for (std::size_t i{0}; i < block.results.size(); ++i)
+                REQUIRE(block.results[i] ==
+                        expression.evaluate(std::vector<double>{block.outer[0], block.inner[i]}));
+        });
+        REQUIRE(Counting::operatorCalls > 0);
+    }
+}
+
+TEST_CASE("Batch operators")
+{
+    CalcEval::Expression expression{std::vector<std::string>{"x"}};
+    REQUIRE_THROWS_AS(expression.setBatchOperator(CalcEval::OpCode::Negate, nullptr),
+                      std::invalid_argument);
+
+    // Set and removed again, an Expression without hooks runs the built-in code.
+    const CalcEval::Kernel::binary_type subtract{
+        [](CalcEval::Span<const double> a, CalcEval::Span<const double> b,
+           CalcEval::Span<double> results, CalcEval::Kernel::Accuracy) {
+            for (std::size_t i{0}; i < results.size(); ++i)
+                results[i] = a[i] - b[i];
+        }};
+    expression.setBatchOperator(CalcEval::OpCode::Subtract, subtract);
+    REQUIRE(expression.batchOperator(CalcEval::OpCode::Subtract) == subtract);
+    expression.setBatchOperator(CalcEval::OpCode::Subtract, nullptr);
+    REQUIRE(expression.batchOperator(CalcEval::OpCode::Subtract) == nullptr);
+}
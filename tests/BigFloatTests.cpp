@@ -0,0 +1,199 @@
+//
+//  tests/BigFloatTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/BigFloat.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/type/BigFloat.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using CalcEval::BigFloat;
+
+static_assert(CalcEval::Type::isCalcType<CalcEval::Type::BigFloat<>>);
+static_assert(CalcEval::Type::hasPower<CalcEval::Type::BigFloat<>>);
+static_assert(
+    std::is_same_v<decltype(std::declval<CalcEval::Parser<CalcEval::Type::BigFloat<>>>().parse("")),
+                   BigFloat>);
+
+template<std::uint32_t Precision = 128>
+static std::string parse(const std::string& str, std::size_t digits)
+{
+    return CalcEval::Parser<CalcEval::Type::BigFloat<Precision>>{}.parse(str).toString(digits);
+}
+
+// 100 digits of the constants.
+static const std::string pi100{
+    "3.141592653589793238462643383279502884197169399375105820974944592307816406286208998628"
+    "034825342117068"};
+static const std::string e100{
+    "2.718281828459045235360287471352662497757247093699959574966967627724076630353547594571"
+    "382178525166427"};
+
+TEST_CASE("BigFloat construction")
+{
+    REQUIRE(BigFloat{}.isZero());
+    REQUIRE(BigFloat{0}.toString() == "0");
+    REQUIRE(BigFloat{42}.toString() == "42");
+    REQUIRE(BigFloat{-7}.toString() == "-7");
+    REQUIRE(BigFloat{std::numeric_limits<std::int64_t>::min()}.toInt64() ==
+            std::numeric_limits<std::int64_t>::min());
+    REQUIRE(BigFloat::fromDouble(0.1).toDouble() == 0.1);
+    REQUIRE(BigFloat::fromDouble(-1.5e-300).toDouble() == -1.5e-300);
+    REQUIRE(BigFloat::fromString("0.1", 53).toDouble() == 0.1);
+    REQUIRE(BigFloat::fromString("123.456e2").toString() == "12345.6");
+    REQUIRE(BigFloat::fromString("1.5e-7").toString(5) == "1.5e-07");
+    REQUIRE(BigFloat::fromString("2.5e40").toString(5) == "2.5e+40");
+
+    REQUIRE_THROWS_AS(BigFloat::fromDouble(std::nan("")), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(BigFloat::fromString("1.2.3"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(BigFloat::fromString("1e"), CalcEval::ArithmeticError);
+}
+
+TEST_CASE("BigFloat small values are inline")
+{
+    REQUIRE(BigFloat{123456789}.isInline());
+    REQUIRE(BigFloat::fromString("0.1", 128).isInline());
+    REQUIRE(BigFloat::fromString("0.1", 192).isInline());
+    REQUIRE(BigFloat::fromString("3", 4096).isInline());
+    REQUIRE_FALSE(BigFloat::fromString("0.1", 4096).isInline());
+
+    const BigFloat a{BigFloat::fromString("1.1")}, b{BigFloat::fromString("2.3")};
+    REQUIRE((a * b).isInline());
+    REQUIRE((a / b).isInline());
+    REQUIRE((a + b).isInline());
+}
+
+TEST_CASE("BigFloat arithmetic")
+{
+    SECTION("Exact decimal results")
+    {
+        REQUIRE(parse("0.1+0.2", 30) == "0.3");
+        REQUIRE(parse("1/3", 30) == "0.333333333333333333333333333333");
+        REQUIRE(parse("2/3", 10) == "0.6666666667");
+        REQUIRE(parse("-2^2", 10) == "-4");
+        REQUIRE(parse("2^-1", 10) == "0.5");
+        REQUIRE(parse("1-1", 10) == "0");
+        REQUIRE(parse<256>("1.000000000000000000000000000001-1", 10) == "1e-30");
+    }
+
+    SECTION("Beyond double precision")
+    {
+        // 2^64 + 1 and 3^80 are not representable as doubles.
+        REQUIRE(parse("2^64+1", 25) == "18446744073709551617");
+        REQUIRE(parse<256>("3^80", 60) == "147808829414345923316083210206383297601");
+        REQUIRE(parse("12345678901234567890*98765432109876543210", 40) ==
+                "1219326311370217952237463801111263526900");
+    }
+
+    SECTION("Division by zero")
+    {
+        REQUIRE_THROWS_AS(parse("1/0", 10), CalcEval::ArithmeticError);
+        REQUIRE_THROWS_AS(parse("0^-1", 10), CalcEval::ArithmeticError);
+        REQUIRE_THROWS_AS(parse("(-2)^0.5", 10), CalcEval::ArithmeticError);
+    }
+
+    SECTION("Rounding is to nearest even")
+    {
+        const BigFloat one{BigFloat{1}.withPrecision(4)};
+        REQUIRE((BigFloat{17} * one).toInt64() == 16);
+        REQUIRE((BigFloat{19} * one).toInt64() == 20);
+        REQUIRE((BigFloat{25} * one).toInt64() == 24);
+        REQUIRE((BigFloat{27} * one).toInt64() == 28);
+    }
+
+    SECTION("Comparison")
+    {
+        const BigFloat a{BigFloat::fromString("0.1")}, b{BigFloat::fromString("0.2")};
+        REQUIRE(a < b);
+        REQUIRE(-b < -a);
+        REQUIRE(a + a == b);
+        REQUIRE(a != b);
+        REQUIRE(BigFloat{} == -BigFloat{});
+    }
+}
+
+TEST_CASE("BigFloat long multiplication and division")
+{
+    // (10^n + 1) * (10^n - 1) = 10^2n - 1 exercises Karatsuba for long mantissas.
+    for (const std::uint32_t precision : {256u, 2048u, 8192u})
+    {
+        INFO(precision);
+        const std::int64_t n{static_cast<std::int64_t>(precision * 3 / 20)};
+        const BigFloat ten{BigFloat{10}.withPrecision(precision)};
+        const BigFloat power{BigFloat::pow(ten, BigFloat{n})};
+        const BigFloat product{(power + BigFloat{1}) * (power - BigFloat{1})};
+        REQUIRE(product == BigFloat::pow(ten, BigFloat{2 * n}) - BigFloat{1});
+
+        const BigFloat third{BigFloat{1}.withPrecision(precision) / BigFloat{3}};
+        REQUIRE(third * BigFloat{3} == BigFloat{1});
+        REQUIRE((product / (power - BigFloat{1})) == power + BigFloat{1});
+    }
+}
+
+TEST_CASE("BigFloat functions")
+{
+    SECTION("Constants")
+    {
+        REQUIRE(parse<340>("pi", 100) == pi100);
+        REQUIRE(parse<340>("e", 100) == e100);
+        REQUIRE(parse<340>("exp(1)", 100) == e100);
+        REQUIRE(BigFloat::pi(53).toDouble() == M_PI);
+    }
+
+    SECTION("Agree with double")
+    {
+        for (const double x : {0.001, 0.5, 1.0, 2.0, 3.0, 10.0, 100.0, 12345.678})
+        {
+            const BigFloat big{BigFloat::fromDouble(x).withPrecision(128)};
+            INFO(x);
+            REQUIRE(std::fabs(BigFloat::exp(-big).toDouble() - std::exp(-x)) <=
+                    1e-15 * std::exp(-x));
+            REQUIRE(std::fabs(BigFloat::log(big).toDouble() - std::log(x)) <= 1e-15);
+            REQUIRE(std::fabs(BigFloat::sin(big).toDouble() - std::sin(x)) <= 1e-15);
+            REQUIRE(std::fabs(BigFloat::cos(big).toDouble() - std::cos(x)) <= 1e-15);
+            REQUIRE(std::fabs(BigFloat::sqrt(big).toDouble() - std::sqrt(x)) <=
+                    1e-15 * std::sqrt(x));
+        }
+    }
+
+    SECTION("Known values")
+    {
+        REQUIRE(parse<200>("log(2)", 50) == "0.69314718055994530941723212145817656807550013436026");
+        REQUIRE(parse<200>("log10(1000)", 50) == "3");
+        REQUIRE(parse<200>("sqrt(2)", 50) == "1.4142135623730950488016887242096980785696718753769");
+        REQUIRE(parse<200>("sin(pi/6)", 50) == "0.5");
+        REQUIRE(parse<200>("cos(pi/3)", 50) == "0.5");
+        REQUIRE(parse<200>("tan(pi/4)", 50) == "1");
+        REQUIRE(parse<200>("sin(1e6)", 40) == "-0.3499935021712929521176524867807714690614");
+        REQUIRE(parse<200>("2^0.5", 50) == parse<200>("sqrt(2)", 50));
+        REQUIRE(parse<200>("exp(log(123.456))", 40) == "123.456");
+    }
+
+    SECTION("Precision is kept close to 1")
+    {
+        // 1 + 2^-80 is exact, so is the subtraction in log.
+        REQUIRE(parse("log(1+2^-80)", 22) == "8.271806125530276748714e-25");
+    }
+
+    SECTION("Errors")
+    {
+        REQUIRE_THROWS_AS(parse("log(0)", 10), CalcEval::ArithmeticError);
+        REQUIRE_THROWS_AS(parse("log(-1)", 10), CalcEval::ArithmeticError);
+        REQUIRE_THROWS_AS(parse("sqrt(-1)", 10), CalcEval::ArithmeticError);
+        REQUIRE_THROWS_AS(parse("exp(10^13)", 10), CalcEval::ArithmeticError);
+        REQUIRE(parse("exp(-10^13)", 10) == "0");
+    }
+}
@@ -0,0 +1,267 @@
+//
+//  tests/ConditionTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ParallelExpression.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Sweep.hpp"
+#include "calceval/Tape.hpp"
+#include "calceval/ThreadPool.hpp"
+#include "calceval/type/BigFloat.hpp"
+#include "calceval/type/Dual.hpp"
+#include "calceval/type/Int64.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Comparisons and logic")
+{
+    const CalcEval::Parser<> parser{};
+    const CalcEval::Compiler<> compiler{};
+
+    // Parsed and compiled give the same bits, or both NaN.
+    const auto same = [&](const std::string& str) {
+        const double value{parser.parse(str)};
+        const double compiled{compiler.compile(str).evaluate()};
+        REQUIRE((compiled == value || (std::isnan(compiled) && std::isnan(value))));
+        return value;
+    };
+
+    SECTION("Relations")
+    {
+        REQUIRE(same("1 < 2") == 1.0);
+        REQUIRE(same("2 < 2") == 0.0);
+        REQUIRE(same("2 <= 2") == 1.0);
+        REQUIRE(same("3 > 2") == 1.0);
+        REQUIRE(same("2 >= 3") == 0.0);
+        REQUIRE(same("2 == 2") == 1.0);
+        REQUIRE(same("2 != 2") == 0.0);
+        REQUIRE(same("1 + 1 == 2*1") == 1.0);
+        REQUIRE(same("-1 < 0") == 1.0);
+    }
+
+    SECTION("NaN")
+    {
+        // Only != is true for NaN, and NaN is a true condition.
+        for (const char* relation : {"<", "<=", ">", ">=", "=="})
+            REQUIRE(same(std::string{"0/0 "} + relation + " 1") == 0.0);
+        REQUIRE(same("0/0 != 0/0") == 1.0);
+        REQUIRE(same("if(0/0, 1, 2)") == 1.0);
+        REQUIRE(same("not 0/0") == 0.0);
+    }
+
+    SECTION("and, or and not")
+    {
+        REQUIRE(same("1 and 2") == 1.0);
+        REQUIRE(same("1 and 0") == 0.0);
+        REQUIRE(same("0 or 0") == 0.0);
+        REQUIRE(same("0 or 5") == 1.0);
+        REQUIRE(same("not 0") == 1.0);
+        REQUIRE(same("not not 3") == 1.0);
+
+        // not binds tighter than and, which binds tighter than or.
+        REQUIRE(same("1 or 1 and 0") == 1.0);
+        REQUIRE(same("(1 or 1) and 0") == 0.0);
+        REQUIRE(same("not 1 or 1") == 1.0);
+        REQUIRE(same("not 1 < 0") == 1.0);
+        REQUIRE(same("1 < 2 and 2 < 3 or 0") == 1.0);
+    }
+
+    SECTION("if")
+    {
+        REQUIRE(same("if(1, 2, 3)") == 2.0);
+        REQUIRE(same("if(0, 2, 3)") == 3.0);
+        REQUIRE(same("1 + if(2 > 1, 10, 20)*2") == 21.0);
+        REQUIRE(same("if(0, 1, if(1, 2, 3))") == 2.0);
+        REQUIRE(same("if(if(1, 0, 1), 4, 5)^2") == 25.0);
+        REQUIRE(same("sum(i = 1, 10, if(i < 5, i, 0))") == 10.0);
+        REQUIRE(same("max(if(1, 1, 2), 0)") == 1.0);
+    }
+
+    SECTION("Errors")
+    {
+        const std::vector<std::string> errors{"if(1, 2)", "if(1, 2, 3",     "if 1",  "1 < ",
+                                              "and",      "if(1 2, 3)",     "1 and", "not",
+                                              "1 = 2",    "if(1, 2, 3, 4)", "1 ! 2"};
+        for (const std::string& str : errors)
+        {
+            REQUIRE_THROWS(parser.parse(str));
+            REQUIRE_THROWS(compiler.compile(str));
+        }
+    }
+
+    SECTION("Keywords are not names")
+    {
+        REQUIRE_THROWS_AS(parser.parse("sum(if = 1, 2, 1)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(compiler.compile("sum(and = 1, 2, 1)"), CalcEval::ParserError);
+    }
+}
+
+TEST_CASE("Short-circuit")
+{
+    // 1/0 throws for Int64, the branch that is not taken is not computed.
+    const CalcEval::Parser<CalcEval::Type::Int64> int64{};
+    REQUIRE(int64.parse("if(0, 1/0, 5)") == 5);
+    REQUIRE(int64.parse("if(1, 5, 1/0)") == 5);
+    REQUIRE(int64.parse("0 and 1/0") == 0);
+    REQUIRE(int64.parse("1 or 1/0") == 1);
+    REQUIRE(int64.parse("if(0, sum(i = 1, 3, i/0), 7)") == 7);
+    REQUIRE(int64.parse("3 > 2 and 10/2 == 5") == 1);
+    REQUIRE_THROWS(int64.parse("if(1, 1/0, 5)"));
+    REQUIRE_THROWS(int64.parse("1 and 1/0"));
+
+    // Errors in the skipped branch are still errors.
+    REQUIRE_THROWS_AS(int64.parse("if(0, 1 +, 5)"), CalcEval::ParserError);
+    REQUIRE_THROWS_AS(int64.parse("if(0, nosuch(1), 5)"), CalcEval::ParserError);
+
+    // In compiled code only the taken branch is run by evaluate.
+    const CalcEval::Compiler<> compiler{};
+    const CalcEval::Expression expression{compiler.compile("if(x > 0, log(x), 0)", {"x"})};
+    REQUIRE(expression.evaluate(std::vector<double>{-1.0}) == 0.0);
+    REQUIRE(expression.evaluate(std::vector<double>{1.0}) == 0.0);
+    REQUIRE(expression.evaluate(std::vector<double>{std::exp(2.0)}) == 2.0);
+
+    // NaN > 0 is false.
+    REQUIRE(expression.evaluate(std::vector<double>{NAN}) == 0.0);
+}
+
+TEST_CASE("Comparisons of other types")
+{
+    const CalcEval::Parser<CalcEval::Type::BigFloat<>> bigFloat{};
+    REQUIRE(bigFloat.parse("if(1/3 < 0.34, 1, 2)").toString() == "1");
+    REQUIRE(bigFloat.parse("2 >= 2 and 1 != 2").toString() == "1");
+    REQUIRE(bigFloat.parse("1/3 == 0.3333333333333333").toString() == "0");
+
+    // Dual has no ordering, the relations are unexpected tokens and the
+    // keywords unknown names.
+    const CalcEval::Parser<CalcEval::Type::Dual<1>> dual{};
+    REQUIRE_THROWS_AS(dual.parse("1 < 2"), CalcEval::ParserError);
+    REQUIRE_THROWS_AS(dual.parse("if(1, 2, 3)"), CalcEval::ParserError);
+    REQUIRE_THROWS_AS(dual.parse("1 and 2"), CalcEval::ParserError);
+}
+
+TEST_CASE("Compiled conditions")
+{
+    const CalcEval::Compiler<> compiler{};
+    const CalcEval::Expression expression{compiler.compile(
+        "if(x < 0, -x, if(x < 1 and y >= 0, x*y, exp(x) - y)) + (x == y or not y)",
+        {"x", "y"})};
+
+    std::vector<double> x{}, y{};
+    for (int i{-20}; i <= 20; ++i)
+    {
+        for (int j{-3}; j <= 3; ++j)
+        {
+            x.push_back(0.1 * i);
+            y.push_back(0.5 * j);
+        }
+    }
+    x.push_back(NAN);
+    y.push_back(1.0);
+    x.push_back(0.5);
+    y.push_back(NAN);
+
+    const auto same = [](double a, double b) {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    };
+
+    SECTION("Batch")
+    {
+        // Both branches run with a mask, the values are the same.
+        const std::vector<CalcEval::Span<const double>> columns{x, y};
+        std::vector<double> results(x.size());
+        expression.evaluateBatch(columns, results);
+        for (std::size_t i{0}; i < x.size(); ++i)
+            REQUIRE(same(results[i], expression.evaluate(std::vector<double>{x[i], y[i]})));
+
+        // A single value condition takes one branch for the whole block.
+        const std::vector<double> zero{0.0};
+        const std::vector<CalcEval::Span<const double>> uniform{zero, y};
+        expression.evaluateBatch(uniform, results);
+        for (std::size_t i{0}; i < x.size(); ++i)
+            REQUIRE(same(results[i], expression.evaluate(std::vector<double>{0.0, y[i]})));
+    }
+
+    SECTION("Tape")
+    {
+        // The derivative of the branch that is taken.
+        CalcEval::Tape tape{compiler.compile("if(x < 1, x*y, y^2) + (x > y)", {"x", "y"})};
+        std::vector<double> gradient(2);
+        REQUIRE(tape.gradient(std::vector<double>{0.5, 3.0}, gradient) == 1.5);
+        REQUIRE(gradient == std::vector<double>{3.0, 0.5});
+        REQUIRE(tape.gradient(std::vector<double>{2.0, 3.0}, gradient) == 9.0);
+        REQUIRE(gradient == std::vector<double>{0.0, 6.0});
+    }
+
+    SECTION("ParallelExpression")
+    {
+        std::string str{"0"};
+        for (int i{0}; i < 50; ++i)
+            str += " + if(x > " + std::to_string(i) + ", x*" + std::to_string(i) + ", y)";
+
+        const CalcEval::Expression large{compiler.compile(str, {"x", "y"})};
+        CalcEval::ThreadPool pool{4};
+        const CalcEval::ParallelExpression parallel{large, 4};
+        REQUIRE(parallel.splitCount() > 0);
+        for (std::size_t i{0}; i < x.size(); i += 7)
+        {
+            const std::vector<double> values{10.0 * x[i], y[i]};
+            REQUIRE(same(parallel.evaluate(pool, values), large.evaluate(values)));
+        }
+    }
+
+    SECTION("Sweep")
+    {
+        // The condition on the outer axis is hoisted, the Select is not.
+        const CalcEval::Expression swept{
+            compiler.compile("if(a > 1, exp(a)*x, x - a) + if(x > a, 1, 2)", {"a", "x"})};
+        const std::vector<CalcEval::Sweep::Axis> axes{CalcEval::Sweep::Axis::parse("a=0:0.5:3"),
+                                                      CalcEval::Sweep::Axis::parse("x=0:0.25:4")};
+        const CalcEval::Sweep sweep{swept, axes};
+        REQUIRE(sweep.hoistedCount() > 0);
+        sweep.run([&](const CalcEval::Sweep::Block& block) {
+            for (std::size_t i{0}; i < block.results.size(); ++i)
+                REQUIRE(block.results[i] ==
+                        swept.evaluate(std::vector<double>{block.outer[0], block.inner[i]}));
+        });
+    }
+}
+
+TEST_CASE("Expression code for if")
+{
+    // The operands of a Select must end with Then and Else.
+    CalcEval::Expression markers{std::vector<std::string>{"x"}};
+    markers.pushVariable(0);
+    markers.pushConstant(1.0);
+    markers.pushConstant(2.0);
+    REQUIRE_THROWS_AS(markers.pushOperator(CalcEval::OpCode::Select), std::invalid_argument);
+
+    // c, Then, a, Else, b, Select.
+    CalcEval::Expression code{std::vector<std::string>{"x"}};
+    code.pushVariable(0);
+    code.pushOperator(CalcEval::OpCode::Then);
+    code.pushConstant(2.0);
+    REQUIRE_FALSE(code.complete());
+    code.pushOperator(CalcEval::OpCode::Else);
+    code.pushConstant(3.0);
+    REQUIRE_FALSE(code.complete());
+    code.pushOperator(CalcEval::OpCode::Select);
+    REQUIRE(code.complete());
+    REQUIRE(code.code()[1].index == 2);
+    REQUIRE(code.code()[3].index == 2);
+    REQUIRE(code.evaluate(std::vector<double>{1.0}) == 2.0);
+    REQUIRE(code.evaluate(std::vector<double>{0.0}) == 3.0);
+}
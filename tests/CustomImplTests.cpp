@@ -6,13 +6,19 @@
 //
 
 // Local Headers
+#include "calceval/Compiler.hpp"
 #include "calceval/Parser.hpp"
+#include "calceval/StaticTable.hpp"
+#include "calceval/type/Standard.hpp"
 
 // Catch2 Headers
 #include "catch2/catch_approx.hpp"
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_exception.hpp"
 
+// C++ Headers
+#include <algorithm>
+
 ///////////////////////////////////////////////////////////////////////////////
 
     struct CustomImpl : public CalcEval::Type::Base<double>
@@ -32,23 +38,45 @@
             return std::nullopt;
         }
 
-        [[nodiscard]] std::optional<std::function<double(double)>> function(const std::string& str) noexcept
+        [[nodiscard]] std::optional<func_type> function(const std::string& str) noexcept
         {
-            const std::map<std::string_view, std::function<double(double)>> funcs {
+            static constexpr auto funcs = CalcEval::makeStaticTable<func_type>(
                 std::pair{"log", [](double x) { return std::log(x); }},
                 std::pair{"exp", [](double x) { return std::exp(x); }},
-                std::pair{"div10", [](double x) { return x / 10.0; }}
-            };
-
-            const auto search = funcs.find(str);
+                std::pair{"div10", [](double x) { return x / 10.0; }});
 
-            if (search != funcs.cend())
-                return search->second;
-
-            return std::nullopt;
+            return funcs.find(str);
         }
     };
 
+// Types are dispatched statically, there is no vtable involved.
+static_assert(CalcEval::Type::isCalcType<CustomImpl>);
+static_assert(!std::is_polymorphic_v<CustomImpl>);
+static_assert(!std::is_polymorphic_v<CalcEval::Type::Standard>);
+
+// A type without stot is not a CalcType.
+struct MissingStot : public CalcEval::Type::Base<double>
+{
+};
+static_assert(!CalcEval::Type::isCalcType<MissingStot>);
+
+// No vectorized functions or operators, evaluateBatch uses the scalar ones.
+static_assert(!CalcEval::Type::hasBatchFunction<CustomImpl>);
+static_assert(!CalcEval::Type::hasBatchOperator<CustomImpl>);
+
+// Caps the result of + at 10, the compiled code would use the built-in +.
+struct Saturating : public CalcEval::Type::Standard
+{
+    [[nodiscard]] double add(double lhs, double rhs) const noexcept
+    {
+        return std::min(lhs + rhs, 10.0);
+    }
+};
+static_assert(CalcEval::Type::hasAdd<Saturating>);
+static_assert(CalcEval::Type::isCompilable<CustomImpl>);
+static_assert(CalcEval::Type::isCompilable<CalcEval::Type::Standard>);
+static_assert(!CalcEval::Type::isCompilable<Saturating>);
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static double parse(const std::string& expr)
@@ -72,3 +100,40 @@ TEST_CASE("Constants")
         REQUIRE(parse("pi") == Catch::Approx(3.14159265));
     }
 }
+
+TEST_CASE("Functions")
+{
+    SECTION("Exists")
+    {
+        REQUIRE(parse("log(10)") == Catch::Approx(2.302585093));
+        REQUIRE(parse("exp(1)") == Catch::Approx(2.7182818285));
+        REQUIRE(parse("div10(25)") == Catch::Approx(2.5));
+    }
+
+    SECTION("Does not exist")
+    {
+        REQUIRE_THROWS_AS(parse("sin(1)"), CalcEval::ParserError);
+    }
+}
+
+TEST_CASE("Operators")
+{
+    const CalcEval::Parser<Saturating> parser{};
+    REQUIRE(parser.parse("8+8") == 10.0);
+    REQUIRE(parser.parse("8*8") == 64.0);
+    REQUIRE(parser.parse("sum(i = 1, 5, i)") == 10.0);
+}
+
+TEST_CASE("Compiled")
+{
+    const CalcEval::Compiler<CustomImpl> compiler{};
+    const CalcEval::Expression expression{compiler.compile("div10(x)^2 + exp(x)*pi", {"x"})};
+
+    std::vector<double> x(300);
+    for (std::size_t i{0}; i < x.size(); ++i)
+        x[i] = 0.1 * static_cast<double>(i);
+    std::vector<double> results(x.size());
+    expression.evaluateBatch(std::vector<CalcEval::Span<const double>>{x}, results);
+    for (std::size_t i{0}; i < x.size(); ++i)
+        REQUIRE(results[i] == expression.evaluate(std::vector<double>{x[i]}));
+}
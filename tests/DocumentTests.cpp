@@ -0,0 +1,402 @@
+//
+//  tests/DocumentTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Document.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    using Lines = std::vector<std::size_t>;
+
+    Lines lines(const std::vector<CalcEval::Document::Result>& results)
+    {
+        Lines result{};
+        for (const auto& r : results)
+            result.push_back(r.line);
+        return result;
+    }
+
+    double value(const CalcEval::Document& document, std::size_t line)
+    {
+        const CalcEval::Document::Result result{document.result(line)};
+        INFO(result.error);
+        REQUIRE(result.value);
+        return *result.value;
+    }
+
+    bool failed(const CalcEval::Document& document, std::size_t line)
+    {
+        const CalcEval::Document::Result result{document.result(line)};
+        return !result.value && !result.error.empty();
+    }
+} // namespace
+
+TEST_CASE("Load")
+{
+    CalcEval::Document document{};
+    REQUIRE(document.size() == 1);
+    REQUIRE(document.update("").empty());
+
+    const auto results{document.update("a = 2\n\nb = a * 3\r\na + b\n1 +\n")};
+    REQUIRE(lines(results) == Lines{1, 3, 4, 5});
+    REQUIRE(document.size() == 6);
+    REQUIRE(results[2].value == 8.0);
+    REQUIRE_FALSE(results[3].value);
+    REQUIRE_FALSE(results[3].error.empty());
+
+    // Blank lines have no result.
+    REQUIRE_FALSE(document.result(2).value);
+    REQUIRE(document.result(2).error.empty());
+    REQUIRE_FALSE(document.result(6).value);
+
+    // The line with an error is kept, it is compiled again when a name it uses changes.
+    REQUIRE(document.session().size() == 4);
+
+    REQUIRE_THROWS_AS(document.result(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(document.result(7), std::invalid_argument);
+}
+
+TEST_CASE("Edits")
+{
+    CalcEval::Document document{};
+    std::string content{"a = 2\nb = a * 3\nc = 10\na + b\nc * 2\n"};
+    (void)document.update(content);
+    const std::uint64_t evaluations{document.session().evaluations()};
+
+    SECTION("Unchanged")
+    {
+        REQUIRE(document.update(content).empty());
+        REQUIRE(document.session().evaluations() == evaluations);
+    }
+
+    SECTION("A name and its users")
+    {
+        content.replace(0, 5, "a = 5");
+        REQUIRE(lines(document.update(content)) == Lines{1, 2, 4});
+        REQUIRE(value(document, 4) == 20.0);
+        REQUIRE(value(document, 5) == 20.0);
+
+        // Lines 2 and 4, and 1 that changed.
+        REQUIRE(document.session().evaluations() == evaluations + 3);
+    }
+
+    SECTION("Same value")
+    {
+        content.replace(0, 5, "a = 1 + 1");
+        REQUIRE(lines(document.update(content)) == Lines{1});
+    }
+
+    SECTION("Expression")
+    {
+        content.replace(content.find("c * 2"), 5, "c * 3");
+        REQUIRE(lines(document.update(content)) == Lines{5});
+        REQUIRE(value(document, 5) == 30.0);
+        REQUIRE(document.session().size() == 5);
+    }
+
+    SECTION("Insert and delete")
+    {
+        content.insert(0, "x = 1\n\n");
+        REQUIRE(lines(document.update(content)) == Lines{1});
+        REQUIRE(document.size() == 8);
+        REQUIRE(value(document, 6) == 8.0);
+
+        content.insert(content.find("a + b"), "a + x\n");
+        REQUIRE(lines(document.update(content)) == Lines{6});
+        REQUIRE(value(document, 6) == 3.0);
+        REQUIRE(value(document, 7) == 8.0);
+
+        // The line that used x gets an error.
+        content.erase(0, 7);
+        REQUIRE(lines(document.update(content)) == Lines{4});
+        REQUIRE(failed(document, 4));
+        REQUIRE(value(document, 5) == 8.0);
+        REQUIRE(document.session().size() == 6);
+    }
+
+    SECTION("Moved lines keep their values")
+    {
+        const std::string moved{"c * 2\na + b\nc = 10\nb = a * 3\na = 2\n"};
+        REQUIRE(document.update(moved).empty());
+        REQUIRE(value(document, 1) == 20.0);
+        REQUIRE(value(document, 2) == 8.0);
+        REQUIRE(document.session().evaluations() == evaluations);
+    }
+
+    SECTION("Errors")
+    {
+        content.replace(0, 5, "a = 2 +");
+        REQUIRE(lines(document.update(content)) == Lines{1, 2, 4});
+        REQUIRE(failed(document, 1));
+        REQUIRE(failed(document, 2));
+        REQUIRE(failed(document, 4));
+        REQUIRE(value(document, 5) == 20.0);
+
+        content.replace(0, 7, "a = 4");
+        REQUIRE(lines(document.update(content)) == Lines{1, 2, 4});
+        REQUIRE(value(document, 4) == 16.0);
+    }
+
+    SECTION("Cycles")
+    {
+        content.replace(0, 5, "a = b");
+        REQUIRE(lines(document.update(content)) == Lines{1, 2, 4});
+        REQUIRE(failed(document, 1));
+        REQUIRE(failed(document, 4));
+    }
+}
+
+TEST_CASE("Names on more than one line")
+{
+    CalcEval::Document document{};
+    std::string content{"a = 1\na + 1\na = 2\n"};
+    (void)document.update(content);
+    REQUIRE(value(document, 2) == 2.0);
+    REQUIRE(failed(document, 3));
+
+    SECTION("Changed")
+    {
+        content.replace(content.find("a = 2"), 5, "a = 3");
+        REQUIRE(lines(document.update(content)) == Lines{3});
+        REQUIRE(failed(document, 3));
+        REQUIRE(value(document, 2) == 2.0);
+    }
+
+    SECTION("Removed")
+    {
+        content.erase(0, 6);
+        REQUIRE(lines(document.update(content)) == Lines{1, 2});
+        REQUIRE(value(document, 1) == 3.0);
+        REQUIRE(value(document, 2) == 2.0);
+    }
+
+    SECTION("Renamed")
+    {
+        content.replace(0, 5, "b = 1");
+        REQUIRE(lines(document.update(content)) == Lines{1, 2, 3});
+        REQUIRE(value(document, 2) == 3.0);
+        REQUIRE(value(document, 3) == 2.0);
+    }
+}
+
+TEST_CASE("Ranges")
+{
+    CalcEval::Document document{};
+    std::string content{"a = 2\nb = a * 3\na + b"};
+    (void)document.update(content);
+
+    SECTION("In a line")
+    {
+        REQUIRE(lines(document.replace(4, 1, "5")) == Lines{1, 2, 3});
+        REQUIRE(value(document, 3) == 20.0);
+        REQUIRE(document.replace(4, 0, "").empty());
+    }
+
+    SECTION("Lines")
+    {
+        // Joins the first two lines, then splits them again.
+        REQUIRE(lines(document.replace(5, 1, " + ")) == Lines{1, 2});
+        REQUIRE(document.size() == 2);
+        REQUIRE(failed(document, 1));
+        REQUIRE(lines(document.replace(5, 3, "\n")) == Lines{1, 2, 3});
+        REQUIRE(value(document, 3) == 8.0);
+
+        REQUIRE(lines(document.replace(16, 5, "c = 1\n\nc")) == Lines{3, 5});
+        REQUIRE(document.size() == 5);
+        REQUIRE(value(document, 5) == 1.0);
+    }
+
+    SECTION("Outside the content")
+    {
+        REQUIRE_THROWS_AS(document.replace(22, 0, "1"), std::invalid_argument);
+        REQUIRE_THROWS_AS(document.replace(20, 2, ""), std::invalid_argument);
+        REQUIRE(lines(document.replace(21, 0, "\n1")) == Lines{4});
+        REQUIRE(document.size() == 4);
+    }
+}
+
+TEST_CASE("Same results as new content")
+{
+    const auto same = [](const CalcEval::Document& edited, const std::string& content) {
+        CalcEval::Document loaded{};
+        (void)loaded.update(content);
+        REQUIRE(edited.size() == loaded.size());
+        for (std::size_t line{1}; line <= edited.size(); ++line)
+        {
+            INFO(content << "line " << line);
+            const CalcEval::Document::Result a{edited.result(line)};
+            const CalcEval::Document::Result b{loaded.result(line)};
+            REQUIRE(a.error == b.error);
+            REQUIRE(a.value.has_value() == b.value.has_value());
+            REQUIRE((!a.value || *a.value == *b.value ||
+                     (std::isnan(*a.value) && std::isnan(*b.value))));
+        }
+    };
+
+    SECTION("Cycles")
+    {
+        CalcEval::Document document{};
+        (void)document.update("e = 1\nd = e\n");
+        (void)document.update("e = d + 1\nd = e\n");
+        REQUIRE(failed(document, 1));
+        REQUIRE(failed(document, 2));
+        same(document, "e = d + 1\nd = e\n");
+
+        // The cycle is gone, d is defined again.
+        REQUIRE(lines(document.update("e = 2\nd = e\n")) == Lines{1, 2});
+        REQUIRE(value(document, 2) == 2.0);
+    }
+
+    SECTION("First line of a name")
+    {
+        CalcEval::Document document{};
+        (void)document.update("x = 1\n");
+        REQUIRE(lines(document.update("x = 2\nx = 1\n")) == Lines{1, 2});
+        REQUIRE(value(document, 1) == 2.0);
+        REQUIRE(failed(document, 2));
+        same(document, "x = 2\nx = 1\n");
+    }
+
+    SECTION("Names that do not compile")
+    {
+        CalcEval::Document document{};
+        (void)document.update("y = sin\n");
+        (void)document.update("y = sin\nsin = 3\n");
+        REQUIRE(value(document, 1) == 3.0);
+        same(document, "y = sin\nsin = 3\n");
+    }
+
+    SECTION("Random edits")
+    {
+        const std::vector<std::string> lines{
+            "a = 1",   "a = b + 1", "b = c * 2",       "b = a", "c = 3",   "c = e + a",
+            "d = sin", "sin = 2",   "e = d + 1",       "e = pi", "pi = 3", "a + b + c",
+            "d + e",   "i = 2",     "sum(a, 1, 3, i)", "a = 1 +", "",      "b = sum(i = 1, c, i)"};
+        std::mt19937 random{7};
+        const auto pick = [&random](std::size_t n) {
+            return static_cast<std::size_t>(random() % n);
+        };
+
+        for (int round{0}; round < 100; ++round)
+        {
+            CalcEval::Document document{};
+            std::vector<std::string> content{};
+            for (int edit{0}; edit < 20; ++edit)
+            {
+                const std::size_t at{pick(content.size() + 1)};
+                if (at == content.size() || pick(3) == 0)
+                    content.insert(content.begin() + static_cast<std::ptrdiff_t>(at),
+                                   lines[pick(lines.size())]);
+                else if (pick(2) == 0)
+                    content.erase(content.begin() + static_cast<std::ptrdiff_t>(at));
+                else
+                    content[at] = lines[pick(lines.size())];
+
+                std::string text{};
+                for (const std::string& line : content)
+                    text += line + '\n';
+                (void)document.update(text);
+                same(document, text);
+            }
+        }
+    }
+
+    SECTION("Random ranges")
+    {
+        const std::string text{"a = b + 1\nb = a\nc = 2 * a\n\nd = c\na + c + d\ne = 1 +"};
+        std::mt19937 random{11};
+        const auto pick = [&random](std::size_t n) {
+            return static_cast<std::size_t>(random() % (n + 1));
+        };
+
+        for (int round{0}; round < 100; ++round)
+        {
+            CalcEval::Document document{};
+            std::string content{};
+            for (int edit{0}; edit < 20; ++edit)
+            {
+                const std::size_t at{pick(content.size())};
+                const std::size_t count{pick(std::min<std::size_t>(content.size() - at, 12))};
+                const std::size_t from{pick(text.size())};
+                const std::string inserted{text.substr(from, pick(12))};
+                content.replace(at, count, inserted);
+                (void)document.replace(at, count, inserted);
+                same(document, content);
+            }
+        }
+    }
+}
+
+TEST_CASE("Many lines")
+{
+    // Every line uses the one before, an edit evaluates the lines after it.
+    std::string content{"x0 = 1\n"};
+    for (int i{1}; i < 2000; ++i)
+        content += "x" + std::to_string(i) + " = x" + std::to_string(i - 1) + " + 1\n";
+    for (int i{0}; i < 2000; ++i)
+        content += std::to_string(i) + " * 2\n";
+
+    CalcEval::Document document{};
+    REQUIRE(document.update(content).size() == 4000);
+    REQUIRE(value(document, 2000) == 2000.0);
+
+    content.replace(content.find("x1500 = x1499 + 1"), 17, "x1500 = x1499 + 2");
+    const std::uint64_t evaluations{document.session().evaluations()};
+    const auto results{document.update(content)};
+    REQUIRE(results.size() == 500);
+    REQUIRE(results.front().line == 1501);
+    REQUIRE(value(document, 2000) == 2001.0);
+    REQUIRE(document.session().evaluations() == evaluations + 500);
+
+    // The expressions at the end are not evaluated again.
+    content.replace(content.find("\n1999 * 2"), 9, "\n1999 * 3");
+    REQUIRE(lines(document.update(content)) == Lines{4000});
+    REQUIRE(value(document, 4000) == 5997.0);
+    REQUIRE(document.session().evaluations() == evaluations + 501);
+
+    SECTION("Ranges")
+    {
+        const std::size_t at{content.find("x1500 = x1499 + 2")};
+        REQUIRE(document.replace(at + 16, 1, "1").size() == 500);
+        REQUIRE(value(document, 2000) == 2000.0);
+
+        // Lines inserted and removed before it move the results.
+        REQUIRE(lines(document.replace(at, 0, "y = 1\n\n")) == Lines{1501});
+        REQUIRE(value(document, 2002) == 2000.0);
+        REQUIRE(document.replace(at, 7, "").empty());
+        REQUIRE(document.size() == 4001);
+        REQUIRE(value(document, 4000) == 5997.0);
+    }
+
+    SECTION("A line that would depend on itself")
+    {
+        // Only the lines of the cycle are defined again.
+        content += "a = b\nb = a\n";
+        REQUIRE(lines(document.update(content)) == Lines{4001, 4002});
+        REQUIRE(failed(document, 4001));
+        REQUIRE(failed(document, 4002));
+
+        const std::uint64_t before{document.session().evaluations()};
+        content.replace(content.find("\n1999 * 3"), 9, "\n1999 * 4");
+        REQUIRE(lines(document.update(content)) == Lines{4000});
+        REQUIRE(document.session().evaluations() < before + 10);
+        REQUIRE(failed(document, 4002));
+    }
+}
@@ -0,0 +1,142 @@
+//
+//  tests/DualTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Dual.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/type/Dual.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <array>
+#include <cmath>
+#include <string>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using D = CalcEval::Dual<2>;
+
+static_assert(CalcEval::Type::isCalcType<CalcEval::Type::Dual<2>>);
+static_assert(CalcEval::Type::hasVariadic<CalcEval::Type::Dual<2>>);
+static_assert(
+    std::is_same_v<decltype(std::declval<CalcEval::Parser<CalcEval::Type::Dual<2>>>().parse("")),
+                   D>);
+
+static bool near(double a, double b, double tolerance = 1e-9)
+{
+    return std::fabs(a - b) <= tolerance * std::fmax(1.0, std::fabs(b));
+}
+
+// Parses str with x and y as the inputs 0 and 1.
+static D parse(const std::string& str, double x, double y)
+{
+    CalcEval::Registry<D> registry{};
+    registry.addConstant("x", D::variable(x, 0));
+    registry.addConstant("y", D::variable(y, 1));
+    return CalcEval::Parser<CalcEval::Type::Dual<2>>{registry.freeze()}.parse(str);
+}
+
+// Gradient by central differences with Type::Standard.
+static std::array<double, 2> numeric(const std::string& str, double x, double y)
+{
+    const auto f = [&str](double a, double b) {
+        CalcEval::Registry<double> registry{};
+        registry.addConstant("x", a);
+        registry.addConstant("y", b);
+        return CalcEval::Parser<CalcEval::Type::Standard>{registry.freeze()}.parse(str);
+    };
+
+    const double h{1e-6};
+    return {(f(x + h, y) - f(x - h, y)) / (2.0 * h), (f(x, y + h) - f(x, y - h)) / (2.0 * h)};
+}
+
+TEST_CASE("Dual arithmetic")
+{
+    const D x{D::variable(3.0, 0)}, y{D::variable(4.0, 1)};
+
+    REQUIRE(D{2.5}.value() == 2.5);
+    REQUIRE(D{2.5}.derivative(0) == 0.0);
+    REQUIRE(x.derivative(0) == 1.0);
+    REQUIRE(x.derivative(1) == 0.0);
+
+    const D f{x * y - x / y + (-x)};
+    REQUIRE(f.value() == 3.0 * 4.0 - 3.0 / 4.0 - 3.0);
+    REQUIRE(near(f.derivative(0), 4.0 - 1.0 / 4.0 - 1.0));
+    REQUIRE(near(f.derivative(1), 3.0 + 3.0 / 16.0));
+}
+
+TEST_CASE("Dual parser")
+{
+    SECTION("Analytic derivatives")
+    {
+        const D f{parse("x*y + sin(x)", 3.0, 4.0)};
+        REQUIRE(f.value() == 12.0 + std::sin(3.0));
+        REQUIRE(near(f.derivative(0), 4.0 + std::cos(3.0)));
+        REQUIRE(near(f.derivative(1), 3.0));
+
+        const D g{parse("-x^2/y", 3.0, 4.0)};
+        REQUIRE(near(g.value(), -9.0 / 4.0));
+        REQUIRE(near(g.derivative(0), -6.0 / 4.0));
+        REQUIRE(near(g.derivative(1), 9.0 / 16.0));
+    }
+
+    SECTION("Power")
+    {
+        // d/dx x^y = y x^(y-1), d/dy x^y = x^y log(x)
+        const D f{parse("x^y", 2.0, 3.0)};
+        REQUIRE(f.value() == 8.0);
+        REQUIRE(near(f.derivative(0), 12.0));
+        REQUIRE(near(f.derivative(1), 8.0 * std::log(2.0)));
+
+        // Negative exponent as parsed by factorTail, 2^-x.
+        const D g{parse("2^-x", 3.0, 0.0)};
+        REQUIRE(g.value() == 0.125);
+        REQUIRE(near(g.derivative(0), -0.125 * std::log(2.0)));
+
+        // Negative base with constant exponent and zero base.
+        const D h{parse("x^3", -2.0, 0.0)};
+        REQUIRE(h.value() == -8.0);
+        REQUIRE(near(h.derivative(0), 12.0));
+        REQUIRE(parse("x^y", 0.0, 2.0).derivative(1) == 0.0);
+        REQUIRE(parse("x^0", 0.0, 0.0).derivative(0) == 0.0);
+    }
+
+    SECTION("Constants have zero derivatives")
+    {
+        const D f{parse("pi*e + 2^0.5 + log(2)", 1.0, 1.0)};
+        REQUIRE(f.derivative(0) == 0.0);
+        REQUIRE(f.derivative(1) == 0.0);
+    }
+
+    SECTION("Same values as Standard")
+    {
+        const std::string str{"log(7)/log10(3)+exp(0.5)*arctan(2)-pi^e/tan(1)"};
+        REQUIRE(CalcEval::Parser<CalcEval::Type::Dual<2>>{}.parse(str).value() ==
+                CalcEval::Parser<CalcEval::Type::Standard>{}.parse(str));
+    }
+}
+
+TEST_CASE("Dual functions against numeric derivatives")
+{
+    const double x{0.3}, y{1.7};
+    for (const std::string str :
+         {"log(x*y)", "log10(x+y)", "exp(x-y)", "sin(x*y)", "cos(x/y)", "tan(x+y)",
+          "arcsin(x/y)", "arccos(x*y/2)", "arctan(x-y)", "min(x, y, 2)", "max(x, y, -1)",
+          "sum(x, y, x*y)", "mean(x, y^2)", "hypot(x, y)", "hypot(x, y, 3)", "atan2(y, x)",
+          "atan2(-x, -y)", "x^y^x", "(x+1)^(y-x)*sin(exp(x))"})
+    {
+        INFO(str);
+        const D f{parse(str, x, y)};
+        const std::array<double, 2> expected{numeric(str, x, y)};
+        REQUIRE(near(f.derivative(0), expected[0], 1e-6));
+        REQUIRE(near(f.derivative(1), expected[1], 1e-6));
+    }
+}
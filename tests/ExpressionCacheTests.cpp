@@ -0,0 +1,193 @@
+//
+//  tests/ExpressionCacheTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ExpressionCache.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Canonical text")
+{
+    using CalcEval::ExpressionCache;
+    REQUIRE(ExpressionCache::canonical("  1 +\t2 * ( x )\n") == "1+2*(x)");
+    REQUIRE(ExpressionCache::canonical("sin (x)") == "sin(x)");
+    REQUIRE(ExpressionCache::canonical("") == "");
+    REQUIRE(ExpressionCache::canonical("   ") == "");
+
+    // Whitespace between tokens that would be one token without it.
+    REQUIRE(ExpressionCache::canonical("not   x") == "not x");
+    REQUIRE(ExpressionCache::canonical("1  2") == "1 2");
+    REQUIRE(ExpressionCache::canonical("x < =y") == "x< =y");
+    REQUIRE(ExpressionCache::canonical("x <= y") == "x<=y");
+    REQUIRE(ExpressionCache::canonical("1. 5") == "1. 5");
+}
+
+TEST_CASE("Find and insert")
+{
+    const CalcEval::Compiler compiler{};
+    CalcEval::ExpressionCache cache{1 << 20};
+    REQUIRE(cache.capacity() == 1 << 20);
+    REQUIRE(cache.find("x * 2", {"x"}) == nullptr);
+
+    const auto inserted{cache.insert("x * 2", {"x"}, compiler.compile("x * 2", {"x"}))};
+    REQUIRE(inserted->evaluate(std::vector<double>{3.0}) == 6.0);
+    REQUIRE(cache.find("x*2", {"x"}) == inserted);
+    REQUIRE(cache.find("  x *  2 ", {"x"}) == inserted);
+
+    // The variables are part of the key.
+    REQUIRE(cache.find("x*2", {"x", "y"}) == nullptr);
+    REQUIRE(cache.find("x*2") == nullptr);
+
+    // The first expression is kept.
+    const auto again{cache.insert("x*2", {"x"}, compiler.compile("x*2", {"x"}))};
+    REQUIRE(again == inserted);
+
+    CalcEval::ExpressionCache::Statistics statistics{cache.statistics()};
+    REQUIRE(statistics.hits == 2);
+    REQUIRE(statistics.misses == 3);
+    REQUIRE(statistics.evictions == 0);
+    REQUIRE(statistics.entries == 1);
+    REQUIRE(statistics.bytes > 0);
+
+    cache.clear();
+    statistics = cache.statistics();
+    REQUIRE(statistics.entries == 0);
+    REQUIRE(statistics.bytes == 0);
+    REQUIRE(statistics.hits == 2);
+    REQUIRE(cache.find("x*2", {"x"}) == nullptr);
+
+    REQUIRE_THROWS_AS(CalcEval::ExpressionCache(100, 0), std::invalid_argument);
+}
+
+TEST_CASE("Eviction")
+{
+    const CalcEval::Compiler compiler{};
+    const auto insert = [&](CalcEval::ExpressionCache& cache, const std::string& str) {
+        return cache.insert(str, {"x"}, compiler.compile(str, {"x"}));
+    };
+
+    // Size of one entry, all keys below have the same length.
+    CalcEval::ExpressionCache probe{1 << 20, 1};
+    insert(probe, "x+1");
+    const std::size_t entry{probe.statistics().bytes};
+
+    SECTION("Bounded")
+    {
+        CalcEval::ExpressionCache cache{10 * entry, 1};
+        for (int i{0}; i < 9; ++i)
+            insert(cache, "x+" + std::to_string(i));
+        REQUIRE(cache.statistics().evictions == 0);
+
+        for (int i{10}; i < 99; ++i)
+            insert(cache, "x+" + std::to_string(i));
+        const CalcEval::ExpressionCache::Statistics statistics{cache.statistics()};
+        REQUIRE(statistics.bytes <= cache.capacity());
+        REQUIRE(statistics.entries == 10);
+        REQUIRE(statistics.evictions == 89 - 10 + 9);
+    }
+
+    SECTION("Used entries get a second chance")
+    {
+        CalcEval::ExpressionCache cache{3 * entry + entry / 2, 1};
+        insert(cache, "x+1");
+        insert(cache, "x+2");
+        insert(cache, "x+3");
+        REQUIRE(cache.find("x+1", {"x"}) != nullptr);
+
+        insert(cache, "x+4");
+        REQUIRE(cache.statistics().evictions == 1);
+        REQUIRE(cache.find("x+1", {"x"}) != nullptr);
+        REQUIRE(cache.find("x+2", {"x"}) == nullptr);
+        REQUIRE(cache.find("x+3", {"x"}) != nullptr);
+        REQUIRE(cache.find("x+4", {"x"}) != nullptr);
+    }
+
+    SECTION("Too large for a shard")
+    {
+        CalcEval::ExpressionCache cache{entry / 2, 1};
+        const auto expression{insert(cache, "x+1")};
+        REQUIRE(expression->evaluate(std::vector<double>{1.0}) == 2.0);
+        REQUIRE(cache.statistics().entries == 0);
+    }
+}
+
+TEST_CASE("Parser with a cache")
+{
+    CalcEval::Registry<double> registry{};
+    registry.addConstant("answer", 42.0);
+    const CalcEval::Parser<> plain{registry.freeze()};
+    const CalcEval::Parser<> cached{plain.symbols(), 1 << 20};
+    REQUIRE(plain.cache() == nullptr);
+    REQUIRE(cached.cache() != nullptr);
+
+    const std::vector<std::string> expressions{
+        "1+3-(-5)*4^2+pi+log10(10)", "answer / 2", "max(1, 2, sum(i = 1, 10, i^2))",
+        "if(2 > 1, sin(1), cos(1))", "1/0", "0/0", "not 0 or 1 and 0", "atan2(1, 2)*e"};
+    for (int round{0}; round < 3; ++round)
+    {
+        for (const std::string& str : expressions)
+        {
+            INFO(str);
+            const double expected{plain.parse(str)};
+            const double value{cached.parse((round == 2) ? " " + str + " " : str)};
+            REQUIRE((value == expected || (std::isnan(value) && std::isnan(expected))));
+        }
+    }
+    CalcEval::ExpressionCache::Statistics statistics{cached.cache()->statistics()};
+    REQUIRE(statistics.misses == expressions.size());
+    REQUIRE(statistics.hits == 2 * expressions.size());
+
+    // Errors are thrown and nothing is cached.
+    REQUIRE_THROWS_AS(cached.parse("1 +"), CalcEval::ParserError);
+    REQUIRE_THROWS_AS(cached.parse("nosuch(1)"), CalcEval::ParserError);
+    REQUIRE(cached.cache()->statistics().entries == expressions.size());
+
+    // Copies share the cache.
+    const CalcEval::Parser<> copy{cached};
+    REQUIRE(copy.parse("answer/2") == 21.0);
+    REQUIRE(cached.cache()->statistics().hits == 2 * expressions.size() + 1);
+}
+
+TEST_CASE("Concurrent lookups")
+{
+    const CalcEval::Parser<> parser{nullptr, 1 << 16};
+    std::vector<std::string> expressions{};
+    for (int i{0}; i < 64; ++i)
+        expressions.push_back("sin(" + std::to_string(i) + ") * " + std::to_string(i % 7));
+
+    constexpr std::size_t count{20000};
+    std::atomic<std::size_t> wrong{0};
+    CalcEval::ThreadPool pool{4};
+    pool.parallelFor(count, 100, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i{begin}; i < end; ++i)
+        {
+            const std::size_t k{(i * 7919) % expressions.size()};
+            const double expected{std::sin(static_cast<double>(k)) * static_cast<double>(k % 7)};
+            if (parser.parse(expressions[k]) != expected)
+                ++wrong;
+        }
+    });
+    REQUIRE(wrong == 0);
+
+    const CalcEval::ExpressionCache::Statistics statistics{parser.cache()->statistics()};
+    REQUIRE(statistics.hits + statistics.misses == count);
+    REQUIRE(statistics.bytes <= parser.cache()->capacity());
+}
@@ -0,0 +1,278 @@
+//
+//  tests/ExpressionFileTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ExpressionFile.hpp"
+#include "calceval/Registry.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // Removed when the test ends, also if it fails.
+    struct TemporaryFile
+    {
+        std::string path;
+
+        explicit TemporaryFile(const std::string& name)
+            : path{(std::filesystem::temp_directory_path() / name).string()}
+        {
+            std::filesystem::remove(path);
+        }
+
+        ~TemporaryFile()
+        {
+            std::error_code ignored{};
+            std::filesystem::remove(path, ignored);
+        }
+    };
+
+    bool same(double a, double b)
+    {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    }
+
+    CalcEval::Compiler<>::symbols_type symbols()
+    {
+        CalcEval::Registry<double> registry{};
+        registry.addConstant("answer", 42.0);
+        registry.addFunction("half", [](double x) { return x / 2.0; });
+        registry.addVariadic("first", [](CalcEval::Span<const double> args) { return args[0]; });
+        return registry.freeze();
+    }
+} // namespace
+
+TEST_CASE("Write and open")
+{
+    const TemporaryFile file{"calceval-expressionfile-roundtrip.cef"};
+    const CalcEval::Compiler<> compiler{symbols()};
+    const std::vector<std::string> variables{"x", "y"};
+    const std::vector<std::string> sources{
+        "x*y + sin(x) - 2^y",
+        "if(x > y, log(x), -y) + if(x < 0, 1, if(y < 0, 2, 3))",
+        "max(x, y, 1) + min(x, 0) + atan2(y, x) + hypot(x, y)",
+        "sum(i = 1, 10, i*x) + prod(k = 1, 4, k + y)",
+        "integrate(t*y, t, 0, x)",
+        "sum(i = 1, 3, sum(j = 1, i, i*j*x))",
+        "sum(x = 1, 3, x*y) + x",
+        "half(x) + first(y, x) + answer",
+        "x / 0",
+        "0 / (x - x)"};
+
+    std::vector<CalcEval::Expression> expressions{};
+    for (const std::string& str : sources)
+        expressions.push_back(compiler.compile(str, variables));
+    const std::uint64_t key{CalcEval::ExpressionFile::sourceHash(sources, variables)};
+    CalcEval::ExpressionFile::write(file.path, expressions, "double", key);
+
+    const CalcEval::ExpressionFile opened{
+        file.path, "double", key,
+        [&compiler](const std::string& str) { return compiler.compile(str, {"x"}); }};
+    REQUIRE(opened.size() == sources.size());
+    REQUIRE(opened.path() == file.path);
+    REQUIRE(opened.bytes() == std::filesystem::file_size(file.path));
+    REQUIRE(opened.bytes() % 8 == 0);
+    REQUIRE_FALSE(opened.rebuilt());
+
+    for (std::size_t i{0}; i < sources.size(); ++i)
+    {
+        INFO(sources[i]);
+        REQUIRE(opened.variableCount(i) == 2);
+        const CalcEval::Expression copy{opened.expression(i)};
+        REQUIRE(copy.sameShape(expressions[i]));
+        for (const double x : {-1.5, 0.0, 2.0, 3.25})
+        {
+            for (const double y : {-2.0, 0.5, 4.0})
+            {
+                const std::vector<double> values{x, y};
+                const double expected{expressions[i].evaluate(values)};
+                REQUIRE(same(opened.evaluate(i, values), expected));
+                REQUIRE(same(copy.evaluate(values), expected));
+            }
+        }
+    }
+
+    // The copies evaluate in batches like the compiled expressions.
+    const std::vector<double> x{-1.0, 0.5, 2.0, 7.0};
+    const std::vector<double> y{3.0, -0.5, 1.0, 2.0};
+    const std::vector<CalcEval::Span<const double>> columns{x, y};
+    std::vector<double> expected(x.size()), results(x.size());
+    expressions[0].evaluateBatch(columns, expected);
+    opened.expression(0).evaluateBatch(columns, results);
+    REQUIRE(results == expected);
+
+    REQUIRE_THROWS_AS(opened.evaluate(sources.size(), std::vector<double>{1.0, 2.0}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(opened.evaluate(0, std::vector<double>{1.0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(opened.expression(sources.size()), std::invalid_argument);
+}
+
+TEST_CASE("Invalid files")
+{
+    const TemporaryFile file{"calceval-expressionfile-invalid.cef"};
+    const CalcEval::Compiler<> compiler{symbols()};
+    const CalcEval::ExpressionFile::resolver_type resolve = [&compiler](const std::string& str) {
+        return compiler.compile(str, {"x"});
+    };
+    const std::vector<std::string> sources{"half(x) + max(x, 2) + sum(i = 1, 3, i*x)"};
+    const std::uint64_t key{CalcEval::ExpressionFile::sourceHash(sources, {"x"})};
+    CalcEval::ExpressionFile::write(file.path, {compiler.compile(sources[0], {"x"})}, "double",
+                                    key);
+    REQUIRE(CalcEval::ExpressionFile(file.path, "double", key, resolve)
+                .evaluate(0, std::vector<double>{2.0}) == 1.0 + 2.0 + 12.0);
+
+    SECTION("Missing")
+    {
+        REQUIRE_THROWS_AS(CalcEval::ExpressionFile(file.path + ".missing", "double", key, resolve),
+                          CalcEval::Error);
+    }
+
+    SECTION("Other type or sources")
+    {
+        REQUIRE_THROWS_AS(CalcEval::ExpressionFile(file.path, "float", key, resolve),
+                          CalcEval::Error);
+        REQUIRE_THROWS_AS(CalcEval::ExpressionFile(file.path, "double", key + 1, resolve),
+                          CalcEval::Error);
+    }
+
+    SECTION("Unknown function")
+    {
+        const CalcEval::Compiler<> plain{};
+        REQUIRE_THROWS_AS(CalcEval::ExpressionFile(file.path, "double", key,
+                                                   [&plain](const std::string& str) {
+                                                       return plain.compile(str, {"x"});
+                                                   }),
+                          CalcEval::Error);
+    }
+
+    SECTION("Every changed byte is found")
+    {
+        std::string bytes{};
+        {
+            std::ifstream in{file.path, std::ios::binary};
+            bytes.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+        }
+        for (std::size_t i{0}; i < bytes.size(); ++i)
+        {
+            std::string changed{bytes};
+            changed[i] = static_cast<char>(changed[i] ^ 0x10);
+            {
+                std::ofstream out{file.path, std::ios::binary | std::ios::trunc};
+                out.write(changed.data(), static_cast<std::streamsize>(changed.size()));
+            }
+            INFO(i);
+            REQUIRE_THROWS_AS(CalcEval::ExpressionFile(file.path, "double", key, resolve),
+                              CalcEval::Error);
+        }
+
+        // And a file that ends early.
+        std::ofstream out{file.path, std::ios::binary | std::ios::trunc};
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+        out.close();
+        REQUIRE_THROWS_AS(CalcEval::ExpressionFile(file.path, "double", key, resolve),
+                          CalcEval::Error);
+    }
+}
+
+TEST_CASE("Load")
+{
+    const TemporaryFile file{"calceval-expressionfile-load.cef"};
+    std::vector<std::string> sources{"x^2 + 1", "log10(x) * 2", "sum(i = 1, 4, x^i)"};
+    const std::vector<std::string> variables{"x"};
+
+    SECTION("Built once")
+    {
+        const CalcEval::ExpressionFile built{
+            CalcEval::ExpressionFile::load(file.path, sources, variables)};
+        REQUIRE(built.rebuilt());
+        REQUIRE(built.evaluate(0, std::vector<double>{3.0}) == 10.0);
+
+        const CalcEval::ExpressionFile loaded{
+            CalcEval::ExpressionFile::load(file.path, sources, variables)};
+        REQUIRE_FALSE(loaded.rebuilt());
+        REQUIRE(loaded.evaluate(1, std::vector<double>{100.0}) == 4.0);
+        REQUIRE(loaded.evaluate(2, std::vector<double>{2.0}) == 2.0 + 4.0 + 8.0 + 16.0);
+        REQUIRE_FALSE(std::filesystem::exists(file.path + ".tmp"));
+    }
+
+    SECTION("Rebuilt when the sources change")
+    {
+        (void)CalcEval::ExpressionFile::load(file.path, sources, variables);
+        sources[0] = "x^2 + 2";
+        const CalcEval::ExpressionFile loaded{
+            CalcEval::ExpressionFile::load(file.path, sources, variables)};
+        REQUIRE(loaded.rebuilt());
+        REQUIRE(loaded.evaluate(0, std::vector<double>{3.0}) == 11.0);
+
+        // Also when only the variables change.
+        REQUIRE(CalcEval::ExpressionFile::load(file.path, sources, {"x", "y"}).rebuilt());
+    }
+
+    SECTION("Rebuilt when a constant of the symbols changes")
+    {
+        sources.emplace_back("x * rate");
+        const auto compiler = [](double rate) {
+            CalcEval::Registry<double> registry{};
+            registry.addConstant("rate", rate);
+            return CalcEval::Compiler<>{registry.freeze()};
+        };
+
+        (void)CalcEval::ExpressionFile::load(file.path, sources, variables, compiler(2.0));
+        REQUIRE_FALSE(
+            CalcEval::ExpressionFile::load(file.path, sources, variables, compiler(2.0)).rebuilt());
+        const CalcEval::ExpressionFile loaded{
+            CalcEval::ExpressionFile::load(file.path, sources, variables, compiler(3.0))};
+        REQUIRE(loaded.rebuilt());
+        REQUIRE(loaded.evaluate(3, std::vector<double>{5.0}) == 15.0);
+    }
+
+    SECTION("Rebuilt when the file is damaged")
+    {
+        (void)CalcEval::ExpressionFile::load(file.path, sources, variables);
+        {
+            std::fstream io{file.path, std::ios::binary | std::ios::in | std::ios::out};
+            io.seekp(-4, std::ios::end);
+            io.put('\x7f');
+        }
+        const CalcEval::ExpressionFile loaded{
+            CalcEval::ExpressionFile::load(file.path, sources, variables)};
+        REQUIRE(loaded.rebuilt());
+        REQUIRE(loaded.evaluate(0, std::vector<double>{3.0}) == 10.0);
+    }
+
+    SECTION("Rebuilt for another type")
+    {
+        (void)CalcEval::ExpressionFile::load(file.path, sources, variables);
+        const std::uint64_t key{CalcEval::ExpressionFile::sourceHash(sources, variables)};
+        REQUIRE_THROWS_AS(CalcEval::ExpressionFile(file.path, "another", key,
+                                                   [](const std::string& str) {
+                                                       return CalcEval::Compiler{}.compile(str,
+                                                                                           {"x"});
+                                                   }),
+                          CalcEval::Error);
+    }
+
+    SECTION("Errors in the sources are thrown")
+    {
+        sources.emplace_back("x +");
+        REQUIRE_THROWS_AS(CalcEval::ExpressionFile::load(file.path, sources, variables),
+                          CalcEval::ParserError);
+        REQUIRE_FALSE(std::filesystem::exists(file.path));
+    }
+}
@@ -0,0 +1,153 @@
+//
+//  tests/ExpressionTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Expression.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool identical(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+TEST_CASE("Expression is identical to Parser")
+{
+    const CalcEval::Parser parser{};
+    const CalcEval::Compiler compiler{};
+
+    for (const std::string str :
+         {"1+2*3", "-2^2", "2^-1", "2^3^2", "-2^-3^-0.5", "1-2-3", "8/4/2", "(1+2)*(3-4)/5",
+          "-(1.5)", "-0", "0.1+0.2", "log(7)/log10(3)+exp(0.5)*arctan(2)-pi^e/tan(1)",
+          "sin(1)*cos(2)-arcsin(0.3)+arccos(0.4)", "max(1, 2, -3)+min(4, 5)-mean(1, 2, 4)",
+          "sum(1, 2, sum(3, 4))*hypot(3, 4, 12)+atan2(1, -1)", "1/0", "log(-1)",
+          "2\n+\n3"})
+    {
+        INFO(str);
+        const CalcEval::Expression expression{compiler.compile(str)};
+        REQUIRE(identical(expression.evaluate(), parser.parse(str)));
+    }
+}
+
+TEST_CASE("Expression variables")
+{
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression expression{compiler.compile("x*y - x/2 + sin(y)", {"x", "y"})};
+
+    REQUIRE(expression.variableCount() == 2);
+    REQUIRE(expression.variables().find("y") == 1u);
+    REQUIRE(expression.complete());
+    for (double x{-2.0}; x <= 2.0; x += 0.25)
+    {
+        const std::vector<double> values{x, 3.0 - x};
+        REQUIRE(expression.evaluate(values) ==
+                x * (3.0 - x) - x / 2.0 + std::sin(3.0 - x));
+    }
+
+    SECTION("Variables hide constants")
+    {
+        REQUIRE(compiler.compile("pi", {"pi"}).evaluate(std::vector<double>{3.0}) == 3.0);
+        REQUIRE(compiler.compile("pi*2").evaluate() == 3.14159265 * 2.0);
+    }
+
+    SECTION("Symbols")
+    {
+        CalcEval::Registry<double> registry{};
+        registry.addConstant("g", 9.81);
+        registry.addFunction("twice", [](double v) { return 2.0 * v; });
+        const CalcEval::Compiler withSymbols{registry.freeze()};
+
+        const CalcEval::Expression e{withSymbols.compile("twice(g*t)", {"t"})};
+        REQUIRE(e.evaluate(std::vector<double>{2.0}) == 2.0 * 9.81 * 2.0);
+        REQUIRE(e.functions().front().name == "twice");
+    }
+
+    SECTION("Deep expressions")
+    {
+        std::string str{"x"};
+        for (int i{0}; i < 200; ++i)
+            str = "(1+" + str + ")";
+        const CalcEval::Expression e{compiler.compile(str, {"x"})};
+        REQUIRE(e.stackSize() > 64);
+        REQUIRE(e.evaluate(std::vector<double>{0.5}) == 200.5);
+    }
+}
+
+TEST_CASE("Expression errors")
+{
+    const CalcEval::Compiler compiler{};
+
+    SECTION("Same errors as Parser")
+    {
+        const CalcEval::Parser parser{};
+        for (const std::string str : {"", "1+", "(1", "1)", "sin", "foo(1)", "bar", "max()",
+                                      "atan2(1)", "atan2(1, 2, 3)", "2 3"})
+        {
+            INFO(str);
+            std::string expected{};
+            try
+            {
+                (void)parser.parse(str);
+            }
+            catch (const CalcEval::ParserError& e)
+            {
+                expected = e.what();
+            }
+
+            REQUIRE_FALSE(expected.empty());
+            REQUIRE_THROWS_WITH(compiler.compile(str), expected);
+        }
+    }
+
+    SECTION("Variables")
+    {
+        REQUIRE_THROWS_AS(compiler.compile("x", {"x", "x"}), std::invalid_argument);
+
+        const CalcEval::Expression e{compiler.compile("x+y", {"x", "y"})};
+        REQUIRE_THROWS_AS(e.evaluate(std::vector<double>{1.0}), std::invalid_argument);
+        REQUIRE_THROWS_AS(CalcEval::Expression{}.evaluate(), std::invalid_argument);
+    }
+
+    SECTION("Functions that throw")
+    {
+        CalcEval::Registry<double> registry{};
+        registry.addVariadic("bad", [](CalcEval::Span<const double>) -> double {
+            throw std::domain_error{"bad"};
+        });
+        const CalcEval::Compiler<> symbols{registry.freeze()};
+        const CalcEval::Expression e{symbols.compile("1 + bad(2)")};
+        REQUIRE_THROWS_AS(e.evaluate(), std::domain_error);
+        REQUIRE_THROWS_AS(CalcEval::Parser<>{symbols.symbols()}.parse("1 + bad(2)"),
+                          std::domain_error);
+    }
+
+    SECTION("Code")
+    {
+        CalcEval::Expression e{std::vector<std::string>{"x"}};
+        REQUIRE_THROWS_AS(e.pushOperator(CalcEval::OpCode::Add), std::invalid_argument);
+        REQUIRE_THROWS_AS(e.pushVariable(1), std::invalid_argument);
+        e.pushVariable(0);
+        e.pushConstant(2.0);
+        REQUIRE_FALSE(e.complete());
+        REQUIRE_THROWS_AS(e.pushOperator(CalcEval::OpCode::Constant), std::invalid_argument);
+        e.pushOperator(CalcEval::OpCode::Power);
+        REQUIRE(e.evaluate(std::vector<double>{3.0}) == 9.0);
+    }
+}
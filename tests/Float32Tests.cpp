@@ -0,0 +1,116 @@
+//
+//  tests/Float32Tests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/type/StandardFloat32.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using Float32Parser = CalcEval::Parser<CalcEval::Type::StandardFloat32>;
+
+static_assert(CalcEval::Type::isCalcType<CalcEval::Type::Float32>);
+static_assert(CalcEval::Type::isCalcType<CalcEval::Type::StandardFloat32>);
+static_assert(CalcEval::Type::hasVariadic<CalcEval::Type::StandardFloat32>);
+static_assert(std::is_same_v<decltype(std::declval<Float32Parser>().parse("")), float>);
+
+static float parse(const std::string& str)
+{
+    return Float32Parser{}.parse(str);
+}
+
+TEST_CASE("Float literals")
+{
+    SECTION("Rounded directly to float")
+    {
+        REQUIRE(parse("0.1") == 0.1f);
+        REQUIRE(parse("16777217") == 16777216.0f);
+        REQUIRE(parse("3.4028235e38") == std::numeric_limits<float>::max());
+
+        // Halfway between two floats when rounded to double first.
+        REQUIRE(parse("1.00000005960464477539062500000000001") == 1.00000012f);
+    }
+
+    SECTION("Out of range")
+    {
+        REQUIRE(std::isinf(parse("1e39")));
+        REQUIRE(parse("1e-50") == 0.0f);
+    }
+}
+
+TEST_CASE("Float arithmetic")
+{
+    REQUIRE(parse("1+2*3") == 7.0f);
+    REQUIRE(parse("-2^2") == -4.0f);
+    REQUIRE(parse("2^-1") == 0.5f);
+    REQUIRE(parse("1/3") == 1.0f / 3.0f);
+    REQUIRE(parse("0.1+0.2") == 0.1f + 0.2f);
+    REQUIRE(parse("2^0.5") == std::pow(2.0f, 0.5f));
+    REQUIRE(std::isinf(parse("1e30*1e30")));
+}
+
+TEST_CASE("Float constants and functions")
+{
+    SECTION("Constants")
+    {
+        REQUIRE(parse("pi") == 3.14159265f);
+        REQUIRE(parse("e") == 2.71828183f);
+    }
+
+    SECTION("Functions use the float overloads")
+    {
+        REQUIRE(parse("sin(0.5)") == std::sin(0.5f));
+        REQUIRE(parse("cos(0.5)") == std::cos(0.5f));
+        REQUIRE(parse("tan(0.5)") == std::tan(0.5f));
+        REQUIRE(parse("log(10)") == std::log(10.0f));
+        REQUIRE(parse("log10(2)") == std::log10(2.0f));
+        REQUIRE(parse("exp(1.5)") == std::exp(1.5f));
+        REQUIRE(parse("arcsin(0.5)") == std::asin(0.5f));
+        REQUIRE(parse("arccos(0.5)") == std::acos(0.5f));
+        REQUIRE(parse("arctan(0.5)") == std::atan(0.5f));
+    }
+
+    SECTION("Functions with several arguments")
+    {
+        REQUIRE(parse("min(3, -2, 5)") == -2.0f);
+        REQUIRE(parse("max(3, -2, 5)") == 5.0f);
+        REQUIRE(parse("sum(1, 2, 3, 4, 5)") == 15.0f);
+        REQUIRE(parse("mean(1, 2, 3, 4)") == 2.5f);
+        REQUIRE(parse("hypot(3, 4)") == 5.0f);
+        REQUIRE(std::fabs(parse("hypot(2, 3, 6)") - 7.0f) < 1e-5f);
+        REQUIRE(parse("hypot(3e30, 4e30, 0)") == 5e30f);
+        REQUIRE(parse("atan2(1, 1)") == std::atan2(1.0f, 1.0f));
+        REQUIRE(std::isnan(parse("max(1, 0/0, 2)")));
+    }
+
+    SECTION("Errors")
+    {
+        REQUIRE_THROWS_AS(parse("foo(1)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("atan2(1)"), CalcEval::ParserError);
+    }
+}
+
+TEST_CASE("Float registry")
+{
+    CalcEval::Registry<float> registry{};
+    registry.addConstant("g", 9.81f);
+    registry.addFunction("half", [](float x) { return x * 0.5f; });
+
+    const Float32Parser parser{registry.freeze()};
+    REQUIRE(parser.parse("half(g)") == 9.81f * 0.5f);
+    REQUIRE(parser.parse("sin(pi)") == std::sin(3.14159265f));
+}
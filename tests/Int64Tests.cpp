@@ -0,0 +1,129 @@
+//
+//  tests/Int64Tests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+#include "calceval/type/Int64.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using Int64Parser = CalcEval::Parser<CalcEval::Type::Int64>;
+
+static_assert(CalcEval::Type::isCalcType<CalcEval::Type::Int64>);
+static_assert(CalcEval::Type::hasAdd<CalcEval::Type::Int64>);
+static_assert(CalcEval::Type::hasPower<CalcEval::Type::Int64>);
+static_assert(!CalcEval::Type::hasAdd<CalcEval::Type::Standard>);
+static_assert(std::is_same_v<decltype(std::declval<Int64Parser>().parse("")), std::int64_t>);
+
+static std::int64_t parse(const std::string& str)
+{
+    return Int64Parser{}.parse(str);
+}
+
+constexpr std::int64_t int64Max{std::numeric_limits<std::int64_t>::max()};
+constexpr std::int64_t int64Min{std::numeric_limits<std::int64_t>::min()};
+
+TEST_CASE("Integer literals")
+{
+    REQUIRE(parse("0") == 0);
+    REQUIRE(parse("42") == 42);
+    REQUIRE(parse("9223372036854775807") == int64Max);
+    REQUIRE(parse("-9223372036854775807") == -int64Max);
+
+    // Would be rounded to 9007199254740992 as a double.
+    REQUIRE(parse("9007199254740993") == 9007199254740993);
+
+    REQUIRE_THROWS_AS(parse("9223372036854775808"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("1.5"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("1e3"), CalcEval::ArithmeticError);
+}
+
+TEST_CASE("Integer arithmetic")
+{
+    REQUIRE(parse("1+2*3") == 7);
+    REQUIRE(parse("(1+2)*3") == 9);
+    REQUIRE(parse("10-4-3") == 3);
+    REQUIRE(parse("-2^2") == -4);
+    REQUIRE(parse("3000000000*3000000000") == 9000000000000000000);
+
+    SECTION("Division truncates towards zero")
+    {
+        REQUIRE(parse("7/2") == 3);
+        REQUIRE(parse("-7/2") == -3);
+        REQUIRE(parse("7/-2") == -3);
+        REQUIRE(parse("100/10/5") == 2);
+    }
+
+    SECTION("Power")
+    {
+        REQUIRE(parse("2^0") == 1);
+        REQUIRE(parse("0^0") == 1);
+        REQUIRE(parse("2^10") == 1024);
+        REQUIRE(parse("2^62") == std::int64_t{1} << 62);
+        REQUIRE(parse("3^39") == 4052555153018976267);
+        REQUIRE(parse("(-2)^63") == int64Min);
+        REQUIRE(parse("(-3)^3") == -27);
+        REQUIRE(parse("2^3^2") == 512);
+        REQUIRE(parse("2^-1") == 0);
+        REQUIRE(parse("1^-5") == 1);
+        REQUIRE(parse("(-1)^-5") == -1);
+        REQUIRE(parse("(-1)^-4") == 1);
+    }
+}
+
+TEST_CASE("Integer overflow")
+{
+    REQUIRE_THROWS_AS(parse("9223372036854775807+1"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("-9223372036854775807-2"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("4000000000*4000000000"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("2^63"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("-2^63"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("3^40"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("2^1000000"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("-((-2)^63)"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("(-2)^63/-1"), CalcEval::ArithmeticError);
+
+    REQUIRE(parse("9223372036854775807-1+1") == int64Max);
+    REQUIRE(parse("1^1000000") == 1);
+    REQUIRE(parse("0^1000000") == 0);
+
+    REQUIRE_THROWS_WITH(parse("9223372036854775807+1"),
+                        "Integer overflow: 9223372036854775807 + 1");
+}
+
+TEST_CASE("Integer division by zero")
+{
+    REQUIRE_THROWS_AS(parse("1/0"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("1/(2-2)"), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(parse("0^-1"), CalcEval::ArithmeticError);
+}
+
+TEST_CASE("Checked operations")
+{
+    using CalcEval::Type::Int64;
+
+    REQUIRE(Int64::add(int64Max, int64Min) == -1);
+    REQUIRE(Int64::subtract(-1, int64Max) == int64Min);
+    REQUIRE(Int64::multiply(int64Min, 1) == int64Min);
+    REQUIRE(Int64::multiply(-1, int64Max) == -int64Max);
+    REQUIRE(Int64::divide(int64Min, 1) == int64Min);
+    REQUIRE(Int64::power(-1, int64Max) == -1);
+
+    REQUIRE_THROWS_AS(Int64::subtract(int64Min, 1), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(Int64::multiply(int64Min, -1), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(Int64::multiply(-1, int64Min), CalcEval::ArithmeticError);
+    REQUIRE_THROWS_AS(Int64::power(2, int64Max), CalcEval::ArithmeticError);
+}
@@ -0,0 +1,228 @@
+//
+//  tests/KernelTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Kernel.hpp"
+#include "calceval/type/Standard.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using CalcEval::Kernel::Accuracy;
+
+struct Function
+{
+    std::string name;
+    CalcEval::Kernel::func_type kernel;
+    double (*reference)(double);
+    std::uint64_t maxUlp;
+};
+
+static std::vector<Function> functions()
+{
+    // Bounds documented in Kernel.hpp.
+    return {{"log", CalcEval::Kernel::log, [](double x) { return std::log(x); }, 1},
+            {"log10", CalcEval::Kernel::log10, [](double x) { return std::log10(x); }, 2},
+            {"exp", CalcEval::Kernel::exp, [](double x) { return std::exp(x); }, 1},
+            {"sin", CalcEval::Kernel::sin, [](double x) { return std::sin(x); }, 1},
+            {"cos", CalcEval::Kernel::cos, [](double x) { return std::cos(x); }, 1},
+            {"tan", CalcEval::Kernel::tan, [](double x) { return std::tan(x); }, 2},
+            {"arcsin", CalcEval::Kernel::asin, [](double x) { return std::asin(x); }, 1},
+            {"arccos", CalcEval::Kernel::acos, [](double x) { return std::acos(x); }, 1},
+            {"arctan", CalcEval::Kernel::atan, [](double x) { return std::atan(x); }, 1}};
+}
+
+// Distance in representable doubles, 0 if both are NaN.
+static std::uint64_t ulp(double a, double b)
+{
+    if (std::isnan(a) || std::isnan(b))
+        return (std::isnan(a) && std::isnan(b)) ? 0 : std::numeric_limits<std::uint64_t>::max();
+
+    const auto ordered = [](double x) {
+        std::int64_t bits{};
+        std::memcpy(&bits, &x, sizeof(double));
+        return (bits < 0) ? std::numeric_limits<std::int64_t>::min() - bits : bits;
+    };
+
+    const std::int64_t ia{ordered(a)}, ib{ordered(b)};
+    return (ia > ib) ? static_cast<std::uint64_t>(ia) - static_cast<std::uint64_t>(ib)
+                     : static_cast<std::uint64_t>(ib) - static_cast<std::uint64_t>(ia);
+}
+
+static std::vector<double> linear(double from, double to, std::size_t count)
+{
+    std::vector<double> grid(count);
+    for (std::size_t i{0}; i < count; ++i)
+        grid[i] = from + (to - from) * static_cast<double>(i) / static_cast<double>(count - 1);
+    return grid;
+}
+
+static std::vector<double> logarithmic(double from, double to, std::size_t count)
+{
+    std::vector<double> grid{linear(std::log(from), std::log(to), count)};
+    for (double& x : grid)
+        x = std::exp(x);
+    return grid;
+}
+
+static std::vector<double> grid(const std::string& name)
+{
+    std::vector<double> values{};
+    const auto add = [&values](const std::vector<double>& more, bool mirror) {
+        for (double x : more)
+        {
+            values.push_back(x);
+            if (mirror)
+                values.push_back(-x);
+        }
+    };
+
+    if (name == "log" || name == "log10")
+    {
+        add(linear(0.5, 2.0, 400000), false);
+        add(linear(1.0 - 1e-6, 1.0 + 1e-6, 10000), false);
+        add(logarithmic(4.9e-324, 1.7e308, 400000), false);
+    }
+    else if (name == "exp")
+    {
+        add(linear(-1.0, 1.0, 200000), false);
+        add(linear(-746.0, 710.0, 600000), false);
+    }
+    else if (name == "sin" || name == "cos" || name == "tan")
+    {
+        add(linear(0.0, 10.0, 400000), true);
+        add(linear(0.0, 2e6, 200000), true);
+        add(logarithmic(1e-300, 1e300, 20000), true);
+    }
+    else if (name == "arcsin" || name == "arccos")
+    {
+        add(linear(-1.0, 1.0, 600000), false);
+        add(linear(1.0 - 1e-6, 1.0, 10000), true);
+    }
+    else if (name == "arctan")
+    {
+        add(linear(0.0, 4.0, 400000), true);
+        add(logarithmic(1e-300, 1e300, 200000), true);
+    }
+
+    return values;
+}
+
+TEST_CASE("Fast kernels are within the documented ULP bound")
+{
+    for (const Function& func : functions())
+    {
+        const std::vector<double> values{grid(func.name)};
+        std::vector<double> results(values.size());
+        func.kernel(values, results, Accuracy::Fast);
+
+        std::uint64_t worst{0};
+        double worstAt{0.0};
+        for (std::size_t i{0}; i < values.size(); ++i)
+        {
+            const std::uint64_t error{ulp(results[i], func.reference(values[i]))};
+            if (error > worst)
+            {
+                worst = error;
+                worstAt = values[i];
+            }
+        }
+
+        INFO(func.name << " worst " << worst << " ULP at " << worstAt);
+        REQUIRE(worst <= func.maxUlp);
+    }
+}
+
+TEST_CASE("Exact kernels are identical to cmath")
+{
+    for (const Function& func : functions())
+    {
+        const std::vector<double> values{grid(func.name)};
+        std::vector<double> results(values.size());
+        func.kernel(values, results, Accuracy::Exact);
+
+        INFO(func.name);
+        for (std::size_t i{0}; i < values.size(); ++i)
+            REQUIRE(ulp(results[i], func.reference(values[i])) == 0);
+    }
+}
+
+TEST_CASE("Special values")
+{
+    constexpr double inf{std::numeric_limits<double>::infinity()};
+    constexpr double nan{std::numeric_limits<double>::quiet_NaN()};
+    const std::vector<double> values{0.0,  -0.0, 1.0,  -1.0,    inf,    -inf,    nan,
+                                     2.0,  -2.0, 1e-310, -1e-310, 800.0, -800.0, 1e300};
+
+    for (const Function& func : functions())
+    {
+        std::vector<double> results(values.size());
+        func.kernel(values, results, Accuracy::Fast);
+
+        for (std::size_t i{0}; i < values.size(); ++i)
+        {
+            INFO(func.name << "(" << values[i] << ") = " << results[i]);
+            REQUIRE(ulp(results[i], func.reference(values[i])) <= func.maxUlp);
+        }
+    }
+}
+
+TEST_CASE("Any length and in-place")
+{
+    for (const Function& func : functions())
+    {
+        for (std::size_t count{0}; count < 20; ++count)
+        {
+            std::vector<double> values{linear(0.05, 0.95, count + 2)};
+            values.resize(count);
+
+            std::vector<double> results(count);
+            func.kernel(values, results, Accuracy::Fast);
+
+            // An element gets the same result regardless of its position.
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                double single{};
+                func.kernel({&values[i], 1}, {&single, 1}, Accuracy::Fast);
+                REQUIRE(ulp(results[i], single) == 0);
+            }
+
+            func.kernel(values, values, Accuracy::Fast);
+            REQUIRE(values == results);
+        }
+    }
+}
+
+TEST_CASE("Standard batch functions")
+{
+    CalcEval::Type::Standard standard{};
+    const std::vector<double> values{linear(0.01, 0.99, 37)};
+
+    for (const auto& [name, function] : CalcEval::Type::Standard::functions.entries())
+    {
+        INFO(name);
+        const auto batch{standard.batchFunction(std::string{name})};
+        REQUIRE(batch);
+
+        std::vector<double> results(values.size());
+        (*batch)(values, results, Accuracy::Exact);
+        for (std::size_t i{0}; i < values.size(); ++i)
+            REQUIRE(ulp(results[i], function(values[i])) == 0);
+    }
+
+    REQUIRE_FALSE(standard.batchFunction("max"));
+}
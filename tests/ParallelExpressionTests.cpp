@@ -0,0 +1,119 @@
+//
+//  tests/ParallelExpressionTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ParallelExpression.hpp"
+#include "calceval/Reduce.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// 1/1^2 + 1/2^2 - ... with n terms, every seventh subtracted.
+static std::string series(int n, const std::string& variable)
+{
+    std::string str{};
+    for (int i{1}; i <= n; ++i)
+    {
+        if (i > 1)
+            str += (i % 7 == 0) ? "-" : "+";
+        str += variable + "/" + std::to_string(i) + "^2";
+    }
+    return str;
+}
+
+TEST_CASE("ParallelExpression")
+{
+    const CalcEval::Compiler compiler{};
+    const std::vector<std::string> variables{"x", "y"};
+    const std::vector<double> values{1.5, -0.25};
+
+    const std::vector<std::string> strings{
+        series(20000, "x"),
+        "(" + series(5000, "x") + ")*(" + series(5000, "y") + ")/(" + series(3000, "x") + ")",
+        "max(" + series(4000, "x") + ", " + series(4000, "y") + ", 3)-sin(" + series(6000, "y") +
+            ")",
+        "(" + series(3000, "x") + ")^(" + series(100, "y") + ")",
+        "-(" + series(8000, "y") + ")*2",
+        "x+y"};
+
+    CalcEval::ThreadPool one{1};
+    CalcEval::ThreadPool four{4};
+
+    for (const std::string& str : strings)
+    {
+        const CalcEval::Expression expression{compiler.compile(str, variables)};
+        const CalcEval::ParallelExpression parallel{expression, 1000};
+        const double expected{expression.evaluate(values)};
+
+        // Sequential combination is identical to evaluate.
+        REQUIRE(parallel.evaluate(one, values) == expected);
+        REQUIRE(parallel.evaluate(four, values) == expected);
+
+        // Pairwise does not depend on the number of threads.
+        using Association = CalcEval::ParallelExpression::Association;
+        const double pairwise{parallel.evaluate(one, values, Association::Pairwise)};
+        REQUIRE(parallel.evaluate(four, values, Association::Pairwise) == pairwise);
+        REQUIRE(pairwise == Catch::Approx(expected).epsilon(1e-12));
+    }
+
+    SECTION("Split operators")
+    {
+        const CalcEval::Expression small{compiler.compile("x+y", variables)};
+        REQUIRE(CalcEval::ParallelExpression{small}.splitCount() == 0);
+
+        const CalcEval::Expression large{compiler.compile(strings[1], variables)};
+        REQUIRE(CalcEval::ParallelExpression{large, 1000}.splitCount() == 4);
+        REQUIRE(CalcEval::ParallelExpression{large, 1u << 30}.splitCount() == 0);
+    }
+
+    SECTION("Pairwise is more accurate")
+    {
+        // 1 + 1e-16 + 1e-16 + ..., the small terms are lost from left to right.
+        std::string str{"1"};
+        for (int i{0}; i < 4096; ++i)
+            str += "+0.0000000000000001";
+        const CalcEval::ParallelExpression parallel{compiler.compile(str), 100};
+        const double pairwise{
+            parallel.evaluate(four, {}, CalcEval::ParallelExpression::Association::Pairwise)};
+        REQUIRE(parallel.evaluate(four) == 1.0);
+        REQUIRE(pairwise == Catch::Approx(1.0 + 4096e-16).epsilon(1e-15));
+    }
+
+    SECTION("Errors")
+    {
+        REQUIRE_THROWS_AS(CalcEval::ParallelExpression{CalcEval::Expression{}},
+                          std::invalid_argument);
+        const CalcEval::Expression expression{compiler.compile("x", variables)};
+        REQUIRE_THROWS_AS(CalcEval::ParallelExpression(expression, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(CalcEval::ParallelExpression{expression}.evaluate(four),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("pairwiseSum")
+{
+    REQUIRE(CalcEval::Reduce::pairwiseSum({}) == 0.0);
+
+    std::vector<double> values(1000);
+    for (std::size_t i{0}; i < values.size(); ++i)
+        values[i] = static_cast<double>(i);
+    REQUIRE(CalcEval::Reduce::pairwiseSum(values) == 499500.0);
+
+    const std::vector<double> negativeZero{-0.0};
+    REQUIRE(std::signbit(CalcEval::Reduce::pairwiseSum(negativeZero)));
+}
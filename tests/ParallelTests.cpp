@@ -0,0 +1,167 @@
+//
+//  tests/ParallelTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Parallel.hpp"
+#include "calceval/ThreadPool.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("ThreadPool")
+{
+    CalcEval::ThreadPool pool{4};
+    REQUIRE(pool.size() == 4);
+
+    SECTION("Every index once")
+    {
+        std::vector<std::atomic<int>> visits(10007);
+        pool.parallelFor(visits.size(), 13, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i{begin}; i < end; ++i)
+                ++visits[i];
+        });
+
+        for (const std::atomic<int>& count : visits)
+            REQUIRE(count.load() == 1);
+    }
+
+    SECTION("Worker index")
+    {
+        std::atomic<bool> valid{true};
+        pool.parallelFor(1000, 1, [&](std::size_t, std::size_t, std::size_t worker) {
+            if (worker >= pool.size())
+                valid = false;
+        });
+        REQUIRE(valid);
+    }
+
+    SECTION("Uneven costs")
+    {
+        // All the expensive chunks start in the queue of one worker.
+        std::vector<int> done(64, 0);
+        pool.parallelFor(done.size(), 1, [&](std::size_t begin, std::size_t, std::size_t) {
+            if (begin < 16)
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            done[begin] = 1;
+        });
+
+        for (int value : done)
+            REQUIRE(value == 1);
+    }
+
+    SECTION("Nested")
+    {
+        std::atomic<std::size_t> total{0};
+        pool.parallelFor(8, 1, [&](std::size_t, std::size_t, std::size_t) {
+            pool.parallelFor(100, 7, [&](std::size_t begin, std::size_t end, std::size_t) {
+                total += end - begin;
+            });
+        });
+        REQUIRE(total == 800);
+    }
+
+    SECTION("Nested one chunk of a job at a time")
+    {
+        // A worker waiting in the nested call never starts another chunk
+        // of the outer job with the same worker index.
+        std::vector<std::atomic<int>> busy(pool.size());
+        std::atomic<bool> overlap{false};
+        pool.parallelFor(64, 1, [&](std::size_t, std::size_t, std::size_t worker) {
+            if (busy[worker].exchange(1) != 0)
+                overlap = true;
+            pool.parallelFor(50, 1, [](std::size_t, std::size_t, std::size_t) {
+                std::this_thread::yield();
+            });
+            busy[worker] = 0;
+        });
+        REQUIRE_FALSE(overlap);
+    }
+
+    SECTION("Errors")
+    {
+        // The error of the lowest chunk, wherever it ran.
+        const auto body = [](std::size_t begin, std::size_t, std::size_t) {
+            if (begin % 10 == 3)
+                throw std::runtime_error("chunk " + std::to_string(begin));
+        };
+        for (int i{0}; i < 20; ++i)
+            REQUIRE_THROWS_WITH(pool.parallelFor(100, 1, body), "chunk 3");
+
+        REQUIRE_THROWS_AS(pool.parallelFor(10, 0, body), std::invalid_argument);
+        pool.parallelFor(0, 1, body);
+    }
+}
+
+TEST_CASE("parallelEvaluate expressions")
+{
+    CalcEval::ThreadPool pool{3};
+    const CalcEval::Parser<> parser{};
+
+    SECTION("Same order as sequential")
+    {
+        std::vector<std::string> expressions{};
+        for (int i{0}; i < 2000; ++i)
+        {
+            // Lengths vary a lot, so does the cost.
+            std::string str{std::to_string(i)};
+            for (int k{0}; k < i % 50; ++k)
+                str += "+sin(" + std::to_string(k) + ")*2^0.5";
+            expressions.push_back(str);
+        }
+
+        const std::vector<double> results{CalcEval::parallelEvaluate(pool, expressions, parser)};
+        REQUIRE(results.size() == expressions.size());
+        for (std::size_t i{0}; i < expressions.size(); ++i)
+            REQUIRE(results[i] == parser.parse(expressions[i]));
+    }
+
+    SECTION("Errors")
+    {
+        const std::vector<std::string> expressions{"1+2", "3*", "4", "foo(1)"};
+        REQUIRE_THROWS_AS(CalcEval::parallelEvaluate(pool, expressions), CalcEval::ParserError);
+        REQUIRE(CalcEval::parallelEvaluate(pool, {}).empty());
+    }
+}
+
+TEST_CASE("parallelEvaluate rows")
+{
+    CalcEval::ThreadPool pool{4};
+    const CalcEval::Compiler compiler{};
+    const CalcEval::Expression expression{compiler.compile("x*y+sin(x)-max(x,y)^2", {"x", "y"})};
+
+    constexpr std::size_t rows{100003};
+    std::vector<double> x(rows), y(rows);
+    for (std::size_t i{0}; i < rows; ++i)
+    {
+        x[i] = 0.001 * static_cast<double>(i % 1000) - 0.5;
+        y[i] = 0.002 * static_cast<double>(i % 777);
+    }
+    const std::vector<CalcEval::Span<const double>> columns{x, y};
+
+    std::vector<double> expected(rows), results(rows);
+    expression.evaluateBatch(columns, expected);
+    CalcEval::parallelEvaluate(pool, expression, columns, results);
+    REQUIRE(results == expected);
+
+    const std::vector<CalcEval::Span<const double>> one{x};
+    REQUIRE_THROWS_AS(CalcEval::parallelEvaluate(pool, expression, one, results),
+                      std::invalid_argument);
+    std::vector<double> shorter(rows - 1);
+    REQUIRE_THROWS_AS(CalcEval::parallelEvaluate(pool, expression, columns, shorter),
+                      std::invalid_argument);
+}
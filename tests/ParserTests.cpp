@@ -107,6 +107,65 @@ TEST_CASE("Function call")
     }
 }
 
+TEST_CASE("Variadic function call")
+{
+    SECTION("min and max")
+    {
+        REQUIRE(parse("min(3)") == Catch::Approx(3.0));
+        REQUIRE(parse("min(3, -2, 5)") == Catch::Approx(-2.0));
+        REQUIRE(parse("max(3, -2, 5)") == Catch::Approx(5.0));
+        REQUIRE(parse("max(1+1, 2*3, 10/5)") == Catch::Approx(6.0));
+    }
+
+    SECTION("sum and mean")
+    {
+        REQUIRE(parse("sum(1, 2, 3, 4)") == Catch::Approx(10.0));
+        REQUIRE(parse("mean(1, 2, 3, 4)") == Catch::Approx(2.5));
+    }
+
+    SECTION("hypot")
+    {
+        REQUIRE(parse("hypot(3, 4)") == Catch::Approx(5.0));
+        REQUIRE(parse("hypot(2, 3, 6)") == Catch::Approx(7.0));
+    }
+
+    SECTION("atan2")
+    {
+        REQUIRE(parse("atan2(1, 1)") == Catch::Approx(0.7853981634));
+        REQUIRE(parse("atan2(1, -1)") == Catch::Approx(2.3561944902));
+    }
+
+    SECTION("Nested")
+    {
+        REQUIRE(parse("max(min(4, 2), sum(1, max(0, 1)), 1)") == Catch::Approx(2.0));
+        REQUIRE(parse("-max(1, 2)^2") == Catch::Approx(-4.0));
+        REQUIRE(parse("sin(max(0, pi/2))") == Catch::Approx(1.0));
+    }
+
+    SECTION("Many arguments")
+    {
+        std::string expr{"sum(1"};
+        for (int i{2}; i <= 100; ++i)
+            expr += "," + std::to_string(i);
+        expr += ")";
+        REQUIRE(parse(expr) == Catch::Approx(5050.0));
+        REQUIRE(parse("max" + expr.substr(3)) == Catch::Approx(100.0));
+        REQUIRE(parse("min" + expr.substr(3)) == Catch::Approx(1.0));
+    }
+
+    SECTION("Wrong number of arguments")
+    {
+        REQUIRE_THROWS_AS(parse("atan2(1)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("atan2(1, 2, 3)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("hypot(1)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("sin(1, 2)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("max()"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("max(1,)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("max"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parse("1,2"), CalcEval::ParserError);
+    }
+}
+
 TEST_CASE("Grouping")
 {
     SECTION("Numeric")
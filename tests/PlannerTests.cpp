@@ -0,0 +1,205 @@
+//
+//  tests/PlannerTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Planner.hpp"
+#include "calceval/type/Int64.hpp"
+#include "calceval/type/Standard.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+// double with an operator of its own, compiled code would not call it.
+struct Saturating : public CalcEval::Type::Standard
+{
+    [[nodiscard]] double add(double lhs, double rhs) const noexcept
+    {
+        return std::min(lhs + rhs, 10.0);
+    }
+};
+
+// Fixed costs and four threads, the plans do not depend on the host.
+static const CalcEval::Planner planner{CalcEval::Planner::defaultCosts, 4};
+
+TEST_CASE("Workload")
+{
+    const CalcEval::Workload workload{
+        CalcEval::Workload::scan("x*y + sin(x) - max(1, atan2(y, x))")};
+    REQUIRE(workload.tokens == 20);
+    REQUIRE(workload.functions == 3);
+    REQUIRE(CalcEval::Workload::scan("").tokens == 0);
+    REQUIRE_THROWS_AS(CalcEval::Workload::scan("1 $ 2"), CalcEval::ScannerError);
+}
+
+TEST_CASE("Plans")
+{
+    const CalcEval::Parser<> parser{nullptr, planner};
+
+    SECTION("Once without variables is parsed")
+    {
+        const CalcEval::Plan plan{parser.plan("1 + 2*3")};
+        REQUIRE(plan.engine == CalcEval::Engine::Parse);
+        REQUIRE(plan.threads == 1);
+    }
+
+    SECTION("Many calls are compiled")
+    {
+        REQUIRE(parser.plan("1 + 2*3", {}, 1, 1000).engine == CalcEval::Engine::Compiled);
+        REQUIRE(parser.plan("x*y + sin(x)", {"x", "y"}).engine == CalcEval::Engine::Compiled);
+
+        // Without variables every row has the same value.
+        REQUIRE(parser.plan("1 + 2*3", {}, 100000).engine == CalcEval::Engine::Parse);
+    }
+
+    SECTION("Many rows are evaluated in batches")
+    {
+        const CalcEval::Plan plan{parser.plan("x*y + sin(x)", {"x", "y"}, 2000)};
+        REQUIRE(plan.engine == CalcEval::Engine::Batch);
+        REQUIRE(std::isinf(plan.costs[0]));
+        REQUIRE(plan.costs[2] < plan.costs[1]);
+
+        // Too few rows to split.
+        REQUIRE(std::isinf(plan.costs[3]));
+    }
+
+    SECTION("Even more rows are evaluated in parallel")
+    {
+        const CalcEval::Plan plan{parser.plan("x*y + sin(x)", {"x", "y"}, 100000)};
+        REQUIRE(plan.engine == CalcEval::Engine::Parallel);
+        REQUIRE(plan.threads == 4);
+        REQUIRE(plan.costs[3] < plan.costs[2]);
+
+        // Not with one thread.
+        const CalcEval::Planner single{CalcEval::Planner::defaultCosts, 1};
+        const CalcEval::Parser<> serial{nullptr, single};
+        REQUIRE(serial.plan("x*y + sin(x)", {"x", "y"}, 100000).engine ==
+                CalcEval::Engine::Batch);
+
+        // Not when starting threads costs more than they save.
+        CalcEval::Planner::Costs costs{CalcEval::Planner::defaultCosts};
+        costs.threadStart = 1e9;
+        const CalcEval::Parser<> slow{nullptr, CalcEval::Planner{costs, 4}};
+        REQUIRE(slow.plan("x*y + sin(x)", {"x", "y"}, 100000).engine == CalcEval::Engine::Batch);
+    }
+
+    SECTION("Explain")
+    {
+        const CalcEval::Plan plan{parser.plan("x*y + sin(x)", {"x", "y"}, 100000)};
+        const std::string text{plan.explain()};
+        REQUIRE(text.rfind("parallel on 4 threads: 8 tokens, 1 function, 2 variables, "
+                           "100000 rows, 1 call\n",
+                           0) == 0);
+        REQUIRE(text.find("parse -, compiled ") != std::string::npos);
+        REQUIRE(text.find("parallel (4 threads) ") != std::string::npos);
+    }
+
+    SECTION("Types that can not be compiled are parsed")
+    {
+        const CalcEval::Parser<CalcEval::Type::Int64> int64{};
+        const CalcEval::Plan plan{int64.plan("1 + 2*3", {}, 1, 1000)};
+        REQUIRE(plan.engine == CalcEval::Engine::Parse);
+        REQUIRE(std::isinf(plan.costs[1]));
+        REQUIRE_THROWS_AS(int64.plan("x + 1", {"x"}), std::invalid_argument);
+
+        const CalcEval::Parser<Saturating> saturating{};
+        REQUIRE(saturating.plan("8+8", {}, 1, 1000).engine == CalcEval::Engine::Parse);
+    }
+}
+
+TEST_CASE("Planner costs")
+{
+    SECTION("Calibrate")
+    {
+        const CalcEval::Planner calibrated{CalcEval::Planner::calibrate(2)};
+        REQUIRE(calibrated.threads() == 2);
+        const CalcEval::Planner::Costs& costs{calibrated.costs()};
+        for (const double cost : {costs.parseToken, costs.compileToken, costs.instruction,
+                                  costs.batchInstruction, costs.function, costs.batchFunction,
+                                  costs.call, costs.threadStart})
+            REQUIRE((std::isfinite(cost) && cost >= 0.0));
+        REQUIRE(costs.parseToken > 0.0);
+        REQUIRE(costs.compileToken > 0.0);
+    }
+
+    SECTION("toString and fromString")
+    {
+        const CalcEval::Planner read{CalcEval::Planner::fromString(planner.toString())};
+        REQUIRE(read.threads() == 4);
+        REQUIRE(read.toString() == planner.toString());
+        REQUIRE(read.costs().threadStart == CalcEval::Planner::defaultCosts.threadStart);
+    }
+
+    SECTION("Errors")
+    {
+        CalcEval::Planner::Costs negative{CalcEval::Planner::defaultCosts};
+        negative.call = -1.0;
+        REQUIRE_THROWS_AS(CalcEval::Planner(negative), std::invalid_argument);
+
+        const std::string text{planner.toString()};
+        for (const std::string& str :
+             {std::string{}, text + " cost=1", text.substr(0, text.find("threads=")),
+              text.substr(text.find(' ') + 1), text + " threads=0", text + " call=x",
+              text + " call"})
+            REQUIRE_THROWS_AS(CalcEval::Planner::fromString(str), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Evaluate with a plan")
+{
+    const std::string str{"x*y + sin(x) - max(x, 0.5)"};
+    const std::vector<std::string> variables{"x", "y"};
+    std::vector<double> x(5000), y(5000);
+    for (std::size_t i{0}; i < x.size(); ++i)
+    {
+        x[i] = 0.01 * static_cast<double>(i) - 20.0;
+        y[i] = 0.5 + 0.001 * static_cast<double>(i);
+    }
+    const std::vector<CalcEval::Span<const double>> columns{x, y};
+
+    const CalcEval::Expression expression{CalcEval::Compiler{}.compile(str, variables)};
+    std::vector<double> expected(x.size());
+    for (std::size_t i{0}; i < x.size(); ++i)
+        expected[i] = expression.evaluate(std::vector<double>{x[i], y[i]});
+
+    CalcEval::Plan plan{};
+    plan.threads = 2;
+    for (const CalcEval::Engine engine :
+         {CalcEval::Engine::Compiled, CalcEval::Engine::Batch, CalcEval::Engine::Parallel})
+    {
+        plan.engine = engine;
+        std::vector<double> results(x.size());
+        CalcEval::Planner::evaluate(plan, str, variables, columns, results);
+        REQUIRE(results == expected);
+    }
+
+    // A constant is parsed once.
+    plan.engine = CalcEval::Engine::Parse;
+    std::vector<double> results(3);
+    CalcEval::Planner::evaluate(plan, "2^10", {}, {}, results);
+    REQUIRE(results == std::vector<double>(3, 1024.0));
+
+    std::vector<double> all(x.size());
+    REQUIRE_THROWS_AS(CalcEval::Planner::evaluate(plan, str, variables, columns, all),
+                      std::invalid_argument);
+    plan.engine = CalcEval::Engine::Batch;
+    const std::vector<CalcEval::Span<const double>> one{x};
+    REQUIRE_THROWS_AS(CalcEval::Planner::evaluate(plan, str, variables, one, all),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(CalcEval::Planner::evaluate(plan, str, variables, columns, results),
+                      std::invalid_argument);
+}
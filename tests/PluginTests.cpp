@@ -0,0 +1,116 @@
+//
+//  tests/PluginTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Error.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Plugin.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#endif
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Path of the shared object built from TestPlugin.cpp.
+#ifndef TEST_PLUGIN
+#error "TEST_PLUGIN must be defined"
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Loading plugins")
+{
+    const CalcEval::Plugin plugin{TEST_PLUGIN};
+    REQUIRE(plugin.name() == "test");
+    REQUIRE(plugin.path() == TEST_PLUGIN);
+    REQUIRE(plugin.functionCount() == 2);
+    REQUIRE(plugin.constantCount() == 1);
+
+    SECTION("Errors")
+    {
+        REQUIRE_THROWS_AS(CalcEval::Plugin{"no/such/libplugin.so"}, CalcEval::Error);
+
+#if defined(__linux__)
+        // Any shared object without the entry point.
+        REQUIRE_THROWS_AS(CalcEval::Plugin{"libm.so.6"}, CalcEval::Error);
+#endif
+    }
+
+    SECTION("Names already in use")
+    {
+        CalcEval::Registry<double> registry{};
+        registry.addFunction("square", [](double x) { return x; });
+        REQUIRE_THROWS_AS(plugin.addTo(registry), std::invalid_argument);
+    }
+
+    SECTION("Moved")
+    {
+        CalcEval::Plugin first{TEST_PLUGIN};
+        CalcEval::Plugin second{std::move(first)};
+        REQUIRE(second.functionCount() == 2);
+        first = std::move(second);
+        REQUIRE(first.name() == "test");
+    }
+}
+
+TEST_CASE("Functions from plugins")
+{
+    const CalcEval::Plugin plugin{TEST_PLUGIN};
+    CalcEval::Registry<double> registry{};
+    plugin.addTo(registry);
+    const auto symbols = registry.freeze();
+
+    SECTION("Parser")
+    {
+        const CalcEval::Parser parser{symbols};
+        REQUIRE(parser.parse("square(3) + answer") == 51.0);
+        REQUIRE(parser.parse("step(-2) + step(2)") == 1.0);
+    }
+
+    SECTION("Batch entry points")
+    {
+        const CalcEval::Compiler compiler{symbols};
+        const CalcEval::Expression expression{
+            compiler.compile("square(x) + step(x - 1)", {"x"})};
+        REQUIRE(expression.functions()[0].batch == nullptr);
+        REQUIRE(expression.functions()[0].array != nullptr);
+        REQUIRE(expression.functions()[1].array == nullptr);
+
+        std::vector<double> x(3000), results(x.size());
+        for (std::size_t i{0}; i < x.size(); ++i)
+            x[i] = 0.001 * static_cast<double>(i);
+        const std::vector<CalcEval::Span<const double>> columns{x};
+        expression.evaluateBatch(columns, results);
+
+#if !defined(_WIN32)
+        // One batch call per block, the scalar version is not used.
+        void* handle{dlopen(TEST_PLUGIN, RTLD_NOW | RTLD_NOLOAD)};
+        REQUIRE(handle != nullptr);
+        using calls_type = std::size_t (*)(int);
+        const auto calls = reinterpret_cast<calls_type>(dlsym(handle, "test_plugin_calls"));
+        REQUIRE(calls != nullptr);
+        const std::size_t scalar{calls(0)};
+        const std::size_t batch{calls(1)};
+        expression.evaluateBatch(columns, results);
+        REQUIRE(calls(0) - scalar == x.size()); // step
+        REQUIRE(calls(1) - batch == (x.size() - 1) / expression.blockSize() + 1);
+        dlclose(handle);
+#endif
+
+        for (std::size_t i{0}; i < x.size(); ++i)
+            REQUIRE(results[i] == expression.evaluate(std::vector<double>{x[i]}));
+        REQUIRE(results[2000] == 5.0);
+    }
+}
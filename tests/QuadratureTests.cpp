@@ -0,0 +1,139 @@
+//
+//  tests/QuadratureTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Quadrature.hpp"
+#include "calceval/type/Int64.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Quadrature")
+{
+    const CalcEval::Compiler<> compiler{};
+    const auto integrate = [&](const std::string& body, double a, double b,
+                               double tolerance = CalcEval::Quadrature::defaultTolerance) {
+        return CalcEval::Quadrature::integrate(compiler.compile(body, {"x"}), a, b, tolerance);
+    };
+
+    SECTION("Smooth")
+    {
+        const CalcEval::Quadrature::Result square{integrate("x^2", 0.0, 1.0)};
+        REQUIRE(square.value == Catch::Approx(1.0 / 3.0).epsilon(1e-14));
+        REQUIRE(square.intervals == 1);
+
+        REQUIRE(integrate("exp(x)", 0.0, 1.0).value == Catch::Approx(std::exp(1.0) - 1.0));
+        REQUIRE(integrate("sin(x)", 0.0, 3.14159265358979323846).value == Catch::Approx(2.0));
+        REQUIRE(integrate("1/(1+x^2)", -10.0, 10.0).value ==
+                Catch::Approx(2.0 * std::atan(10.0)).epsilon(1e-12));
+    }
+
+    SECTION("Refined")
+    {
+        // Infinite derivative at 0, the intervals close to it are halved.
+        const CalcEval::Quadrature::Result root{integrate("x^0.5", 0.0, 1.0)};
+        REQUIRE(root.intervals > 1);
+        REQUIRE(root.error <= CalcEval::Quadrature::defaultTolerance);
+        REQUIRE(root.value == Catch::Approx(2.0 / 3.0).epsilon(1e-10));
+
+        // Many periods, more intervals than one chunk.
+        const CalcEval::Quadrature::Result wave{integrate("sin(50*x)^2", 0.0, 20.0, 1e-12)};
+        REQUIRE(wave.intervals > 256);
+        REQUIRE(wave.value == Catch::Approx(10.0 - std::sin(2000.0) / 200.0).epsilon(1e-12));
+
+        // The same intervals and the same sum every time.
+        const CalcEval::Quadrature::Result again{integrate("sin(50*x)^2", 0.0, 20.0, 1e-12)};
+        REQUIRE(again.value == wave.value);
+        REQUIRE(again.intervals == wave.intervals);
+    }
+
+    SECTION("Bounds")
+    {
+        REQUIRE(integrate("x", 1.0, 0.0).value == Catch::Approx(-0.5));
+        REQUIRE(integrate("x", 2.0, 2.0).value == 0.0);
+        REQUIRE(std::isnan(integrate("x", 0.0, INFINITY).value));
+        REQUIRE(std::isnan(integrate("x", NAN, 1.0).value));
+        REQUIRE(std::isnan(integrate("x", 0.0, 1.0, 0.0).value));
+        REQUIRE(std::isnan(integrate("x", 0.0, 1.0, -1.0).value));
+    }
+}
+
+TEST_CASE("integrate")
+{
+    const CalcEval::Parser<> parser{};
+    const CalcEval::Compiler<> compiler{};
+
+    // Parsed and compiled give the same bits.
+    const auto same = [&](const std::string& str) {
+        const double value{parser.parse(str)};
+        REQUIRE(compiler.compile(str).evaluate() == value);
+        return value;
+    };
+
+    SECTION("Values")
+    {
+        REQUIRE(same("integrate(x^2, x, 0, 1)") == Catch::Approx(1.0 / 3.0));
+        REQUIRE(same("integrate(sin(t), t, 0, pi, 1e-6)") == Catch::Approx(2.0).epsilon(1e-6));
+        REQUIRE(same("1+2*integrate(max(x, 1), x, 0, 2)") == Catch::Approx(6.0));
+        REQUIRE(same("integrate(integrate(x*y, y, 0, x), x, 0, 1)") == Catch::Approx(0.125));
+        REQUIRE(same("integrate(sum(k = 1, 3, x^k), x, 0, 1)") ==
+                Catch::Approx(1.0 / 2 + 1.0 / 3 + 1.0 / 4));
+    }
+
+    SECTION("Scope of the variable")
+    {
+        // The variable hides a constant or outer variable in the integrand.
+        REQUIRE(same("integrate(pi, pi, 0, 2)") == Catch::Approx(2.0));
+        REQUIRE(same("integrate(x*integrate(x, x, 0, 1), x, 0, 2)") == Catch::Approx(1.0));
+        const CalcEval::Expression expression{
+            compiler.compile("integrate(x^2, x, 0, 1) + x", {"x"})};
+        REQUIRE(expression.evaluate(std::vector<double>{10.0}) == Catch::Approx(10.0 + 1.0 / 3.0));
+    }
+
+    SECTION("Errors")
+    {
+        const std::vector<std::string> errors{
+            "integrate(x)",          "integrate(x, x, 0)",          "integrate(x, if, 0, 1)",
+            "integrate(y, x, 0, 1)", "integrate(x, x, 0, 1, 1, 2)", "integrate(, x, 0, 1)",
+            "integrate(x, x, 0, 1"};
+        for (const std::string& str : errors)
+        {
+            REQUIRE_THROWS_AS(parser.parse(str), CalcEval::ParserError);
+            REQUIRE_THROWS_AS(compiler.compile(str), CalcEval::ParserError);
+        }
+
+        // Only for a body that can be compiled.
+        const CalcEval::Parser<CalcEval::Type::Int64> int64{};
+        REQUIRE_THROWS_AS(int64.parse("integrate(x, x, 0, 1)"), CalcEval::ParserError);
+    }
+
+    SECTION("Variables")
+    {
+        const CalcEval::Expression expression{
+            compiler.compile("integrate(exp(k*t), t, 0, u)", {"k", "u"})};
+        REQUIRE(expression.evaluate(std::vector<double>{2.0, 1.0}) ==
+                Catch::Approx((std::exp(2.0) - 1.0) / 2.0));
+
+        const std::vector<double> k{2.0, -1.0, 0.5, 0.0};
+        const std::vector<double> u{1.0, 3.0, 0.0, 2.0};
+        const std::vector<CalcEval::Span<const double>> columns{k, u};
+        std::vector<double> results(k.size());
+        expression.evaluateBatch(columns, results);
+        for (std::size_t i{0}; i < k.size(); ++i)
+            REQUIRE(results[i] == expression.evaluate(std::vector<double>{k[i], u[i]}));
+    }
+}
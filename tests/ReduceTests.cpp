@@ -0,0 +1,95 @@
+//
+//  tests/ReduceTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Reduce.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <limits>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static std::vector<double> values(std::size_t count)
+{
+    std::vector<double> vec(count);
+    for (std::size_t i{0}; i < count; ++i)
+        vec[i] = std::sin(static_cast<double>(i) * 0.7) * static_cast<double>(i % 17);
+    return vec;
+}
+
+TEST_CASE("Reductions match a plain loop")
+{
+    // Sizes around the SIMD threshold and with different tails.
+    for (std::size_t count : {1u, 2u, 3u, 7u, 15u, 16u, 17u, 31u, 64u, 65u, 1000u, 1003u})
+    {
+        const std::vector<double> vec{values(count)};
+
+        double sum{0.0}, min{vec[0]}, max{vec[0]}, maxAbs{0.0}, squares{0.0};
+        for (double x : vec)
+        {
+            sum += x;
+            min = std::min(min, x);
+            max = std::max(max, x);
+            maxAbs = std::max(maxAbs, std::fabs(x));
+            squares += (x * 0.5) * (x * 0.5);
+        }
+
+        REQUIRE(CalcEval::Reduce::sum(vec) == Catch::Approx(sum).margin(1e-9));
+        REQUIRE(CalcEval::Reduce::min(vec) == min);
+        REQUIRE(CalcEval::Reduce::max(vec) == max);
+        REQUIRE(CalcEval::Reduce::maxAbs(vec) == maxAbs);
+        REQUIRE(CalcEval::Reduce::sumOfSquares(vec, 0.5) == Catch::Approx(squares));
+    }
+}
+
+TEST_CASE("NaN is propagated")
+{
+    for (std::size_t count : {1u, 5u, 64u, 1003u})
+    {
+        for (std::size_t at : {std::size_t{0}, count / 2, count - 1})
+        {
+            std::vector<double> vec{values(count)};
+            vec[at] = std::numeric_limits<double>::quiet_NaN();
+
+            REQUIRE(std::isnan(CalcEval::Reduce::sum(vec)));
+            REQUIRE(std::isnan(CalcEval::Reduce::min(vec)));
+            REQUIRE(std::isnan(CalcEval::Reduce::max(vec)));
+            REQUIRE(std::isnan(CalcEval::Reduce::maxAbs(vec)));
+        }
+    }
+}
+
+TEST_CASE("Float reductions")
+{
+    std::vector<float> vec(103);
+    for (std::size_t i{0}; i < vec.size(); ++i)
+        vec[i] = static_cast<float>(i % 7) - 2.5f;
+
+    float sum{0.0f}, min{vec[0]}, max{vec[0]};
+    for (float x : vec)
+    {
+        sum += x;
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+
+    REQUIRE(CalcEval::Reduce::sum(vec) == sum);
+    REQUIRE(CalcEval::Reduce::min(vec) == min);
+    REQUIRE(CalcEval::Reduce::max(vec) == max);
+    REQUIRE(CalcEval::Reduce::maxAbs(vec) == 3.5f);
+
+    vec[50] = std::numeric_limits<float>::quiet_NaN();
+    REQUIRE(std::isnan(CalcEval::Reduce::min(vec)));
+    REQUIRE(std::isnan(CalcEval::Reduce::max(vec)));
+    REQUIRE(std::isnan(CalcEval::Reduce::maxAbs(vec)));
+}
@@ -0,0 +1,180 @@
+//
+//  tests/RegistryTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("NameTable")
+{
+    CalcEval::NameTable names{};
+
+    SECTION("Insert and find")
+    {
+        REQUIRE(names.insert("alpha") == std::pair{0u, true});
+        REQUIRE(names.insert("beta") == std::pair{1u, true});
+        REQUIRE(names.insert("alpha") == std::pair{0u, false});
+        REQUIRE(names.size() == 2);
+
+        REQUIRE(names.find("alpha") == 0u);
+        REQUIRE(names.find("beta") == 1u);
+        REQUIRE_FALSE(names.find("gamma"));
+        REQUIRE(names.name(1) == "beta");
+    }
+
+    SECTION("Many names")
+    {
+        for (std::uint32_t i{0}; i < 5000; ++i)
+            REQUIRE(names.insert("n" + std::to_string(i)).first == i);
+
+        for (std::uint32_t i{0}; i < 5000; ++i)
+            REQUIRE(names.find("n" + std::to_string(i)) == i);
+
+        REQUIRE_FALSE(names.find("n5000"));
+    }
+}
+
+TEST_CASE("Registry")
+{
+    CalcEval::Registry<double> registry{};
+
+    SECTION("Constants and functions")
+    {
+        registry.addConstant("g", 9.81);
+        registry.addFunction("half", [](double x) { return x / 2.0; });
+
+        auto symbols = registry.freeze();
+        REQUIRE(symbols->constant("g") == 9.81);
+        REQUIRE(symbols->function("half"));
+        REQUIRE((*symbols->function("half"))(3.0) == 1.5);
+
+        // Constants are not functions and the other way around.
+        REQUIRE_FALSE(symbols->function("g"));
+        REQUIRE_FALSE(symbols->constant("half"));
+    }
+
+    SECTION("Invalid names")
+    {
+        REQUIRE_THROWS_AS(registry.addConstant("", 1.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(registry.addConstant("1a", 1.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(registry.addConstant("a_b", 1.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(registry.addFunction("f", nullptr), std::invalid_argument);
+
+        registry.addConstant("a", 1.0);
+        REQUIRE_THROWS_AS(registry.addConstant("a", 2.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(registry.addFunction("a", [](double x) { return x; }),
+                          std::invalid_argument);
+    }
+
+    SECTION("Variadic functions")
+    {
+        registry.addVariadic(
+            "count", [](CalcEval::Span<const double> args) {
+                return static_cast<double>(args.size());
+            });
+        registry.addVariadic(
+            "pair", [](CalcEval::Span<const double> args) { return args[0] * args[1]; }, 2, 2);
+        REQUIRE_THROWS_AS(registry.addVariadic("bad", nullptr), std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            registry.addVariadic(
+                "bad", [](CalcEval::Span<const double>) { return 0.0; }, 3, 2),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(registry.addFunction("count", [](double x) { return x; }),
+                          std::invalid_argument);
+
+        const CalcEval::Parser parser{registry.freeze()};
+        REQUIRE(parser.parse("count(1, 2, 3)") == Catch::Approx(3.0));
+        REQUIRE(parser.parse("pair(3, 4)") == Catch::Approx(12.0));
+        REQUIRE(parser.parse("max(pair(2, 2), count(1))") == Catch::Approx(4.0));
+        REQUIRE_THROWS_AS(parser.parse("pair(1)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parser.parse("count"), CalcEval::ParserError);
+    }
+
+    SECTION("Snapshot is not affected by later registrations")
+    {
+        registry.addConstant("a", 1.0);
+        auto first = registry.freeze();
+        registry.addConstant("b", 2.0);
+        auto second = registry.freeze();
+
+        REQUIRE(first->size() == 1);
+        REQUIRE_FALSE(first->constant("b"));
+        REQUIRE(second->constant("b") == 2.0);
+    }
+}
+
+TEST_CASE("Parser with symbols")
+{
+    CalcEval::Registry<double> registry{};
+    registry.addConstant("c", 299792458.0);
+    registry.addConstant("pi", 3.0);
+    registry.addFunction("sq", [](double x) { return x * x; });
+
+    const CalcEval::Parser parser{registry.freeze()};
+
+    SECTION("Symbols are used")
+    {
+        REQUIRE(parser.parse("c") == Catch::Approx(299792458.0));
+        REQUIRE(parser.parse("sq(3)+1") == Catch::Approx(10.0));
+    }
+
+    SECTION("Symbols take precedence over CalcType")
+    {
+        REQUIRE(parser.parse("pi") == Catch::Approx(3.0));
+        REQUIRE(parser.parse("e") == Catch::Approx(2.71828183));
+        REQUIRE(parser.parse("sin(0)") == Catch::Approx(0.0));
+    }
+
+    SECTION("Errors")
+    {
+        REQUIRE_THROWS_AS(parser.parse("sq"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(parser.parse("c(1)"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(CalcEval::Parser{}.parse("c"), CalcEval::ParserError);
+    }
+}
+
+TEST_CASE("Concurrent reads")
+{
+    CalcEval::Registry<double> registry{};
+    registry.reserve(1000);
+    for (int i{0}; i < 1000; ++i)
+        registry.addConstant("k" + std::to_string(i), static_cast<double>(i));
+
+    const CalcEval::Parser parser{registry.freeze()};
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads{};
+    for (int t{0}; t < 4; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int i{0}; i < 1000; ++i)
+            {
+                const int k{(i + t * 250) % 1000};
+                if (parser.parse("k" + std::to_string(k) + "*2") != 2.0 * k)
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(failures == 0);
+}
@@ -19,12 +19,13 @@
 
 TEST_CASE("Expected input")
 {
-    constexpr std::array<CalcEval::TokenType, 10> sequence{
+    constexpr std::array<CalcEval::TokenType, 12> sequence{
         CalcEval::TokenType::Number,     CalcEval::TokenType::LeftParen,
         CalcEval::TokenType::RightParen, CalcEval::TokenType::Identifier,
         CalcEval::TokenType::Plus,       CalcEval::TokenType::Minus,
         CalcEval::TokenType::Multiply,   CalcEval::TokenType::Divide,
-        CalcEval::TokenType::Power,      CalcEval::TokenType::EndMark};
+        CalcEval::TokenType::Power,      CalcEval::TokenType::Comma,
+        CalcEval::TokenType::Assign,     CalcEval::TokenType::EndMark};
 
     SECTION("No whitespaces")
     {
@@ -36,7 +37,7 @@ TEST_CASE("Expected input")
         // Original string with error: "1.0id+-*/^()""
         // Changed to: "1.0()id+-*/^"
 
-        std::istringstream iss{"1.0()id+-*/^"};
+        std::istringstream iss{"1.0()id+-*/^,="};
         CalcEval::Scanner scanner{iss};
         for (CalcEval::TokenType type : sequence)
         {
@@ -47,7 +48,7 @@ TEST_CASE("Expected input")
 
     SECTION("With whitespaces")
     {
-        std::istringstream iss{" 1.0 ( ) id + - * / ^ "};
+        std::istringstream iss{" 1.0 ( ) id + - * / ^ , = "};
         CalcEval::Scanner scanner{iss};
         for (CalcEval::TokenType type : sequence)
         {
@@ -85,6 +86,36 @@ TEST_CASE("Expected input")
     }
 }
 
+TEST_CASE("Relations")
+{
+    // The longest symbol is taken, "<=" is one token and "< =" is not.
+    constexpr std::array<CalcEval::TokenType, 8> sequence{
+        CalcEval::TokenType::Less,      CalcEval::TokenType::LessEqual,
+        CalcEval::TokenType::Greater,   CalcEval::TokenType::GreaterEqual,
+        CalcEval::TokenType::Equal,     CalcEval::TokenType::NotEqual,
+        CalcEval::TokenType::Less,      CalcEval::TokenType::Minus};
+
+    std::istringstream iss{"< <=>>= ==!=<-"};
+    CalcEval::Scanner scanner{iss};
+    for (CalcEval::TokenType type : sequence)
+    {
+        const CalcEval::Token token{scanner.scan()};
+        REQUIRE(type == token.type);
+    }
+    REQUIRE(scanner.scan().type == CalcEval::TokenType::EndMark);
+
+    // Located at the first char, the same as a single '>'.
+    std::istringstream one{"x > 1"}, two{"x >= 1"};
+    CalcEval::Scanner first{one}, second{two};
+    static_cast<void>(first.scan());
+    static_cast<void>(second.scan());
+    const CalcEval::Token greater{first.scan()}, greaterEqual{second.scan()};
+    REQUIRE(greaterEqual.value == ">=");
+    REQUIRE(greaterEqual.location.line == greater.location.line);
+    REQUIRE(greaterEqual.location.column == greater.location.column);
+    REQUIRE(second.scanned() == "x >=");
+}
+
 TEST_CASE("Scanned")
 {
     std::istringstream iss{"123+123"};
@@ -148,7 +179,7 @@ bool valid(int c)
         return true;
 
     const char car{static_cast<char>(c)};
-    constexpr std::array<char, 7> match{'+', '-', '*', '/', '^', '(', ')'};
+    constexpr std::array<char, 11> match{'+', '-', '*', '/', '^', '(', ')', ',', '=', '<', '>'};
     const auto found = std::find(match.cbegin(), match.cend(),car);
     if (found != match.cend())
         return true;
@@ -171,6 +202,16 @@ TEST_CASE("Unexpected input")
         }
     }
 
+    SECTION("Single !")
+    {
+        for (const char* str : {"!", "! =", "!<"})
+        {
+            std::istringstream iss{str};
+            CalcEval::Scanner scanner{iss};
+            REQUIRE_THROWS_AS(scanner.scan(), CalcEval::ScannerError);
+        }
+    }
+
     SECTION("Number starting with dot")
     {
         std::istringstream iss{".0001"};
@@ -0,0 +1,187 @@
+//
+//  tests/SeriesTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ParallelExpression.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Series.hpp"
+#include "calceval/Tape.hpp"
+#include "calceval/ThreadPool.hpp"
+#include "calceval/type/Float32.hpp"
+#include "calceval/type/Int64.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Series count")
+{
+    REQUIRE(CalcEval::Series::count(1.0, 10.0) == 10u);
+    REQUIRE(CalcEval::Series::count(0.5, 3.0) == 3u);
+    REQUIRE(CalcEval::Series::count(5.0, 5.0) == 1u);
+    REQUIRE(CalcEval::Series::count(5.0, 4.0) == 0u);
+    REQUIRE_FALSE(CalcEval::Series::count(0.0, INFINITY));
+    REQUIRE_FALSE(CalcEval::Series::count(NAN, 1.0));
+    REQUIRE_FALSE(CalcEval::Series::count(0.0, 1e300));
+}
+
+TEST_CASE("sum and prod")
+{
+    const CalcEval::Parser<> parser{};
+    const CalcEval::Compiler<> compiler{};
+
+    // Parsed and compiled give the same bits, or both NaN.
+    const auto same = [&](const std::string& str) {
+        const double value{parser.parse(str)};
+        const double compiled{compiler.compile(str).evaluate()};
+        REQUIRE((compiled == value || (std::isnan(compiled) && std::isnan(value))));
+        return value;
+    };
+
+    SECTION("Values")
+    {
+        const double pi{3.14159265358979323846};
+        REQUIRE(same("sum(i = 1, 100000, 1/i^2)") == Catch::Approx(pi * pi / 6.0).epsilon(1e-5));
+        REQUIRE(same("sum(i = 1, 1000000, i)") == 500000500000.0);
+        REQUIRE(same("prod(i = 1, 10, i)") == 3628800.0);
+        REQUIRE(same("sum(i = 0.5, 3, i)") == 4.5);
+        REQUIRE(same("2*sum(k = -3, 3, k^2)+1") == 57.0);
+        REQUIRE(same("sum(i = 1, 10, sum(j = 1, i, i*j))") == 1705.0);
+        REQUIRE(same("sum(i = 1, 3, prod(j = 1, i, j))") == 9.0);
+    }
+
+    SECTION("Scope of the index")
+    {
+        // The index hides a constant or outer index in the body, the
+        // bounds are outside of it.
+        REQUIRE(same("sum(e = 1, 3, e^2)") == 14.0);
+        REQUIRE(same("prod(pi = 1, 3, pi)") == 6.0);
+        REQUIRE(same("sum(i = 1, 3, sum(i = 1, i, i))") == 10.0);
+        const CalcEval::Expression expression{compiler.compile("sum(i = 1, 3, i^2) + i", {"i"})};
+        REQUIRE(expression.evaluate(std::vector<double>{10.0}) == 24.0);
+    }
+
+    SECTION("Compensated")
+    {
+        // Added one at a time 0.1 drifts by about 1e-6 over a million terms.
+        const double value{same("sum(i = 1, 1000000, 0.1)")};
+        REQUIRE(std::fabs(value - 100000.0) < 1e-9);
+    }
+
+    SECTION("Empty and invalid ranges")
+    {
+        REQUIRE(same("sum(i = 5, 4, i)") == 0.0);
+        REQUIRE(same("prod(i = 5, 4, i)") == 1.0);
+        REQUIRE(std::isnan(same("sum(i = 1, 1/0, i)")));
+        REQUIRE(std::isnan(same("prod(i = 0/0, 1, i)")));
+        REQUIRE(std::isnan(same("sum(i = 0, 10^300, i)")));
+    }
+
+    SECTION("Variadic sum")
+    {
+        // Without '=' after a name the arguments are summed.
+        REQUIRE(same("sum(1, 2, 3)") == 6.0);
+        REQUIRE(same("sum(pi, 1)") == Catch::Approx(3.14159265358979323846 + 1.0));
+        REQUIRE(same("sum(pi, 1, 3, pi)") == Catch::Approx(2.0 * 3.14159265358979323846 + 4.0));
+        REQUIRE(compiler.compile("sum(d, 1, 3, d)", {"d"}).evaluate(std::vector<double>{4.0}) ==
+                12.0);
+        REQUIRE(same("sum(sin(0), 2)") == 2.0);
+    }
+
+    SECTION("Errors")
+    {
+        const std::vector<std::string> errors{
+            "sum(i = 1, 2)",     "sum(i = 1, 2, i",   "sum(i = 1 2, i)", "sum(i = 1, 2, )",
+            "prod(i = 1, 2, j)", "sum(i = 1, 2, i))", "i",               "sum(i, 1, 2, i)",
+            "sum(i = i, 2, i)",  "sum(i == 1, 2, i)"};
+        for (const std::string& str : errors)
+        {
+            REQUIRE_THROWS_AS(parser.parse(str), CalcEval::ParserError);
+            REQUIRE_THROWS_AS(compiler.compile(str), CalcEval::ParserError);
+        }
+    }
+}
+
+TEST_CASE("sum and prod with variables")
+{
+    const CalcEval::Compiler<> compiler{};
+    const CalcEval::Expression expression{
+        compiler.compile("sum(i = 0, n, x^i) - prod(k = 1, 3, x+k)", {"x", "n"})};
+    REQUIRE(expression.reductions().size() == 2);
+
+    const auto expected = [](double x, double n) {
+        double s{0.0};
+        for (double i{0.0}; i <= n; ++i)
+            s += std::pow(x, i);
+        return s - (x + 1.0) * (x + 2.0) * (x + 3.0);
+    };
+
+    REQUIRE(expression.evaluate(std::vector<double>{0.5, 10.0}) ==
+            Catch::Approx(expected(0.5, 10.0)));
+
+    SECTION("Batch")
+    {
+        const std::vector<double> x{0.5, -0.25, 2.0, 0.0, 1.0};
+        const std::vector<double> n{10.0, 3.0, 0.0, 5.0, -1.0};
+        const std::vector<CalcEval::Span<const double>> columns{x, n};
+        std::vector<double> results(x.size());
+        expression.evaluateBatch(columns, results);
+
+        for (std::size_t i{0}; i < x.size(); ++i)
+            REQUIRE(results[i] == expression.evaluate(std::vector<double>{x[i], n[i]}));
+    }
+
+    SECTION("ParallelExpression")
+    {
+        // The reductions are operands of their own, the same values.
+        CalcEval::ThreadPool pool{4};
+        const CalcEval::ParallelExpression parallel{expression, 1};
+        REQUIRE(parallel.evaluate(pool, std::vector<double>{0.5, 10.0}) ==
+                expression.evaluate(std::vector<double>{0.5, 10.0}));
+    }
+
+    SECTION("Shape")
+    {
+        const CalcEval::Expression other{
+            compiler.compile("sum(i = 0, n, x^i) - prod(k = 1, 3, x-k)", {"x", "n"})};
+        REQUIRE(expression.sameShape(expression));
+        REQUIRE_FALSE(expression.sameShape(other));
+    }
+
+    SECTION("No derivative")
+    {
+        REQUIRE_THROWS_AS(CalcEval::Tape{expression}, CalcEval::Error);
+    }
+}
+
+TEST_CASE("sum and prod of other types")
+{
+    // The body is replayed for every value of the index.
+    const CalcEval::Parser<CalcEval::Type::Int64> int64{};
+    REQUIRE(int64.parse("sum(i = 1, 100, i)") == 5050);
+    REQUIRE(int64.parse("prod(i = 1, 10, i)") == 3628800);
+    REQUIRE(int64.parse("sum(i = 1, 3, sum(j = 1, i, j))") == 10);
+    REQUIRE(int64.parse("sum(i = 1, 4, i*sum(j = i, 2, 1))") == 4);
+    REQUIRE(int64.parse("sum(i = 5, 4, i)") == 0);
+    REQUIRE(int64.parse("prod(i = 5, 4, i)") == 1);
+    REQUIRE_THROWS_AS(int64.parse("sum(i = 1, 2, i"), CalcEval::ParserError);
+    REQUIRE_THROWS_AS(int64.parse("sum(i = 1, 2, j)"), CalcEval::ParserError);
+
+    const CalcEval::Parser<CalcEval::Type::Float32> float32{};
+    REQUIRE(float32.parse("sum(i = 1, 4, 1/i)") == 1.0f + 1.0f / 2 + 1.0f / 3 + 1.0f / 4);
+
+    // Above 2^24 the index of a float cannot be stepped.
+    REQUIRE_THROWS_AS(float32.parse("sum(i = 16777216, 16777218, 1)"), CalcEval::ParserError);
+}
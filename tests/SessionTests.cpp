@@ -0,0 +1,213 @@
+//
+//  tests/SessionTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/Session.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+using Names = std::vector<std::string>;
+
+TEST_CASE("Assignments")
+{
+    using CalcEval::Session;
+    REQUIRE(Session::assignment("x = 1 + 2") ==
+            std::make_pair(std::string{"x"}, std::string{" 1 + 2"}));
+    REQUIRE(Session::assignment("  rate2=0.5")->first == "rate2");
+    REQUIRE_FALSE(Session::assignment("x == 1"));
+    REQUIRE_FALSE(Session::assignment("x <= 1"));
+    REQUIRE_FALSE(Session::assignment("1 + 2"));
+    REQUIRE_FALSE(Session::assignment("2x = 1"));
+    REQUIRE_FALSE(Session::assignment("= 1"));
+    REQUIRE_FALSE(Session::assignment(""));
+}
+
+TEST_CASE("Definitions")
+{
+    CalcEval::Session session{};
+    REQUIRE(session.define("a", "2") == Names{"a"});
+    REQUIRE(session.define("b", "a * 3") == Names{"b"});
+    REQUIRE(session.define("c", "a + b + pi - pi") == Names{"c"});
+    REQUIRE(session.value("c") == 8.0);
+    REQUIRE(session.size() == 3);
+    REQUIRE(session.evaluate("c * 10 + sum(i = 1, 3, i)") == 86.0);
+
+    // Changing a evaluates b before c.
+    REQUIRE(session.define("a", "3") == Names{"a", "b", "c"});
+    REQUIRE(session.value("b") == 9.0);
+    REQUIRE(session.value("c") == 12.0);
+
+    // Nothing depends on c.
+    const std::uint64_t evaluations{session.evaluations()};
+    REQUIRE(session.define("c", "a - b") == Names{"c"});
+    REQUIRE(session.evaluations() == evaluations + 1);
+    REQUIRE(session.users("b") == Names{"c"});
+    REQUIRE(session.users("c").empty());
+
+    SECTION("Names hide constants and functions")
+    {
+        REQUIRE(session.define("e", "10") == Names{"e"});
+        REQUIRE(session.evaluate("e + 1") == 11.0);
+        REQUIRE(session.define("x", "log(e)") == Names{"x"});
+        REQUIRE(session.value("x") == std::log(10.0));
+    }
+
+    SECTION("Indices are not names")
+    {
+        REQUIRE(session.define("s", "sum(i = 1, a, i * b)") == Names{"s"});
+        REQUIRE(session.value("s") == 6.0 * 9.0);
+        REQUIRE(session.define("q", "integrate(t, t, 0, a)") == Names{"q"});
+        REQUIRE(std::abs(*session.value("q") - 4.5) < 1e-9);
+    }
+
+    SECTION("Indices hide names")
+    {
+        // Only the bounds use a defined i, not the body.
+        REQUIRE(session.define("s", "sum(i = 1, 3, i^2)") == Names{"s"});
+        REQUIRE(session.define("t", "sum(i = 1, i, i) + integrate(x, x, 0, 1)") == Names{"t"});
+        REQUIRE(session.error("t") == "i is not defined");
+        REQUIRE(session.define("i", "10") == Names{"i", "t"});
+        REQUIRE(session.value("s") == 14.0);
+        REQUIRE(std::abs(*session.value("t") - 55.5) < 1e-9);
+        REQUIRE(session.define("x", "2") == Names{"x"});
+        REQUIRE(std::abs(*session.value("t") - 55.5) < 1e-9);
+    }
+
+    SECTION("Errors leave the session unchanged")
+    {
+        REQUIRE_THROWS_AS(session.define("b", "a +"), CalcEval::ParserError);
+        REQUIRE_THROWS_AS(session.define("b", "a $ 2"), CalcEval::ScannerError);
+        REQUIRE_THROWS_AS(session.define("sum", "1"), std::invalid_argument);
+        REQUIRE_THROWS_AS(session.define("2b", "1"), std::invalid_argument);
+        REQUIRE(session.value("b") == 9.0);
+        REQUIRE_THROWS_AS(session.evaluate("nothing + 1"), CalcEval::Error);
+    }
+}
+
+TEST_CASE("Names that are not defined")
+{
+    CalcEval::Session session{};
+    REQUIRE(session.define("total", "price * count") == Names{"total"});
+    REQUIRE_FALSE(session.value("total"));
+    REQUIRE(session.error("total") == "count is not defined");
+
+    REQUIRE(session.define("price", "2.5") == Names{"price"});
+    REQUIRE(session.error("total") == "count is not defined");
+    REQUIRE(session.define("count", "4") == Names{"count", "total"});
+    REQUIRE(session.value("total") == 10.0);
+    REQUIRE(session.error("total").empty());
+
+    // Removed names give errors to their dependents.
+    REQUIRE(session.define("double", "total * 2") == Names{"double"});
+    REQUIRE(session.remove("count") == Names{"total", "double"});
+    REQUIRE_FALSE(session.contains("count"));
+    REQUIRE(session.error("double") == "depends on total, which has no value");
+    REQUIRE(session.remove("count").empty());
+    REQUIRE_THROWS_AS(session.evaluate("double"), CalcEval::Error);
+
+    REQUIRE(session.define("count", "1") == Names{"count", "total", "double"});
+    REQUIRE(session.value("double") == 5.0);
+}
+
+TEST_CASE("Cycles")
+{
+    CalcEval::Session session{};
+    REQUIRE_THROWS_AS(session.define("x", "x + 1"), CalcEval::Error);
+    REQUIRE_FALSE(session.contains("x"));
+
+    session.define("a", "b + 1");
+    session.define("b", "c + 1");
+    REQUIRE_THROWS_AS(session.define("c", "a + 1"), CalcEval::Error);
+    REQUIRE_FALSE(session.contains("c"));
+
+    session.define("c", "1");
+    REQUIRE(session.value("a") == 3.0);
+    REQUIRE_THROWS_AS(session.define("c", "if(1, 2, a)"), CalcEval::Error);
+    REQUIRE(session.value("a") == 3.0);
+}
+
+TEST_CASE("Kept errors")
+{
+    CalcEval::Session session{};
+    REQUIRE(session.keep("y", "sin + 1") == Names{"y"});
+    REQUIRE_FALSE(session.value("y"));
+    REQUIRE_FALSE(session.error("y").empty());
+    REQUIRE(session.keep("#1", "y * 2") == Names{"#1"});
+    REQUIRE(session.error("#1") == "depends on y, which has no value");
+
+    // Compiled again when sin is a name.
+    REQUIRE(session.define("sin", "2") == Names{"sin", "y", "#1"});
+    REQUIRE(session.value("#1") == 6.0);
+
+    REQUIRE_THROWS_AS(session.keep("sin", "y"), CalcEval::Error);
+    REQUIRE_THROWS_AS(session.keep("sum", "1"), std::invalid_argument);
+    REQUIRE(session.defineError("sin", "rejected") == Names{"sin", "y", "#1"});
+    REQUIRE(session.error("sin") == "rejected");
+    REQUIRE(session.error("y") == "depends on sin, which has no value");
+
+    session.clear();
+    REQUIRE(session.size() == 0);
+    REQUIRE(session.evaluate("sin(0)") == 0.0);
+}
+
+TEST_CASE("Only dependents are evaluated")
+{
+    // A chain of 10000 names and one that is independent of it.
+    CalcEval::Session session{};
+    session.define("x0", "1");
+    for (int i{1}; i < 10000; ++i)
+        session.define("x" + std::to_string(i), "x" + std::to_string(i - 1) + " + 1");
+    session.define("other", "x0 * 0 + 7");
+    REQUIRE(session.value("x9999") == 10000.0);
+
+    std::uint64_t evaluations{session.evaluations()};
+    REQUIRE(session.define("x9000", "x8999 + 2").size() == 1000);
+    REQUIRE(session.evaluations() == evaluations + 1000);
+    REQUIRE(session.value("x9999") == 10001.0);
+    REQUIRE(session.value("x8999") == 9000.0);
+
+    // The values in the diamond are computed once each, in order.
+    session.define("top", "1");
+    session.define("left", "top * 2");
+    session.define("right", "top * 3");
+    session.define("bottom", "left + right");
+    const Names changed{session.define("top", "2")};
+    REQUIRE(changed.size() == 4);
+    REQUIRE(changed.front() == "top");
+    REQUIRE(changed.back() == "bottom");
+    REQUIRE(session.value("bottom") == 10.0);
+
+    // A value that does not change stops the updates.
+    evaluations = session.evaluations();
+    REQUIRE(session.define("x0", "0 + 1") == Names{"x0"});
+    REQUIRE(session.evaluations() == evaluations + 1);
+
+    // other is evaluated, but has the same value.
+    REQUIRE(session.define("x0", "5").size() == 10000);
+    REQUIRE(session.value("x9999") == 10005.0);
+    REQUIRE(session.value("other") == 7.0);
+}
+
+TEST_CASE("Session with symbols")
+{
+    CalcEval::Registry<double> registry{};
+    registry.addFunction("twice", [](double x) { return 2.0 * x; });
+    CalcEval::Session session{registry.freeze()};
+    session.define("a", "twice(4)");
+    REQUIRE(session.value("a") == 8.0);
+}
@@ -0,0 +1,147 @@
+//
+//  tests/ShapeGroupsTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/ShapeGroups.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool identical(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0 || (std::isnan(a) && std::isnan(b));
+}
+
+static std::vector<CalcEval::Expression> compileAll(const std::vector<std::string>& strings,
+                                                    const std::vector<std::string>& variables)
+{
+    const CalcEval::Compiler compiler{};
+    std::vector<CalcEval::Expression> expressions{};
+    for (const std::string& str : strings)
+        expressions.push_back(compiler.compile(str, variables));
+    return expressions;
+}
+
+TEST_CASE("Shape")
+{
+    const CalcEval::Compiler compiler{};
+    const auto same = [&](const std::string& a, const std::string& b) {
+        const CalcEval::Expression x{compiler.compile(a, {"x"})};
+        const CalcEval::Expression y{compiler.compile(b, {"x"})};
+        const bool result{x.sameShape(y)};
+        if (result)
+            REQUIRE(x.shapeHash() == y.shapeHash());
+        return result;
+    };
+
+    REQUIRE(same("2*x+1", "3*x+0.5"));
+    REQUIRE(same("sin(x*2)^3", "sin(x*7)^0.5"));
+    REQUIRE(same("max(1, x, 2)", "max(5, x, 6)"));
+    REQUIRE(same("pi*x", "3*x"));
+
+    REQUIRE_FALSE(same("2*x+1", "x*2+1"));
+    REQUIRE_FALSE(same("sin(x)", "cos(x)"));
+    REQUIRE_FALSE(same("max(1, x)", "max(1, x, 2)"));
+    REQUIRE_FALSE(same("max(1, x)", "min(1, x)"));
+    REQUIRE_FALSE(same("-x", "x"));
+
+    const CalcEval::Expression x{compiler.compile("x+1", {"x"})};
+    const CalcEval::Expression y{compiler.compile("y+1", {"y"})};
+    REQUIRE_FALSE(x.sameShape(y));
+}
+
+TEST_CASE("groupByShape")
+{
+    const std::vector<CalcEval::Expression> expressions{
+        compileAll({"2*x+1", "sin(x)", "3*x+2", "sin(x)", "x*2+1", "4*x+3"}, {"x"})};
+
+    const std::vector<std::vector<std::size_t>> groups{CalcEval::groupByShape(expressions)};
+    const std::vector<std::vector<std::size_t>> expected{{0, 2, 5}, {1, 3}, {4}};
+    REQUIRE(groups == expected);
+    REQUIRE(CalcEval::groupByShape({}).empty());
+}
+
+TEST_CASE("ShapeGroups")
+{
+    SECTION("Identical to evaluate")
+    {
+        // Many lanes per group, with a tail that does not fill a SIMD register.
+        std::vector<std::string> strings{};
+        for (int i{0}; i < 1003; ++i)
+        {
+            const std::string a{std::to_string(0.25 * i + 0.5)};
+            const std::string b{std::to_string(i % 7)};
+            switch (i % 4)
+            {
+                case 0:
+                    strings.push_back(a + "*x+" + b + "/y");
+                    break;
+                case 1:
+                    strings.push_back("sin(" + a + "*x)^" + b + "-y");
+                    break;
+                case 2:
+                    strings.push_back("max(" + a + ", x, " + b + ")*exp(-" + b + ")");
+                    break;
+                default:
+                    strings.push_back("(" + a + ")^0.5+log(" + b + ")");
+                    break;
+            }
+        }
+        const std::vector<CalcEval::Expression> expressions{compileAll(strings, {"x", "y"})};
+        const CalcEval::ShapeGroups groups{expressions};
+        REQUIRE(groups.size() == expressions.size());
+        REQUIRE(groups.groupCount() == 4);
+
+        for (const std::vector<double>& variables : {std::vector<double>{1.25, -0.5},
+                                                     std::vector<double>{-3.0, 0.0}})
+        {
+            const std::vector<double> results{groups.evaluate(variables)};
+            REQUIRE(results.size() == expressions.size());
+            for (std::size_t i{0}; i < expressions.size(); ++i)
+            {
+                INFO(strings[i]);
+                REQUIRE(identical(results[i], expressions[i].evaluate(variables)));
+            }
+        }
+    }
+
+    SECTION("Expression without constants")
+    {
+        const CalcEval::ShapeGroups groups{compileAll({"x*x", "x*x", "x"}, {"x"})};
+        const std::vector<double> variables{3.0};
+        REQUIRE(groups.evaluate(variables) == std::vector<double>{9, 9, 3});
+    }
+
+    SECTION("Errors")
+    {
+        const std::vector<CalcEval::Expression> expressions{compileAll({"x+1", "x+2"}, {"x"})};
+        const CalcEval::ShapeGroups groups{expressions};
+        REQUIRE_THROWS_AS(groups.evaluate(), std::invalid_argument);
+        const std::vector<double> variables{1.0};
+        std::vector<double> results(1);
+        REQUIRE_THROWS_AS(groups.evaluate(variables, results), std::invalid_argument);
+
+        std::vector<CalcEval::Expression> mixed{compileAll({"x+1"}, {"x"})};
+        mixed.push_back(CalcEval::Compiler{}.compile("y+1", {"y"}));
+        REQUIRE_THROWS_AS(CalcEval::ShapeGroups{mixed}, std::invalid_argument);
+
+        const std::vector<CalcEval::Span<const double>> columns{variables};
+        std::vector<double> lanes(2);
+        REQUIRE_THROWS_AS(expressions[0].evaluateLanes(columns, variables, lanes),
+                          std::invalid_argument);
+    }
+}
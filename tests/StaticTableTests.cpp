@@ -0,0 +1,87 @@
+//
+//  tests/StaticTableTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/StaticTable.hpp"
+#include "calceval/type/Standard.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static constexpr auto table = CalcEval::makeStaticTable<int>(
+    std::pair{"one", 1}, std::pair{"two", 2}, std::pair{"three", 3}, std::pair{"four", 4},
+    std::pair{"five", 5}, std::pair{"six", 6}, std::pair{"seven", 7}, std::pair{"eight", 8});
+
+// Lookups can be done at compile time.
+static_assert(table.find("three") == 3);
+static_assert(!table.find("zero"));
+static_assert(table.index("one") == 0);
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("Lookup")
+{
+    SECTION("Every entry")
+    {
+        for (const auto& [name, value] : table.entries())
+        {
+            REQUIRE(table.find(std::string{name}) == value);
+        }
+    }
+
+    SECTION("Missing entries")
+    {
+        REQUIRE_FALSE(table.find(""));
+        REQUIRE_FALSE(table.find("on"));
+        REQUIRE_FALSE(table.find("ones"));
+        REQUIRE_FALSE(table.find("ONE"));
+    }
+
+    SECTION("Index follows entry order")
+    {
+        REQUIRE(table.index("one") == 0u);
+        REQUIRE(table.index("eight") == 7u);
+        REQUIRE_FALSE(table.index("nine"));
+    }
+
+    SECTION("Empty table")
+    {
+        constexpr auto empty = CalcEval::makeStaticTable<int>();
+        REQUIRE(empty.size() == 0);
+        REQUIRE_FALSE(empty.find("one"));
+    }
+}
+
+TEST_CASE("Standard tables")
+{
+    using Standard = CalcEval::Type::Standard;
+
+    SECTION("Constants")
+    {
+        REQUIRE(Standard::constants.find("pi") == 3.14159265);
+        REQUIRE(Standard::constants.find("e") == 2.71828183);
+        REQUIRE_FALSE(Standard::constants.find("sin"));
+    }
+
+    SECTION("Functions")
+    {
+        for (const auto& [name, func] : Standard::functions.entries())
+        {
+            auto found = Standard::functions.find(name);
+            REQUIRE(found);
+            REQUIRE(*found == func);
+        }
+
+        REQUIRE_FALSE(Standard::functions.find("pi"));
+        REQUIRE_FALSE(Standard::functions.find("sinh"));
+    }
+}
@@ -0,0 +1,171 @@
+//
+//  tests/SweepTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Sweep.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    // Every point of the sweep compared with evaluating it on its own.
+    std::uint64_t compare(const CalcEval::Sweep& sweep, const CalcEval::Expression& expression)
+    {
+        std::uint64_t points{0};
+        sweep.run([&](const CalcEval::Sweep::Block& block) {
+            std::vector<double> values(block.outer.begin(), block.outer.end());
+            values.push_back(0.0);
+            for (std::size_t i{0}; i < block.results.size(); ++i)
+            {
+                values.back() = block.inner[i];
+                const double expected{expression.evaluate(values)};
+                REQUIRE((block.results[i] == expected ||
+                         (std::isnan(block.results[i]) && std::isnan(expected))));
+                ++points;
+            }
+        });
+        return points;
+    }
+
+} // namespace
+
+TEST_CASE("Sweep axis")
+{
+    using Axis = CalcEval::Sweep::Axis;
+
+    const Axis x{Axis::parse("x=0:1:1000")};
+    REQUIRE(x.name == "x");
+    REQUIRE(x.count() == 1001);
+    REQUIRE(x.value(0) == 0.0);
+    REQUIRE(x.value(1000) == 1000.0);
+
+    REQUIRE(Axis::parse("y=0:0.1:1").count() == 11);
+    REQUIRE(Axis::parse("t=1:-0.25:-1").count() == 9);
+    REQUIRE(Axis::parse("t=1:-0.25:-1").value(8) == -1.0);
+    REQUIRE(Axis::parse("a=2:5:2").count() == 1);
+    REQUIRE(Axis::parse("a=1e3:1e2:1.5e3").count() == 6);
+
+    // Wrong direction, no step or not finite.
+    REQUIRE(Axis::parse("a=0:1:-1").count() == 0);
+    REQUIRE(Axis::parse("a=0:0:1").count() == 0);
+    REQUIRE(Axis::parse("a=0:1:inf").count() == 0);
+    REQUIRE(Axis::parse("a=nan:1:2").count() == 0);
+
+    const std::vector<std::string> errors{"x",     "=0:1:2",    "x=0:1",  "x=0:1:2:3",
+                                          "x=0::2", "x=0:1:2a", "x=a:1:2", "x=0:1:"};
+    for (const std::string& str : errors)
+        REQUIRE_THROWS_AS(Axis::parse(str), std::invalid_argument);
+}
+
+TEST_CASE("Sweep")
+{
+    const CalcEval::Compiler<> compiler{};
+    using Axis = CalcEval::Sweep::Axis;
+
+    SECTION("Two axes")
+    {
+        const CalcEval::Expression expression{
+            compiler.compile("sin(x)*y + x^2 - exp(x/3)*y", {"x", "y"})};
+        const CalcEval::Sweep sweep{expression,
+                                    {Axis::parse("x=0:0.5:10"), Axis::parse("y=-1:0.01:1")}};
+
+        REQUIRE(sweep.size() == 21 * 201);
+        REQUIRE(compare(sweep, expression) == sweep.size());
+
+        // sin(x), x^2 and exp(x/3) are computed once per x.
+        REQUIRE(sweep.hoistedCount() == 3);
+        REQUIRE(sweep.inner().code().size() == 9);
+        REQUIRE(sweep.inner().variableCount() == 5);
+        REQUIRE(sweep.instructionCount() < expression.code().size() * sweep.size());
+    }
+
+    SECTION("Three axes")
+    {
+        const CalcEval::Expression expression{
+            compiler.compile("x*y + sin(x*y)*z - 2*pi + max(x, z, 1)", {"x", "y", "z"})};
+        const CalcEval::Sweep sweep{
+            expression,
+            {Axis::parse("x=1:1:3"), Axis::parse("y=0:0.25:2"), Axis::parse("z=0:0.001:5")}};
+
+        REQUIRE(compare(sweep, expression) == sweep.size());
+        REQUIRE(sweep.hoistedCount() == 2);
+    }
+
+    SECTION("Constants are folded")
+    {
+        const CalcEval::Expression expression{
+            compiler.compile("x + 2*pi - log(10)", {"x"})};
+        const CalcEval::Sweep sweep{expression, {Axis::parse("x=0:1:9")}};
+
+        REQUIRE(compare(sweep, expression) == 10);
+        REQUIRE(sweep.hoistedCount() == 0);
+        REQUIRE(sweep.inner().code().size() == 5);
+        REQUIRE(sweep.inner().functions().empty());
+    }
+
+    SECTION("Nothing to move")
+    {
+        // x*y*2 is (x*y)*2, every operator depends on y.
+        const CalcEval::Expression expression{compiler.compile("x*y*2", {"x", "y"})};
+        const CalcEval::Sweep sweep{expression, {Axis::parse("x=0:1:3"), Axis::parse("y=0:1:3")}};
+
+        REQUIRE(compare(sweep, expression) == 16);
+        REQUIRE(sweep.hoistedCount() == 0);
+        REQUIRE(sweep.inner().code().size() == expression.code().size());
+    }
+
+    SECTION("Reductions")
+    {
+        const CalcEval::Expression expression{compiler.compile(
+            "sum(i = 1, 10, i*x) + y*sum(i = 1, y, sum(j = 1, i, x*j)) + integrate(sin(t*x), t, 0, 1)",
+            {"x", "y"})};
+        const CalcEval::Sweep sweep{expression, {Axis::parse("x=0:0.5:2"), Axis::parse("y=1:1:5")}};
+
+        REQUIRE(compare(sweep, expression) == 25);
+        REQUIRE(sweep.hoistedCount() == 2);
+    }
+
+    SECTION("Several blocks")
+    {
+        const CalcEval::Expression expression{compiler.compile("x/y + log(x)", {"x", "y"})};
+        const CalcEval::Sweep sweep{expression,
+                                    {Axis::parse("x=1:1:2"), Axis::parse("y=0:1:9999")}};
+
+        std::size_t blocks{0};
+        sweep.run([&](const CalcEval::Sweep::Block& block) {
+            REQUIRE(block.outer.size() == 1);
+            REQUIRE(block.results.size() <= CalcEval::Sweep::blockSize);
+            ++blocks;
+        });
+        REQUIRE(blocks == 6);
+        REQUIRE(compare(sweep, expression) == 20000);
+    }
+
+    SECTION("Errors")
+    {
+        const CalcEval::Expression expression{compiler.compile("x+y", {"x", "y"})};
+        REQUIRE_THROWS_AS((CalcEval::Sweep{expression, {Axis::parse("x=0:1:1")}}),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            (CalcEval::Sweep{expression, {Axis::parse("y=0:1:1"), Axis::parse("x=0:1:1")}}),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS(
+            (CalcEval::Sweep{expression, {Axis::parse("x=0:1:1"), Axis::parse("y=0:1:-1")}}),
+            std::invalid_argument);
+        REQUIRE_THROWS_AS((CalcEval::Sweep{CalcEval::Expression{}, {}}), std::invalid_argument);
+    }
+}
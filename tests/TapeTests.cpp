@@ -0,0 +1,107 @@
+//
+//  tests/TapeTests.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Local Headers
+#include "calceval/Compiler.hpp"
+#include "calceval/Dual.hpp"
+#include "calceval/Parser.hpp"
+#include "calceval/Registry.hpp"
+#include "calceval/Tape.hpp"
+#include "calceval/type/Dual.hpp"
+
+// Catch2 Headers
+#include "catch2/catch_test_macros.hpp"
+
+// C++ Headers
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool near(double a, double b)
+{
+    return std::fabs(a - b) <= 1e-12 * std::fmax(1.0, std::fabs(b));
+}
+
+// Value and gradient with forward mode, x and y are the inputs.
+static CalcEval::Dual<2> forward(const std::string& str, double x, double y)
+{
+    using D = CalcEval::Dual<2>;
+    CalcEval::Registry<D> registry{};
+    registry.addConstant("x", D::variable(x, 0));
+    registry.addConstant("y", D::variable(y, 1));
+    return CalcEval::Parser<CalcEval::Type::Dual<2>>{registry.freeze()}.parse(str);
+}
+
+TEST_CASE("Tape matches forward mode")
+{
+    const CalcEval::Compiler compiler{};
+    for (const std::string str :
+         {"x*y + sin(x)", "-x^2/y", "x^y", "2^-x*y", "x^3-y", "log(x*y)", "log10(x+y)",
+          "exp(x-y)", "cos(x/y)*tan(x+y)", "arcsin(x/y)-arccos(x*y/2)+arctan(x-y)",
+          "min(x, y, 2)*max(x, y, -1)", "sum(x, y, x*y)/mean(x, y^2)", "hypot(x, y)",
+          "hypot(x, y, 3)", "atan2(y, x)+atan2(-x, -y)", "x^y^x", "(x+1)^(y-x)*sin(exp(x))",
+          "x-x", "pi*e+1", "x*x*x*y"})
+    {
+        INFO(str);
+        CalcEval::Tape tape{compiler.compile(str, {"x", "y"})};
+        for (const auto& [x, y] : {std::pair{0.3, 1.7}, std::pair{0.75, 1.5}})
+        {
+            const CalcEval::Dual<2> expected{forward(str, x, y)};
+            std::vector<double> gradient(2);
+            const double value{tape.gradient(std::vector<double>{x, y}, gradient)};
+
+            REQUIRE(value == expected.value());
+            REQUIRE(near(gradient[0], expected.derivative(0)));
+            REQUIRE(near(gradient[1], expected.derivative(1)));
+        }
+    }
+}
+
+TEST_CASE("Tape with many variables")
+{
+    // f = sum(i * x_i^2) has df/dx_i = 2 i x_i.
+    const std::size_t count{500};
+    std::vector<std::string> names{};
+    std::string str{"0"};
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        names.push_back("x" + std::to_string(i));
+        str += "+" + std::to_string(i) + "*" + names.back() + "^2";
+    }
+
+    CalcEval::Tape tape{CalcEval::Compiler{}.compile(str, names)};
+    std::vector<double> values(count), gradient(count);
+    for (int round{0}; round < 3; ++round)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+            values[i] = 0.5 * static_cast<double>(round) - 0.001 * static_cast<double>(i);
+
+        (void)tape.gradient(values, gradient);
+        for (std::size_t i{0}; i < count; ++i)
+            REQUIRE(near(gradient[i], 2.0 * static_cast<double>(i) * values[i]));
+    }
+}
+
+TEST_CASE("Tape errors")
+{
+    CalcEval::Registry<double> registry{};
+    registry.addFunction("twice", [](double v) { return 2.0 * v; });
+    registry.addFunction("sin", [](double v) { return v; });
+    const CalcEval::Compiler compiler{registry.freeze()};
+
+    REQUIRE_THROWS_AS(CalcEval::Tape{compiler.compile("twice(x)", {"x"})}, CalcEval::Error);
+    REQUIRE_THROWS_AS(CalcEval::Tape{compiler.compile("sin(x)", {"x"})}, CalcEval::Error);
+    REQUIRE_THROWS_AS(CalcEval::Tape{CalcEval::Expression{}}, std::invalid_argument);
+
+    CalcEval::Tape tape{compiler.compile("x*y", {"x", "y"})};
+    std::vector<double> gradient(1);
+    REQUIRE_THROWS_AS(tape.gradient(std::vector<double>{1.0, 2.0}, gradient),
+                      std::invalid_argument);
+}
@@ -0,0 +1,57 @@
+//
+//  tests/TestPlugin.cpp
+//  CalcEval
+//
+//  Created by Robin Gustafsson on 2026-10-18.
+//
+
+// Shared object loaded by tests/PluginTests.cpp.
+
+// Local Headers
+#include "calceval/Plugin.h"
+
+// C++ Headers
+#include <atomic>
+#include <cstddef>
+
+namespace
+{
+    // Number of calls, to see which version is used.
+    std::atomic<std::size_t> g_scalarCalls{0};
+    std::atomic<std::size_t> g_batchCalls{0};
+
+    double square(double x)
+    {
+        ++g_scalarCalls;
+        return x * x;
+    }
+
+    void squareBatch(const double* in, double* out, std::size_t n)
+    {
+        ++g_batchCalls;
+        for (std::size_t i{0}; i < n; ++i)
+            out[i] = in[i] * in[i];
+    }
+
+    double step(double x)
+    {
+        ++g_scalarCalls;
+        return (x < 0.0) ? 0.0 : 1.0;
+    }
+
+    const calceval_function g_functions[]{{"square", square, squareBatch},
+                                          {"step", step, nullptr}};
+    const calceval_constant g_constants[]{{"answer", 42.0}};
+    const calceval_plugin g_plugin{CALCEVAL_PLUGIN_ABI, "test", g_functions, 2, g_constants, 1};
+
+} // namespace
+
+extern "C" CALCEVAL_PLUGIN_EXPORT const calceval_plugin* calceval_plugin_entry()
+{
+    return &g_plugin;
+}
+
+extern "C" CALCEVAL_PLUGIN_EXPORT std::size_t test_plugin_calls(int batch)
+{
+    return (batch) ? g_batchCalls.load() : g_scalarCalls.load();
+}